@@ -0,0 +1,166 @@
+#pragma once
+
+#include "collision_shapes.hpp"
+#include "vectors/vectors.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+class RigidBody;
+
+/**
+ * @brief Per-body float fields kept by BodyStore
+ */
+enum class BodyField : uint32_t {
+    PositionX,
+    PositionY,
+    Rotation,
+    VelocityX,
+    VelocityY,
+    AngularVelocity,
+    ForceX,
+    ForceY,
+    Torque,
+    InverseMass,
+    InverseInertia,
+    Drag,
+    DragFactor,         // (1 - drag)^dt for the last integration step
+    SleepTime,
+    ShapeHalfX,         // Collision shape in rounded-box form, see CollisionDetection::getRoundedBox()
+    ShapeHalfY,
+    ShapeRadius,
+    Count
+};
+
+/**
+ * @brief Structure-of-arrays storage for the hot state of rigid bodies
+ *
+ * Every field is a contiguous, 32-byte aligned array, all carved out of one
+ * allocation, so the integrator streams through exactly the data it needs
+ * with AVX2/SSE loads. RigidBody objects are handles into a store: a body
+ * owns a single-slot store until it is added to a PhysicsWorld, which moves
+ * its state into the world's store.
+ *
+ * Slots are dense; remove() shifts later slots down and updates the slot
+ * index of their owning bodies.
+ */
+class BodyStore {
+public:
+    static constexpr size_t kAlignment = 32;
+    static constexpr size_t kFieldCount = static_cast<size_t>(BodyField::Count);
+
+    // Bits of the flags array
+    static constexpr uint32_t kFlagDynamic = 1u << 0;
+    static constexpr uint32_t kFlagAwake = 1u << 1;
+    static constexpr uint32_t kFlagActive = 1u << 2;
+    static constexpr uint32_t kFlagContinuous = 1u << 3;   // Swept against the world each step (CCD)
+    static constexpr uint32_t kShapeTypeShift = 4;          // Bits 4-5 hold the ShapeType
+    static constexpr uint32_t kShapeTypeMask = 3u << kShapeTypeShift;
+
+    // Sleep thresholds applied by integrate()
+    static constexpr float kSleepLinearThreshold = 0.01f;
+    static constexpr float kSleepAngularThreshold = 0.01f;
+    static constexpr float kSleepTimeThreshold = 0.5f;
+
+    BodyStore() = default;
+    ~BodyStore();
+
+    // Bodies point back at their store, so it cannot be copied or moved
+    BodyStore(const BodyStore&) = delete;
+    BodyStore& operator=(const BodyStore&) = delete;
+
+    /**
+     * @brief Append a zeroed slot owned by the given body
+     * @return Slot index
+     */
+    uint32_t add(RigidBody* owner);
+
+    /**
+     * @brief Append a copy of a slot from another store
+     * @return Slot index
+     */
+    uint32_t add(RigidBody* owner, const BodyStore& source, uint32_t source_slot);
+
+    /**
+     * @brief Remove a slot, shifting later slots down by one
+     */
+    void remove(uint32_t slot);
+
+    void clear();
+    void reserve(size_t capacity);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    RigidBody* getOwner(uint32_t slot) const { return owners_[slot]; }
+
+    float* data(BodyField field) { return fields_[static_cast<size_t>(field)]; }
+    const float* data(BodyField field) const { return fields_[static_cast<size_t>(field)]; }
+    uint32_t* flags() { return flags_; }
+    const uint32_t* flags() const { return flags_; }
+
+    ShapeType getShapeType(uint32_t slot) const {
+        return static_cast<ShapeType>((flags_[slot] & kShapeTypeMask) >> kShapeTypeShift);
+    }
+
+    float& at(BodyField field, uint32_t slot) { return data(field)[slot]; }
+    float at(BodyField field, uint32_t slot) const { return data(field)[slot]; }
+
+    /**
+     * @brief Bytes saveState() writes for the current size
+     */
+    size_t getStateSize() const { return size_ * (kFieldCount * sizeof(float) + sizeof(uint32_t)); }
+
+    /**
+     * @brief Copy every field and the flags of all slots to out
+     *
+     * Field by field, so each is a single memcpy. out must hold
+     * getStateSize() bytes.
+     */
+    void saveState(std::byte* out) const;
+
+    /**
+     * @brief Overwrite all slots from a saveState() buffer of a store of the same size
+     */
+    void restoreState(const std::byte* in);
+
+    /**
+     * @brief Set a body's drag, keeping its cached drag factor current
+     */
+    void setDrag(uint32_t slot, float drag);
+
+    /**
+     * @brief Integrate every awake dynamic body
+     *
+     * Applies gravity and drag, integrates forces into velocities and
+     * velocities into positions, clears forces and updates sleep state.
+     * Uses AVX2 or SSE when available, eight or four bodies at a time.
+     *
+     * @param update_sleep Put slow bodies to sleep one by one; PhysicsWorld
+     *        passes false and sleeps whole islands after solving instead
+     */
+    void integrate(float delta_time, const Vector2<float>& gravity, bool update_sleep = true);
+
+    /**
+     * @brief Scalar version of integrate() for the slot range [begin, end)
+     */
+    void integrateScalar(float delta_time, const Vector2<float>& gravity, size_t begin, size_t end,
+                         bool update_sleep = true);
+
+private:
+    void grow(size_t min_capacity);
+    void updateDragFactors(float delta_time);
+
+    std::byte* block_ = nullptr;
+    float* fields_[kFieldCount] = {};
+    uint32_t* flags_ = nullptr;
+    std::vector<RigidBody*> owners_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    float drag_delta_time_ = -1.0f;     // Step the drag factors were computed for; < 0 if none
+};
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "dynamic_aabb_tree.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+/**
+ * @brief Available broad-phase algorithms
+ */
+enum class BroadPhaseType {
+    BruteForce,     // Test every pair; only sensible for a few hundred bodies
+    SweepAndPrune,  // Incremental sort-and-sweep on the x axis
+    UniformGrid,    // Uniform grid of PhysicsConfig::broad_phase_cell_size cells
+    DynamicTree     // Dynamic AABB tree fattened by PhysicsConfig::broad_phase_margin
+};
+
+/**
+ * @brief Axis-aligned bounds of one body as seen by the broad phase
+ */
+struct BroadPhaseProxy {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    uint32_t body_index;    // Index into PhysicsWorld's body list
+
+    bool overlaps(const BroadPhaseProxy& other) const {
+        return max_x >= other.min_x && min_x <= other.max_x &&
+               max_y >= other.min_y && min_y <= other.max_y;
+    }
+};
+
+/**
+ * @brief Potentially colliding pair of bodies (index1 < index2)
+ */
+struct BroadPhasePair {
+    uint32_t index1;
+    uint32_t index2;
+
+    static BroadPhasePair make(uint32_t a, uint32_t b) {
+        return a < b ? BroadPhasePair{a, b} : BroadPhasePair{b, a};
+    }
+
+    // Unique sortable key: pairs sort by first then second index
+    uint64_t key() const { return (static_cast<uint64_t>(index1) << 32) | index2; }
+    static BroadPhasePair fromKey(uint64_t key) {
+        return {static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)};
+    }
+
+    bool operator==(const BroadPhasePair& other) const {
+        return index1 == other.index1 && index2 == other.index2;
+    }
+    bool operator<(const BroadPhasePair& other) const { return key() < other.key(); }
+};
+
+/**
+ * @brief Broad-phase interface
+ *
+ * Implementations receive the current proxies each step and report every
+ * overlapping pair exactly once. They may keep state between calls to
+ * exploit temporal coherence; reset() discards it.
+ */
+class BroadPhase {
+public:
+    virtual ~BroadPhase() = default;
+
+    virtual BroadPhaseType getType() const = 0;
+
+    /**
+     * @brief Find all overlapping proxy pairs
+     * @param proxies Current proxy bounds
+     * @param pairs Replaced with the overlapping pairs, as body indices
+     */
+    virtual void findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) = 0;
+
+    /**
+     * @brief Discard state cached between calls
+     */
+    virtual void reset() {}
+};
+
+/**
+ * @brief Reference O(n²) broad phase
+ */
+class BruteForceBroadPhase : public BroadPhase {
+public:
+    BroadPhaseType getType() const override { return BroadPhaseType::BruteForce; }
+    void findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) override;
+};
+
+/**
+ * @brief Incremental sort-and-sweep broad phase
+ *
+ * Keeps proxies sorted by min x across steps. Bodies move little between
+ * steps, so re-sorting with insertion sort is close to linear; when too
+ * many proxies moved past each other it falls back to a full sort. The
+ * sweep runs over a contiguous copy of the proxies in sorted order.
+ */
+class SweepAndPruneBroadPhase : public BroadPhase {
+public:
+    BroadPhaseType getType() const override { return BroadPhaseType::SweepAndPrune; }
+    void findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) override;
+    void reset() override { order_.clear(); }
+
+private:
+    bool insertionSort(const std::vector<BroadPhaseProxy>& proxies);
+
+    std::vector<uint32_t> order_;           // Proxy indices sorted by min x
+    std::vector<BroadPhaseProxy> sorted_;
+};
+
+/**
+ * @brief Uniform grid broad phase
+ *
+ * Each proxy is binned into every cell it touches. Cell entries are sorted
+ * by cell, pairs are tested within each cell, and pairs found in several
+ * cells are removed by sorting their keys. Proxies covering more than
+ * kMaxCellsPerProxy cells are kept out of the grid and tested against
+ * everything instead.
+ */
+class UniformGridBroadPhase : public BroadPhase {
+public:
+    static constexpr size_t kMaxCellsPerProxy = 64;
+
+    explicit UniformGridBroadPhase(float cell_size);
+
+    BroadPhaseType getType() const override { return BroadPhaseType::UniformGrid; }
+    void findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) override;
+
+    float getCellSize() const { return cell_size_; }
+
+private:
+    struct CellEntry {
+        uint64_t cell;
+        uint32_t proxy;
+    };
+
+    float cell_size_;
+    float inverse_cell_size_;
+    std::vector<CellEntry> entries_;
+    std::vector<uint32_t> oversized_;
+    std::vector<uint64_t> pair_keys_;
+};
+
+/**
+ * @brief Dynamic AABB tree broad phase
+ *
+ * Keeps one tree proxy per body across steps; a proxy is only re-inserted
+ * when its body leaves the fattened bounds. Each proxy then queries the
+ * tree with its tight bounds.
+ */
+class DynamicTreeBroadPhase : public BroadPhase {
+public:
+    explicit DynamicTreeBroadPhase(float margin) : tree_(margin) {}
+
+    BroadPhaseType getType() const override { return BroadPhaseType::DynamicTree; }
+    void findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) override;
+    void reset() override;
+
+    const DynamicAABBTree& getTree() const { return tree_; }
+
+private:
+    DynamicAABBTree tree_;
+    std::vector<int32_t> body_nodes_;       // Tree proxy per body index
+    std::vector<uint32_t> body_stamps_;     // Step in which each body last had a proxy
+    uint32_t stamp_ = 0;
+};
+
+/**
+ * @brief Create a broad phase of the given type
+ * @param cell_size Cell size for BroadPhaseType::UniformGrid
+ * @param margin Bounds margin for BroadPhaseType::DynamicTree
+ */
+std::unique_ptr<BroadPhase> createBroadPhase(BroadPhaseType type, float cell_size, float margin = 0.1f);
+
+} // namespace Physics
+} // namespace PyNovaGE
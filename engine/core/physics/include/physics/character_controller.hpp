@@ -0,0 +1,112 @@
+#pragma once
+
+#include "collision_shapes.hpp"
+#include "dynamic_aabb_tree.hpp"
+#include "rigid_body.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+/**
+ * @brief Shape and movement limits shared by a batch of characters
+ *
+ * Characters are upright capsules centered on their position.
+ */
+struct CharacterConfig {
+    float radius = 0.4f;              // Capsule radius
+    float height = 1.8f;              // Capsule height including both caps
+    float step_height = 0.3f;         // Tallest ledge walked onto without jumping; 0 disables stepping
+    float min_ground_normal = 0.7f;   // Surfaces whose normal has at least this y are walkable
+    float skin = 0.01f;               // Gap kept between the capsule and the geometry
+    int max_slides = 4;               // Surfaces slid along per move
+};
+
+/**
+ * @brief One character's move: where it is and where it wants to go this step
+ *
+ * The displacement should include gravity, so that characters fall and
+ * stay on the ground.
+ */
+struct CharacterMove {
+    Vector2<float> position;
+    Vector2<float> displacement;
+};
+
+/**
+ * @brief Where a character ended up
+ */
+struct CharacterResult {
+    Vector2<float> position;
+    Vector2<float> ground_normal{0.0f, 1.0f};   // Normal of the ground under the character, when grounded
+    bool grounded = false;                      // Standing on a walkable surface at the end of the move
+    bool collided = false;                      // Touched geometry during the move
+    bool stepped = false;                       // Stepped up onto a ledge
+};
+
+/**
+ * @brief Static level geometry baked for kinematic character movement
+ *
+ * build() copies the rounded-box form (see
+ * CollisionDetection::getRoundedBox()) of every static body into a flat
+ * array and inserts it into a dynamic AABB tree of its own, with no margin.
+ * Neither is touched again until the next build(), so moving or removing
+ * static bodies afterwards has no effect on characters.
+ *
+ * moveCharacter() is move-and-slide: the capsule is swept along its
+ * displacement, stops short of the first surface, keeps the part of the
+ * displacement along it and repeats. Walls up to
+ * CharacterConfig::step_height tall are stepped onto instead. One tree
+ * query per move collects the shapes within reach, and every sweep after
+ * that runs over that short list. Queries only read the geometry, so any
+ * number of threads can move characters at once.
+ */
+class StaticGeometry {
+public:
+    /**
+     * @brief Bake the static bodies among bodies, replacing the previous geometry
+     */
+    void build(std::span<const std::shared_ptr<RigidBody>> bodies);
+    void clear();
+
+    size_t getShapeCount() const { return shapes_.size(); }
+    const DynamicAABBTree& getTree() const { return tree_; }
+
+    /**
+     * @brief Move one character against the geometry
+     * @param candidates Scratch list reused between calls
+     */
+    CharacterResult moveCharacter(const CharacterConfig& config, const CharacterMove& move,
+                                  std::vector<uint32_t>& candidates) const;
+
+private:
+    // A static body as a rectangle of half_size around center with corners rounded by radius
+    struct Shape {
+        Vector2<float> center;
+        Vector2<float> half_size;
+        float radius;
+    };
+
+    // Earliest hit of the capsule moving by motion, over the candidates
+    CollisionDetection::SweepResult sweep(const Vector2<float>& half_size, float radius, const Vector2<float>& position,
+                                          const Vector2<float>& motion, std::span<const uint32_t> candidates) const;
+
+    // Push the capsule out of any candidate it starts in
+    void depenetrate(const CharacterConfig& config, const Vector2<float>& half_size, Vector2<float>& position,
+                     std::span<const uint32_t> candidates) const;
+
+    // Up by the step height, along the horizontal part of motion, then back
+    // down onto walkable ground; false if that gets nowhere
+    bool stepUp(const CharacterConfig& config, const Vector2<float>& half_size, const Vector2<float>& motion,
+                Vector2<float>& position, Vector2<float>& ground_normal, std::span<const uint32_t> candidates) const;
+
+    std::vector<Shape> shapes_;
+    DynamicAABBTree tree_{0.0f};    // User data is the index into shapes_
+};
+
+} // namespace Physics
+} // namespace PyNovaGE
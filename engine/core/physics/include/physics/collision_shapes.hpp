@@ -2,6 +2,7 @@
 
 #include "simd/geometry_ops.hpp"
 #include "vectors/vectors.hpp"
+#include <cstdint>
 #include <memory>
 #include <variant>
 
@@ -20,7 +21,7 @@ class RigidBody;
 enum class ShapeType {
     Rectangle,  // AABB (Axis-Aligned Bounding Box)
     Circle,     // Sphere in 2D
-    Capsule     // Rounded rectangle (for future expansion)
+    Capsule     // Upright capsule: a vertical segment swept by a circle
 };
 
 /**
@@ -94,6 +95,43 @@ private:
     float radius_;
 };
 
+/**
+ * @brief Upright capsule collision shape
+ *
+ * A vertical segment swept by a circle, the usual shape for characters.
+ * Like rectangles, capsules stay axis-aligned whatever the body rotation.
+ */
+class CapsuleShape : public CollisionShape {
+public:
+    /**
+     * @param radius Radius of the end caps and half the width
+     * @param height Total height including both caps, at least 2 * radius
+     */
+    CapsuleShape(float radius, float height)
+        : CollisionShape(ShapeType::Capsule), radius_(radius),
+          half_length_(height * 0.5f > radius ? height * 0.5f - radius : 0.0f) {}
+    
+    float getRadius() const { return radius_; }
+    float getHeight() const { return (half_length_ + radius_) * 2.0f; }
+    float getHalfLength() const { return half_length_; }    // Half length of the inner segment
+    
+    bool intersects(const CollisionShape& other, const Vector2<float>& thisPos, const Vector2<float>& otherPos) const override;
+    AABB<float> getBounds(const Vector2<float>& position) const override;
+    Vector2<float> getClosestPoint(const Vector2<float>& point, const Vector2<float>& position) const override;
+    
+    float getArea() const override { return 4.0f * radius_ * half_length_ + 3.14159265359f * radius_ * radius_; }
+    float getInertia(float mass) const override {
+        // Bounding rectangle approximation
+        float width = radius_ * 2.0f;
+        float height = getHeight();
+        return mass * (width * width + height * height) / 12.0f;
+    }
+
+private:
+    float radius_;
+    float half_length_;
+};
+
 /**
  * @brief Collision detection utilities
  */
@@ -111,6 +149,10 @@ namespace CollisionDetection {
     bool intersects(const RectangleShape& rect, const Vector2<float>& rectPos,
                    const CircleShape& circle, const Vector2<float>& circlePos);
     
+    // Capsule vs any shape
+    bool intersects(const CapsuleShape& capsule, const Vector2<float>& capsulePos,
+                   const CollisionShape& other, const Vector2<float>& otherPos);
+    
     // Point-in-shape tests (leveraging existing SIMD containment)
     bool contains(const RectangleShape& rect, const Vector2<float>& rectPos, const Vector2<float>& point);
     bool contains(const CircleShape& circle, const Vector2<float>& circlePos, const Vector2<float>& point);
@@ -121,10 +163,55 @@ namespace CollisionDetection {
         Vector2<float> normal;      // Collision normal (from body1 to body2)
         float penetration = 0.0f;   // Penetration depth
         Vector2<float> contactPoint; // Contact point in world space
+        uint32_t featureId = 0;     // Which face/vertex pair touches; stable while the contact persists
     };
     
     CollisionManifold generateManifold(const CollisionShape& shape1, const Vector2<float>& pos1,
                                      const CollisionShape& shape2, const Vector2<float>& pos2);
+    
+    /**
+     * @brief Shape as a rectangle of the given half size with corners rounded by radius
+     *
+     * Rectangles have radius 0, circles half size 0 and capsules a half
+     * size of (0, half length). Every shape pair is then a point against
+     * the Minkowski sum of two rounded boxes.
+     */
+    bool getRoundedBox(const CollisionShape& shape, Vector2<float>& halfSize, float& radius);
+    
+    /**
+     * @brief Manifold of two shapes in rounded-box form (see getRoundedBox())
+     *
+     * Used for every pair involving a capsule.
+     */
+    CollisionManifold generateRoundedBoxManifold(const Vector2<float>& halfSize1, float radius1, const Vector2<float>& pos1,
+                                                 const Vector2<float>& halfSize2, float radius2, const Vector2<float>& pos2);
+    
+    // Time of impact for continuous collision detection
+    struct SweepResult {
+        bool hit = false;
+        float toi = 1.0f;           // Fraction of the motion at first contact
+        Vector2<float> normal;      // Contact normal at impact, from shape2 towards shape1
+    };
+    
+    /**
+     * @brief First contact of shape1 moving by motion from pos1 against a still shape2
+     *
+     * Shapes that already overlap at the start report no hit; that is left
+     * to the discrete tests.
+     */
+    SweepResult sweep(const CollisionShape& shape1, const Vector2<float>& pos1, const Vector2<float>& motion,
+                      const CollisionShape& shape2, const Vector2<float>& pos2);
+    
+    /**
+     * @brief First contact of the point origin moving by motion against a
+     *        rectangle of the given half size around center, with corners
+     *        rounded by radius
+     *
+     * Every shape pair reduces to this through its Minkowski sum. The normal
+     * points out of the rounded box; starting inside reports no hit.
+     */
+    SweepResult sweepRoundedBox(const Vector2<float>& origin, const Vector2<float>& motion,
+                                const Vector2<float>& center, const Vector2<float>& halfSize, float radius);
 
 } // namespace CollisionDetection
 
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "vectors/vectors.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+/**
+ * @brief Plain 2D bounds used by the acceleration structures
+ */
+struct Bounds2D {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+
+    bool overlaps(const Bounds2D& other) const {
+        return max_x >= other.min_x && min_x <= other.max_x &&
+               max_y >= other.min_y && min_y <= other.max_y;
+    }
+
+    bool contains(const Bounds2D& other) const {
+        return min_x <= other.min_x && min_y <= other.min_y &&
+               max_x >= other.max_x && max_y >= other.max_y;
+    }
+
+    float perimeter() const { return 2.0f * ((max_x - min_x) + (max_y - min_y)); }
+
+    Bounds2D expanded(float margin) const {
+        return {min_x - margin, min_y - margin, max_x + margin, max_y + margin};
+    }
+
+    static Bounds2D combine(const Bounds2D& a, const Bounds2D& b) {
+        return {std::min(a.min_x, b.min_x), std::min(a.min_y, b.min_y),
+                std::max(a.max_x, b.max_x), std::max(a.max_y, b.max_y)};
+    }
+};
+
+/**
+ * @brief Dynamic bounding volume hierarchy over fattened AABBs
+ *
+ * Leaves store bounds enlarged by a margin, so a proxy only has to be
+ * re-inserted when its tight bounds leave the fat bounds. Insertion picks
+ * the sibling with the surface-area heuristic and keeps the tree balanced
+ * with AVL-style rotations. Traversal is stackless: internal nodes keep
+ * parent links and the walk climbs back up instead of pushing children,
+ * so queries need no scratch memory and are safe to run concurrently.
+ * Raycasts clip the ray as the callback reports closer hits.
+ *
+ * Node ids stay valid until the proxy is destroyed. Not thread-safe for
+ * modification.
+ */
+class DynamicAABBTree {
+public:
+    static constexpr int32_t kNullNode = -1;
+
+    explicit DynamicAABBTree(float margin = 0.1f) : margin_(margin) {}
+
+    /**
+     * @brief Insert a proxy
+     * @param bounds Tight bounds (fattened by the margin internally)
+     * @param user_data Value returned by getUserData()
+     * @return Proxy id
+     */
+    int32_t createProxy(const Bounds2D& bounds, uint32_t user_data);
+
+    /**
+     * @brief Remove a proxy
+     */
+    void destroyProxy(int32_t proxy);
+
+    /**
+     * @brief Update a proxy's bounds
+     * @return true if the proxy left its fat bounds and was re-inserted
+     */
+    bool moveProxy(int32_t proxy, const Bounds2D& bounds);
+
+    /**
+     * @brief Remove all proxies
+     */
+    void clear();
+
+    uint32_t getUserData(int32_t proxy) const { return nodes_[proxy].user_data; }
+    void setUserData(int32_t proxy, uint32_t user_data) { nodes_[proxy].user_data = user_data; }
+    const Bounds2D& getFatBounds(int32_t proxy) const { return nodes_[proxy].bounds; }
+
+    float getMargin() const { return margin_; }
+    void setMargin(float margin) { margin_ = margin; }
+
+    size_t getProxyCount() const { return proxy_count_; }
+    int32_t getHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; }
+
+    /**
+     * @brief Check parent links, heights and bounds of the whole tree
+     */
+    bool validate() const;
+
+    /**
+     * @brief Visit every proxy whose fat bounds overlap the query bounds
+     * @param callback bool(int32_t proxy); return false to stop
+     */
+    template<typename Callback>
+    void query(const Bounds2D& bounds, Callback&& callback) const {
+        int32_t index = root_;
+        while (index != kNullNode) {
+            const Node& node = nodes_[index];
+            if (node.bounds.overlaps(bounds)) {
+                if (!node.isLeaf()) {
+                    index = node.child1;
+                    continue;
+                }
+                if (!callback(index)) {
+                    return;
+                }
+            }
+            index = nextSubtree(index);
+        }
+    }
+
+    /**
+     * @brief Visit every proxy in depth-first order, so spatially close
+     *        proxies are visited one after another
+     * @param callback void(int32_t proxy)
+     */
+    template<typename Callback>
+    void forEachProxy(Callback&& callback) const {
+        int32_t index = root_;
+        while (index != kNullNode) {
+            const Node& node = nodes_[index];
+            if (!node.isLeaf()) {
+                index = node.child1;
+                continue;
+            }
+            callback(index);
+            index = nextSubtree(index);
+        }
+    }
+
+    /**
+     * @brief Visit every proxy whose fat bounds the ray segment crosses
+     * @param origin Ray start
+     * @param direction Ray direction (any length; t is measured in multiples of it)
+     * @param max_t Segment end
+     * @param callback float(int32_t proxy, float max_t); return the new max_t
+     *        to clip the ray (return max_t unchanged to keep going, 0 to stop)
+     */
+    template<typename Callback>
+    void raycast(const Vector2<float>& origin, const Vector2<float>& direction, float max_t,
+                 Callback&& callback) const {
+        // Large finite stand-ins for 1/0 keep the slab test valid under fast-math
+        const float inv_x = std::abs(direction.x) > 1e-12f ? 1.0f / direction.x
+                                                           : (direction.x < 0.0f ? -1e30f : 1e30f);
+        const float inv_y = std::abs(direction.y) > 1e-12f ? 1.0f / direction.y
+                                                           : (direction.y < 0.0f ? -1e30f : 1e30f);
+
+        int32_t index = root_;
+        while (index != kNullNode && max_t > 0.0f) {
+            const Node& node = nodes_[index];
+            if (rayOverlaps(node.bounds, origin, inv_x, inv_y, max_t)) {
+                if (!node.isLeaf()) {
+                    index = node.child1;
+                    continue;
+                }
+                max_t = std::min(max_t, callback(index, max_t));
+            }
+            index = nextSubtree(index);
+        }
+    }
+
+private:
+    struct Node {
+        Bounds2D bounds;
+        int32_t parent = kNullNode;     // Next free node while on the free list
+        int32_t child1 = kNullNode;
+        int32_t child2 = kNullNode;
+        int32_t height = -1;            // 0 for leaves, -1 for free nodes
+        uint32_t user_data = 0;
+
+        bool isLeaf() const { return child1 == kNullNode; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t index);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t index);
+    void refitAncestors(int32_t index);
+    void replaceChild(int32_t parent, int32_t old_child, int32_t new_child);
+    int32_t validateNode(int32_t index, bool& valid) const;
+
+    // Next node in depth-first order after skipping index's subtree
+    int32_t nextSubtree(int32_t index) const {
+        while (index != root_) {
+            const int32_t parent = nodes_[index].parent;
+            if (nodes_[parent].child1 == index) {
+                return nodes_[parent].child2;
+            }
+            index = parent;
+        }
+        return kNullNode;
+    }
+
+    static bool rayOverlaps(const Bounds2D& bounds, const Vector2<float>& origin,
+                            float inv_x, float inv_y, float max_t) {
+        const float tx1 = (bounds.min_x - origin.x) * inv_x;
+        const float tx2 = (bounds.max_x - origin.x) * inv_x;
+        const float ty1 = (bounds.min_y - origin.y) * inv_y;
+        const float ty2 = (bounds.max_y - origin.y) * inv_y;
+        const float t_enter = std::max(std::min(tx1, tx2), std::min(ty1, ty2));
+        const float t_exit = std::min(std::max(tx1, tx2), std::max(ty1, ty2));
+        return t_exit >= std::max(t_enter, 0.0f) && t_enter <= max_t;
+    }
+
+    std::vector<Node> nodes_;
+    int32_t root_ = kNullNode;
+    int32_t free_list_ = kNullNode;
+    size_t proxy_count_ = 0;
+    float margin_;
+};
+
+} // namespace Physics
+} // namespace PyNovaGE
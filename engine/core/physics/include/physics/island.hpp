@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+/**
+ * @brief Groups bodies connected by contacts into simulation islands
+ *
+ * Bodies are identified by index. Each step, add the bodies taking part
+ * (awake dynamic bodies) and every contact, then call finish(). Contacts
+ * join the islands of their two bodies with a union-find; a contact end of
+ * kNoBody (a static or kinematic body) joins nothing, so a shared ground
+ * does not merge everything resting on it into one island.
+ *
+ * Output is deterministic: islands are ordered by their lowest body index
+ * and list their bodies and contacts in the order they were added.
+ */
+class IslandBuilder {
+public:
+    static constexpr uint32_t kNoBody = 0xFFFFFFFFu;
+
+    /**
+     * @brief Start a new build for body indices [0, body_count)
+     */
+    void reset(size_t body_count);
+
+    /**
+     * @brief Add a body; bodies must be added in increasing index order
+     */
+    void addBody(uint32_t body);
+
+    /**
+     * @brief Add a contact between two added bodies (or kNoBody)
+     *
+     * Contacts with no body on either side are ignored.
+     */
+    void addContact(uint32_t contact, uint32_t body1, uint32_t body2);
+
+    /**
+     * @brief Resolve islands; the getters are valid until the next reset()
+     */
+    void finish();
+
+    size_t getIslandCount() const { return body_offsets_.empty() ? 0 : body_offsets_.size() - 1; }
+
+    std::span<const uint32_t> getIslandBodies(size_t island) const {
+        return {bodies_.data() + body_offsets_[island], body_offsets_[island + 1] - body_offsets_[island]};
+    }
+
+    std::span<const uint32_t> getIslandContacts(size_t island) const {
+        return {contacts_.data() + contact_offsets_[island], contact_offsets_[island + 1] - contact_offsets_[island]};
+    }
+
+    /**
+     * @brief Island of an added body (after finish())
+     */
+    uint32_t getIsland(uint32_t body) const { return island_of_body_[body]; }
+
+private:
+    uint32_t find(uint32_t body);
+
+    struct ContactEntry {
+        uint32_t contact;
+        uint32_t body;      // Either end that is an added body
+    };
+
+    std::vector<uint32_t> parent_;          // Union-find forest over body indices
+    std::vector<uint32_t> island_of_body_;
+    std::vector<uint32_t> added_bodies_;
+    std::vector<ContactEntry> added_contacts_;
+
+    // Islands in compressed form: island i owns [offsets[i], offsets[i + 1])
+    std::vector<uint32_t> bodies_;
+    std::vector<uint32_t> body_offsets_;
+    std::vector<uint32_t> contacts_;
+    std::vector<uint32_t> contact_offsets_;
+};
+
+/**
+ * @brief Splits contacts into colors that share no body
+ *
+ * Greedy graph coloring of the contact graph: each contact gets the lowest
+ * color that neither of its bodies is already using, so all contacts of one
+ * color can be solved in parallel without races. Contacts that do not fit
+ * in kMaxColors go into an overflow batch that must be solved serially.
+ * Colors keep the relative order of the input, making the result
+ * deterministic.
+ */
+class ContactColoring {
+public:
+    static constexpr size_t kMaxColors = 64;
+
+    /**
+     * @brief Color the given contacts
+     * @param contacts Contact indices to color
+     * @param body1 First body of each contact, indexed by contact (IslandBuilder::kNoBody if static)
+     * @param body2 Second body of each contact, indexed by contact
+     * @param body_count Upper bound of the body indices
+     */
+    void build(std::span<const uint32_t> contacts, const uint32_t* body1, const uint32_t* body2, size_t body_count);
+
+    size_t getColorCount() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    std::span<const uint32_t> getColor(size_t color) const {
+        return {contacts_.data() + offsets_[color], offsets_[color + 1] - offsets_[color]};
+    }
+
+    std::span<const uint32_t> getOverflow() const { return overflow_; }
+
+private:
+    std::vector<uint64_t> body_colors_;     // Bit c set if the body has a contact of color c
+    std::vector<uint8_t> contact_colors_;
+    std::vector<uint32_t> contacts_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> overflow_;
+    std::vector<uint32_t> color_sizes_;     // Scratch for build(), kept to reuse its capacity
+    std::vector<uint32_t> cursor_;
+};
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -7,11 +7,12 @@
  * This header provides access to the complete 2D physics system built on top of 
  * PyNovaGE's SIMD-optimized math foundation. The physics system includes:
  * 
- * - Collision shapes (Rectangle, Circle)
+ * - Collision shapes (Rectangle, Circle, Capsule)
  * - Rigid body dynamics
  * - Physics world simulation
  * - SIMD-accelerated broad-phase collision detection
  * - Constraint-based collision resolution
+ * - Batched kinematic character movement against baked static geometry
  * 
  * Example usage:
  * @code
@@ -91,6 +92,10 @@ namespace PyNovaGE {
             inline std::shared_ptr<CircleShape> circle(float radius) {
                 return std::make_shared<CircleShape>(radius);
             }
+            
+            inline std::shared_ptr<CapsuleShape> capsule(float radius, float height) {
+                return std::make_shared<CapsuleShape>(radius, height);
+            }
         }
         
         /**
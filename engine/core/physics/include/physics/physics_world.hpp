@@ -1,13 +1,27 @@
 #pragma once
 
 #include "rigid_body.hpp"
+#include "body_store.hpp"
 #include "collision_shapes.hpp"
+#include "broad_phase.hpp"
+#include "character_controller.hpp"
+#include "dynamic_aabb_tree.hpp"
+#include "island.hpp"
+#include "narrow_phase.hpp"
+#include "region_grid.hpp"
 #include "simd/geometry_ops.hpp"
 #include <vector>
 #include <unordered_set>
 #include <memory>
+#include <memory_resource>
+#include <cstddef>
+#include <span>
 
 namespace PyNovaGE {
+namespace Threading {
+class ThreadPool;
+}
+
 namespace Physics {
 
 /**
@@ -18,9 +32,14 @@ struct PhysicsConfig {
     float time_scale = 1.0f;               // Time scale multiplier
     int velocity_iterations = 8;           // Constraint solver iterations for velocity
     int position_iterations = 3;           // Constraint solver iterations for position
-    float sleep_threshold = 0.5f;          // Time before bodies go to sleep
+    float sleep_threshold = 0.5f;          // Time an island must be at rest before it goes to sleep
     bool enable_sleeping = true;           // Whether to use sleeping optimization
-    float broad_phase_margin = 0.1f;       // Extra margin for broad-phase collision detection
+    float broad_phase_margin = 0.1f;       // Fattening margin for the query tree and BroadPhaseType::DynamicTree
+    BroadPhaseType broad_phase = BroadPhaseType::SweepAndPrune; // Broad-phase algorithm
+    float broad_phase_cell_size = 4.0f;    // Cell size for BroadPhaseType::UniformGrid
+    bool enable_warm_starting = true;      // Seed contacts with last step's impulses
+    int max_continuous_substeps = 4;       // Impacts handled per step for continuous-collision bodies
+    float region_size = 0.0f;              // Side of the spatial regions stepped in parallel; 0 disables them
 };
 
 /**
@@ -30,6 +49,8 @@ struct Contact {
     RigidBody* body1 = nullptr;
     RigidBody* body2 = nullptr;
     CollisionDetection::CollisionManifold manifold;
+    uint64_t pair_key = 0;          // BroadPhasePair::key() of the two bodies
+    Vector2<float> separation;      // body2 minus body1 position when the manifold was built
     
     // Constraint solving data
     float normal_impulse = 0.0f;
@@ -45,15 +66,70 @@ struct Contact {
  * @brief 2D Physics World
  * 
  * Manages all rigid bodies and simulates physics using your existing SIMD collision detection.
- * Uses efficient broad-phase collision detection with SIMD AABB tests.
+ * The broad phase is pluggable (see BroadPhaseType) and selected through PhysicsConfig.
+ * Its pairs go through the batched NarrowPhase, bucketed by shape pair.
+ * Queries and raycasts go through a dynamic AABB tree over all bodies that is
+ * kept in sync on addBody() and at the end of every step; call
+ * updateQueryTree() after moving bodies by hand between steps.
+ *
+ * Added bodies keep their hot state in the world's BodyStore, indexed like
+ * getBodies(), and are integrated together with SIMD kernels. A body can be
+ * in one world at a time.
+ *
+ * Contacts that persist from one step to the next (same body pair, same
+ * manifold feature) start from the impulses they ended the last step with,
+ * so resting stacks converge in a few solver iterations. Removing a body
+ * drops the cache and contacts start cold for one step.
+ *
+ * Every step the awake bodies are grouped into islands connected by
+ * contacts. An island whose bodies all stay at rest for
+ * PhysicsConfig::sleep_threshold goes to sleep as a whole; sleeping bodies
+ * are not integrated, have no broad-phase proxy and are not solved, and
+ * they wake with everything resting on them when something awake touches
+ * them. Islands are independent, so with a thread pool set they are solved
+ * in parallel; large islands are split into contact colors that share no
+ * body. Results do not depend on the pool or its thread count.
+ *
+ * Bodies with RigidBody::setContinuousCollision() are swept from their
+ * previous to their new position after integration. On impact with a
+ * static or kinematic body they stop at the time of impact, lose their
+ * approach velocity (keeping restitution) and continue with the rest of the
+ * step, up to PhysicsConfig::max_continuous_substeps impacts. On impact
+ * with a dynamic body they stop just inside it and the solver resolves the
+ * contact.
+ *
+ * Stepping is deterministic: bodies are processed in getBodies() order and
+ * pairs, contacts and islands in body index order, never by address, so
+ * the same bodies added in the same order with the same inputs give
+ * bit-identical results whatever the broad phase or thread pool. With
+ * saveState() and restoreState() this supports an authoritative server
+ * and client-side rollback.
+ *
+ * For very large worlds, PhysicsConfig::region_size splits the awake bodies
+ * into square regions (see RegionGrid). Each region finds its pairs with
+ * its own SweepAndPruneBroadPhase, in place of PhysicsConfig::broad_phase,
+ * runs its narrow phase and solves the contacts between its bodies, all
+ * concurrently on the thread pool. Bodies straddling a region border, and
+ * their contacts, are handled in a separate boundary pass after the regions
+ * in each solver iteration. Results depend on the region size but still not
+ * on the thread pool.
+ *
+ * Characters that should not be simulated, such as crowds of NPCs, move
+ * kinematically with moveCharacters() against the static geometry baked
+ * by bakeStaticGeometry() (see StaticGeometry). They do not collide with
+ * dynamic bodies or with each other.
  */
 class PhysicsWorld {
 public:
     PhysicsWorld(const PhysicsConfig& config = PhysicsConfig{});
-    ~PhysicsWorld() = default;
+    ~PhysicsWorld();
+
+    // Bodies point into the world's store
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
 
     // World configuration
-    void setConfig(const PhysicsConfig& config) { config_ = config; }
+    void setConfig(const PhysicsConfig& config);
     const PhysicsConfig& getConfig() const { return config_; }
     
     void setGravity(const Vector2<float>& gravity) { config_.gravity = gravity; }
@@ -67,16 +143,68 @@ public:
     
     size_t getBodyCount() const { return bodies_.size(); }
     const std::vector<std::shared_ptr<RigidBody>>& getBodies() const { return bodies_; }
+    const BodyStore& getBodyStore() const { return body_store_; }
+
+    /**
+     * @brief Indices into getBodies() of the non-static bodies awake after the last step()
+     *
+     * Sleeping and static bodies did not move, so code copying results out
+     * can walk this instead of every body. Emptied when a body is removed.
+     */
+    std::span<const uint32_t> getAwakeBodies() const { return awake_bodies_; }
 
     // Physics simulation
     void step(float deltaTime);
     void setTimeScale(float scale) { config_.time_scale = scale; }
     float getTimeScale() const { return config_.time_scale; }
 
-    // Collision queries (leveraging SIMD broad-phase)
+    /**
+     * @brief Snapshot everything step() carries over from one step to the next
+     *
+     * That is the BodyStore of all bodies (positions, velocities, forces,
+     * sleep state, flags), the warm-starting contact cache and the fixed
+     * step time accumulator, as one flat buffer. Bodies are identified by
+     * index, so a snapshot fits this world, or one with the same bodies
+     * added in the same order, as long as no body was added or removed.
+     *
+     * @param buffer Replaced with the snapshot; reuse it to avoid allocating
+     */
+    void saveState(std::vector<std::byte>& buffer) const;
+    std::vector<std::byte> saveState() const;
+
+    /**
+     * @brief Return to a snapshot taken by saveState()
+     * @throws std::invalid_argument If the buffer is not a snapshot of a world with this many bodies
+     */
+    void restoreState(std::span<const std::byte> buffer);
+
+    /**
+     * @brief Solve islands, or step regions, on a thread pool
+     * @param pool Pool to use, or nullptr to solve on the calling thread (default)
+     */
+    void setThreadPool(Threading::ThreadPool* pool) { thread_pool_ = pool; }
+    Threading::ThreadPool* getThreadPool() const { return thread_pool_; }
+
+    // Collision queries (accelerated by the query tree)
     std::vector<RigidBody*> queryAABB(const AABB<float>& bounds) const;
     std::vector<RigidBody*> queryPoint(const Vector2<float>& point) const;
     std::vector<RigidBody*> queryShape(const CollisionShape& shape, const Vector2<float>& position) const;
+
+    // Allocation-free variants: replace the contents of results. Pass a vector
+    // backed by a per-frame memory resource to keep per-frame queries off the heap.
+    void queryAABB(const AABB<float>& bounds, std::pmr::vector<RigidBody*>& results) const;
+    void queryPoint(const Vector2<float>& point, std::pmr::vector<RigidBody*>& results) const;
+    void queryShape(const CollisionShape& shape, const Vector2<float>& position,
+                    std::pmr::vector<RigidBody*>& results) const;
+
+    /**
+     * @brief Refit the query tree to the current body bounds
+     *
+     * step() does this automatically; only needed after moving bodies
+     * directly (setPosition, shape changes) before querying.
+     */
+    void updateQueryTree();
+    const DynamicAABBTree& getQueryTree() const { return query_tree_; }
     
     // Ray casting
     struct RaycastHit {
@@ -89,13 +217,63 @@ public:
     
     RaycastHit raycast(const Vector2<float>& start, const Vector2<float>& end) const;
     std::vector<RaycastHit> raycastAll(const Vector2<float>& start, const Vector2<float>& end) const;
+    void raycastAll(const Vector2<float>& start, const Vector2<float>& end,
+                    std::pmr::vector<RaycastHit>& results) const;
+
+    struct RaySegment {
+        Vector2<float> start;
+        Vector2<float> end;
+    };
+
+    /**
+     * @brief Closest hit for each ray
+     * @param hits Receives one result per ray; must be at least rays.size() long
+     */
+    void raycastBatch(std::span<const RaySegment> rays, std::span<RaycastHit> hits) const;
+
+    /**
+     * @brief Any hit for each ray, stopping at the first one found
+     *
+     * Cheaper than raycastBatch() when only occlusion matters, as for line of
+     * sight; the reported hit is not necessarily the closest.
+     */
+    void raycastAnyBatch(std::span<const RaySegment> rays, std::span<RaycastHit> hits) const;
+
+    /**
+     * @brief Bake the current static bodies for moveCharacters()
+     *
+     * Call once the level is loaded. Static bodies added, moved or removed
+     * later only affect characters after the next bake.
+     */
+    void bakeStaticGeometry();
+    const StaticGeometry& getStaticGeometry() const { return static_geometry_; }
+
+    /**
+     * @brief Move-and-slide a batch of capsule characters against the baked static geometry
+     *
+     * Spread over the thread pool when one is set; every character is moved
+     * independently, so results do not depend on the pool. Query scratch is
+     * kept per worker by the world, so calls after the first do not allocate
+     * once it has grown to fit.
+     *
+     * @param results Receives one result per move; must be at least moves.size() long
+     * @throws std::invalid_argument If the result buffer is too small or the character shape is invalid
+     */
+    void moveCharacters(const CharacterConfig& config, std::span<const CharacterMove> moves,
+                        std::span<CharacterResult> results);
 
     // Debug and statistics
     struct PhysicsStats {
         size_t active_bodies = 0;
         size_t sleeping_bodies = 0;
         size_t contacts = 0;
+        size_t broad_phase_proxies = 0;    // Awake bodies in the broad phase
         size_t broad_phase_pairs = 0;
+        size_t islands = 0;                // Awake islands solved in the last step
+        size_t continuous_hits = 0;        // Impacts found by continuous collision
+        size_t warm_started_contacts = 0;  // Contacts seeded from the contact cache
+        size_t regions = 0;                // Spatial regions of the last step, 0 without region_size
+        size_t boundary_contacts = 0;      // Contacts solved in the boundary pass after the regions
         float step_time = 0.0f;
         float broad_phase_time = 0.0f;
         float narrow_phase_time = 0.0f;
@@ -108,40 +286,114 @@ public:
 private:
     PhysicsConfig config_;
     std::vector<std::shared_ptr<RigidBody>> bodies_;
+    BodyStore body_store_;                  // Slot i holds the state of bodies_[i]
     std::vector<Contact> contacts_;
     PhysicsStats stats_;
 
+    // Accumulated impulses of last step's contacts, sorted by pair key
+    struct CachedImpulse {
+        uint64_t pair_key;
+        uint32_t feature_id;
+        float normal_impulse;
+        float tangent_impulse;
+    };
+    std::vector<CachedImpulse> contact_cache_;
+
+    // saveState() layout: header, BodyStore state, then the contact cache
+    struct StateHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t body_count;
+        uint32_t cached_contacts;
+        float time_accumulator;
+    };
+    static constexpr uint32_t kStateMagic = 0x50534E50u;   // "PNSP"
+    static constexpr uint32_t kStateVersion = 1;
+    static constexpr size_t kCachedImpulseBytes = sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(float);
+
     // Simulation steps
     void integrate(float deltaTime);
     void broadPhaseCollision();
     void narrowPhaseCollision();
+    void beginContinuousCollision();
+    void solveContinuousCollisions(float deltaTime);
+    void buildIslands();
     void solveConstraints(float deltaTime);
     void updateSleepingBodies(float deltaTime);
     
     // Collision detection phases
-    struct BroadPhasePair {
-        size_t index1;
-        size_t index2;
-        
-        bool operator==(const BroadPhasePair& other) const {
-            return (index1 == other.index1 && index2 == other.index2) ||
-                   (index1 == other.index2 && index2 == other.index1);
-        }
-    };
-    
+    std::unique_ptr<BroadPhase> broad_phase_;
+    std::vector<BroadPhaseProxy> broad_phase_proxies_;
     std::vector<BroadPhasePair> broad_phase_pairs_;
     
-    // Broad-phase collision using SIMD AABB intersection
+    // Broad-phase collision using the configured BroadPhase
     void performBroadPhase();
+    void findStillPairs(const BroadPhaseProxy& proxy, std::vector<BroadPhasePair>& pairs) const;
+    void finishPairs(std::vector<BroadPhasePair>& pairs) const;
     
-    // Narrow-phase collision using shape-specific tests
+    // Narrow-phase collision using shape-pair kernels
     void performNarrowPhase();
+    NarrowPhase narrow_phase_;
+    Contact createContact(const BroadPhasePair& pair, const CollisionDetection::CollisionManifold& manifold) const;
+    bool seedFromCache(Contact& contact, const CachedImpulse& cached) const;
     
-    // Contact constraint solving
-    void warmStartContacts();
-    void solveVelocityConstraints();
-    void solvePositionConstraints();
+    // Spatial regions; job r < getRegionCount() is region r, the last job
+    // the boundary pass
+    struct RegionJob {
+        SweepAndPruneBroadPhase broad_phase;
+        std::vector<BroadPhaseProxy> proxies;
+        std::vector<BroadPhasePair> pairs;
+        NarrowPhase narrow_phase;
+        std::vector<Contact> contacts;
+        size_t warm_started = 0;
+    };
+    RegionGrid region_grid_;
+    std::vector<std::unique_ptr<RegionJob>> region_jobs_;
+    std::vector<uint32_t> region_contact_offsets_;  // Runs of contacts_ sorted by key, one per job
+    void regionBroadPhase();
+    void regionNarrowPhase();
+    void solveRegions();
     
+    // Contact constraint solving over lists of contact indices
+    void warmStartContacts(std::span<const uint32_t> contacts);
+    void solveVelocityConstraints(std::span<const uint32_t> contacts);
+    void solvePositionConstraints(std::span<const uint32_t> contacts);
+    void solveIsland(std::span<const uint32_t> contacts);
+    void solveColoredIsland(std::span<const uint32_t> contacts);
+    void updateContactCache();
+
+    // Islands of awake bodies; contact ends are body indices, or
+    // IslandBuilder::kNoBody for bodies the solver does not move
+    IslandBuilder island_builder_;
+    ContactColoring contact_coloring_;
+    std::vector<uint32_t> contact_body1_;
+    std::vector<uint32_t> contact_body2_;
+    std::vector<uint32_t> small_islands_;
+    std::vector<uint32_t> large_islands_;
+    std::vector<uint32_t> wake_stack_;
+    Threading::ThreadPool* thread_pool_ = nullptr;
+    static constexpr size_t kColoredIslandContacts = 256;  // Islands this large are solved by color
+
+    // Continuous-collision bodies moving this step and where they started
+    std::vector<uint32_t> continuous_bodies_;
+    std::vector<Vector2<float>> continuous_starts_;
+
+    // Wake a sleeping body and every sleeping body touching it, transitively
+    void wakeBody(uint32_t index);
+    void wakeBodiesTouching(const AABB<float>& bounds);
+    
+    // Query tree over all bodies; user data is the body index
+    DynamicAABBTree query_tree_;
+    std::vector<int32_t> query_proxies_;    // Tree proxy per body, parallel to bodies_
+
+    // Level geometry for moveCharacters()
+    StaticGeometry static_geometry_;
+    static constexpr size_t kCharacterBatch = 256;          // Characters per thread pool task
+    std::vector<std::vector<uint32_t>> character_candidates_;   // Per pool worker, plus one for the caller
+
+    void removeBodyAt(size_t index);
+    RaycastHit castRay(const Vector2<float>& start, const Vector2<float>& end, bool any_hit) const;
+
     // Utility methods
     void clearContacts() { contacts_.clear(); }
     bool isValidPair(const RigidBody& body1, const RigidBody& body2) const;
@@ -149,6 +401,7 @@ private:
     // Performance optimization
     void updateActiveBodyList();
     std::vector<size_t> active_body_indices_;
+    std::vector<uint32_t> awake_bodies_;    // See getAwakeBodies(), rebuilt by step()
     
     // Time accumulation for fixed time step (optional)
     float time_accumulator_ = 0.0f;
@@ -181,6 +434,22 @@ public:
         return *this;
     }
     
+    PhysicsWorldBuilder& enableWarmStarting(bool enable) {
+        config_.enable_warm_starting = enable;
+        return *this;
+    }
+    
+    PhysicsWorldBuilder& setBroadPhase(BroadPhaseType type, float cell_size = 4.0f) {
+        config_.broad_phase = type;
+        config_.broad_phase_cell_size = cell_size;
+        return *this;
+    }
+    
+    PhysicsWorldBuilder& setRegionSize(float size) {
+        config_.region_size = size;
+        return *this;
+    }
+    
     std::unique_ptr<PhysicsWorld> build() {
         return std::make_unique<PhysicsWorld>(config_);
     }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "broad_phase.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Physics {
+
+/**
+ * @brief Splits the world into square regions that can be stepped in parallel
+ *
+ * build() lays a grid of region_size cells over the bounds of the given
+ * proxies, at most kMaxRegionsPerAxis cells per axis (the outer cells
+ * stretch to cover the rest). A proxy whose bounds lie in one cell is
+ * interior to that region; any other proxy is a boundary proxy and a guest
+ * in every region it overlaps. Interior proxies of different regions
+ * cannot overlap, so each region finds its own pairs, those with at least
+ * one interior proxy, independently of the others. Pairs of two boundary
+ * proxies are left to a separate boundary pass.
+ *
+ * assignContacts() then sorts contacts the same way: a contact whose moving
+ * bodies are all interior to one region belongs to it, every other contact
+ * to the boundary. Region contacts touch disjoint bodies, so regions can be
+ * solved concurrently before the boundary contacts.
+ *
+ * Everything is listed in input order, so the result does not depend on
+ * how the regions are scheduled.
+ */
+class RegionGrid {
+public:
+    static constexpr uint32_t kBoundary = 0xFFFFFFFFu;
+    static constexpr uint32_t kNoBody = 0xFFFFFFFFu;       // Same as IslandBuilder::kNoBody
+    static constexpr int32_t kMaxRegionsPerAxis = 32;
+
+    /**
+     * @brief Assign proxies to regions
+     * @param proxies Proxies of the moving bodies
+     * @param region_size Side of a region, must be positive
+     * @param body_count Upper bound of the proxies' body indices
+     */
+    void build(std::span<const BroadPhaseProxy> proxies, float region_size, size_t body_count);
+
+    size_t getRegionCount() const { return interior_counts_.size(); }
+
+    /**
+     * @brief Proxies of a region as indices into the built proxies: its
+     * getInteriorCount() interior proxies first, then its guests
+     */
+    std::span<const uint32_t> getRegionProxies(size_t region) const {
+        return {proxies_.data() + proxy_offsets_[region], proxy_offsets_[region + 1] - proxy_offsets_[region]};
+    }
+
+    size_t getInteriorCount(size_t region) const { return interior_counts_[region]; }
+
+    /**
+     * @brief Every boundary proxy, as indices into the built proxies
+     */
+    std::span<const uint32_t> getBoundaryProxies() const { return boundary_; }
+
+    /**
+     * @brief Region a body is interior to, or kBoundary
+     *
+     * Bodies without a proxy are kBoundary.
+     */
+    uint32_t getRegion(uint32_t body) const { return region_of_body_[body]; }
+
+    /**
+     * @brief Sort contacts into regions and the boundary
+     * @param body1 First moving body of each contact (kNoBody for static or kinematic)
+     * @param body2 Second moving body of each contact
+     * @param contact_count Number of contacts
+     */
+    void assignContacts(const uint32_t* body1, const uint32_t* body2, size_t contact_count);
+
+    std::span<const uint32_t> getRegionContacts(size_t region) const {
+        return {contacts_.data() + contact_offsets_[region], contact_offsets_[region + 1] - contact_offsets_[region]};
+    }
+
+    std::span<const uint32_t> getBoundaryContacts() const {
+        const size_t begin = contact_offsets_.empty() ? 0 : contact_offsets_.back();
+        return {contacts_.data() + begin, contacts_.size() - begin};
+    }
+
+private:
+    std::vector<uint32_t> region_of_body_;
+    std::vector<uint32_t> interior_counts_;
+    std::vector<uint32_t> proxy_offsets_;   // Region r owns [offsets[r], offsets[r + 1])
+    std::vector<uint32_t> proxies_;
+    std::vector<uint32_t> boundary_;
+    std::vector<uint32_t> contact_region_;
+    std::vector<uint32_t> contact_offsets_; // Boundary contacts follow the last region
+    std::vector<uint32_t> contacts_;
+    std::vector<uint32_t> cursors_;        // Fill positions of the counting sorts
+};
+
+} // namespace Physics
+} // namespace PyNovaGE
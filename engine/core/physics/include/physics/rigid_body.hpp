@@ -1,6 +1,7 @@
 #pragma once
 
 #include "collision_shapes.hpp"
+#include "body_store.hpp"
 #include "vectors/vectors.hpp"
 #include <memory>
 
@@ -31,48 +32,78 @@ struct Material {
  * 
  * This class represents a physical object that can participate in collision detection
  * and physics simulation. It integrates with your existing SIMD math foundation.
+ *
+ * A RigidBody is a handle: its position, velocity, forces and flags live in a
+ * BodyStore slot. A new body owns a private one-slot store; PhysicsWorld::addBody
+ * moves the state into the world's store so the world can integrate all bodies
+ * with SIMD kernels, and removing the body moves it back out. Bodies are
+ * therefore not copyable; share them through std::shared_ptr.
  */
 class RigidBody {
 public:
     RigidBody(std::shared_ptr<CollisionShape> shape, BodyType type = BodyType::Dynamic);
-    ~RigidBody() = default;
+    ~RigidBody();
+
+    RigidBody(const RigidBody&) = delete;
+    RigidBody& operator=(const RigidBody&) = delete;
 
     // Basic properties
-    void setPosition(const Vector2<float>& position) { position_ = position; }
-    const Vector2<float>& getPosition() const { return position_; }
+    void setPosition(const Vector2<float>& position) {
+        field(BodyField::PositionX) = position.x;
+        field(BodyField::PositionY) = position.y;
+    }
+    Vector2<float> getPosition() const {
+        return Vector2<float>(field(BodyField::PositionX), field(BodyField::PositionY));
+    }
     
-    void setRotation(float rotation) { rotation_ = rotation; }
-    float getRotation() const { return rotation_; }
+    void setRotation(float rotation) { field(BodyField::Rotation) = rotation; }
+    float getRotation() const { return field(BodyField::Rotation); }
     
-    void setBodyType(BodyType type) { type_ = type; updateMassProperties(); }
+    void setBodyType(BodyType type);
     BodyType getBodyType() const { return type_; }
 
     // Physics properties
     void setMass(float mass);
     float getMass() const { return mass_; }
-    float getInverseMass() const { return inverse_mass_; }
+    float getInverseMass() const { return field(BodyField::InverseMass); }
     
     void setInertia(float inertia);
     float getInertia() const { return inertia_; }
-    float getInverseInertia() const { return inverse_inertia_; }
+    float getInverseInertia() const { return field(BodyField::InverseInertia); }
 
     // Velocity and motion
-    void setLinearVelocity(const Vector2<float>& velocity) { linear_velocity_ = velocity; }
-    const Vector2<float>& getLinearVelocity() const { return linear_velocity_; }
+    void setLinearVelocity(const Vector2<float>& velocity) {
+        field(BodyField::VelocityX) = velocity.x;
+        field(BodyField::VelocityY) = velocity.y;
+    }
+    Vector2<float> getLinearVelocity() const {
+        return Vector2<float>(field(BodyField::VelocityX), field(BodyField::VelocityY));
+    }
     
-    void setAngularVelocity(float velocity) { angular_velocity_ = velocity; }
-    float getAngularVelocity() const { return angular_velocity_; }
+    void setAngularVelocity(float velocity) { field(BodyField::AngularVelocity) = velocity; }
+    float getAngularVelocity() const { return field(BodyField::AngularVelocity); }
 
     // Forces and impulses
-    void applyForce(const Vector2<float>& force) { accumulated_force_ += force; }
+    void applyForce(const Vector2<float>& force) {
+        field(BodyField::ForceX) += force.x;
+        field(BodyField::ForceY) += force.y;
+    }
     void applyForceAtPoint(const Vector2<float>& force, const Vector2<float>& point);
-    void applyImpulse(const Vector2<float>& impulse) { linear_velocity_ += impulse * inverse_mass_; }
-    void applyAngularImpulse(float impulse) { angular_velocity_ += impulse * inverse_inertia_; }
+    void applyImpulse(const Vector2<float>& impulse) { setLinearVelocity(getLinearVelocity() + impulse * getInverseMass()); }
+    void applyAngularImpulse(float impulse) { field(BodyField::AngularVelocity) += impulse * getInverseInertia(); }
     
-    void clearForces() { accumulated_force_ = Vector2<float>(0.0f); accumulated_torque_ = 0.0f; }
+    Vector2<float> getAccumulatedForce() const {
+        return Vector2<float>(field(BodyField::ForceX), field(BodyField::ForceY));
+    }
+    float getAccumulatedTorque() const { return field(BodyField::Torque); }
+    void clearForces() {
+        field(BodyField::ForceX) = 0.0f;
+        field(BodyField::ForceY) = 0.0f;
+        field(BodyField::Torque) = 0.0f;
+    }
 
     // Material properties
-    void setMaterial(const Material& material) { material_ = material; updateMassProperties(); }
+    void setMaterial(const Material& material);
     const Material& getMaterial() const { return material_; }
 
     // Collision shape
@@ -80,13 +111,14 @@ public:
     std::shared_ptr<CollisionShape> getCollisionShapePtr() const { return collision_shape_; }
     void setCollisionShape(std::shared_ptr<CollisionShape> shape) { 
         collision_shape_ = shape; 
+        updateShape();
         updateMassProperties(); 
     }
 
     // World space bounds (uses existing SIMD AABB system)
     AABB<float> getWorldBounds() const;
 
-    // Integration (called by physics world)
+    // Integrate this body alone; PhysicsWorld integrates its whole store at once
     void integrate(float deltaTime);
 
     // Collision response helpers
@@ -94,36 +126,59 @@ public:
     void resolveCollision(const Vector2<float>& normal, float penetration, const Vector2<float>& contactPoint, RigidBody& other);
 
     // State flags
-    void setActive(bool active) { is_active_ = active; }
-    bool isActive() const { return is_active_; }
+    void setActive(bool active) { setFlag(BodyStore::kFlagActive, active); }
+    bool isActive() const { return hasFlag(BodyStore::kFlagActive); }
     
-    void setAwake(bool awake) { is_awake_ = awake; if (awake) sleep_time_ = 0.0f; }
-    bool isAwake() const { return is_awake_; }
+    void setAwake(bool awake) {
+        setFlag(BodyStore::kFlagAwake, awake);
+        if (awake) field(BodyField::SleepTime) = 0.0f;
+    }
+    bool isAwake() const { return hasFlag(BodyStore::kFlagAwake); }
+
+    /**
+     * @brief Opt in to continuous collision detection
+     *
+     * For fast, small bodies such as projectiles that would otherwise pass
+     * through thin geometry between steps. Costs a swept query per step
+     * while the body moves far enough to tunnel; other bodies pay nothing.
+     */
+    void setContinuousCollision(bool enabled) { setFlag(BodyStore::kFlagContinuous, enabled); }
+    bool hasContinuousCollision() const { return hasFlag(BodyStore::kFlagContinuous); }
 
     // Debug/utility
     bool isStatic() const { return type_ == BodyType::Static; }
     bool isKinematic() const { return type_ == BodyType::Kinematic; }
     bool isDynamic() const { return type_ == BodyType::Dynamic; }
 
+    // Storage
+    const BodyStore& getStore() const { return *store_; }
+    uint32_t getStoreSlot() const { return slot_; }
+
 private:
-    // Transform
-    Vector2<float> position_{0.0f};
-    float rotation_ = 0.0f;
+    friend class BodyStore;     // Renumbers slot_ when earlier slots are removed
+    friend class PhysicsWorld;  // Attaches bodies to its store
+
+    float& field(BodyField f) { return store_->at(f, slot_); }
+    float field(BodyField f) const { return store_->at(f, slot_); }
+    bool hasFlag(uint32_t flag) const { return (store_->flags()[slot_] & flag) != 0; }
+    void setFlag(uint32_t flag, bool value) {
+        uint32_t& flags = store_->flags()[slot_];
+        flags = value ? (flags | flag) : (flags & ~flag);
+    }
+
+    // Move the hot state into another store, or back into a private one
+    void attachToStore(BodyStore& store);
+    void detachFromStore();
+
+    // Hot state
+    BodyStore* store_ = nullptr;
+    uint32_t slot_ = 0;
+    std::unique_ptr<BodyStore> own_store_;  // Set while not in a world
 
     // Physics properties
     BodyType type_;
     float mass_ = 1.0f;
-    float inverse_mass_ = 1.0f;
     float inertia_ = 1.0f;
-    float inverse_inertia_ = 1.0f;
-
-    // Motion state
-    Vector2<float> linear_velocity_{0.0f};
-    float angular_velocity_ = 0.0f;
-
-    // Forces
-    Vector2<float> accumulated_force_{0.0f};
-    float accumulated_torque_ = 0.0f;
 
     // Material
     Material material_;
@@ -131,19 +186,11 @@ private:
     // Collision
     std::shared_ptr<CollisionShape> collision_shape_;
 
-    // State management
-    bool is_active_ = true;
-    bool is_awake_ = true;
-    float sleep_time_ = 0.0f;
-
     // Internal methods
     void updateMassProperties();
-    void updateSleepState(float deltaTime);
-    
-    // Physics constants
-    static constexpr float SLEEP_LINEAR_THRESHOLD = 0.01f;
-    static constexpr float SLEEP_ANGULAR_THRESHOLD = 0.01f;
-    static constexpr float SLEEP_TIME_THRESHOLD = 0.5f;
+    void updateShape();     // Mirror the shape into the store for the narrow phase
+    void setInverseMass(float inverse_mass) { field(BodyField::InverseMass) = inverse_mass; }
+    void setInverseInertia(float inverse_inertia) { field(BodyField::InverseInertia) = inverse_inertia; }
 };
 
 /**
@@ -1,14 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
-#include <memory>
-#include "rigid_body.hpp"
-#include "math/vector.hpp"
-#include "simd/geometry_ops.hpp"
+#include "broad_phase.hpp"
+#include "vectors/vectors.hpp"
 
 namespace PyNovaGE {
+namespace Threading {
+class ThreadPool;
+}
+
 namespace Physics {
 
 //------------------------------------------------------------------------------
@@ -16,165 +19,82 @@ namespace Physics {
 // Divides 2D space into uniform grid cells for O(n) collision detection
 //------------------------------------------------------------------------------
 
+/**
+ * @brief Flat uniform grid over a fixed world rectangle
+ *
+ * Items are broad-phase proxies, identified by their index in the span
+ * passed to rebuild(). Each item sits in one cell, the one holding its min
+ * corner, and the grid is stored in counting-sort form: item indices
+ * ordered by cell plus each cell's start and size, with a copy of the
+ * bounds in the same order. Items outside the world rectangle go to the
+ * nearest edge cell. Items spanning more than two cells on an axis go to an oversized
+ * bucket after the last cell and are tested against everything.
+ *
+ * rebuild() is a linear-time counting sort, optionally spread over a
+ * thread pool with the same result. It leaves kCellSlack free slots at the
+ * end of every cell, so update(), which takes the same items with new
+ * bounds, moves an item that changed cells in constant time; only a move
+ * into a full cell makes it rebuild. emitPairs() writes the overlapping
+ * pairs into a caller-provided buffer. Nothing allocates once the buffers
+ * have grown to the item and cell counts.
+ */
 class SpatialGrid {
 public:
-    struct GridCell {
-        std::vector<std::shared_ptr<RigidBody>> bodies;
-        
-        void clear() {
-            bodies.clear();
-        }
-        
-        void reserve(size_t capacity) {
-            bodies.reserve(capacity);
-        }
-    };
-    
-    struct CollisionPair {
-        std::shared_ptr<RigidBody> bodyA;
-        std::shared_ptr<RigidBody> bodyB;
-        
-        CollisionPair(std::shared_ptr<RigidBody> a, std::shared_ptr<RigidBody> b) 
-            : bodyA(a), bodyB(b) {}
-        
-        bool operator==(const CollisionPair& other) const {
-            return (bodyA == other.bodyA && bodyB == other.bodyB) ||
-                   (bodyA == other.bodyB && bodyB == other.bodyA);
-        }
-    };
+    static constexpr uint32_t kCellSlack = 2;
 
-private:
-    float cell_size_;
-    Vector2<float> world_min_;
-    Vector2<float> world_max_;
-    int grid_width_;
-    int grid_height_;
-    
-    std::vector<GridCell> grid_;
-    std::vector<CollisionPair> potential_pairs_;
-    
-    // Hash function for collision pair deduplication
-    struct PairHash {
-        std::size_t operator()(const CollisionPair& pair) const {
-            auto h1 = std::hash<void*>{}(pair.bodyA.get());
-            auto h2 = std::hash<void*>{}(pair.bodyB.get());
-            // Ensure consistent hash regardless of order
-            return (h1 < h2) ? h1 ^ (h2 << 1) : h2 ^ (h1 << 1);
-        }
-    };
-    
-    std::unordered_set<CollisionPair, PairHash> unique_pairs_;
+    /**
+     * @throws std::invalid_argument If cell_size is not positive or the world rectangle is empty
+     */
+    SpatialGrid(float cell_size, const Vector2<float>& world_min, const Vector2<float>& world_max);
+
+    /**
+     * @brief Sort all items into their cells
+     * @param proxies Item bounds; item i is proxies[i]
+     * @param pool Pool to spread the sort over, or nullptr for the calling thread
+     */
+    void rebuild(std::span<const BroadPhaseProxy> proxies, Threading::ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Refresh the bounds of the items of the last rebuild()
+     *
+     * Items that stayed in their cell are updated in place and the others
+     * are moved to a free slot of their new cell. Falls back to rebuild()
+     * when the item count changed or a cell runs out of free slots.
+     *
+     * @return Number of items that changed cells
+     */
+    size_t update(std::span<const BroadPhaseProxy> proxies);
+
+    /**
+     * @brief Write every overlapping pair of items, as their body indices
+     *
+     * Each item is tested against its own and the neighboring cells.
+     *
+     * @return Number of overlapping pairs. Only the first pairs.size() are
+     * written, so a larger value means the buffer was too small.
+     */
+    size_t emitPairs(std::span<BroadPhasePair> pairs) const;
+
+    // Remove all items
+    void clear();
 
-public:
-    SpatialGrid(float cell_size, const Vector2<float>& world_min, const Vector2<float>& world_max)
-        : cell_size_(cell_size), world_min_(world_min), world_max_(world_max) {
-        
-        Vector2<float> world_size = world_max - world_min;
-        grid_width_ = static_cast<int>(std::ceil(world_size.x / cell_size_)) + 1;
-        grid_height_ = static_cast<int>(std::ceil(world_size.y / cell_size_)) + 1;
-        
-        grid_.resize(grid_width_ * grid_height_);
-        
-        // Pre-allocate space for common use cases
-        potential_pairs_.reserve(1024);
-        unique_pairs_.reserve(1024);
-        
-        // Reserve space in each cell for better performance
-        for (auto& cell : grid_) {
-            cell.reserve(8); // Expect average of 8 objects per cell
-        }
-    }
-    
     // Get grid cell index from world position
-    int getCellIndex(const Vector2<float>& position) const {
-        Vector2<float> local_pos = position - world_min_;
-        int x = static_cast<int>(local_pos.x / cell_size_);
-        int y = static_cast<int>(local_pos.y / cell_size_);
-        
-        // Clamp to valid range
-        x = std::max(0, std::min(x, grid_width_ - 1));
-        y = std::max(0, std::min(y, grid_height_ - 1));
-        
-        return y * grid_width_ + x;
-    }
-    
-    // Get all grid cell indices that an AABB overlaps
-    std::vector<int> getCellIndices(const SIMD::AABB<float>& aabb) const {
-        std::vector<int> indices;
-        
-        Vector2<float> min_local = Vector2<float>(aabb.min[0], aabb.min[1]) - world_min_;
-        Vector2<float> max_local = Vector2<float>(aabb.max[0], aabb.max[1]) - world_min_;
-        
-        int min_x = std::max(0, static_cast<int>(min_local.x / cell_size_));
-        int min_y = std::max(0, static_cast<int>(min_local.y / cell_size_));
-        int max_x = std::min(grid_width_ - 1, static_cast<int>(max_local.x / cell_size_));
-        int max_y = std::min(grid_height_ - 1, static_cast<int>(max_local.y / cell_size_));
-        
-        indices.reserve((max_x - min_x + 1) * (max_y - min_y + 1));
-        
-        for (int y = min_y; y <= max_y; ++y) {
-            for (int x = min_x; x <= max_x; ++x) {
-                indices.push_back(y * grid_width_ + x);
-            }
-        }
-        
-        return indices;
-    }
-    
-    // Clear all grid cells
-    void clear() {
-        for (auto& cell : grid_) {
-            cell.clear();
-        }
-        potential_pairs_.clear();
-        unique_pairs_.clear();
-    }
-    
-    // Insert rigid body into appropriate grid cells
-    void insert(std::shared_ptr<RigidBody> body) {
-        auto aabb = body->getWorldBounds();
-        auto cell_indices = getCellIndices(aabb);
-        
-        for (int index : cell_indices) {
-            grid_[index].bodies.push_back(body);
-        }
-    }
-    
-    // Generate potential collision pairs using spatial grid
-    const std::vector<CollisionPair>& generatePotentialPairs() {
-        potential_pairs_.clear();
-        unique_pairs_.clear();
-        
-        // Process each grid cell
-        for (const auto& cell : grid_) {
-            if (cell.bodies.size() < 2) continue;
-            
-            // Check all pairs within the cell
-            for (size_t i = 0; i < cell.bodies.size(); ++i) {
-                for (size_t j = i + 1; j < cell.bodies.size(); ++j) {
-                    CollisionPair pair(cell.bodies[i], cell.bodies[j]);
-                    
-                    // Only add if we haven't seen this pair before
-                    if (unique_pairs_.find(pair) == unique_pairs_.end()) {
-                        unique_pairs_.insert(pair);
-                        potential_pairs_.push_back(pair);
-                    }
-                }
-            }
-        }
-        
-        return potential_pairs_;
-    }
-    
-    // Update grid with new set of rigid bodies
-    void update(const std::vector<std::shared_ptr<RigidBody>>& bodies) {
-        clear();
-        
-        for (const auto& body : bodies) {
-            insert(body);
-        }
+    int getCellIndex(const Vector2<float>& position) const;
+
+    /**
+     * @brief Items in a cell, as indices into the proxies of the last rebuild()
+     *
+     * In item order after rebuild(); update() reorders moved items.
+     */
+    std::span<const uint32_t> getCell(int cell) const {
+        return {items_.data() + starts_[cell], sizes_[cell]};
     }
-    
+
+    std::span<const uint32_t> getOversized() const { return getCell(getCellCount()); }
+
+    int getCellCount() const { return grid_width_ * grid_height_; }
+    size_t getItemCount() const { return slots_.size(); }
+
     // Get statistics about grid usage
     struct GridStats {
         int total_cells;
@@ -182,60 +102,54 @@ public:
         int max_objects_per_cell;
         double average_objects_per_occupied_cell;
         size_t total_objects;
-        size_t potential_pairs;
+        size_t oversized_objects;
     };
-    
-    GridStats getStats() const {
-        GridStats stats = {};
-        stats.total_cells = static_cast<int>(grid_.size());
-        stats.potential_pairs = potential_pairs_.size();
-        
-        int max_objects = 0;
-        size_t total_objects = 0;
-        int occupied = 0;
-        
-        for (const auto& cell : grid_) {
-            if (!cell.bodies.empty()) {
-                occupied++;
-                max_objects = std::max(max_objects, static_cast<int>(cell.bodies.size()));
-                total_objects += cell.bodies.size();
-            }
-        }
-        
-        stats.occupied_cells = occupied;
-        stats.max_objects_per_cell = max_objects;
-        stats.total_objects = total_objects;
-        stats.average_objects_per_occupied_cell = occupied > 0 ? 
-            static_cast<double>(total_objects) / occupied : 0.0;
-        
-        return stats;
-    }
-    
-    // Resize the grid (useful for dynamic worlds)
-    void resize(float new_cell_size, const Vector2<float>& new_world_min, const Vector2<float>& new_world_max) {
-        cell_size_ = new_cell_size;
-        world_min_ = new_world_min;
-        world_max_ = new_world_max;
-        
-        Vector2<float> world_size = world_max_ - world_min_;
-        grid_width_ = static_cast<int>(std::ceil(world_size.x / cell_size_)) + 1;
-        grid_height_ = static_cast<int>(std::ceil(world_size.y / cell_size_)) + 1;
-        
-        grid_.clear();
-        grid_.resize(grid_width_ * grid_height_);
-        
-        for (auto& cell : grid_) {
-            cell.reserve(8);
-        }
-    }
-    
+
+    GridStats getStats() const;
+
+    // Resize the grid (useful for dynamic worlds); removes all items
+    void resize(float new_cell_size, const Vector2<float>& new_world_min, const Vector2<float>& new_world_max);
+
     // Getters
     float getCellSize() const { return cell_size_; }
     Vector2<float> getWorldMin() const { return world_min_; }
     Vector2<float> getWorldMax() const { return world_max_; }
     int getGridWidth() const { return grid_width_; }
     int getGridHeight() const { return grid_height_; }
+
+private:
+    // Bucket of an item: its min-corner cell, or getCellCount() if oversized
+    uint32_t bucketOf(const BroadPhaseProxy& proxy) const;
+    int cellX(float x) const;
+    int cellY(float y) const;
+    uint32_t getCapacity(uint32_t bucket) const { return starts_[bucket + 1] - starts_[bucket]; }
+
+    float cell_size_;
+    float inverse_cell_size_;
+    Vector2<float> world_min_;
+    Vector2<float> world_max_;
+    int grid_width_;
+    int grid_height_;
+
+    // Counting-sort layout; bucket b owns slots [starts[b], starts[b + 1])
+    // and uses the first sizes[b] of them
+    std::vector<uint32_t> starts_;
+    std::vector<uint32_t> sizes_;
+    std::vector<uint32_t> items_;           // Item in each slot
+    std::vector<BroadPhaseProxy> bounds_;   // Bounds of the item in each slot
+    std::vector<uint32_t> slots_;           // Slot of each item
+    std::vector<uint32_t> buckets_;         // Bucket of each item
+
+    // rebuild() scratch: bucket counts, then cursors, per chunk
+    std::vector<uint32_t> counts_;
+
+    // update() scratch
+    struct Move {
+        uint32_t item;
+        uint32_t bucket;
+    };
+    std::vector<Move> moves_;
 };
 
 } // namespace Physics
-} // namespace PyNovaGE
\ No newline at end of file
+} // namespace PyNovaGE
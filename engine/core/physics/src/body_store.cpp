@@ -0,0 +1,365 @@
+#include "physics/body_store.hpp"
+#include "physics/rigid_body.hpp"
+#include "simd/types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace PyNovaGE {
+namespace Physics {
+
+namespace {
+
+constexpr size_t kSlotGranularity = BodyStore::kAlignment / sizeof(float);
+
+size_t roundUpCapacity(size_t capacity) {
+    return (capacity + kSlotGranularity - 1) / kSlotGranularity * kSlotGranularity;
+}
+
+} // anonymous namespace
+
+BodyStore::~BodyStore() {
+    if (block_) {
+        ::operator delete(block_, std::align_val_t(kAlignment));
+    }
+}
+
+uint32_t BodyStore::add(RigidBody* owner) {
+    if (size_ == capacity_) {
+        grow(size_ + 1);
+    }
+
+    const size_t slot = size_++;
+    for (float* field : fields_) {
+        field[slot] = 0.0f;
+    }
+    flags_[slot] = 0;
+    fields_[static_cast<size_t>(BodyField::DragFactor)][slot] = 1.0f;
+    owners_.push_back(owner);
+    return static_cast<uint32_t>(slot);
+}
+
+uint32_t BodyStore::add(RigidBody* owner, const BodyStore& source, uint32_t source_slot) {
+    if (size_ == capacity_) {
+        grow(size_ + 1);
+    }
+
+    const size_t slot = size_++;
+    for (size_t field = 0; field < kFieldCount; ++field) {
+        fields_[field][slot] = source.fields_[field][source_slot];
+    }
+    flags_[slot] = source.flags_[source_slot];
+    owners_.push_back(owner);
+
+    // The source may have cached drag for a different step length
+    if (drag_delta_time_ >= 0.0f) {
+        setDrag(static_cast<uint32_t>(slot), source.at(BodyField::Drag, source_slot));
+    }
+    return static_cast<uint32_t>(slot);
+}
+
+void BodyStore::remove(uint32_t slot) {
+    const size_t tail = size_ - slot - 1;
+    for (float* field : fields_) {
+        std::memmove(field + slot, field + slot + 1, tail * sizeof(float));
+    }
+    std::memmove(flags_ + slot, flags_ + slot + 1, tail * sizeof(uint32_t));
+    owners_.erase(owners_.begin() + slot);
+    --size_;
+
+    for (size_t i = slot; i < size_; ++i) {
+        owners_[i]->slot_ = static_cast<uint32_t>(i);
+    }
+}
+
+void BodyStore::clear() {
+    owners_.clear();
+    size_ = 0;
+}
+
+void BodyStore::saveState(std::byte* out) const {
+    for (const float* field : fields_) {
+        std::memcpy(out, field, size_ * sizeof(float));
+        out += size_ * sizeof(float);
+    }
+    std::memcpy(out, flags_, size_ * sizeof(uint32_t));
+}
+
+void BodyStore::restoreState(const std::byte* in) {
+    for (float* field : fields_) {
+        std::memcpy(field, in, size_ * sizeof(float));
+        in += size_ * sizeof(float);
+    }
+    std::memcpy(flags_, in, size_ * sizeof(uint32_t));
+}
+
+void BodyStore::reserve(size_t capacity) {
+    if (capacity > capacity_) {
+        grow(capacity);
+    }
+}
+
+void BodyStore::grow(size_t min_capacity) {
+    const size_t capacity = roundUpCapacity(std::max({min_capacity, capacity_ * 2, kSlotGranularity}));
+    const size_t field_bytes = capacity * sizeof(float);
+    static_assert(sizeof(float) == sizeof(uint32_t), "flags share the float field stride");
+
+    auto* block = static_cast<std::byte*>(
+        ::operator new((kFieldCount + 1) * field_bytes, std::align_val_t(kAlignment)));
+
+    for (size_t field = 0; field < kFieldCount; ++field) {
+        float* array = reinterpret_cast<float*>(block + field * field_bytes);
+        if (size_ > 0) {
+            std::memcpy(array, fields_[field], size_ * sizeof(float));
+        }
+        fields_[field] = array;
+    }
+    uint32_t* flags = reinterpret_cast<uint32_t*>(block + kFieldCount * field_bytes);
+    if (size_ > 0) {
+        std::memcpy(flags, flags_, size_ * sizeof(uint32_t));
+    }
+    flags_ = flags;
+
+    if (block_) {
+        ::operator delete(block_, std::align_val_t(kAlignment));
+    }
+    block_ = block;
+    capacity_ = capacity;
+}
+
+void BodyStore::setDrag(uint32_t slot, float drag) {
+    at(BodyField::Drag, slot) = drag;
+    if (drag_delta_time_ >= 0.0f) {
+        at(BodyField::DragFactor, slot) = std::pow(1.0f - drag, drag_delta_time_);
+    }
+}
+
+void BodyStore::updateDragFactors(float delta_time) {
+    const float* drag = data(BodyField::Drag);
+    float* factor = data(BodyField::DragFactor);
+    for (size_t i = 0; i < size_; ++i) {
+        factor[i] = std::pow(1.0f - drag[i], delta_time);
+    }
+    drag_delta_time_ = delta_time;
+}
+
+void BodyStore::integrate(float delta_time, const Vector2<float>& gravity, bool update_sleep) {
+    // pow() is too slow for the hot loop; the world steps at a fixed rate,
+    // so the factors only need recomputing when the step length changes
+    if (delta_time != drag_delta_time_) {
+        updateDragFactors(delta_time);
+    }
+
+    float* px = data(BodyField::PositionX);
+    float* py = data(BodyField::PositionY);
+    float* rot = data(BodyField::Rotation);
+    float* vx = data(BodyField::VelocityX);
+    float* vy = data(BodyField::VelocityY);
+    float* w = data(BodyField::AngularVelocity);
+    float* fx = data(BodyField::ForceX);
+    float* fy = data(BodyField::ForceY);
+    float* torque = data(BodyField::Torque);
+    const float* inv_mass = data(BodyField::InverseMass);
+    const float* inv_inertia = data(BodyField::InverseInertia);
+    const float* drag = data(BodyField::DragFactor);
+    float* sleep = data(BodyField::SleepTime);
+    uint32_t* flags = flags_;
+
+    size_t i = 0;
+
+#if defined(NOVA_AVX2_AVAILABLE) && defined(__AVX2__)
+    {
+        const __m256 dt = _mm256_set1_ps(delta_time);
+        const __m256 gx = _mm256_set1_ps(gravity.x);
+        const __m256 gy = _mm256_set1_ps(gravity.y);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 linear_threshold = _mm256_set1_ps(kSleepLinearThreshold);
+        const __m256 angular_threshold = _mm256_set1_ps(kSleepAngularThreshold);
+        const __m256 time_threshold = _mm256_set1_ps(kSleepTimeThreshold);
+        const __m256i required = _mm256_set1_epi32(static_cast<int>(kFlagDynamic | kFlagAwake));
+        const __m256i awake_bit = _mm256_set1_epi32(static_cast<int>(kFlagAwake));
+        const __m256 sleep_enabled = update_sleep ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : zero;
+
+        for (; i + 8 <= size_; i += 8) {
+            const __m256i f = _mm256_load_si256(reinterpret_cast<const __m256i*>(flags + i));
+            const __m256 moving = _mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(_mm256_and_si256(f, required), required));
+            if (_mm256_movemask_ps(moving) == 0) {
+                continue;
+            }
+
+            const __m256 im = _mm256_load_ps(inv_mass + i);
+            const __m256 ii = _mm256_load_ps(inv_inertia + i);
+            const __m256 d = _mm256_load_ps(drag + i);
+            const __m256 has_mass = _mm256_cmp_ps(im, zero, _CMP_GT_OQ);
+
+            // Forces to velocity; gravity only acts on bodies with mass
+            const __m256 ax = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(fx + i), im), _mm256_and_ps(gx, has_mass));
+            const __m256 ay = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(fy + i), im), _mm256_and_ps(gy, has_mass));
+            const __m256 alpha = _mm256_mul_ps(_mm256_load_ps(torque + i), ii);
+            __m256 nvx = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(vx + i), d), _mm256_mul_ps(ax, dt));
+            __m256 nvy = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(vy + i), d), _mm256_mul_ps(ay, dt));
+            __m256 nw = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(w + i), d), _mm256_mul_ps(alpha, dt));
+
+            // Velocity to position
+            const __m256 npx = _mm256_add_ps(_mm256_load_ps(px + i), _mm256_mul_ps(nvx, dt));
+            const __m256 npy = _mm256_add_ps(_mm256_load_ps(py + i), _mm256_mul_ps(nvy, dt));
+            const __m256 nrot = _mm256_add_ps(_mm256_load_ps(rot + i), _mm256_mul_ps(nw, dt));
+
+            // Sleep: accumulate time while slow, fall asleep past the threshold
+            const __m256 linear = _mm256_add_ps(_mm256_mul_ps(nvx, nvx), _mm256_mul_ps(nvy, nvy));
+            const __m256 angular = _mm256_mul_ps(nw, nw);
+            const __m256 slow = _mm256_and_ps(_mm256_cmp_ps(linear, linear_threshold, _CMP_LT_OQ),
+                                              _mm256_cmp_ps(angular, angular_threshold, _CMP_LT_OQ));
+            const __m256 nsleep = _mm256_blendv_ps(_mm256_load_ps(sleep + i),
+                                                   _mm256_and_ps(_mm256_add_ps(_mm256_load_ps(sleep + i), dt), slow),
+                                                   sleep_enabled);
+            const __m256 asleep = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(nsleep, time_threshold, _CMP_GE_OQ), moving),
+                                                sleep_enabled);
+            nvx = _mm256_andnot_ps(asleep, nvx);
+            nvy = _mm256_andnot_ps(asleep, nvy);
+            nw = _mm256_andnot_ps(asleep, nw);
+
+            _mm256_store_ps(px + i, _mm256_blendv_ps(_mm256_load_ps(px + i), npx, moving));
+            _mm256_store_ps(py + i, _mm256_blendv_ps(_mm256_load_ps(py + i), npy, moving));
+            _mm256_store_ps(rot + i, _mm256_blendv_ps(_mm256_load_ps(rot + i), nrot, moving));
+            _mm256_store_ps(vx + i, _mm256_blendv_ps(_mm256_load_ps(vx + i), nvx, moving));
+            _mm256_store_ps(vy + i, _mm256_blendv_ps(_mm256_load_ps(vy + i), nvy, moving));
+            _mm256_store_ps(w + i, _mm256_blendv_ps(_mm256_load_ps(w + i), nw, moving));
+            _mm256_store_ps(fx + i, _mm256_blendv_ps(_mm256_load_ps(fx + i), zero, moving));
+            _mm256_store_ps(fy + i, _mm256_blendv_ps(_mm256_load_ps(fy + i), zero, moving));
+            _mm256_store_ps(torque + i, _mm256_blendv_ps(_mm256_load_ps(torque + i), zero, moving));
+            _mm256_store_ps(sleep + i, _mm256_blendv_ps(_mm256_load_ps(sleep + i), nsleep, moving));
+
+            const __m256i cleared = _mm256_and_si256(_mm256_castps_si256(asleep), awake_bit);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(flags + i), _mm256_andnot_si256(cleared, f));
+        }
+    }
+#elif defined(NOVA_SSE4_1_AVAILABLE) && defined(__SSE4_1__)
+    {
+        const __m128 dt = _mm_set1_ps(delta_time);
+        const __m128 gx = _mm_set1_ps(gravity.x);
+        const __m128 gy = _mm_set1_ps(gravity.y);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 linear_threshold = _mm_set1_ps(kSleepLinearThreshold);
+        const __m128 angular_threshold = _mm_set1_ps(kSleepAngularThreshold);
+        const __m128 time_threshold = _mm_set1_ps(kSleepTimeThreshold);
+        const __m128i required = _mm_set1_epi32(static_cast<int>(kFlagDynamic | kFlagAwake));
+        const __m128i awake_bit = _mm_set1_epi32(static_cast<int>(kFlagAwake));
+        const __m128 sleep_enabled = update_sleep ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+
+        for (; i + 4 <= size_; i += 4) {
+            const __m128i f = _mm_load_si128(reinterpret_cast<const __m128i*>(flags + i));
+            const __m128 moving = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(f, required), required));
+            if (_mm_movemask_ps(moving) == 0) {
+                continue;
+            }
+
+            const __m128 im = _mm_load_ps(inv_mass + i);
+            const __m128 ii = _mm_load_ps(inv_inertia + i);
+            const __m128 d = _mm_load_ps(drag + i);
+            const __m128 has_mass = _mm_cmpgt_ps(im, zero);
+
+            const __m128 ax = _mm_add_ps(_mm_mul_ps(_mm_load_ps(fx + i), im), _mm_and_ps(gx, has_mass));
+            const __m128 ay = _mm_add_ps(_mm_mul_ps(_mm_load_ps(fy + i), im), _mm_and_ps(gy, has_mass));
+            const __m128 alpha = _mm_mul_ps(_mm_load_ps(torque + i), ii);
+            __m128 nvx = _mm_add_ps(_mm_mul_ps(_mm_load_ps(vx + i), d), _mm_mul_ps(ax, dt));
+            __m128 nvy = _mm_add_ps(_mm_mul_ps(_mm_load_ps(vy + i), d), _mm_mul_ps(ay, dt));
+            __m128 nw = _mm_add_ps(_mm_mul_ps(_mm_load_ps(w + i), d), _mm_mul_ps(alpha, dt));
+
+            const __m128 npx = _mm_add_ps(_mm_load_ps(px + i), _mm_mul_ps(nvx, dt));
+            const __m128 npy = _mm_add_ps(_mm_load_ps(py + i), _mm_mul_ps(nvy, dt));
+            const __m128 nrot = _mm_add_ps(_mm_load_ps(rot + i), _mm_mul_ps(nw, dt));
+
+            const __m128 linear = _mm_add_ps(_mm_mul_ps(nvx, nvx), _mm_mul_ps(nvy, nvy));
+            const __m128 angular = _mm_mul_ps(nw, nw);
+            const __m128 slow = _mm_and_ps(_mm_cmplt_ps(linear, linear_threshold),
+                                           _mm_cmplt_ps(angular, angular_threshold));
+            const __m128 nsleep = _mm_blendv_ps(_mm_load_ps(sleep + i),
+                                                _mm_and_ps(_mm_add_ps(_mm_load_ps(sleep + i), dt), slow), sleep_enabled);
+            const __m128 asleep = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(nsleep, time_threshold), moving), sleep_enabled);
+            nvx = _mm_andnot_ps(asleep, nvx);
+            nvy = _mm_andnot_ps(asleep, nvy);
+            nw = _mm_andnot_ps(asleep, nw);
+
+            _mm_store_ps(px + i, _mm_blendv_ps(_mm_load_ps(px + i), npx, moving));
+            _mm_store_ps(py + i, _mm_blendv_ps(_mm_load_ps(py + i), npy, moving));
+            _mm_store_ps(rot + i, _mm_blendv_ps(_mm_load_ps(rot + i), nrot, moving));
+            _mm_store_ps(vx + i, _mm_blendv_ps(_mm_load_ps(vx + i), nvx, moving));
+            _mm_store_ps(vy + i, _mm_blendv_ps(_mm_load_ps(vy + i), nvy, moving));
+            _mm_store_ps(w + i, _mm_blendv_ps(_mm_load_ps(w + i), nw, moving));
+            _mm_store_ps(fx + i, _mm_blendv_ps(_mm_load_ps(fx + i), zero, moving));
+            _mm_store_ps(fy + i, _mm_blendv_ps(_mm_load_ps(fy + i), zero, moving));
+            _mm_store_ps(torque + i, _mm_blendv_ps(_mm_load_ps(torque + i), zero, moving));
+            _mm_store_ps(sleep + i, _mm_blendv_ps(_mm_load_ps(sleep + i), nsleep, moving));
+
+            const __m128i cleared = _mm_and_si128(_mm_castps_si128(asleep), awake_bit);
+            _mm_store_si128(reinterpret_cast<__m128i*>(flags + i), _mm_andnot_si128(cleared, f));
+        }
+    }
+#endif
+
+    integrateScalar(delta_time, gravity, i, size_, update_sleep);
+}
+
+void BodyStore::integrateScalar(float delta_time, const Vector2<float>& gravity, size_t begin, size_t end,
+                                bool update_sleep) {
+    if (delta_time != drag_delta_time_) {
+        updateDragFactors(delta_time);
+    }
+
+    float* px = data(BodyField::PositionX);
+    float* py = data(BodyField::PositionY);
+    float* rot = data(BodyField::Rotation);
+    float* vx = data(BodyField::VelocityX);
+    float* vy = data(BodyField::VelocityY);
+    float* w = data(BodyField::AngularVelocity);
+    float* fx = data(BodyField::ForceX);
+    float* fy = data(BodyField::ForceY);
+    float* torque = data(BodyField::Torque);
+    const float* inv_mass = data(BodyField::InverseMass);
+    const float* inv_inertia = data(BodyField::InverseInertia);
+    const float* drag = data(BodyField::DragFactor);
+    float* sleep = data(BodyField::SleepTime);
+
+    constexpr uint32_t required = kFlagDynamic | kFlagAwake;
+    for (size_t i = begin; i < end; ++i) {
+        if ((flags_[i] & required) != required) {
+            continue;
+        }
+
+        // Same operation order as the SIMD kernels
+        const float gravity_x = inv_mass[i] > 0.0f ? gravity.x : 0.0f;
+        const float gravity_y = inv_mass[i] > 0.0f ? gravity.y : 0.0f;
+        vx[i] = vx[i] * drag[i] + (fx[i] * inv_mass[i] + gravity_x) * delta_time;
+        vy[i] = vy[i] * drag[i] + (fy[i] * inv_mass[i] + gravity_y) * delta_time;
+        w[i] = w[i] * drag[i] + (torque[i] * inv_inertia[i]) * delta_time;
+
+        px[i] += vx[i] * delta_time;
+        py[i] += vy[i] * delta_time;
+        rot[i] += w[i] * delta_time;
+
+        fx[i] = 0.0f;
+        fy[i] = 0.0f;
+        torque[i] = 0.0f;
+
+        if (!update_sleep) {
+            continue;
+        }
+        if (vx[i] * vx[i] + vy[i] * vy[i] < kSleepLinearThreshold && w[i] * w[i] < kSleepAngularThreshold) {
+            sleep[i] += delta_time;
+            if (sleep[i] >= kSleepTimeThreshold) {
+                flags_[i] &= ~kFlagAwake;
+                vx[i] = 0.0f;
+                vy[i] = 0.0f;
+                w[i] = 0.0f;
+            }
+        } else {
+            sleep[i] = 0.0f;
+        }
+    }
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -0,0 +1,243 @@
+#include "physics/broad_phase.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace PyNovaGE {
+namespace Physics {
+
+//------------------------------------------------------------------------------
+// BruteForceBroadPhase
+//------------------------------------------------------------------------------
+
+void BruteForceBroadPhase::findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) {
+    pairs.clear();
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        for (size_t j = i + 1; j < proxies.size(); ++j) {
+            if (proxies[i].overlaps(proxies[j])) {
+                pairs.push_back(BroadPhasePair::make(proxies[i].body_index, proxies[j].body_index));
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// SweepAndPruneBroadPhase
+//------------------------------------------------------------------------------
+
+void SweepAndPruneBroadPhase::findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) {
+    pairs.clear();
+    const size_t count = proxies.size();
+
+    // order_ is a permutation of the proxy indices, so it stays valid as long
+    // as the proxy count is unchanged even if bodies were swapped around
+    if (order_.size() != count || !insertionSort(proxies)) {
+        order_.resize(count);
+        std::iota(order_.begin(), order_.end(), 0u);
+        std::sort(order_.begin(), order_.end(), [&proxies](uint32_t a, uint32_t b) {
+            return proxies[a].min_x < proxies[b].min_x;
+        });
+    }
+
+    sorted_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        sorted_[i] = proxies[order_[i]];
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const BroadPhaseProxy& a = sorted_[i];
+        for (size_t j = i + 1; j < count && sorted_[j].min_x <= a.max_x; ++j) {
+            const BroadPhaseProxy& b = sorted_[j];
+            if (a.max_y >= b.min_y && a.min_y <= b.max_y) {
+                pairs.push_back(BroadPhasePair::make(a.body_index, b.body_index));
+            }
+        }
+    }
+}
+
+bool SweepAndPruneBroadPhase::insertionSort(const std::vector<BroadPhaseProxy>& proxies) {
+    // Give up once the order is clearly not coherent with the last step
+    const size_t max_shifts = 8 * order_.size() + 64;
+    size_t shifts = 0;
+
+    for (size_t i = 1; i < order_.size(); ++i) {
+        const uint32_t index = order_[i];
+        const float key = proxies[index].min_x;
+        size_t j = i;
+        while (j > 0 && proxies[order_[j - 1]].min_x > key) {
+            order_[j] = order_[j - 1];
+            --j;
+            if (++shifts > max_shifts) {
+                order_[j] = index;
+                return false;
+            }
+        }
+        order_[j] = index;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// UniformGridBroadPhase
+//------------------------------------------------------------------------------
+
+namespace {
+
+uint64_t packCell(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+} // anonymous namespace
+
+UniformGridBroadPhase::UniformGridBroadPhase(float cell_size)
+    : cell_size_(cell_size), inverse_cell_size_(cell_size > 0.0f ? 1.0f / cell_size : 0.0f) {
+    if (!(cell_size > 0.0f)) {
+        throw std::invalid_argument("UniformGridBroadPhase: cell size must be positive");
+    }
+}
+
+void UniformGridBroadPhase::findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) {
+    pairs.clear();
+    entries_.clear();
+    oversized_.clear();
+    pair_keys_.clear();
+
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        const BroadPhaseProxy& proxy = proxies[i];
+        const int32_t min_x = static_cast<int32_t>(std::floor(proxy.min_x * inverse_cell_size_));
+        const int32_t min_y = static_cast<int32_t>(std::floor(proxy.min_y * inverse_cell_size_));
+        const int32_t max_x = static_cast<int32_t>(std::floor(proxy.max_x * inverse_cell_size_));
+        const int32_t max_y = static_cast<int32_t>(std::floor(proxy.max_y * inverse_cell_size_));
+
+        const uint64_t cells = static_cast<uint64_t>(max_x - min_x + 1) * static_cast<uint64_t>(max_y - min_y + 1);
+        if (cells > kMaxCellsPerProxy) {
+            oversized_.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        for (int32_t y = min_y; y <= max_y; ++y) {
+            for (int32_t x = min_x; x <= max_x; ++x) {
+                entries_.push_back({packCell(x, y), static_cast<uint32_t>(i)});
+            }
+        }
+    }
+
+    std::sort(entries_.begin(), entries_.end(), [](const CellEntry& a, const CellEntry& b) {
+        return a.cell < b.cell;
+    });
+
+    // Test pairs within each run of entries sharing a cell
+    for (size_t begin = 0; begin < entries_.size();) {
+        size_t end = begin + 1;
+        while (end < entries_.size() && entries_[end].cell == entries_[begin].cell) ++end;
+
+        for (size_t i = begin; i < end; ++i) {
+            const BroadPhaseProxy& a = proxies[entries_[i].proxy];
+            for (size_t j = i + 1; j < end; ++j) {
+                const BroadPhaseProxy& b = proxies[entries_[j].proxy];
+                if (a.overlaps(b)) {
+                    pair_keys_.push_back(BroadPhasePair::make(a.body_index, b.body_index).key());
+                }
+            }
+        }
+        begin = end;
+    }
+
+    // Oversized proxies against everything else
+    for (size_t i = 0; i < oversized_.size(); ++i) {
+        const BroadPhaseProxy& a = proxies[oversized_[i]];
+        for (size_t j = 0; j < proxies.size(); ++j) {
+            if (j == oversized_[i]) continue;
+            const BroadPhaseProxy& b = proxies[j];
+            if (a.overlaps(b)) {
+                pair_keys_.push_back(BroadPhasePair::make(a.body_index, b.body_index).key());
+            }
+        }
+    }
+
+    std::sort(pair_keys_.begin(), pair_keys_.end());
+    pair_keys_.erase(std::unique(pair_keys_.begin(), pair_keys_.end()), pair_keys_.end());
+
+    pairs.reserve(pair_keys_.size());
+    for (uint64_t key : pair_keys_) {
+        pairs.push_back(BroadPhasePair::fromKey(key));
+    }
+}
+
+//------------------------------------------------------------------------------
+// DynamicTreeBroadPhase
+//------------------------------------------------------------------------------
+
+void DynamicTreeBroadPhase::findPairs(const std::vector<BroadPhaseProxy>& proxies, std::vector<BroadPhasePair>& pairs) {
+    pairs.clear();
+    ++stamp_;
+
+    // Sync tree proxies; user data is the proxy's position in this step's list
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        const BroadPhaseProxy& proxy = proxies[i];
+        const Bounds2D bounds{proxy.min_x, proxy.min_y, proxy.max_x, proxy.max_y};
+        if (proxy.body_index >= body_nodes_.size()) {
+            body_nodes_.resize(proxy.body_index + 1, DynamicAABBTree::kNullNode);
+            body_stamps_.resize(proxy.body_index + 1, 0);
+        }
+
+        int32_t& node = body_nodes_[proxy.body_index];
+        if (node == DynamicAABBTree::kNullNode) {
+            node = tree_.createProxy(bounds, static_cast<uint32_t>(i));
+        } else {
+            tree_.moveProxy(node, bounds);
+            tree_.setUserData(node, static_cast<uint32_t>(i));
+        }
+        body_stamps_[proxy.body_index] = stamp_;
+    }
+
+    // Bodies without a proxy this step were removed or deactivated
+    for (size_t body = 0; body < body_nodes_.size(); ++body) {
+        if (body_nodes_[body] != DynamicAABBTree::kNullNode && body_stamps_[body] != stamp_) {
+            tree_.destroyProxy(body_nodes_[body]);
+            body_nodes_[body] = DynamicAABBTree::kNullNode;
+        }
+    }
+
+    // Query in tree order: consecutive queries walk mostly the same nodes,
+    // which roughly halves the time against querying in body order
+    tree_.forEachProxy([&](int32_t leaf) {
+        const uint32_t i = tree_.getUserData(leaf);
+        const BroadPhaseProxy& a = proxies[i];
+        tree_.query(Bounds2D{a.min_x, a.min_y, a.max_x, a.max_y}, [&](int32_t node) {
+            const uint32_t j = tree_.getUserData(node);
+            if (j > i && a.overlaps(proxies[j])) {
+                pairs.push_back(BroadPhasePair::make(a.body_index, proxies[j].body_index));
+            }
+            return true;
+        });
+    });
+}
+
+void DynamicTreeBroadPhase::reset() {
+    tree_.clear();
+    body_nodes_.clear();
+    body_stamps_.clear();
+}
+
+//------------------------------------------------------------------------------
+// Factory
+//------------------------------------------------------------------------------
+
+std::unique_ptr<BroadPhase> createBroadPhase(BroadPhaseType type, float cell_size, float margin) {
+    switch (type) {
+        case BroadPhaseType::BruteForce:
+            return std::make_unique<BruteForceBroadPhase>();
+        case BroadPhaseType::UniformGrid:
+            return std::make_unique<UniformGridBroadPhase>(cell_size);
+        case BroadPhaseType::DynamicTree:
+            return std::make_unique<DynamicTreeBroadPhase>(margin);
+        case BroadPhaseType::SweepAndPrune:
+        default:
+            return std::make_unique<SweepAndPruneBroadPhase>();
+    }
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
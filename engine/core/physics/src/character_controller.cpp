@@ -0,0 +1,185 @@
+#include "physics/character_controller.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace PyNovaGE {
+namespace Physics {
+
+namespace {
+
+// Depenetration passes per move; more only matter in tight corners
+constexpr int kDepenetrationPasses = 4;
+
+// Whether the character can stand on a surface with this normal: one that is
+// walkable, or a ledge corner touched by the bottom cap within step height
+// of the feet
+bool isSupport(const CharacterConfig& config, const Vector2<float>& normal) {
+    return normal.y >= config.min_ground_normal ||
+           (normal.y > 0.0f && config.radius * (1.0f - normal.y) <= config.step_height);
+}
+
+} // anonymous namespace
+
+void StaticGeometry::build(std::span<const std::shared_ptr<RigidBody>> bodies) {
+    clear();
+    for (const auto& body : bodies) {
+        if (!body || !body->isStatic()) continue;
+
+        Shape shape;
+        if (!CollisionDetection::getRoundedBox(body->getCollisionShape(), shape.half_size, shape.radius)) {
+            continue;
+        }
+        shape.center = body->getPosition();
+        const Vector2<float> extent(shape.half_size.x + shape.radius, shape.half_size.y + shape.radius);
+        tree_.createProxy({shape.center.x - extent.x, shape.center.y - extent.y,
+                           shape.center.x + extent.x, shape.center.y + extent.y},
+                          static_cast<uint32_t>(shapes_.size()));
+        shapes_.push_back(shape);
+    }
+}
+
+void StaticGeometry::clear() {
+    shapes_.clear();
+    tree_.clear();
+}
+
+CollisionDetection::SweepResult StaticGeometry::sweep(const Vector2<float>& half_size, float radius,
+                                                      const Vector2<float>& position, const Vector2<float>& motion,
+                                                      std::span<const uint32_t> candidates) const {
+    CollisionDetection::SweepResult earliest;
+    for (uint32_t index : candidates) {
+        const Shape& shape = shapes_[index];
+        const auto hit = CollisionDetection::sweepRoundedBox(position, motion, shape.center,
+                                                             half_size + shape.half_size, radius + shape.radius);
+        if (hit.hit && hit.toi < earliest.toi) {
+            earliest = hit;
+        }
+    }
+    return earliest;
+}
+
+void StaticGeometry::depenetrate(const CharacterConfig& config, const Vector2<float>& half_size,
+                                 Vector2<float>& position, std::span<const uint32_t> candidates) const {
+    for (int pass = 0; pass < kDepenetrationPasses; ++pass) {
+        bool pushed = false;
+        for (uint32_t index : candidates) {
+            const Shape& shape = shapes_[index];
+            const auto manifold = CollisionDetection::generateRoundedBoxManifold(
+                half_size, config.radius, position, shape.half_size, shape.radius, shape.center);
+            if (manifold.hasCollision) {
+                // The normal points from the character into the shape
+                position -= manifold.normal * (manifold.penetration + config.skin);
+                pushed = true;
+            }
+        }
+        if (!pushed) return;
+    }
+}
+
+bool StaticGeometry::stepUp(const CharacterConfig& config, const Vector2<float>& half_size,
+                            const Vector2<float>& motion, Vector2<float>& position, Vector2<float>& ground_normal,
+                            std::span<const uint32_t> candidates) const {
+    const Vector2<float> forward(motion.x, 0.0f);
+    if (std::abs(forward.x) <= config.skin) return false;
+
+    const Vector2<float> up(0.0f, config.step_height);
+    const auto ceiling = sweep(half_size, config.radius, position, up, candidates);
+    const float rise = std::max(config.step_height * ceiling.toi - config.skin, 0.0f);
+    const Vector2<float> raised(position.x, position.y + rise);
+
+    const auto wall = sweep(half_size, config.radius, raised, forward, candidates);
+    Vector2<float> moved = raised + forward * wall.toi;
+    if (wall.hit) {
+        moved += wall.normal * config.skin;
+    }
+    if (std::abs(moved.x - position.x) <= config.skin) return false;
+
+    // Land no lower than where the step started, on ground no higher than
+    // the step height above the feet it started from
+    const Vector2<float> down(0.0f, -(rise + config.skin * 2.0f));
+    const auto ground = sweep(half_size, config.radius, moved, down, candidates);
+    if (!ground.hit || !isSupport(config, ground.normal)) return false;
+
+    const Vector2<float> landed = moved + down * ground.toi + ground.normal * config.skin;
+    const float contact_height = (landed.y - config.radius * ground.normal.y) - (position.y - config.radius);
+    if (contact_height > config.step_height) return false;
+
+    position = landed;
+    ground_normal = ground.normal;
+    return true;
+}
+
+CharacterResult StaticGeometry::moveCharacter(const CharacterConfig& config, const CharacterMove& move,
+                                              std::vector<uint32_t>& candidates) const {
+    const Vector2<float> half_size(0.0f, std::max(config.height * 0.5f - config.radius, 0.0f));
+    Vector2<float> position = move.position;
+    Vector2<float> motion = move.displacement;
+    CharacterResult result;
+
+    // Everything the move, a step up and the ground probe can reach
+    const float reach = config.step_height + config.skin * 4.0f;
+    const float extent_x = half_size.x + config.radius + reach;
+    const float extent_y = half_size.y + config.radius + reach;
+    const Bounds2D bounds{std::min(position.x, position.x + motion.x) - extent_x,
+                          std::min(position.y, position.y + motion.y) - extent_y,
+                          std::max(position.x, position.x + motion.x) + extent_x,
+                          std::max(position.y, position.y + motion.y) + extent_y};
+    candidates.clear();
+    tree_.query(bounds, [&](int32_t proxy) {
+        candidates.push_back(tree_.getUserData(proxy));
+        return true;
+    });
+
+    if (candidates.empty()) {
+        position += motion;
+    } else {
+        // Whatever is left after max_slides surfaces is dropped
+        depenetrate(config, half_size, position, candidates);
+
+        for (int slide = 0; slide < config.max_slides && motion.lengthSquared() > 1e-12f; ++slide) {
+            const auto hit = sweep(half_size, config.radius, position, motion, candidates);
+            if (!hit.hit) {
+                position += motion;
+                motion = Vector2<float>(0.0f, 0.0f);
+                break;
+            }
+
+            result.collided = true;
+            const Vector2<float> rest = motion * (1.0f - hit.toi);
+
+            // Steep slopes and corners above step height block like vertical
+            // walls, so the rounded capsule bottom does not creep up them
+            const bool support = isSupport(config, hit.normal);
+            Vector2<float> normal = hit.normal;
+            if (!support && normal.y > 0.0f && rest.y >= 0.0f) {
+                normal = Vector2<float>(normal.x > 0.0f ? 1.0f : -1.0f, 0.0f);
+            }
+            position += motion * hit.toi + normal * config.skin;
+
+            // Walls, not floors or ceilings, can be stepped over once per move
+            const bool ceiling = hit.normal.y <= -config.min_ground_normal;
+            if (!support && !ceiling && !result.stepped && config.step_height > 0.0f &&
+                stepUp(config, half_size, rest, position, result.ground_normal, candidates)) {
+                result.stepped = true;
+                motion = Vector2<float>(0.0f, 0.0f);
+                break;
+            }
+            motion = rest - normal * rest.dot(normal);
+        }
+    }
+
+    // Ground is whatever lies within the skin below the final position
+    if (!candidates.empty()) {
+        const auto ground = sweep(half_size, config.radius, position, Vector2<float>(0.0f, -config.skin * 2.0f),
+                                  candidates);
+        if (ground.hit && isSupport(config, ground.normal)) {
+            result.grounded = true;
+            result.ground_normal = ground.normal;
+        }
+    }
+    result.position = position;
+    return result;
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -15,6 +15,8 @@ bool RectangleShape::intersects(const CollisionShape& other, const Vector2<float
             return CollisionDetection::intersects(*this, thisPos, static_cast<const RectangleShape&>(other), otherPos);
         case ShapeType::Circle:
             return CollisionDetection::intersects(*this, thisPos, static_cast<const CircleShape&>(other), otherPos);
+        case ShapeType::Capsule:
+            return CollisionDetection::intersects(static_cast<const CapsuleShape&>(other), otherPos, *this, thisPos);
         default:
             return false;
     }
@@ -44,6 +46,8 @@ bool CircleShape::intersects(const CollisionShape& other, const Vector2<float>&
             return CollisionDetection::intersects(*this, thisPos, static_cast<const CircleShape&>(other), otherPos);
         case ShapeType::Rectangle:
             return CollisionDetection::intersects(static_cast<const RectangleShape&>(other), otherPos, *this, thisPos);
+        case ShapeType::Capsule:
+            return CollisionDetection::intersects(static_cast<const CapsuleShape&>(other), otherPos, *this, thisPos);
         default:
             return false;
     }
@@ -67,6 +71,34 @@ Vector2<float> CircleShape::getClosestPoint(const Vector2<float>& point, const V
     return position + (direction / distance) * radius_;
 }
 
+//------------------------------------------------------------------------------
+// CapsuleShape Implementation
+//------------------------------------------------------------------------------
+
+bool CapsuleShape::intersects(const CollisionShape& other, const Vector2<float>& thisPos, const Vector2<float>& otherPos) const {
+    return CollisionDetection::intersects(*this, thisPos, other, otherPos);
+}
+
+AABB<float> CapsuleShape::getBounds(const Vector2<float>& position) const {
+    Vector2<float> extent(radius_, half_length_ + radius_);
+    Vector2<float> min = position - extent;
+    Vector2<float> max = position + extent;
+    return AABB<float>(SIMD::Vector<float, 3>(min.x, min.y, 0.0f), SIMD::Vector<float, 3>(max.x, max.y, 0.0f));
+}
+
+Vector2<float> CapsuleShape::getClosestPoint(const Vector2<float>& point, const Vector2<float>& position) const {
+    // Closest point on the inner segment, then out to the surface
+    Vector2<float> center(position.x, position.y + std::max(-half_length_, std::min(half_length_, point.y - position.y)));
+    Vector2<float> direction = point - center;
+    float distance = direction.length();
+    
+    if (distance <= radius_) {
+        return point; // Point is inside capsule
+    }
+    
+    return center + (direction / distance) * radius_;
+}
+
 //------------------------------------------------------------------------------
 // CollisionDetection Implementation
 //------------------------------------------------------------------------------
@@ -95,6 +127,23 @@ bool CollisionDetection::intersects(const RectangleShape& rect, const Vector2<fl
     return sphere.intersects(rectBounds);
 }
 
+bool CollisionDetection::intersects(const CapsuleShape& capsule, const Vector2<float>& capsulePos,
+                                   const CollisionShape& other, const Vector2<float>& otherPos) {
+    Vector2<float> otherHalfSize;
+    float otherRadius;
+    if (!getRoundedBox(other, otherHalfSize, otherRadius)) {
+        return false;
+    }
+    
+    // Distance from the other center to the Minkowski sum's inner box
+    Vector2<float> halfSize(otherHalfSize.x, otherHalfSize.y + capsule.getHalfLength());
+    float radius = otherRadius + capsule.getRadius();
+    Vector2<float> separation = otherPos - capsulePos;
+    float dx = separation.x - std::max(-halfSize.x, std::min(halfSize.x, separation.x));
+    float dy = separation.y - std::max(-halfSize.y, std::min(halfSize.y, separation.y));
+    return dx * dx + dy * dy <= radius * radius;
+}
+
 bool CollisionDetection::contains(const RectangleShape& rect, const Vector2<float>& rectPos, const Vector2<float>& point) {
     // Use existing SIMD AABB containment test
     auto bounds = rect.getBounds(rectPos);
@@ -111,6 +160,15 @@ CollisionDetection::CollisionManifold CollisionDetection::generateManifold(const
                                                                           const CollisionShape& shape2, const Vector2<float>& pos2) {
     CollisionManifold manifold;
     
+    if (shape1.getType() == ShapeType::Capsule || shape2.getType() == ShapeType::Capsule) {
+        Vector2<float> halfSize1, halfSize2;
+        float radius1, radius2;
+        if (!getRoundedBox(shape1, halfSize1, radius1) || !getRoundedBox(shape2, halfSize2, radius2)) {
+            return manifold;
+        }
+        return generateRoundedBoxManifold(halfSize1, radius1, pos1, halfSize2, radius2, pos2);
+    }
+    
     // Check if shapes intersect
     if (!shape1.intersects(shape2, pos1, pos2)) {
         return manifold; // No collision
@@ -133,10 +191,12 @@ CollisionDetection::CollisionManifold CollisionDetection::generateManifold(const
             manifold.normal = separation.x > 0 ? Vector2<float>(1.0f, 0.0f) : Vector2<float>(-1.0f, 0.0f);
             manifold.penetration = overlap.x;
             manifold.contactPoint = pos1 + Vector2<float>(rect1.getHalfSize().x * (separation.x > 0 ? 1.0f : -1.0f), 0.0f);
+            manifold.featureId = separation.x > 0 ? 0u : 1u;
         } else {
             manifold.normal = separation.y > 0 ? Vector2<float>(0.0f, 1.0f) : Vector2<float>(0.0f, -1.0f);
             manifold.penetration = overlap.y;
             manifold.contactPoint = pos1 + Vector2<float>(0.0f, rect1.getHalfSize().y * (separation.y > 0 ? 1.0f : -1.0f));
+            manifold.featureId = separation.y > 0 ? 2u : 3u;
         }
     }
     else if (shape1.getType() == ShapeType::Circle && shape2.getType() == ShapeType::Circle) {
@@ -185,7 +245,7 @@ CollisionDetection::CollisionManifold CollisionDetection::generateManifold(const
         Vector2<float> separation = circlePos - closestPoint;
         float distance = separation.length();
         
-        if (distance < circle->getRadius()) {
+        if (distance <= circle->getRadius()) {
             if (distance > 0.0001f) {
                 manifold.normal = separation / distance;
                 manifold.penetration = circle->getRadius() - distance;
@@ -203,6 +263,13 @@ CollisionDetection::CollisionManifold CollisionDetection::generateManifold(const
             
             manifold.contactPoint = closestPoint;
             
+            // Voronoi region of the rectangle the circle center is in: one bit
+            // per clamped side, so faces and corners get distinct ids
+            Vector2<float> relative = circlePos - rectPos;
+            const Vector2<float>& halfSize = rect->getHalfSize();
+            manifold.featureId = (relative.x < -halfSize.x ? 1u : 0u) | (relative.x > halfSize.x ? 2u : 0u) |
+                                 (relative.y < -halfSize.y ? 4u : 0u) | (relative.y > halfSize.y ? 8u : 0u);
+            
             if (flipped) {
                 manifold.normal = -manifold.normal;
             }
@@ -212,5 +279,161 @@ CollisionDetection::CollisionManifold CollisionDetection::generateManifold(const
     return manifold;
 }
 
+bool CollisionDetection::getRoundedBox(const CollisionShape& shape, Vector2<float>& halfSize, float& radius) {
+    switch (shape.getType()) {
+        case ShapeType::Rectangle:
+            halfSize = static_cast<const RectangleShape&>(shape).getHalfSize();
+            radius = 0.0f;
+            return true;
+        case ShapeType::Circle:
+            halfSize = Vector2<float>(0.0f, 0.0f);
+            radius = static_cast<const CircleShape&>(shape).getRadius();
+            return true;
+        case ShapeType::Capsule:
+            halfSize = Vector2<float>(0.0f, static_cast<const CapsuleShape&>(shape).getHalfLength());
+            radius = static_cast<const CapsuleShape&>(shape).getRadius();
+            return true;
+        default:
+            return false;
+    }
+}
+
+CollisionDetection::CollisionManifold CollisionDetection::generateRoundedBoxManifold(
+    const Vector2<float>& halfSize1, float radius1, const Vector2<float>& pos1,
+    const Vector2<float>& halfSize2, float radius2, const Vector2<float>& pos2) {
+    CollisionManifold manifold;
+    
+    // The center of shape2 against the inner box of the Minkowski sum
+    const Vector2<float> halfSize = halfSize1 + halfSize2;
+    const float radius = radius1 + radius2;
+    const Vector2<float> separation = pos2 - pos1;
+    const Vector2<float> closest(std::max(-halfSize.x, std::min(halfSize.x, separation.x)),
+                                 std::max(-halfSize.y, std::min(halfSize.y, separation.y)));
+    const Vector2<float> outside = separation - closest;
+    const float distanceSquared = outside.lengthSquared();
+    if (distanceSquared > radius * radius) {
+        return manifold;
+    }
+    
+    manifold.hasCollision = true;
+    // Share of the closest point that lies on shape1
+    const Vector2<float> onShape1(std::max(-halfSize1.x, std::min(halfSize1.x, closest.x)),
+                                  std::max(-halfSize1.y, std::min(halfSize1.y, closest.y)));
+    
+    if (distanceSquared > 1e-8f) {
+        // Outside the inner box: the rounded part touches
+        const float distance = std::sqrt(distanceSquared);
+        manifold.normal = outside / distance;
+        manifold.penetration = radius - distance;
+        manifold.contactPoint = pos1 + onShape1 + manifold.normal * radius1;
+        manifold.featureId = (separation.x < -halfSize.x ? 1u : 0u) | (separation.x > halfSize.x ? 2u : 0u) |
+                             (separation.y < -halfSize.y ? 4u : 0u) | (separation.y > halfSize.y ? 8u : 0u);
+        return manifold;
+    }
+    
+    // Centers are deep inside each other: push out along the shallower axis
+    const float overlapX = halfSize.x + radius - std::abs(separation.x);
+    const float overlapY = halfSize.y + radius - std::abs(separation.y);
+    if (overlapX < overlapY) {
+        const float sign = separation.x > 0.0f ? 1.0f : -1.0f;
+        manifold.normal = Vector2<float>(sign, 0.0f);
+        manifold.penetration = overlapX;
+        manifold.contactPoint = pos1 + Vector2<float>(sign * (halfSize1.x + radius1), onShape1.y);
+        manifold.featureId = separation.x > 0.0f ? 16u : 17u;
+    } else {
+        const float sign = separation.y > 0.0f ? 1.0f : -1.0f;
+        manifold.normal = Vector2<float>(0.0f, sign);
+        manifold.penetration = overlapY;
+        manifold.contactPoint = pos1 + Vector2<float>(onShape1.x, sign * (halfSize1.y + radius1));
+        manifold.featureId = separation.y > 0.0f ? 18u : 19u;
+    }
+    return manifold;
+}
+
+CollisionDetection::SweepResult CollisionDetection::sweepRoundedBox(const Vector2<float>& origin, const Vector2<float>& motion,
+                                                                    const Vector2<float>& center, const Vector2<float>& halfSize,
+                                                                    float radius) {
+    SweepResult result;
+    const float origins[2] = {origin.x - center.x, origin.y - center.y};
+    const float directions[2] = {motion.x, motion.y};
+    const float extents[2] = {halfSize.x + radius, halfSize.y + radius};
+    
+    // Slab test against the box grown by the radius
+    float enter = -1.0f;
+    float exit = 2.0f;
+    int enterAxis = -1;
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::abs(directions[axis]) < 1e-12f) {
+            if (std::abs(origins[axis]) > extents[axis]) return result;
+            continue;
+        }
+        float t1 = (-extents[axis] - origins[axis]) / directions[axis];
+        float t2 = (extents[axis] - origins[axis]) / directions[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        if (t1 > enter) {
+            enter = t1;
+            enterAxis = axis;
+        }
+        exit = std::min(exit, t2);
+    }
+    if (enter > exit || enter > 1.0f) {
+        return result;
+    }
+    
+    float hitX = origins[0];
+    float hitY = origins[1];
+    if (enterAxis >= 0 && enter >= 0.0f) {
+        hitX += directions[0] * enter;
+        hitY += directions[1] * enter;
+        if (radius <= 0.0f || std::abs(hitX) <= halfSize.x || std::abs(hitY) <= halfSize.y) {
+            // Entered through a face
+            result.hit = true;
+            result.toi = enter;
+            result.normal = enterAxis == 0 ? Vector2<float>(directions[0] < 0.0f ? 1.0f : -1.0f, 0.0f)
+                                           : Vector2<float>(0.0f, directions[1] < 0.0f ? 1.0f : -1.0f);
+            return result;
+        }
+    } else if (radius <= 0.0f || std::abs(hitX) <= halfSize.x || std::abs(hitY) <= halfSize.y) {
+        // Starting inside counts as overlapping, not as a hit. Only the
+        // corner squares of the grown box lie partly outside the shape.
+        return result;
+    }
+    
+    // In or entering a corner square; the only way in is through that corner's circle
+    const float cornerX = hitX > 0.0f ? halfSize.x : -halfSize.x;
+    const float cornerY = hitY > 0.0f ? halfSize.y : -halfSize.y;
+    const float ox = origins[0] - cornerX;
+    const float oy = origins[1] - cornerY;
+    const float a = directions[0] * directions[0] + directions[1] * directions[1];
+    const float b = ox * directions[0] + oy * directions[1];
+    const float c = ox * ox + oy * oy - radius * radius;
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f || a <= 0.0f) return result;
+    
+    const float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.0f || t > 1.0f) return result;
+    
+    const float nx = ox + directions[0] * t;
+    const float ny = oy + directions[1] * t;
+    const float length = std::sqrt(nx * nx + ny * ny);
+    result.hit = true;
+    result.toi = t;
+    result.normal = length > 0.0f ? Vector2<float>(nx / length, ny / length) : Vector2<float>(1.0f, 0.0f);
+    return result;
+}
+
+CollisionDetection::SweepResult CollisionDetection::sweep(const CollisionShape& shape1, const Vector2<float>& pos1,
+                                                          const Vector2<float>& motion,
+                                                          const CollisionShape& shape2, const Vector2<float>& pos2) {
+    Vector2<float> halfSize1, halfSize2;
+    float radius1 = 0.0f, radius2 = 0.0f;
+    if (!getRoundedBox(shape1, halfSize1, radius1) || !getRoundedBox(shape2, halfSize2, radius2)) {
+        return SweepResult{};
+    }
+    
+    // The center of shape1 against shape2 grown by shape1
+    return sweepRoundedBox(pos1, motion, pos2, halfSize1 + halfSize2, radius1 + radius2);
+}
+
 } // namespace Physics
 } // namespace PyNovaGE
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "physics/dynamic_aabb_tree.hpp"
+
+namespace PyNovaGE {
+namespace Physics {
+
+int32_t DynamicAABBTree::createProxy(const Bounds2D& bounds, uint32_t user_data) {
+    const int32_t proxy = allocateNode();
+    Node& node = nodes_[proxy];
+    node.bounds = bounds.expanded(margin_);
+    node.user_data = user_data;
+    node.height = 0;
+
+    insertLeaf(proxy);
+    ++proxy_count_;
+    return proxy;
+}
+
+void DynamicAABBTree::destroyProxy(int32_t proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --proxy_count_;
+}
+
+bool DynamicAABBTree::moveProxy(int32_t proxy, const Bounds2D& bounds) {
+    const Bounds2D& fat = nodes_[proxy].bounds;
+    if (fat.contains(bounds)) {
+        // Re-insert anyway if the fat bounds are far larger than needed, as
+        // after a big body shrank; otherwise queries keep paying for it
+        const Bounds2D limit = bounds.expanded(4.0f * margin_);
+        if (limit.contains(fat)) {
+            return false;
+        }
+    }
+
+    removeLeaf(proxy);
+    nodes_[proxy].bounds = bounds.expanded(margin_);
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicAABBTree::clear() {
+    nodes_.clear();
+    root_ = kNullNode;
+    free_list_ = kNullNode;
+    proxy_count_ = 0;
+}
+
+int32_t DynamicAABBTree::allocateNode() {
+    int32_t index;
+    if (free_list_ != kNullNode) {
+        index = free_list_;
+        free_list_ = nodes_[index].parent;
+        nodes_[index] = Node{};
+    } else {
+        index = static_cast<int32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    return index;
+}
+
+void DynamicAABBTree::freeNode(int32_t index) {
+    nodes_[index].parent = free_list_;
+    nodes_[index].height = -1;
+    free_list_ = index;
+}
+
+void DynamicAABBTree::insertLeaf(int32_t leaf) {
+    if (root_ == kNullNode) {
+        root_ = leaf;
+        nodes_[leaf].parent = kNullNode;
+        return;
+    }
+
+    // Descend towards the sibling that minimizes total perimeter growth
+    const Bounds2D leaf_bounds = nodes_[leaf].bounds;
+    int32_t index = root_;
+    while (!nodes_[index].isLeaf()) {
+        const Node& node = nodes_[index];
+        const float combined_perimeter = Bounds2D::combine(node.bounds, leaf_bounds).perimeter();
+
+        // Cost of making a new parent for this node and the leaf
+        const float cost = 2.0f * combined_perimeter;
+        // Minimum cost of pushing the leaf further down
+        const float inheritance = 2.0f * (combined_perimeter - node.bounds.perimeter());
+
+        auto descendCost = [&](int32_t child) {
+            const Node& child_node = nodes_[child];
+            const float perimeter = Bounds2D::combine(leaf_bounds, child_node.bounds).perimeter();
+            return child_node.isLeaf() ? perimeter + inheritance
+                                       : perimeter - child_node.bounds.perimeter() + inheritance;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int32_t sibling = index;
+    const int32_t old_parent = nodes_[sibling].parent;
+    const int32_t new_parent = allocateNode(); // May reallocate nodes_
+
+    Node& parent = nodes_[new_parent];
+    parent.parent = old_parent;
+    parent.bounds = Bounds2D::combine(leaf_bounds, nodes_[sibling].bounds);
+    parent.height = nodes_[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+
+    if (old_parent != kNullNode) {
+        replaceChild(old_parent, sibling, new_parent);
+    } else {
+        root_ = new_parent;
+    }
+
+    refitAncestors(new_parent);
+}
+
+void DynamicAABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root_) {
+        root_ = kNullNode;
+        return;
+    }
+
+    const int32_t parent = nodes_[leaf].parent;
+    const int32_t grand_parent = nodes_[parent].parent;
+    const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    // The sibling takes the parent's place
+    nodes_[sibling].parent = grand_parent;
+    freeNode(parent);
+
+    if (grand_parent != kNullNode) {
+        replaceChild(grand_parent, parent, sibling);
+        refitAncestors(grand_parent);
+    } else {
+        root_ = sibling;
+    }
+}
+
+void DynamicAABBTree::refitAncestors(int32_t index) {
+    while (index != kNullNode) {
+        index = balance(index);
+
+        Node& node = nodes_[index];
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.bounds = Bounds2D::combine(child1.bounds, child2.bounds);
+
+        index = node.parent;
+    }
+}
+
+void DynamicAABBTree::replaceChild(int32_t parent, int32_t old_child, int32_t new_child) {
+    if (nodes_[parent].child1 == old_child) {
+        nodes_[parent].child1 = new_child;
+    } else {
+        nodes_[parent].child2 = new_child;
+    }
+}
+
+int32_t DynamicAABBTree::balance(int32_t a_index) {
+    Node& a = nodes_[a_index];
+    if (a.isLeaf() || a.height < 2) {
+        return a_index;
+    }
+
+    const int32_t b_index = a.child1;
+    const int32_t c_index = a.child2;
+    Node& b = nodes_[b_index];
+    Node& c = nodes_[c_index];
+    const int32_t height_difference = c.height - b.height;
+
+    // Rotate the taller child up into a's place; a keeps the taller
+    // grandchild's sibling and the promoted child keeps the taller grandchild
+    auto rotateUp = [this, a_index, &a](int32_t up_index, Node& up, Node& other, bool up_is_child2) {
+        const int32_t f_index = up.child1;
+        const int32_t g_index = up.child2;
+        Node& f = nodes_[f_index];
+        Node& g = nodes_[g_index];
+
+        up.child1 = a_index;
+        up.parent = a.parent;
+        a.parent = up_index;
+        if (up.parent != kNullNode) {
+            replaceChild(up.parent, a_index, up_index);
+        } else {
+            root_ = up_index;
+        }
+
+        const bool keep_f = f.height > g.height;
+        const int32_t kept_index = keep_f ? f_index : g_index;
+        const int32_t moved_index = keep_f ? g_index : f_index;
+        Node& kept = nodes_[kept_index];
+        Node& moved = nodes_[moved_index];
+
+        up.child2 = kept_index;
+        if (up_is_child2) {
+            a.child2 = moved_index;
+        } else {
+            a.child1 = moved_index;
+        }
+        moved.parent = a_index;
+
+        a.bounds = Bounds2D::combine(other.bounds, moved.bounds);
+        a.height = 1 + std::max(other.height, moved.height);
+        up.bounds = Bounds2D::combine(a.bounds, kept.bounds);
+        up.height = 1 + std::max(a.height, kept.height);
+    };
+
+    if (height_difference > 1) {
+        rotateUp(c_index, c, b, true);
+        return c_index;
+    }
+    if (height_difference < -1) {
+        rotateUp(b_index, b, c, false);
+        return b_index;
+    }
+    return a_index;
+}
+
+bool DynamicAABBTree::validate() const {
+    if (root_ == kNullNode) {
+        return proxy_count_ == 0;
+    }
+    if (nodes_[root_].parent != kNullNode) {
+        return false;
+    }
+
+    bool valid = true;
+    size_t leaves = 0;
+    for (const Node& node : nodes_) {
+        if (node.height == 0) ++leaves;
+    }
+    validateNode(root_, valid);
+    return valid && leaves == proxy_count_;
+}
+
+int32_t DynamicAABBTree::validateNode(int32_t index, bool& valid) const {
+    const Node& node = nodes_[index];
+    if (node.isLeaf()) {
+        if (node.height != 0) valid = false;
+        return 0;
+    }
+
+    const Node& child1 = nodes_[node.child1];
+    const Node& child2 = nodes_[node.child2];
+    if (child1.parent != index || child2.parent != index) {
+        valid = false;
+        return 0;
+    }
+
+    const int32_t height1 = validateNode(node.child1, valid);
+    const int32_t height2 = validateNode(node.child2, valid);
+    const int32_t height = 1 + std::max(height1, height2);
+
+    const Bounds2D combined = Bounds2D::combine(child1.bounds, child2.bounds);
+    if (node.height != height ||
+        combined.min_x != node.bounds.min_x || combined.min_y != node.bounds.min_y ||
+        combined.max_x != node.bounds.max_x || combined.max_y != node.bounds.max_y) {
+        valid = false;
+    }
+    return height;
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
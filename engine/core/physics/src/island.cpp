@@ -0,0 +1,149 @@
+#include "physics/island.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace PyNovaGE {
+namespace Physics {
+
+//------------------------------------------------------------------------------
+// IslandBuilder
+//------------------------------------------------------------------------------
+
+void IslandBuilder::reset(size_t body_count) {
+    // Only added bodies are ever read, so stale entries need no clearing
+    if (parent_.size() < body_count) {
+        parent_.resize(body_count);
+        island_of_body_.resize(body_count);
+    }
+    added_bodies_.clear();
+    added_contacts_.clear();
+    bodies_.clear();
+    body_offsets_.clear();
+    contacts_.clear();
+    contact_offsets_.clear();
+}
+
+void IslandBuilder::addBody(uint32_t body) {
+    parent_[body] = body;
+    added_bodies_.push_back(body);
+}
+
+void IslandBuilder::addContact(uint32_t contact, uint32_t body1, uint32_t body2) {
+    if (body1 == kNoBody && body2 == kNoBody) {
+        return;
+    }
+    if (body1 != kNoBody && body2 != kNoBody) {
+        // Union by index keeps the lowest body as root
+        const uint32_t root1 = find(body1);
+        const uint32_t root2 = find(body2);
+        if (root1 < root2) {
+            parent_[root2] = root1;
+        } else if (root2 < root1) {
+            parent_[root1] = root2;
+        }
+    }
+    added_contacts_.push_back({contact, body1 != kNoBody ? body1 : body2});
+}
+
+uint32_t IslandBuilder::find(uint32_t body) {
+    // Path halving
+    while (parent_[body] != body) {
+        parent_[body] = parent_[parent_[body]];
+        body = parent_[body];
+    }
+    return body;
+}
+
+void IslandBuilder::finish() {
+    // Bodies come in increasing order and roots are the lowest member, so a
+    // root is always seen before the rest of its island
+    uint32_t island_count = 0;
+    for (uint32_t body : added_bodies_) {
+        const uint32_t root = find(body);
+        island_of_body_[body] = root == body ? island_count++ : island_of_body_[root];
+    }
+
+    // Counting sort of bodies and contacts by island
+    body_offsets_.assign(island_count + 1, 0);
+    contact_offsets_.assign(island_count + 1, 0);
+    for (uint32_t body : added_bodies_) {
+        body_offsets_[island_of_body_[body] + 1]++;
+    }
+    for (const ContactEntry& entry : added_contacts_) {
+        contact_offsets_[island_of_body_[entry.body] + 1]++;
+    }
+    for (uint32_t i = 0; i < island_count; ++i) {
+        body_offsets_[i + 1] += body_offsets_[i];
+        contact_offsets_[i + 1] += contact_offsets_[i];
+    }
+
+    bodies_.resize(added_bodies_.size());
+    contacts_.resize(added_contacts_.size());
+    std::vector<uint32_t>& cursor = parent_;    // Union-find is done; reuse as scratch
+    std::copy(body_offsets_.begin(), body_offsets_.end() - 1, cursor.begin());
+    for (uint32_t body : added_bodies_) {
+        bodies_[cursor[island_of_body_[body]]++] = body;
+    }
+    std::copy(contact_offsets_.begin(), contact_offsets_.end() - 1, cursor.begin());
+    for (const ContactEntry& entry : added_contacts_) {
+        contacts_[cursor[island_of_body_[entry.body]]++] = entry.contact;
+    }
+}
+
+//------------------------------------------------------------------------------
+// ContactColoring
+//------------------------------------------------------------------------------
+
+void ContactColoring::build(std::span<const uint32_t> contacts, const uint32_t* body1, const uint32_t* body2,
+                            size_t body_count) {
+    if (body_colors_.size() < body_count) {
+        body_colors_.resize(body_count, 0);
+    }
+    contact_colors_.resize(contacts.size());
+    overflow_.clear();
+
+    size_t color_count = 0;
+    color_sizes_.assign(kMaxColors + 1, 0);
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const uint32_t a = body1[contacts[i]];
+        const uint32_t b = body2[contacts[i]];
+        uint64_t used = 0;
+        if (a != IslandBuilder::kNoBody) used |= body_colors_[a];
+        if (b != IslandBuilder::kNoBody) used |= body_colors_[b];
+
+        if (used == ~uint64_t{0}) {
+            contact_colors_[i] = static_cast<uint8_t>(kMaxColors);
+            continue;
+        }
+        const unsigned color = static_cast<unsigned>(std::countr_one(used));
+        const uint64_t bit = uint64_t{1} << color;
+        if (a != IslandBuilder::kNoBody) body_colors_[a] |= bit;
+        if (b != IslandBuilder::kNoBody) body_colors_[b] |= bit;
+        contact_colors_[i] = static_cast<uint8_t>(color);
+        color_sizes_[color + 1]++;
+        color_count = std::max<size_t>(color_count, color + 1);
+    }
+
+    offsets_.assign(color_count + 1, 0);
+    for (size_t c = 0; c < color_count; ++c) {
+        offsets_[c + 1] = offsets_[c] + color_sizes_[c + 1];
+    }
+    contacts_.resize(offsets_.back());
+    cursor_.assign(offsets_.begin(), offsets_.end());
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        if (contact_colors_[i] == kMaxColors) {
+            overflow_.push_back(contacts[i]);
+        } else {
+            contacts_[cursor_[contact_colors_[i]]++] = contacts[i];
+        }
+    }
+
+    // Leave the masks clear for the next build
+    for (uint32_t contact : contacts) {
+        if (body1[contact] != IslandBuilder::kNoBody) body_colors_[body1[contact]] = 0;
+        if (body2[contact] != IslandBuilder::kNoBody) body_colors_[body2[contact]] = 0;
+    }
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
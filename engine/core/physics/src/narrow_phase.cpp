@@ -0,0 +1,423 @@
+#include "physics/narrow_phase.hpp"
+#include "simd/types.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace PyNovaGE {
+namespace Physics {
+
+namespace {
+
+// Below this distance a normal cannot be taken from the center separation
+constexpr float kMinNormalDistance = 0.0001f;
+
+} // anonymous namespace
+
+ShapePairType NarrowPhase::classify(ShapeType type1, ShapeType type2) {
+    if (type1 == ShapeType::Capsule || type2 == ShapeType::Capsule) {
+        return ShapePairType::RoundedBox;
+    }
+    if (type1 != type2) {
+        return ShapePairType::RectangleCircle;
+    }
+    return type1 == ShapeType::Circle ? ShapePairType::CircleCircle : ShapePairType::RectangleRectangle;
+}
+
+void NarrowPhase::collide(std::span<const BroadPhasePair> pairs, const BodyStore& bodies) {
+    const size_t count = pairs.size();
+    const float* px = bodies.data(BodyField::PositionX);
+    const float* py = bodies.data(BodyField::PositionY);
+    const float* half_x = bodies.data(BodyField::ShapeHalfX);
+    const float* half_y = bodies.data(BodyField::ShapeHalfY);
+    const float* radius = bodies.data(BodyField::ShapeRadius);
+
+    // Counting sort by shape pair
+    types_.resize(count);
+    offsets_.fill(0);
+    for (size_t p = 0; p < count; ++p) {
+        const ShapePairType type = classify(bodies.getShapeType(pairs[p].index1), bodies.getShapeType(pairs[p].index2));
+        types_[p] = static_cast<uint8_t>(type);
+        offsets_[static_cast<size_t>(type) + 1]++;
+    }
+    for (size_t t = 0; t < kPairTypeCount; ++t) {
+        offsets_[t + 1] += offsets_[t];
+    }
+
+    pair_.resize(count);
+    a_x_.resize(count);
+    a_y_.resize(count);
+    dx_.resize(count);
+    dy_.resize(count);
+    half_x1_.resize(count);
+    half_y1_.resize(count);
+    radius1_.resize(count);
+    half_x2_.resize(count);
+    half_y2_.resize(count);
+    radius2_.resize(count);
+    flipped_.resize(count);
+
+    // Gather positions and dimensions into the buckets, rectangle first in
+    // rectangle-circle pairs so the kernel sees one order
+    std::array<uint32_t, kPairTypeCount + 1> cursor = offsets_;
+    for (size_t p = 0; p < count; ++p) {
+        const size_t job = cursor[types_[p]]++;
+        uint32_t a = pairs[p].index1;
+        uint32_t b = pairs[p].index2;
+        const bool flipped = types_[p] == static_cast<uint8_t>(ShapePairType::RectangleCircle) &&
+                             bodies.getShapeType(a) == ShapeType::Circle;
+        if (flipped) {
+            std::swap(a, b);
+        }
+
+        pair_[job] = static_cast<uint32_t>(p);
+        a_x_[job] = px[a];
+        a_y_[job] = py[a];
+        dx_[job] = px[b] - px[a];
+        dy_[job] = py[b] - py[a];
+        half_x1_[job] = half_x[a];
+        half_y1_[job] = half_y[a];
+        radius1_[job] = radius[a];
+        half_x2_[job] = half_x[b];
+        half_y2_[job] = half_y[b];
+        radius2_[job] = radius[b];
+        flipped_[job] = flipped ? 1 : 0;
+    }
+
+    touching_.assign(count, 0);
+    manifolds_.resize(count);
+
+    auto bucket = [&](ShapePairType type) {
+        return std::pair<size_t, size_t>(offsets_[static_cast<size_t>(type)], offsets_[static_cast<size_t>(type) + 1]);
+    };
+    auto [cc_begin, cc_end] = bucket(ShapePairType::CircleCircle);
+    collideCircles(cc_begin, cc_end);
+    auto [rr_begin, rr_end] = bucket(ShapePairType::RectangleRectangle);
+    collideRectangles(rr_begin, rr_end);
+    auto [rc_begin, rc_end] = bucket(ShapePairType::RectangleCircle);
+    collideRectangleCircles(rc_begin, rc_end);
+    auto [rb_begin, rb_end] = bucket(ShapePairType::RoundedBox);
+    collideRoundedBoxes(rb_begin, rb_end);
+
+    // Back to pair order
+    hits_.resize(count);
+    size_t hit_count = 0;
+    for (size_t p = 0; p < count; ++p) {
+        hits_[hit_count] = static_cast<uint32_t>(p);
+        hit_count += touching_[p];
+    }
+    hits_.resize(hit_count);
+}
+
+void NarrowPhase::addHit(size_t job, const CollisionDetection::CollisionManifold& manifold) {
+    manifolds_[pair_[job]] = manifold;
+    touching_[pair_[job]] = 1;
+}
+
+//------------------------------------------------------------------------------
+// Circle vs circle
+//------------------------------------------------------------------------------
+
+void NarrowPhase::collideCircle(size_t job) {
+    const float dx = dx_[job];
+    const float dy = dy_[job];
+    const float radius = radius1_[job] + radius2_[job];
+    const float distance_squared = dx * dx + dy * dy;
+    if (distance_squared > radius * radius) {
+        return;
+    }
+
+    CollisionDetection::CollisionManifold manifold;
+    manifold.hasCollision = true;
+    const float distance = std::sqrt(distance_squared);
+    if (distance > kMinNormalDistance) {
+        manifold.normal = Vector2<float>(dx / distance, dy / distance);
+        manifold.penetration = radius - distance;
+    } else {
+        // Same position, use an arbitrary normal
+        manifold.normal = Vector2<float>(1.0f, 0.0f);
+        manifold.penetration = radius;
+    }
+    manifold.contactPoint = Vector2<float>(a_x_[job] + manifold.normal.x * radius1_[job],
+                                           a_y_[job] + manifold.normal.y * radius1_[job]);
+    addHit(job, manifold);
+}
+
+void NarrowPhase::collideCircles(size_t begin, size_t end) {
+    size_t i = begin;
+
+#if defined(NOVA_AVX2_AVAILABLE) && defined(__AVX2__)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 min_distance = _mm256_set1_ps(kMinNormalDistance);
+        alignas(32) float normal_x[8];
+        alignas(32) float normal_y[8];
+        alignas(32) float penetration[8];
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 dx = _mm256_loadu_ps(dx_.data() + i);
+            const __m256 dy = _mm256_loadu_ps(dy_.data() + i);
+            const __m256 radius = _mm256_add_ps(_mm256_loadu_ps(radius1_.data() + i), _mm256_loadu_ps(radius2_.data() + i));
+            const __m256 distance_squared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            int hits = _mm256_movemask_ps(_mm256_cmp_ps(distance_squared, _mm256_mul_ps(radius, radius), _CMP_LE_OQ));
+            if (hits == 0) {
+                continue;
+            }
+
+            const __m256 distance = _mm256_sqrt_ps(distance_squared);
+            const __m256 apart = _mm256_cmp_ps(distance, min_distance, _CMP_GT_OQ);
+            const __m256 divisor = _mm256_max_ps(distance, min_distance);
+            _mm256_store_ps(normal_x, _mm256_blendv_ps(one, _mm256_div_ps(dx, divisor), apart));
+            _mm256_store_ps(normal_y, _mm256_and_ps(_mm256_div_ps(dy, divisor), apart));
+            _mm256_store_ps(penetration, _mm256_sub_ps(radius, _mm256_and_ps(distance, apart)));
+
+            while (hits) {
+                const int lane = std::countr_zero(static_cast<unsigned>(hits));
+                hits &= hits - 1;
+                const size_t job = i + static_cast<size_t>(lane);
+                CollisionDetection::CollisionManifold manifold;
+                manifold.hasCollision = true;
+                manifold.normal = Vector2<float>(normal_x[lane], normal_y[lane]);
+                manifold.penetration = penetration[lane];
+                manifold.contactPoint = Vector2<float>(a_x_[job] + normal_x[lane] * radius1_[job],
+                                                       a_y_[job] + normal_y[lane] * radius1_[job]);
+                addHit(job, manifold);
+            }
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        collideCircle(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Rectangle vs rectangle
+//------------------------------------------------------------------------------
+
+void NarrowPhase::collideRectangle(size_t job) {
+    const float dx = dx_[job];
+    const float dy = dy_[job];
+    const float overlap_x = half_x1_[job] + half_x2_[job] - std::abs(dx);
+    const float overlap_y = half_y1_[job] + half_y2_[job] - std::abs(dy);
+    if (overlap_x < 0.0f || overlap_y < 0.0f) {
+        return;
+    }
+
+    CollisionDetection::CollisionManifold manifold;
+    manifold.hasCollision = true;
+    if (overlap_x < overlap_y) {
+        const float sign = dx > 0.0f ? 1.0f : -1.0f;
+        manifold.normal = Vector2<float>(sign, 0.0f);
+        manifold.penetration = overlap_x;
+        manifold.contactPoint = Vector2<float>(a_x_[job] + half_x1_[job] * sign, a_y_[job]);
+        manifold.featureId = dx > 0.0f ? 0u : 1u;
+    } else {
+        const float sign = dy > 0.0f ? 1.0f : -1.0f;
+        manifold.normal = Vector2<float>(0.0f, sign);
+        manifold.penetration = overlap_y;
+        manifold.contactPoint = Vector2<float>(a_x_[job], a_y_[job] + half_y1_[job] * sign);
+        manifold.featureId = dy > 0.0f ? 2u : 3u;
+    }
+    addHit(job, manifold);
+}
+
+void NarrowPhase::collideRectangles(size_t begin, size_t end) {
+    size_t i = begin;
+
+#if defined(NOVA_AVX2_AVAILABLE) && defined(__AVX2__)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+        alignas(32) float overlap_x[8];
+        alignas(32) float overlap_y[8];
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 dx = _mm256_loadu_ps(dx_.data() + i);
+            const __m256 dy = _mm256_loadu_ps(dy_.data() + i);
+            const __m256 ox = _mm256_sub_ps(
+                _mm256_add_ps(_mm256_loadu_ps(half_x1_.data() + i), _mm256_loadu_ps(half_x2_.data() + i)),
+                _mm256_andnot_ps(sign_bit, dx));
+            const __m256 oy = _mm256_sub_ps(
+                _mm256_add_ps(_mm256_loadu_ps(half_y1_.data() + i), _mm256_loadu_ps(half_y2_.data() + i)),
+                _mm256_andnot_ps(sign_bit, dy));
+            int hits = _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(ox, zero, _CMP_GE_OQ),
+                                                        _mm256_cmp_ps(oy, zero, _CMP_GE_OQ)));
+            if (hits == 0) {
+                continue;
+            }
+
+            // Axis and direction of least overlap as lane bits
+            const int x_axis = _mm256_movemask_ps(_mm256_cmp_ps(ox, oy, _CMP_LT_OQ));
+            const int positive_x = _mm256_movemask_ps(_mm256_cmp_ps(dx, zero, _CMP_GT_OQ));
+            const int positive_y = _mm256_movemask_ps(_mm256_cmp_ps(dy, zero, _CMP_GT_OQ));
+            _mm256_store_ps(overlap_x, ox);
+            _mm256_store_ps(overlap_y, oy);
+
+            while (hits) {
+                const int lane = std::countr_zero(static_cast<unsigned>(hits));
+                const int bit = 1 << lane;
+                hits &= hits - 1;
+                const size_t job = i + static_cast<size_t>(lane);
+                CollisionDetection::CollisionManifold manifold;
+                manifold.hasCollision = true;
+                if (x_axis & bit) {
+                    const float sign = (positive_x & bit) ? 1.0f : -1.0f;
+                    manifold.normal = Vector2<float>(sign, 0.0f);
+                    manifold.penetration = overlap_x[lane];
+                    manifold.contactPoint = Vector2<float>(a_x_[job] + half_x1_[job] * sign, a_y_[job]);
+                    manifold.featureId = (positive_x & bit) ? 0u : 1u;
+                } else {
+                    const float sign = (positive_y & bit) ? 1.0f : -1.0f;
+                    manifold.normal = Vector2<float>(0.0f, sign);
+                    manifold.penetration = overlap_y[lane];
+                    manifold.contactPoint = Vector2<float>(a_x_[job], a_y_[job] + half_y1_[job] * sign);
+                    manifold.featureId = (positive_y & bit) ? 2u : 3u;
+                }
+                addHit(job, manifold);
+            }
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        collideRectangle(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Rectangle vs circle
+//------------------------------------------------------------------------------
+
+void NarrowPhase::collideRectangleCircle(size_t job) {
+    const float dx = dx_[job];
+    const float dy = dy_[job];
+    const float half_x = half_x1_[job];
+    const float half_y = half_y1_[job];
+    const float radius = radius2_[job];
+
+    // Closest point of the rectangle to the circle center
+    const float closest_x = std::max(-half_x, std::min(half_x, dx));
+    const float closest_y = std::max(-half_y, std::min(half_y, dy));
+    const float sx = dx - closest_x;
+    const float sy = dy - closest_y;
+    const float distance_squared = sx * sx + sy * sy;
+    if (distance_squared > radius * radius) {
+        return;
+    }
+
+    CollisionDetection::CollisionManifold manifold;
+    manifold.hasCollision = true;
+    const float distance = std::sqrt(distance_squared);
+    if (distance > kMinNormalDistance) {
+        manifold.normal = Vector2<float>(sx / distance, sy / distance);
+        manifold.penetration = radius - distance;
+    } else {
+        // Circle center is on the rectangle, use direction from rect center
+        const float center_distance = std::sqrt(dx * dx + dy * dy);
+        manifold.normal = center_distance > kMinNormalDistance
+                              ? Vector2<float>(dx / center_distance, dy / center_distance)
+                              : Vector2<float>(1.0f, 0.0f);
+        manifold.penetration = radius;
+    }
+    manifold.contactPoint = Vector2<float>(a_x_[job] + closest_x, a_y_[job] + closest_y);
+    manifold.featureId = (dx < -half_x ? 1u : 0u) | (dx > half_x ? 2u : 0u) |
+                         (dy < -half_y ? 4u : 0u) | (dy > half_y ? 8u : 0u);
+    if (flipped_[job]) {
+        manifold.normal = -manifold.normal;
+    }
+    addHit(job, manifold);
+}
+
+void NarrowPhase::collideRectangleCircles(size_t begin, size_t end) {
+    size_t i = begin;
+
+#if defined(NOVA_AVX2_AVAILABLE) && defined(__AVX2__)
+    {
+        const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+        const __m256 min_distance = _mm256_set1_ps(kMinNormalDistance);
+        alignas(32) float normal_x[8];
+        alignas(32) float normal_y[8];
+        alignas(32) float penetration[8];
+        alignas(32) float closest_x[8];
+        alignas(32) float closest_y[8];
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 dx = _mm256_loadu_ps(dx_.data() + i);
+            const __m256 dy = _mm256_loadu_ps(dy_.data() + i);
+            const __m256 half_x = _mm256_loadu_ps(half_x1_.data() + i);
+            const __m256 half_y = _mm256_loadu_ps(half_y1_.data() + i);
+            const __m256 radius = _mm256_loadu_ps(radius2_.data() + i);
+
+            const __m256 cx = _mm256_max_ps(_mm256_xor_ps(half_x, sign_bit), _mm256_min_ps(half_x, dx));
+            const __m256 cy = _mm256_max_ps(_mm256_xor_ps(half_y, sign_bit), _mm256_min_ps(half_y, dy));
+            const __m256 sx = _mm256_sub_ps(dx, cx);
+            const __m256 sy = _mm256_sub_ps(dy, cy);
+            const __m256 distance_squared = _mm256_add_ps(_mm256_mul_ps(sx, sx), _mm256_mul_ps(sy, sy));
+            int hits = _mm256_movemask_ps(_mm256_cmp_ps(distance_squared, _mm256_mul_ps(radius, radius), _CMP_LE_OQ));
+            if (hits == 0) {
+                continue;
+            }
+
+            const __m256 distance = _mm256_sqrt_ps(distance_squared);
+            const __m256 divisor = _mm256_max_ps(distance, min_distance);
+            // Centers on the rectangle need the fallback normal
+            const int inside = _mm256_movemask_ps(_mm256_cmp_ps(distance, min_distance, _CMP_LE_OQ));
+            _mm256_store_ps(normal_x, _mm256_div_ps(sx, divisor));
+            _mm256_store_ps(normal_y, _mm256_div_ps(sy, divisor));
+            _mm256_store_ps(penetration, _mm256_sub_ps(radius, distance));
+            _mm256_store_ps(closest_x, cx);
+            _mm256_store_ps(closest_y, cy);
+
+            while (hits) {
+                const int lane = std::countr_zero(static_cast<unsigned>(hits));
+                const int bit = 1 << lane;
+                hits &= hits - 1;
+                const size_t job = i + static_cast<size_t>(lane);
+                if (inside & bit) {
+                    collideRectangleCircle(job);
+                    continue;
+                }
+
+                const float rx = dx_[job];
+                const float ry = dy_[job];
+                const float hx = half_x1_[job];
+                const float hy = half_y1_[job];
+                const float sign = flipped_[job] ? -1.0f : 1.0f;
+                CollisionDetection::CollisionManifold manifold;
+                manifold.hasCollision = true;
+                manifold.normal = Vector2<float>(normal_x[lane] * sign, normal_y[lane] * sign);
+                manifold.penetration = penetration[lane];
+                manifold.contactPoint = Vector2<float>(a_x_[job] + closest_x[lane], a_y_[job] + closest_y[lane]);
+                manifold.featureId = (rx < -hx ? 1u : 0u) | (rx > hx ? 2u : 0u) |
+                                     (ry < -hy ? 4u : 0u) | (ry > hy ? 8u : 0u);
+                addHit(job, manifold);
+            }
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        collideRectangleCircle(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Pairs with a capsule
+//------------------------------------------------------------------------------
+
+void NarrowPhase::collideRoundedBoxes(size_t begin, size_t end) {
+    for (size_t job = begin; job < end; ++job) {
+        auto manifold = CollisionDetection::generateRoundedBoxManifold(
+            Vector2<float>(half_x1_[job], half_y1_[job]), radius1_[job], Vector2<float>(a_x_[job], a_y_[job]),
+            Vector2<float>(half_x2_[job], half_y2_[job]), radius2_[job],
+            Vector2<float>(a_x_[job] + dx_[job], a_y_[job] + dy_[job]));
+        if (manifold.hasCollision) {
+            addHit(job, manifold);
+        }
+    }
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -1,6 +1,10 @@
 #include "physics/physics_world.hpp"
+#include "threading/thread_pool.hpp"
 #include <chrono>
+#include <cstring>
 #include <algorithm>
+#include <stdexcept>
+#include <limits>
 #include <unordered_set>
 
 #ifdef _MSC_VER
@@ -19,12 +23,56 @@ static Vector2<float> safeDivide(const Vector2<float>& vector, float divisor) {
     return vector;
 }
 
+static Bounds2D toBounds2D(const AABB<float>& bounds) {
+    return {bounds.min[0], bounds.min[1], bounds.max[0], bounds.max[1]};
+}
+
+// Run func(0) .. func(count - 1), spread over the pool if there is one
+template<typename Func>
+static void runJobs(size_t count, Threading::ThreadPool* pool, Func&& func) {
+    if (pool && count > 1) {
+        Threading::parallel_for(0, count, func, pool);
+    } else {
+        for (size_t job = 0; job < count; ++job) {
+            func(job);
+        }
+    }
+}
+
 PhysicsWorld::PhysicsWorld(const PhysicsConfig& config) 
-    : config_(config) {
+    : config_(config)
+    , broad_phase_(createBroadPhase(config.broad_phase, config.broad_phase_cell_size, config.broad_phase_margin))
+    , query_tree_(config.broad_phase_margin) {
+}
+
+PhysicsWorld::~PhysicsWorld() {
+    // Bodies may outlive the world; hand their state back before the store goes
+    for (auto& body : bodies_) {
+        body->detachFromStore();
+    }
+}
+
+void PhysicsWorld::setConfig(const PhysicsConfig& config) {
+    const bool broad_phase_changed = config.broad_phase != config_.broad_phase ||
+                                     config.broad_phase_cell_size != config_.broad_phase_cell_size ||
+                                     config.broad_phase_margin != config_.broad_phase_margin;
+    config_ = config;
+    if (broad_phase_changed) {
+        broad_phase_ = createBroadPhase(config_.broad_phase, config_.broad_phase_cell_size,
+                                        config_.broad_phase_margin);
+    }
+    // Existing proxies pick up a new margin the next time they are re-inserted
+    query_tree_.setMargin(config_.broad_phase_margin);
 }
 
 void PhysicsWorld::addBody(std::shared_ptr<RigidBody> body) {
     if (body && std::find(bodies_.begin(), bodies_.end(), body) == bodies_.end()) {
+        if (!body->own_store_) {
+            throw std::invalid_argument("PhysicsWorld::addBody: body already belongs to another world");
+        }
+        body->attachToStore(body_store_);
+        query_proxies_.push_back(query_tree_.createProxy(toBounds2D(body->getWorldBounds()),
+                                                         static_cast<uint32_t>(bodies_.size())));
         bodies_.push_back(body);
         updateActiveBodyList();
     }
@@ -33,8 +81,7 @@ void PhysicsWorld::addBody(std::shared_ptr<RigidBody> body) {
 void PhysicsWorld::removeBody(std::shared_ptr<RigidBody> body) {
     auto it = std::find(bodies_.begin(), bodies_.end(), body);
     if (it != bodies_.end()) {
-        bodies_.erase(it);
-        updateActiveBodyList();
+        removeBodyAt(static_cast<size_t>(it - bodies_.begin()));
     }
 }
 
@@ -44,16 +91,118 @@ void PhysicsWorld::removeBody(RigidBody* body) {
             return ptr && ptr.get() == body;
         });
     if (it != bodies_.end()) {
-        bodies_.erase(it);
-        updateActiveBodyList();
+        removeBodyAt(static_cast<size_t>(it - bodies_.begin()));
     }
 }
 
+void PhysicsWorld::removeBodyAt(size_t index) {
+    // Whatever rested on the body has to fall
+    wakeBodiesTouching(bodies_[index]->getWorldBounds());
+
+    query_tree_.destroyProxy(query_proxies_[index]);
+    query_proxies_.erase(query_proxies_.begin() + static_cast<std::ptrdiff_t>(index));
+    bodies_[index]->detachFromStore();
+    body_store_.remove(static_cast<uint32_t>(index));
+    bodies_.erase(bodies_.begin() + static_cast<std::ptrdiff_t>(index));
+
+    // Bodies after the removed one shifted down by one
+    for (size_t i = index; i < query_proxies_.size(); ++i) {
+        query_tree_.setUserData(query_proxies_[i], static_cast<uint32_t>(i));
+    }
+    // Cache keys are body indices, which just changed
+    contact_cache_.clear();
+    awake_bodies_.clear();
+    updateActiveBodyList();
+}
+
 void PhysicsWorld::clear() {
+    for (auto& body : bodies_) {
+        body->detachFromStore();
+    }
+    body_store_.clear();
     bodies_.clear();
     contacts_.clear();
+    contact_cache_.clear();
+    contact_body1_.clear();
+    contact_body2_.clear();
+    island_builder_.reset(0);
     active_body_indices_.clear();
+    awake_bodies_.clear();
+    broad_phase_proxies_.clear();
     broad_phase_pairs_.clear();
+    broad_phase_->reset();
+    region_jobs_.clear();
+    query_tree_.clear();
+    query_proxies_.clear();
+    static_geometry_.clear();
+}
+
+void PhysicsWorld::updateQueryTree() {
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        query_tree_.moveProxy(query_proxies_[i], toBounds2D(bodies_[i]->getWorldBounds()));
+    }
+}
+
+void PhysicsWorld::saveState(std::vector<std::byte>& buffer) const {
+    const StateHeader header{kStateMagic, kStateVersion, static_cast<uint32_t>(bodies_.size()),
+                             static_cast<uint32_t>(contact_cache_.size()), time_accumulator_};
+    buffer.resize(sizeof(StateHeader) + body_store_.getStateSize() + contact_cache_.size() * kCachedImpulseBytes);
+    
+    std::byte* out = buffer.data();
+    std::memcpy(out, &header, sizeof(StateHeader));
+    out += sizeof(StateHeader);
+    body_store_.saveState(out);
+    out += body_store_.getStateSize();
+    
+    // Field by field so the buffer holds no struct padding
+    for (const CachedImpulse& cached : contact_cache_) {
+        std::memcpy(out, &cached.pair_key, sizeof(uint64_t));
+        std::memcpy(out + 8, &cached.feature_id, sizeof(uint32_t));
+        std::memcpy(out + 12, &cached.normal_impulse, sizeof(float));
+        std::memcpy(out + 16, &cached.tangent_impulse, sizeof(float));
+        out += kCachedImpulseBytes;
+    }
+}
+
+std::vector<std::byte> PhysicsWorld::saveState() const {
+    std::vector<std::byte> buffer;
+    saveState(buffer);
+    return buffer;
+}
+
+void PhysicsWorld::restoreState(std::span<const std::byte> buffer) {
+    StateHeader header;
+    if (buffer.size() < sizeof(StateHeader)) {
+        throw std::invalid_argument("PhysicsWorld::restoreState: buffer too small");
+    }
+    std::memcpy(&header, buffer.data(), sizeof(StateHeader));
+    if (header.magic != kStateMagic || header.version != kStateVersion) {
+        throw std::invalid_argument("PhysicsWorld::restoreState: not a physics snapshot");
+    }
+    if (header.body_count != bodies_.size()) {
+        throw std::invalid_argument("PhysicsWorld::restoreState: snapshot body count does not match the world");
+    }
+    if (buffer.size() != sizeof(StateHeader) + body_store_.getStateSize() + header.cached_contacts * kCachedImpulseBytes) {
+        throw std::invalid_argument("PhysicsWorld::restoreState: buffer size does not match its header");
+    }
+    
+    const std::byte* in = buffer.data() + sizeof(StateHeader);
+    body_store_.restoreState(in);
+    in += body_store_.getStateSize();
+    
+    contact_cache_.resize(header.cached_contacts);
+    for (CachedImpulse& cached : contact_cache_) {
+        std::memcpy(&cached.pair_key, in, sizeof(uint64_t));
+        std::memcpy(&cached.feature_id, in + 8, sizeof(uint32_t));
+        std::memcpy(&cached.normal_impulse, in + 12, sizeof(float));
+        std::memcpy(&cached.tangent_impulse, in + 16, sizeof(float));
+        in += kCachedImpulseBytes;
+    }
+    time_accumulator_ = header.time_accumulator;
+    
+    // Contacts are rebuilt by the next step; the query tree follows the bodies
+    contacts_.clear();
+    updateQueryTree();
 }
 
 void PhysicsWorld::step(float deltaTime) {
@@ -69,116 +218,270 @@ void PhysicsWorld::step(float deltaTime) {
     
     // Process fixed timesteps
     while (time_accumulator_ >= FIXED_TIME_STEP) {
+        beginContinuousCollision();
         integrate(FIXED_TIME_STEP);
+        solveContinuousCollisions(FIXED_TIME_STEP);
         broadPhaseCollision();
         narrowPhaseCollision();
+        buildIslands();
         solveConstraints(FIXED_TIME_STEP);
         updateSleepingBodies(FIXED_TIME_STEP);
         
         time_accumulator_ -= FIXED_TIME_STEP;
     }
     
+    // Only moving bodies need refitting; sleeping ones were refitted when
+    // they fell asleep and static ones are moved by hand
+    const uint32_t* flags = body_store_.flags();
+    size_t awake = 0;
+    awake_bodies_.clear();
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        if (!(flags[i] & BodyStore::kFlagAwake)) continue;
+        ++awake;
+        if (!bodies_[i]->isStatic()) {
+            query_tree_.moveProxy(query_proxies_[i], toBounds2D(bodies_[i]->getWorldBounds()));
+            awake_bodies_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    
     // Update statistics
     auto end = std::chrono::high_resolution_clock::now();
     stats_.step_time = std::chrono::duration<float>(end - start).count();
-    stats_.active_bodies = 0;
-    stats_.sleeping_bodies = 0;
-    
-    for (const auto& body : bodies_) {
-        if (body->isAwake()) {
-            stats_.active_bodies++;
-        } else {
-            stats_.sleeping_bodies++;
-        }
-    }
+    stats_.active_bodies = awake;
+    stats_.sleeping_bodies = bodies_.size() - awake;
 }
 
 // Physics simulation implementation methods
 void PhysicsWorld::integrate(float deltaTime) {
-    // Apply gravity to dynamic bodies first
-    for (auto& body : bodies_) {
-        if (body->getBodyType() == BodyType::Dynamic && body->isAwake()) {
-            Vector2<float> gravityForce = config_.gravity * body->getMass();
-            body->applyForce(gravityForce);
-        }
-    }
+    // Gravity, forces, drag and motion for all awake dynamic bodies; sleep
+    // is decided per island after solving
+    body_store_.integrate(deltaTime, config_.gravity, false);
+}
+
+void PhysicsWorld::beginContinuousCollision() {
+    continuous_bodies_.clear();
+    continuous_starts_.clear();
     
-    // Integrate all dynamic bodies
-    for (auto& body : bodies_) {
-        if (body->getBodyType() == BodyType::Dynamic && body->isAwake()) {
-            body->integrate(deltaTime);
+    const uint32_t* flags = body_store_.flags();
+    constexpr uint32_t required = BodyStore::kFlagContinuous | BodyStore::kFlagDynamic |
+                                  BodyStore::kFlagAwake | BodyStore::kFlagActive;
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        if ((flags[i] & required) == required) {
+            continuous_bodies_.push_back(static_cast<uint32_t>(i));
+            continuous_starts_.push_back(bodies_[i]->getPosition());
         }
     }
 }
 
-void PhysicsWorld::broadPhaseCollision() {
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    broad_phase_pairs_.clear();
+void PhysicsWorld::solveContinuousCollisions(float deltaTime) {
+    // Gap left before a still obstacle so the next sweep does not start touching it
+    const float SKIN = 0.005f;
+    stats_.continuous_hits = 0;
     
-    // Simple O(n²) broad phase using SIMD AABB tests
-    for (size_t i = 0; i < bodies_.size(); ++i) {
-        for (size_t j = i + 1; j < bodies_.size(); ++j) {
-            auto& bodyA = bodies_[i];
-            auto& bodyB = bodies_[j];
+    for (size_t k = 0; k < continuous_bodies_.size(); ++k) {
+        const uint32_t index = continuous_bodies_[k];
+        RigidBody& body = *bodies_[index];
+        const CollisionShape& shape = body.getCollisionShape();
+        
+        Vector2<float> position = continuous_starts_[k];
+        Vector2<float> target = body.getPosition();
+        Vector2<float> velocity = body.getLinearVelocity();
+        
+        // A body moving less than half its size per step cannot pass through anything
+        const AABB<float> startBounds = shape.getBounds(position);
+        const float size = std::min(startBounds.max[0] - startBounds.min[0], startBounds.max[1] - startBounds.min[1]);
+        if ((target - position).length() < 0.5f * size) continue;
+        
+        float remaining = 1.0f;
+        for (int substep = 0; substep < config_.max_continuous_substeps; ++substep) {
+            const Vector2<float> motion = target - position;
+            const float distance = motion.length();
+            if (distance < 1e-6f) break;
+            
+            // Swept bounds of this sub-step against the query tree
+            const AABB<float> from = shape.getBounds(position);
+            const AABB<float> to = shape.getBounds(target);
+            const Bounds2D swept{std::min(from.min[0], to.min[0]), std::min(from.min[1], to.min[1]),
+                                 std::max(from.max[0], to.max[0]), std::max(from.max[1], to.max[1])};
             
-            if (!isValidPair(*bodyA, *bodyB)) {
-                continue;
+            CollisionDetection::SweepResult first;
+            RigidBody* obstacle = nullptr;
+            uint32_t obstacle_index = 0;
+            query_tree_.query(swept, [&](int32_t node) {
+                const uint32_t other = query_tree_.getUserData(node);
+                if (other == index || !bodies_[other]->isActive()) return true;
+                
+                const RigidBody& candidate = *bodies_[other];
+                auto hit = CollisionDetection::sweep(shape, position, motion,
+                                                     candidate.getCollisionShape(), candidate.getPosition());
+                // Ties go to the lower index, not to whichever the tree visits first
+                if (hit.hit && (hit.toi < first.toi ||
+                                (obstacle && hit.toi == first.toi && other < obstacle_index))) {
+                    first = hit;
+                    obstacle = bodies_[other].get();
+                    obstacle_index = other;
+                }
+                return true;
+            });
+            
+            if (!obstacle) {
+                position = target;
+                break;
             }
+            stats_.continuous_hits++;
             
-            // Check AABB overlap using existing SIMD implementation
-            auto boundsA = bodyA->getWorldBounds();
-            auto boundsB = bodyB->getWorldBounds();
+            if (obstacle->isDynamic()) {
+                // Stop just inside so the contact solver exchanges momentum
+                position = position + motion * std::min(1.0f, first.toi + SKIN / distance);
+                break;
+            }
             
-            if (boundsA.intersects(boundsB)) {
-                broad_phase_pairs_.push_back({i, j});
+            // Still obstacle: stop short of it, drop the approach velocity and
+            // spend the rest of the step moving on from there
+            position = position + motion * std::max(0.0f, first.toi - SKIN / distance);
+            remaining *= 1.0f - first.toi;
+            const float approach = velocity.dot(first.normal);
+            if (approach < 0.0f) {
+                const float restitution = std::min(body.getMaterial().restitution, obstacle->getMaterial().restitution);
+                velocity = velocity - first.normal * ((1.0f + restitution) * approach);
             }
+            target = position + velocity * (remaining * deltaTime);
+        }
+        // Out of sub-steps, the body stays at its last impact rather than tunnel
+        
+        body.setPosition(position);
+        body.setLinearVelocity(velocity);
+    }
+}
+
+void PhysicsWorld::broadPhaseCollision() {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    // Only awake, moving bodies get a proxy; inactive bodies never collide
+    broad_phase_proxies_.clear();
+    broad_phase_proxies_.reserve(bodies_.size());
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        const RigidBody& body = *bodies_[i];
+        if (!body.isActive() || !body.isAwake() || body.isStatic()) continue;
+        
+        const auto bounds = body.getWorldBounds();
+        broad_phase_proxies_.push_back({bounds.min[0], bounds.min[1], bounds.max[0], bounds.max[1],
+                                        static_cast<uint32_t>(i)});
+    }
+    
+    if (config_.region_size > 0.0f) {
+        regionBroadPhase();
+    } else {
+        broad_phase_->findPairs(broad_phase_proxies_, broad_phase_pairs_);
+        for (const auto& proxy : broad_phase_proxies_) {
+            findStillPairs(proxy, broad_phase_pairs_);
         }
+        finishPairs(broad_phase_pairs_);
+        stats_.broad_phase_pairs = broad_phase_pairs_.size();
+        stats_.regions = 0;
     }
     
     auto end = std::chrono::high_resolution_clock::now();
     stats_.broad_phase_time = std::chrono::duration<float>(end - start).count();
-    stats_.broad_phase_pairs = broad_phase_pairs_.size();
+    stats_.broad_phase_proxies = broad_phase_proxies_.size();
+}
+
+void PhysicsWorld::findStillPairs(const BroadPhaseProxy& proxy, std::vector<BroadPhasePair>& pairs) const {
+    // Static and sleeping bodies do not move, so their query tree entries are
+    // current; find the ones the moving body touches there
+    const Bounds2D bounds{proxy.min_x, proxy.min_y, proxy.max_x, proxy.max_y};
+    query_tree_.query(bounds, [&](int32_t node) {
+        const uint32_t other = query_tree_.getUserData(node);
+        const RigidBody& body = *bodies_[other];
+        if (body.isActive() && (body.isStatic() || !body.isAwake()) &&
+            toBounds2D(body.getWorldBounds()).overlaps(bounds)) {
+            pairs.push_back(BroadPhasePair::make(proxy.body_index, other));
+        }
+        return true;
+    });
+}
+
+void PhysicsWorld::finishPairs(std::vector<BroadPhasePair>& pairs) const {
+    // Drop static/static and sleeping/sleeping pairs
+    pairs.erase(
+        std::remove_if(pairs.begin(), pairs.end(),
+            [this](const BroadPhasePair& pair) {
+                return !isValidPair(*bodies_[pair.index1], *bodies_[pair.index2]);
+            }),
+        pairs.end());
+    
+    // Solve in pair order regardless of broad phase so results do not depend on it
+    std::sort(pairs.begin(), pairs.end());
+}
+
+void PhysicsWorld::regionBroadPhase() {
+    region_grid_.build(broad_phase_proxies_, config_.region_size, bodies_.size());
+    const size_t regions = region_grid_.getRegionCount();
+    while (region_jobs_.size() < regions + 1) {
+        region_jobs_.push_back(std::make_unique<RegionJob>());
+    }
+    
+    runJobs(regions + 1, thread_pool_, [this, regions](size_t index) {
+        RegionJob& job = *region_jobs_[index];
+        const bool boundary = index == regions;
+        const std::span<const uint32_t> members = boundary ? region_grid_.getBoundaryProxies()
+                                                           : region_grid_.getRegionProxies(index);
+        job.proxies.clear();
+        for (uint32_t proxy : members) {
+            job.proxies.push_back(broad_phase_proxies_[proxy]);
+        }
+        job.broad_phase.findPairs(job.proxies, job.pairs);
+        
+        // A region owns the pairs with one of its interior bodies; pairs of
+        // two guests are found again by the boundary pass
+        size_t owned = job.proxies.size();
+        if (!boundary) {
+            const uint32_t region = static_cast<uint32_t>(index);
+            job.pairs.erase(
+                std::remove_if(job.pairs.begin(), job.pairs.end(),
+                    [this, region](const BroadPhasePair& pair) {
+                        return region_grid_.getRegion(pair.index1) != region &&
+                               region_grid_.getRegion(pair.index2) != region;
+                    }),
+                job.pairs.end());
+            owned = region_grid_.getInteriorCount(index);
+        }
+        for (size_t i = 0; i < owned; ++i) {
+            findStillPairs(job.proxies[i], job.pairs);
+        }
+        finishPairs(job.pairs);
+    });
+    
+    stats_.regions = regions;
+    stats_.broad_phase_pairs = 0;
+    for (size_t index = 0; index <= regions; ++index) {
+        stats_.broad_phase_pairs += region_jobs_[index]->pairs.size();
+    }
 }
 
 void PhysicsWorld::narrowPhaseCollision() {
     auto start = std::chrono::high_resolution_clock::now();
     
     clearContacts();
+    stats_.warm_started_contacts = 0;
     
-    // Generate collision manifolds for each broad-phase pair
-    for (const auto& pair : broad_phase_pairs_) {
-        auto& bodyA = bodies_[pair.index1];
-        auto& bodyB = bodies_[pair.index2];
-        
-        // Generate collision manifold
-        auto manifold = CollisionDetection::generateManifold(
-            bodyA->getCollisionShape(), bodyA->getPosition(),
-            bodyB->getCollisionShape(), bodyB->getPosition()
-        );
-        
-        if (manifold.hasCollision) {
-            Contact contact;
-            contact.body1 = bodyA.get();
-            contact.body2 = bodyB.get();
-            contact.manifold = manifold;
-            
-            // Initialize contact constraint data
-            float totalInverseMass = bodyA->getInverseMass() + bodyB->getInverseMass();
-            contact.normal_mass = (totalInverseMass > 0.0f) ? 1.0f / totalInverseMass : 0.0f;
-            
-            // Calculate effective friction mass (simplified - no rotation for now)
-            contact.tangent_mass = contact.normal_mass;
-            
-            // Calculate bias for position correction (Baumgarte stabilization)
-            const float BIAS_FACTOR = 0.2f;
-            const float BIAS_THRESHOLD = 0.01f;
-            contact.bias = std::max(0.0f, BIAS_FACTOR * (manifold.penetration - BIAS_THRESHOLD) / FIXED_TIME_STEP);
-            
-            // Reset accumulated impulses (will be warmed started if contact persists)
-            contact.normal_impulse = 0.0f;
-            contact.tangent_impulse = 0.0f;
-            
+    // Pairs and cache are both sorted by key, so one forward cursor finds
+    // each pair's cached impulses
+    size_t cached = 0;
+    
+    if (config_.region_size > 0.0f) {
+        regionNarrowPhase();
+    } else {
+        // Manifolds for all pairs at once, then contacts in pair order
+        narrow_phase_.collide(broad_phase_pairs_, body_store_);
+        for (uint32_t hit : narrow_phase_.getHits()) {
+            Contact contact = createContact(broad_phase_pairs_[hit], narrow_phase_.getManifold(hit));
+            while (cached < contact_cache_.size() && contact_cache_[cached].pair_key < contact.pair_key) {
+                ++cached;
+            }
+            if (cached < contact_cache_.size() && seedFromCache(contact, contact_cache_[cached])) {
+                stats_.warm_started_contacts++;
+            }
             contacts_.push_back(contact);
         }
     }
@@ -188,34 +491,281 @@ void PhysicsWorld::narrowPhaseCollision() {
     stats_.contacts = contacts_.size();
 }
 
+void PhysicsWorld::regionNarrowPhase() {
+    const size_t jobs = region_grid_.getRegionCount() + 1;
+    runJobs(jobs, thread_pool_, [this](size_t index) {
+        RegionJob& job = *region_jobs_[index];
+        job.contacts.clear();
+        job.warm_started = 0;
+        job.narrow_phase.collide(job.pairs, body_store_);
+        for (uint32_t hit : job.narrow_phase.getHits()) {
+            Contact contact = createContact(job.pairs[hit], job.narrow_phase.getManifold(hit));
+            // The region's pairs are scattered over the cache, so search it
+            auto cached = std::lower_bound(contact_cache_.begin(), contact_cache_.end(), contact.pair_key,
+                [](const CachedImpulse& entry, uint64_t key) { return entry.pair_key < key; });
+            if (cached != contact_cache_.end() && seedFromCache(contact, *cached)) {
+                job.warm_started++;
+            }
+            job.contacts.push_back(contact);
+        }
+    });
+    
+    // Contacts go in job order, each job's run sorted by pair key
+    region_contact_offsets_.assign(jobs + 1, 0);
+    for (size_t index = 0; index < jobs; ++index) {
+        const RegionJob& job = *region_jobs_[index];
+        region_contact_offsets_[index + 1] = region_contact_offsets_[index] + static_cast<uint32_t>(job.contacts.size());
+        stats_.warm_started_contacts += job.warm_started;
+    }
+    contacts_.resize(region_contact_offsets_.back());
+    runJobs(jobs, thread_pool_, [this](size_t index) {
+        const RegionJob& job = *region_jobs_[index];
+        std::copy(job.contacts.begin(), job.contacts.end(), contacts_.begin() + region_contact_offsets_[index]);
+    });
+}
+
+Contact PhysicsWorld::createContact(const BroadPhasePair& pair,
+                                    const CollisionDetection::CollisionManifold& manifold) const {
+    const auto& bodyA = bodies_[pair.index1];
+    const auto& bodyB = bodies_[pair.index2];
+    
+    Contact contact;
+    contact.body1 = bodyA.get();
+    contact.body2 = bodyB.get();
+    contact.manifold = manifold;
+    contact.pair_key = pair.key();
+    contact.separation = bodyB->getPosition() - bodyA->getPosition();
+    
+    // Initialize contact constraint data
+    float totalInverseMass = bodyA->getInverseMass() + bodyB->getInverseMass();
+    contact.normal_mass = (totalInverseMass > 0.0f) ? 1.0f / totalInverseMass : 0.0f;
+    
+    // Calculate effective friction mass (simplified - no rotation for now)
+    contact.tangent_mass = contact.normal_mass;
+    
+    // Restitution target from the approach speed before solving. Slow
+    // contacts get none, so resting bodies do not bounce; penetration
+    // is left to solvePositionConstraints() so warm-started impulses
+    // carry no position error
+    const float RESTITUTION_THRESHOLD = 1.0f;
+    float restitution = std::min(bodyA->getMaterial().restitution, bodyB->getMaterial().restitution);
+    float approachVelocity = (bodyB->getLinearVelocity() - bodyA->getLinearVelocity()).dot(manifold.normal);
+    contact.bias = approachVelocity < -RESTITUTION_THRESHOLD ? -restitution * approachVelocity : 0.0f;
+    return contact;
+}
+
+bool PhysicsWorld::seedFromCache(Contact& contact, const CachedImpulse& cached) const {
+    // Warm start from the cache if the same feature was touching last step
+    if (!config_.enable_warm_starting || cached.pair_key != contact.pair_key ||
+        cached.feature_id != contact.manifold.featureId) {
+        return false;
+    }
+    contact.normal_impulse = cached.normal_impulse;
+    contact.tangent_impulse = cached.tangent_impulse;
+    return true;
+}
+
+void PhysicsWorld::buildIslands() {
+    // Sleeping bodies touched by awake ones wake up, with everything resting on them
+    contact_body1_.resize(contacts_.size());
+    contact_body2_.resize(contacts_.size());
+    for (size_t i = 0; i < contacts_.size(); ++i) {
+        const BroadPhasePair pair = BroadPhasePair::fromKey(contacts_[i].pair_key);
+        const bool dynamic1 = bodies_[pair.index1]->isDynamic();
+        const bool dynamic2 = bodies_[pair.index2]->isDynamic();
+        contact_body1_[i] = dynamic1 ? pair.index1 : IslandBuilder::kNoBody;
+        contact_body2_[i] = dynamic2 ? pair.index2 : IslandBuilder::kNoBody;
+        if (dynamic1 && !bodies_[pair.index1]->isAwake()) wakeBody(pair.index1);
+        if (dynamic2 && !bodies_[pair.index2]->isAwake()) wakeBody(pair.index2);
+    }
+    
+    island_builder_.reset(bodies_.size());
+    const uint32_t* flags = body_store_.flags();
+    constexpr uint32_t required = BodyStore::kFlagDynamic | BodyStore::kFlagAwake | BodyStore::kFlagActive;
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        if ((flags[i] & required) == required) {
+            island_builder_.addBody(static_cast<uint32_t>(i));
+        }
+    }
+    for (size_t i = 0; i < contacts_.size(); ++i) {
+        island_builder_.addContact(static_cast<uint32_t>(i), contact_body1_[i], contact_body2_[i]);
+    }
+    island_builder_.finish();
+    stats_.islands = island_builder_.getIslandCount();
+}
+
 void PhysicsWorld::solveConstraints(float) {
     auto start = std::chrono::high_resolution_clock::now();
     
-    // Warm start contacts
-    warmStartContacts();
+    if (config_.region_size > 0.0f) {
+        solveRegions();
+        updateContactCache();
+        auto end = std::chrono::high_resolution_clock::now();
+        stats_.solve_time = std::chrono::duration<float>(end - start).count();
+        return;
+    }
+    stats_.boundary_contacts = 0;
     
-    // Solve velocity constraints
-    for (int i = 0; i < config_.velocity_iterations; ++i) {
-        solveVelocityConstraints();
+    // Small islands are solved whole, many at a time; large ones one at a
+    // time with each color of contacts spread over the pool
+    small_islands_.clear();
+    large_islands_.clear();
+    for (size_t i = 0; i < island_builder_.getIslandCount(); ++i) {
+        const size_t contacts = island_builder_.getIslandContacts(i).size();
+        if (contacts >= kColoredIslandContacts) {
+            large_islands_.push_back(static_cast<uint32_t>(i));
+        } else if (contacts > 0) {
+            small_islands_.push_back(static_cast<uint32_t>(i));
+        }
     }
     
-    // Solve position constraints
-    for (int i = 0; i < config_.position_iterations; ++i) {
-        solvePositionConstraints();
+    if (thread_pool_ && small_islands_.size() > 1) {
+        Threading::parallel_for(0, small_islands_.size(), [this](size_t i) {
+            solveIsland(island_builder_.getIslandContacts(small_islands_[i]));
+        }, thread_pool_);
+    } else {
+        for (uint32_t island : small_islands_) {
+            solveIsland(island_builder_.getIslandContacts(island));
+        }
+    }
+    for (uint32_t island : large_islands_) {
+        solveColoredIsland(island_builder_.getIslandContacts(island));
     }
     
+    updateContactCache();
+    
     auto end = std::chrono::high_resolution_clock::now();
     stats_.solve_time = std::chrono::duration<float>(end - start).count();
 }
 
-void PhysicsWorld::updateSleepingBodies(float) {
-    // Sleep state updates are handled by each RigidBody during integration
-    // This method ensures that bodies wake up when they should
-    for (auto& body : bodies_) {
-        if (body->getBodyType() == BodyType::Dynamic) {
-            // Bodies are woken up during collision resolution
-            // Additional sleep logic could go here if needed
+void PhysicsWorld::solveRegions() {
+    region_grid_.assignContacts(contact_body1_.data(), contact_body2_.data(), contacts_.size());
+    stats_.boundary_contacts = region_grid_.getBoundaryContacts().size();
+    
+    // Regions share no moving body, so they are solved concurrently; the
+    // contacts across their borders follow on this thread in every pass
+    auto forEachRegion = [this](auto&& solve) {
+        runJobs(region_grid_.getRegionCount(), thread_pool_, [&](size_t region) {
+            solve(region_grid_.getRegionContacts(region));
+        });
+        solve(region_grid_.getBoundaryContacts());
+    };
+    
+    forEachRegion([this](std::span<const uint32_t> batch) { warmStartContacts(batch); });
+    for (int i = 0; i < config_.velocity_iterations; ++i) {
+        forEachRegion([this](std::span<const uint32_t> batch) { solveVelocityConstraints(batch); });
+    }
+    for (int i = 0; i < config_.position_iterations; ++i) {
+        forEachRegion([this](std::span<const uint32_t> batch) { solvePositionConstraints(batch); });
+    }
+}
+
+void PhysicsWorld::solveIsland(std::span<const uint32_t> contacts) {
+    warmStartContacts(contacts);
+    for (int i = 0; i < config_.velocity_iterations; ++i) {
+        solveVelocityConstraints(contacts);
+    }
+    for (int i = 0; i < config_.position_iterations; ++i) {
+        solvePositionConstraints(contacts);
+    }
+}
+
+void PhysicsWorld::solveColoredIsland(std::span<const uint32_t> contacts) {
+    contact_coloring_.build(contacts, contact_body1_.data(), contact_body2_.data(), bodies_.size());
+    
+    // Contacts of one color touch disjoint bodies, so the order they are
+    // solved in does not matter and chunks of a color can run concurrently
+    static constexpr size_t kChunk = 64;
+    auto forEachColor = [this](auto&& solve) {
+        for (size_t color = 0; color < contact_coloring_.getColorCount(); ++color) {
+            const std::span<const uint32_t> batch = contact_coloring_.getColor(color);
+            if (thread_pool_ && batch.size() > kChunk) {
+                Threading::parallel_for(0, (batch.size() + kChunk - 1) / kChunk, [&](size_t chunk) {
+                    solve(batch.subspan(chunk * kChunk, std::min(kChunk, batch.size() - chunk * kChunk)));
+                }, thread_pool_);
+            } else {
+                solve(batch);
+            }
+        }
+        solve(contact_coloring_.getOverflow());
+    };
+    
+    forEachColor([this](std::span<const uint32_t> batch) { warmStartContacts(batch); });
+    for (int i = 0; i < config_.velocity_iterations; ++i) {
+        forEachColor([this](std::span<const uint32_t> batch) { solveVelocityConstraints(batch); });
+    }
+    for (int i = 0; i < config_.position_iterations; ++i) {
+        forEachColor([this](std::span<const uint32_t> batch) { solvePositionConstraints(batch); });
+    }
+}
+
+void PhysicsWorld::updateSleepingBodies(float deltaTime) {
+    if (!config_.enable_sleeping) return;
+    
+    // An island sleeps once its restless body has been at rest long enough
+    float* vx = body_store_.data(BodyField::VelocityX);
+    float* vy = body_store_.data(BodyField::VelocityY);
+    float* w = body_store_.data(BodyField::AngularVelocity);
+    float* sleep = body_store_.data(BodyField::SleepTime);
+    
+    for (size_t island = 0; island < island_builder_.getIslandCount(); ++island) {
+        const std::span<const uint32_t> members = island_builder_.getIslandBodies(island);
+        float min_sleep = std::numeric_limits<float>::max();
+        for (uint32_t i : members) {
+            const bool resting = vx[i] * vx[i] + vy[i] * vy[i] < BodyStore::kSleepLinearThreshold &&
+                                 w[i] * w[i] < BodyStore::kSleepAngularThreshold;
+            sleep[i] = resting ? sleep[i] + deltaTime : 0.0f;
+            min_sleep = std::min(min_sleep, sleep[i]);
+        }
+        
+        if (min_sleep < config_.sleep_threshold) continue;
+        
+        for (uint32_t i : members) {
+            RigidBody& body = *bodies_[i];
+            body.setFlag(BodyStore::kFlagAwake, false);
+            vx[i] = 0.0f;
+            vy[i] = 0.0f;
+            w[i] = 0.0f;
+            // The broad phase finds sleeping bodies through the query tree
+            query_tree_.moveProxy(query_proxies_[i], toBounds2D(body.getWorldBounds()));
+        }
+    }
+}
+
+void PhysicsWorld::wakeBody(uint32_t index) {
+    wake_stack_.clear();
+    wake_stack_.push_back(index);
+    bodies_[index]->setAwake(true);
+    
+    while (!wake_stack_.empty()) {
+        const uint32_t current = wake_stack_.back();
+        wake_stack_.pop_back();
+        const Bounds2D bounds = toBounds2D(bodies_[current]->getWorldBounds());
+        query_tree_.query(bounds, [&](int32_t node) {
+            const uint32_t other = query_tree_.getUserData(node);
+            RigidBody& body = *bodies_[other];
+            if (body.isDynamic() && !body.isAwake() && toBounds2D(body.getWorldBounds()).overlaps(bounds)) {
+                body.setAwake(true);
+                wake_stack_.push_back(other);
+            }
+            return true;
+        });
+    }
+}
+
+void PhysicsWorld::wakeBodiesTouching(const AABB<float>& bounds) {
+    const Bounds2D query = toBounds2D(bounds);
+    std::vector<uint32_t> touching;
+    query_tree_.query(query, [&](int32_t node) {
+        const uint32_t other = query_tree_.getUserData(node);
+        const RigidBody& body = *bodies_[other];
+        if (body.isDynamic() && !body.isAwake() && toBounds2D(body.getWorldBounds()).overlaps(query)) {
+            touching.push_back(other);
         }
+        return true;
+    });
+    for (uint32_t index : touching) {
+        if (!bodies_[index]->isAwake()) wakeBody(index);
     }
 }
 
@@ -223,44 +773,93 @@ void PhysicsWorld::updateSleepingBodies(float) {
 std::vector<RigidBody*> PhysicsWorld::queryAABB(const AABB<float>& bounds) const {
     std::vector<RigidBody*> results;
     
-    for (const auto& body : bodies_) {
+    query_tree_.query(toBounds2D(bounds), [&](int32_t proxy) {
+        const auto& body = bodies_[query_tree_.getUserData(proxy)];
         if (body->getWorldBounds().intersects(bounds)) {
             results.push_back(body.get());
         }
-    }
+        return true;
+    });
     
     return results;
 }
 
+void PhysicsWorld::queryAABB(const AABB<float>& bounds, std::pmr::vector<RigidBody*>& results) const {
+    results.clear();
+    
+    query_tree_.query(toBounds2D(bounds), [&](int32_t proxy) {
+        const auto& body = bodies_[query_tree_.getUserData(proxy)];
+        if (body->getWorldBounds().intersects(bounds)) {
+            results.push_back(body.get());
+        }
+        return true;
+    });
+}
+
 std::vector<RigidBody*> PhysicsWorld::queryPoint(const Vector2<float>& point) const {
-    std::vector<RigidBody*> results;
+    std::pmr::vector<RigidBody*> results;
+    queryPoint(point, results);
+    return std::vector<RigidBody*>(results.begin(), results.end());
+}
+
+void PhysicsWorld::queryPoint(const Vector2<float>& point, std::pmr::vector<RigidBody*>& results) const {
+    results.clear();
     
-    for (const auto& body : bodies_) {
-        auto bounds = body->getWorldBounds();
-        SIMD::Vector<float, 3> point3d(point.x, point.y, 0.0f);
-        
-        if (bounds.contains(point3d)) {
+    const SIMD::Vector<float, 3> point3d(point.x, point.y, 0.0f);
+    query_tree_.query(Bounds2D{point.x, point.y, point.x, point.y}, [&](int32_t proxy) {
+        const auto& body = bodies_[query_tree_.getUserData(proxy)];
+        if (body->getWorldBounds().contains(point3d)) {
             // Additional precise point-in-shape test could go here
             results.push_back(body.get());
         }
-    }
-    
-    return results;
+        return true;
+    });
 }
 
 std::vector<RigidBody*> PhysicsWorld::queryShape(const CollisionShape& shape, const Vector2<float>& position) const {
-    std::vector<RigidBody*> results;
+    std::pmr::vector<RigidBody*> results;
+    queryShape(shape, position, results);
+    return std::vector<RigidBody*>(results.begin(), results.end());
+}
+
+void PhysicsWorld::queryShape(const CollisionShape& shape, const Vector2<float>& position,
+                              std::pmr::vector<RigidBody*>& results) const {
+    results.clear();
     
-    for (const auto& body : bodies_) {
+    query_tree_.query(toBounds2D(shape.getBounds(position)), [&](int32_t proxy) {
+        const auto& body = bodies_[query_tree_.getUserData(proxy)];
         if (body->getCollisionShape().intersects(shape, body->getPosition(), position)) {
             results.push_back(body.get());
         }
-    }
+        return true;
+    });
+}
+
+namespace {
+
+PhysicsWorld::RaycastHit makeRaycastHit(RigidBody* body, const Vector2<float>& start,
+                                        const Vector2<float>& direction, float t) {
+    PhysicsWorld::RaycastHit hit;
+    hit.hasHit = true;
+    hit.distance = t;
+    hit.point = start + direction * t;
+    hit.body = body;
     
-    return results;
+    // Simple normal calculation (can be improved)
+    Vector2<float> center = body->getPosition();
+    Vector2<float> toHit = hit.point - center;
+    float len = toHit.length();
+    hit.normal = safeDivide(toHit, len);
+    if (hit.normal.lengthSquared() < 1e-12f) {
+        hit.normal = Vector2<float>(1.0f, 0.0f);
+    }
+    return hit;
 }
 
-PhysicsWorld::RaycastHit PhysicsWorld::raycast(const Vector2<float>& start, const Vector2<float>& end) const {
+} // anonymous namespace
+
+PhysicsWorld::RaycastHit PhysicsWorld::castRay(const Vector2<float>& start, const Vector2<float>& end,
+                                               bool any_hit) const {
     RaycastHit result;
     result.hasHit = false;
     
@@ -271,91 +870,120 @@ PhysicsWorld::RaycastHit PhysicsWorld::raycast(const Vector2<float>& start, cons
         return result; // Invalid ray
     }
     
-    // Normalize direction
+    // Normalize direction so tree t values are distances
     direction = direction / maxDistance;
     result.distance = maxDistance;
     
-    // Simple raycast against all body AABBs
-    for (const auto& body : bodies_) {
-        auto bounds = body->getWorldBounds();
-        
-        // Create 3D ray for SIMD operations
-        SIMD::Ray<float> ray(
-            SIMD::Vector<float, 3>(start.x, start.y, 0.0f),
-            SIMD::Vector<float, 3>(direction.x, direction.y, 0.0f)
-        );
-        
+    // Create 3D ray for SIMD operations
+    const SIMD::Ray<float> ray(
+        SIMD::Vector<float, 3>(start.x, start.y, 0.0f),
+        SIMD::Vector<float, 3>(direction.x, direction.y, 0.0f)
+    );
+    
+    // Each hit clips the ray, so the tree skips subtrees beyond it
+    query_tree_.raycast(start, direction, maxDistance, [&](int32_t proxy, float max_t) {
+        RigidBody* body = bodies_[query_tree_.getUserData(proxy)].get();
         float t;
-        if (ray.intersects(bounds, t) && t <= result.distance && t >= 0.0f) {
-            result.hasHit = true;
-            result.distance = t;
-            result.point = start + direction * t;
-            result.body = body.get();
-            
-            // Simple normal calculation (can be improved)
-            Vector2<float> center = body->getPosition();
-            Vector2<float> toHit = result.point - center;
-            float len = toHit.length();
-            result.normal = safeDivide(toHit, len);
-            if (result.normal.lengthSquared() < 1e-12f) {
-                result.normal = Vector2<float>(1.0f, 0.0f);
-            }
+        if (ray.intersects(body->getWorldBounds(), t) && t <= max_t && t >= 0.0f) {
+            result = makeRaycastHit(body, start, direction, t);
+            return any_hit ? 0.0f : t;
         }
-    }
+        return max_t;
+    });
     
     return result;
 }
 
+PhysicsWorld::RaycastHit PhysicsWorld::raycast(const Vector2<float>& start, const Vector2<float>& end) const {
+    return castRay(start, end, false);
+}
+
 std::vector<PhysicsWorld::RaycastHit> PhysicsWorld::raycastAll(const Vector2<float>& start, const Vector2<float>& end) const {
-    std::vector<RaycastHit> results;
+    std::pmr::vector<RaycastHit> results;
+    raycastAll(start, end, results);
+    return std::vector<RaycastHit>(results.begin(), results.end());
+}
+
+void PhysicsWorld::raycastAll(const Vector2<float>& start, const Vector2<float>& end,
+                              std::pmr::vector<RaycastHit>& results) const {
+    results.clear();
     
     Vector2<float> direction = end - start;
     float maxDistance = direction.length();
     
     if (maxDistance < 0.0001f) {
-        return results; // Invalid ray
+        return; // Invalid ray
     }
     
     direction = safeDivide(direction, maxDistance);
     
-    // Raycast against all bodies
-    for (const auto& body : bodies_) {
-        auto bounds = body->getWorldBounds();
-        
-        // Create 3D ray for SIMD operations
-        SIMD::Ray<float> ray(
-            SIMD::Vector<float, 3>(start.x, start.y, 0.0f),
-            SIMD::Vector<float, 3>(direction.x, direction.y, 0.0f)
-        );
-        
+    const SIMD::Ray<float> ray(
+        SIMD::Vector<float, 3>(start.x, start.y, 0.0f),
+        SIMD::Vector<float, 3>(direction.x, direction.y, 0.0f)
+    );
+    
+    // Never clip: every body along the segment is reported
+    query_tree_.raycast(start, direction, maxDistance, [&](int32_t proxy, float max_t) {
+        RigidBody* body = bodies_[query_tree_.getUserData(proxy)].get();
         float t;
-        if (ray.intersects(bounds, t) && t <= maxDistance && t >= 0.0f) {
-            RaycastHit hit;
-            hit.hasHit = true;
-            hit.distance = t;
-            hit.point = start + direction * t;
-            hit.body = body.get();
-            
-            // Simple normal calculation
-            Vector2<float> center = body->getPosition();
-            Vector2<float> toHit = hit.point - center;
-            float len = toHit.length();
-            hit.normal = safeDivide(toHit, len);
-            if (hit.normal.lengthSquared() < 1e-12f) {
-                hit.normal = Vector2<float>(1.0f, 0.0f);
-            }
-            
-            results.push_back(hit);
+        if (ray.intersects(body->getWorldBounds(), t) && t <= maxDistance && t >= 0.0f) {
+            results.push_back(makeRaycastHit(body, start, direction, t));
         }
-    }
+        return max_t;
+    });
     
     // Sort by distance
     std::sort(results.begin(), results.end(),
         [](const RaycastHit& a, const RaycastHit& b) {
             return a.distance < b.distance;
         });
+}
+
+void PhysicsWorld::raycastBatch(std::span<const RaySegment> rays, std::span<RaycastHit> hits) const {
+    if (hits.size() < rays.size()) {
+        throw std::invalid_argument("PhysicsWorld::raycastBatch: hit buffer smaller than ray count");
+    }
+    for (size_t i = 0; i < rays.size(); ++i) {
+        hits[i] = castRay(rays[i].start, rays[i].end, false);
+    }
+}
+
+void PhysicsWorld::raycastAnyBatch(std::span<const RaySegment> rays, std::span<RaycastHit> hits) const {
+    if (hits.size() < rays.size()) {
+        throw std::invalid_argument("PhysicsWorld::raycastAnyBatch: hit buffer smaller than ray count");
+    }
+    for (size_t i = 0; i < rays.size(); ++i) {
+        hits[i] = castRay(rays[i].start, rays[i].end, true);
+    }
+}
+
+void PhysicsWorld::bakeStaticGeometry() {
+    static_geometry_.build(bodies_);
+}
+
+void PhysicsWorld::moveCharacters(const CharacterConfig& config, std::span<const CharacterMove> moves,
+                                  std::span<CharacterResult> results) {
+    if (results.size() < moves.size()) {
+        throw std::invalid_argument("PhysicsWorld::moveCharacters: result buffer smaller than move count");
+    }
+    if (!(config.radius > 0.0f) || !(config.height >= 2.0f * config.radius)) {
+        throw std::invalid_argument("PhysicsWorld::moveCharacters: character needs a positive radius and a height of at least two radii");
+    }
     
-    return results;
+    const size_t batches = (moves.size() + kCharacterBatch - 1) / kCharacterBatch;
+    const size_t slots = (thread_pool_ ? thread_pool_->size() : 0) + 1;
+    if (character_candidates_.size() < slots) {
+        character_candidates_.resize(slots);
+    }
+    runJobs(batches, thread_pool_, [&](size_t batch) {
+        // A thread runs one batch at a time, so its slot is never shared
+        const int worker = thread_pool_ ? thread_pool_->current_worker_index() : -1;
+        std::vector<uint32_t>& candidates = character_candidates_[static_cast<size_t>(worker + 1)];
+        const size_t end = std::min(moves.size(), (batch + 1) * kCharacterBatch);
+        for (size_t i = batch * kCharacterBatch; i < end; ++i) {
+            results[i] = static_geometry_.moveCharacter(config, moves[i], candidates);
+        }
+    });
 }
 
 // Private implementation methods
@@ -367,9 +995,10 @@ void PhysicsWorld::performNarrowPhase() {
     narrowPhaseCollision();
 }
 
-void PhysicsWorld::warmStartContacts() {
+void PhysicsWorld::warmStartContacts(std::span<const uint32_t> contacts) {
     // Apply cached impulses from previous frame for better stability
-    for (auto& contact : contacts_) {
+    for (uint32_t index : contacts) {
+        Contact& contact = contacts_[index];
         if (!contact.isValid()) continue;
         
         RigidBody* bodyA = contact.body1;
@@ -396,9 +1025,34 @@ void PhysicsWorld::warmStartContacts() {
     }
 }
 
-void PhysicsWorld::solveVelocityConstraints() {
+void PhysicsWorld::updateContactCache() {
+    // Without regions contacts_ follows the sorted pair order, so the cache comes out sorted
+    contact_cache_.clear();
+    contact_cache_.reserve(contacts_.size());
+    for (const auto& contact : contacts_) {
+        contact_cache_.push_back({contact.pair_key, contact.manifold.featureId,
+                                  contact.normal_impulse, contact.tangent_impulse});
+    }
+    
+    // Region contacts are sorted within each job's run; merge the runs
+    if (config_.region_size > 0.0f) {
+        auto byKey = [](const CachedImpulse& a, const CachedImpulse& b) { return a.pair_key < b.pair_key; };
+        const auto& offsets = region_contact_offsets_;
+        const size_t runs = offsets.size() - 1;
+        for (size_t width = 1; width < runs; width *= 2) {
+            for (size_t run = 0; run + width < runs; run += 2 * width) {
+                std::inplace_merge(contact_cache_.begin() + offsets[run],
+                                   contact_cache_.begin() + offsets[run + width],
+                                   contact_cache_.begin() + offsets[std::min(run + 2 * width, runs)], byKey);
+            }
+        }
+    }
+}
+
+void PhysicsWorld::solveVelocityConstraints(std::span<const uint32_t> contacts) {
     // Iterative impulse-based constraint solving
-    for (auto& contact : contacts_) {
+    for (uint32_t index : contacts) {
+        Contact& contact = contacts_[index];
         if (!contact.isValid()) continue;
         
         RigidBody* bodyA = contact.body1;
@@ -409,8 +1063,7 @@ void PhysicsWorld::solveVelocityConstraints() {
         float contactVelocity = relativeVelocity.dot(contact.manifold.normal);
         
         // Calculate desired velocity change
-        float restitution = std::min(bodyA->getMaterial().restitution, bodyB->getMaterial().restitution);
-        float desiredDeltaVelocity = -contactVelocity * (1.0f + restitution) + contact.bias;
+        float desiredDeltaVelocity = contact.bias - contactVelocity;
         
         // Calculate impulse magnitude
         float deltaImpulse = desiredDeltaVelocity * contact.normal_mass;
@@ -424,11 +1077,9 @@ void PhysicsWorld::solveVelocityConstraints() {
         Vector2<float> impulse = contact.manifold.normal * deltaImpulse;
         if (bodyA->isDynamic()) {
             bodyA->setLinearVelocity(bodyA->getLinearVelocity() - impulse * bodyA->getInverseMass());
-            bodyA->setAwake(true);
         }
         if (bodyB->isDynamic()) {
             bodyB->setLinearVelocity(bodyB->getLinearVelocity() + impulse * bodyB->getInverseMass());
-            bodyB->setAwake(true);
         }
         
         // Friction constraint
@@ -455,27 +1106,32 @@ void PhysicsWorld::solveVelocityConstraints() {
     }
 }
 
-void PhysicsWorld::solvePositionConstraints() {
+void PhysicsWorld::solvePositionConstraints(std::span<const uint32_t> contacts) {
     // Position-based constraint solving to prevent sinking
     const float POSITION_CORRECTION_PERCENT = 0.4f;
     const float POSITION_CORRECTION_THRESHOLD = 0.01f;
     
-    for (auto& contact : contacts_) {
+    for (uint32_t index : contacts) {
+        Contact& contact = contacts_[index];
         if (!contact.isValid()) continue;
         
-        // Only correct if penetration is significant
-        if (contact.manifold.penetration <= POSITION_CORRECTION_THRESHOLD) {
-            continue;
-        }
-        
         RigidBody* bodyA = contact.body1;
         RigidBody* bodyB = contact.body2;
         
+        // Penetration left after earlier corrections this step. Leave the
+        // threshold unresolved so resting contacts stay in contact and keep
+        // their cached impulses instead of separating every other step.
+        Vector2<float> moved = (bodyB->getPosition() - bodyA->getPosition()) - contact.separation;
+        float penetration = contact.manifold.penetration - moved.dot(contact.manifold.normal);
+        if (penetration <= POSITION_CORRECTION_THRESHOLD) {
+            continue;
+        }
+        
         // Calculate mass-weighted correction
         float totalInverseMass = bodyA->getInverseMass() + bodyB->getInverseMass();
         if (totalInverseMass <= 0.0001f) continue; // Both bodies are static or nearly infinite mass
         
-        float correctionMagnitude = totalInverseMass > 0.0001f ? (contact.manifold.penetration * POSITION_CORRECTION_PERCENT) / totalInverseMass : 0.0f;
+        float correctionMagnitude = (penetration - POSITION_CORRECTION_THRESHOLD) * POSITION_CORRECTION_PERCENT / totalInverseMass;
         Vector2<float> correction = contact.manifold.normal * correctionMagnitude;
         
         // Apply position correction
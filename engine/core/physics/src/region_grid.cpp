@@ -0,0 +1,135 @@
+#include "physics/region_grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace PyNovaGE {
+namespace Physics {
+
+void RegionGrid::build(std::span<const BroadPhaseProxy> proxies, float region_size, size_t body_count) {
+    if (!(region_size > 0.0f)) {
+        throw std::invalid_argument("RegionGrid::build: region size must be positive");
+    }
+    region_of_body_.assign(body_count, kBoundary);
+    interior_counts_.clear();
+    proxy_offsets_.clear();
+    proxies_.clear();
+    boundary_.clear();
+    if (proxies.empty()) return;
+
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    for (const auto& proxy : proxies) {
+        min_x = std::min(min_x, proxy.min_x);
+        min_y = std::min(min_y, proxy.min_y);
+        max_x = std::max(max_x, proxy.max_x);
+        max_y = std::max(max_y, proxy.max_y);
+    }
+
+    // Cells are a monotonic function of the coordinate, so two proxies that
+    // overlap can never sit in two different single cells
+    const float inverse = 1.0f / region_size;
+    auto cellsAlong = [inverse](float extent) {
+        const float cells = std::ceil(extent * inverse);
+        return static_cast<int32_t>(std::clamp(cells, 1.0f, static_cast<float>(kMaxRegionsPerAxis)));
+    };
+    const int32_t columns = cellsAlong(max_x - min_x);
+    const int32_t rows = cellsAlong(max_y - min_y);
+    auto cellOf = [inverse](float value, float origin, int32_t count) {
+        const float cell = std::floor((value - origin) * inverse);
+        return static_cast<int32_t>(std::clamp(cell, 0.0f, static_cast<float>(count - 1)));
+    };
+    struct CellRange {
+        int32_t x0, y0, x1, y1;
+    };
+    auto rangeOf = [&](const BroadPhaseProxy& proxy) {
+        return CellRange{cellOf(proxy.min_x, min_x, columns), cellOf(proxy.min_y, min_y, rows),
+                         cellOf(proxy.max_x, min_x, columns), cellOf(proxy.max_y, min_y, rows)};
+    };
+
+    // Count interior proxies and guests per region
+    const size_t region_count = static_cast<size_t>(columns) * static_cast<size_t>(rows);
+    interior_counts_.assign(region_count, 0);
+    proxy_offsets_.assign(region_count + 1, 0);
+    for (uint32_t i = 0; i < proxies.size(); ++i) {
+        const CellRange range = rangeOf(proxies[i]);
+        if (range.x0 == range.x1 && range.y0 == range.y1) {
+            const size_t region = static_cast<size_t>(range.y0 * columns + range.x0);
+            interior_counts_[region]++;
+            proxy_offsets_[region + 1]++;
+            continue;
+        }
+        boundary_.push_back(i);
+        for (int32_t y = range.y0; y <= range.y1; ++y) {
+            for (int32_t x = range.x0; x <= range.x1; ++x) {
+                proxy_offsets_[static_cast<size_t>(y * columns + x) + 1]++;
+            }
+        }
+    }
+    for (size_t region = 0; region < region_count; ++region) {
+        proxy_offsets_[region + 1] += proxy_offsets_[region];
+    }
+
+    // Fill in proxy order: interior proxies, then guests behind them
+    proxies_.resize(proxy_offsets_.back());
+    cursors_.resize(2 * region_count);
+    uint32_t* interior_cursor = cursors_.data();
+    uint32_t* guest_cursor = cursors_.data() + region_count;
+    for (size_t region = 0; region < region_count; ++region) {
+        interior_cursor[region] = proxy_offsets_[region];
+        guest_cursor[region] = proxy_offsets_[region] + interior_counts_[region];
+    }
+    for (uint32_t i = 0; i < proxies.size(); ++i) {
+        const CellRange range = rangeOf(proxies[i]);
+        if (range.x0 == range.x1 && range.y0 == range.y1) {
+            const uint32_t region = static_cast<uint32_t>(range.y0 * columns + range.x0);
+            proxies_[interior_cursor[region]++] = i;
+            region_of_body_[proxies[i].body_index] = region;
+            continue;
+        }
+        for (int32_t y = range.y0; y <= range.y1; ++y) {
+            for (int32_t x = range.x0; x <= range.x1; ++x) {
+                proxies_[guest_cursor[static_cast<size_t>(y * columns + x)]++] = i;
+            }
+        }
+    }
+}
+
+void RegionGrid::assignContacts(const uint32_t* body1, const uint32_t* body2, size_t contact_count) {
+    // Counting sort with the boundary as one more bucket after the regions
+    const uint32_t boundary = static_cast<uint32_t>(getRegionCount());
+    auto regionOf = [this](uint32_t body) {
+        return body == kNoBody ? kNoBody : region_of_body_[body];
+    };
+
+    contact_region_.resize(contact_count);
+    contact_offsets_.assign(static_cast<size_t>(boundary) + 2, 0);
+    for (size_t i = 0; i < contact_count; ++i) {
+        const uint32_t region1 = regionOf(body1[i]);
+        const uint32_t region2 = regionOf(body2[i]);
+        // A contact with one moving body belongs to that body's region
+        uint32_t region = body1[i] == kNoBody ? region2 : region1;
+        if (body1[i] != kNoBody && body2[i] != kNoBody && region1 != region2) {
+            region = kBoundary;
+        }
+        region = region == kBoundary ? boundary : region;
+        contact_region_[i] = region;
+        contact_offsets_[region + 1]++;
+    }
+    for (size_t region = 0; region <= boundary; ++region) {
+        contact_offsets_[region + 1] += contact_offsets_[region];
+    }
+
+    contacts_.resize(contact_count);
+    cursors_.assign(contact_offsets_.begin(), contact_offsets_.end() - 1);
+    for (size_t i = 0; i < contact_count; ++i) {
+        contacts_[cursors_[contact_region_[i]]++] = static_cast<uint32_t>(i);
+    }
+    contact_offsets_.pop_back();
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -10,17 +10,59 @@ namespace Physics {
 //------------------------------------------------------------------------------
 
 RigidBody::RigidBody(std::shared_ptr<CollisionShape> shape, BodyType type)
-    : type_(type), collision_shape_(shape) {
+    : own_store_(std::make_unique<BodyStore>()), type_(type), collision_shape_(shape) {
+    store_ = own_store_.get();
+    slot_ = store_->add(this);
+    store_->flags()[slot_] = BodyStore::kFlagActive | BodyStore::kFlagAwake |
+                             (type == BodyType::Dynamic ? BodyStore::kFlagDynamic : 0u);
+    store_->setDrag(slot_, material_.drag);
+    updateShape();
+    updateMassProperties();
+}
+
+RigidBody::~RigidBody() = default;
+
+void RigidBody::updateShape() {
+    Vector2<float> half_size;
+    float radius = 0.0f;
+    CollisionDetection::getRoundedBox(*collision_shape_, half_size, radius);
+    field(BodyField::ShapeHalfX) = half_size.x;
+    field(BodyField::ShapeHalfY) = half_size.y;
+    field(BodyField::ShapeRadius) = radius;
+    uint32_t& flags = store_->flags()[slot_];
+    flags = (flags & ~BodyStore::kShapeTypeMask) |
+            (static_cast<uint32_t>(collision_shape_->getType()) << BodyStore::kShapeTypeShift);
+}
+
+void RigidBody::attachToStore(BodyStore& store) {
+    const uint32_t slot = store.add(this, *store_, slot_);
+    own_store_.reset();
+    store_ = &store;
+    slot_ = slot;
+}
+
+void RigidBody::detachFromStore() {
+    // The caller removes the old slot afterwards
+    auto own_store = std::make_unique<BodyStore>();
+    own_store->add(this, *store_, slot_);
+    own_store_ = std::move(own_store);
+    store_ = own_store_.get();
+    slot_ = 0;
+}
+
+void RigidBody::setBodyType(BodyType type) {
+    type_ = type;
+    setFlag(BodyStore::kFlagDynamic, type == BodyType::Dynamic);
     updateMassProperties();
 }
 
 void RigidBody::setMass(float mass) {
     if (mass <= 0.0f || type_ == BodyType::Static) {
         mass_ = 0.0f;
-        inverse_mass_ = 0.0f;
+        setInverseMass(0.0f);
     } else {
         mass_ = mass;
-        inverse_mass_ = 1.0f / mass;
+        setInverseMass(1.0f / mass);
     }
     updateMassProperties();
 }
@@ -28,67 +70,47 @@ void RigidBody::setMass(float mass) {
 void RigidBody::setInertia(float inertia) {
     if (inertia <= 0.0f || type_ == BodyType::Static) {
         inertia_ = 0.0f;
-        inverse_inertia_ = 0.0f;
+        setInverseInertia(0.0f);
     } else {
         inertia_ = inertia;
-        inverse_inertia_ = 1.0f / inertia;
+        setInverseInertia(1.0f / inertia);
     }
 }
 
+void RigidBody::setMaterial(const Material& material) {
+    material_ = material;
+    store_->setDrag(slot_, material_.drag);
+    updateMassProperties();
+}
+
 void RigidBody::applyForceAtPoint(const Vector2<float>& force, const Vector2<float>& point) {
     if (type_ != BodyType::Dynamic) return;
     
-    accumulated_force_ += force;
+    applyForce(force);
     
     // Calculate torque from force at point
-    Vector2<float> r = point - position_;
+    Vector2<float> r = point - getPosition();
     float torque = PhysicsUtils::cross2D(r, force);
-    accumulated_torque_ += torque;
+    field(BodyField::Torque) += torque;
 }
 
 AABB<float> RigidBody::getWorldBounds() const {
-    return collision_shape_->getBounds(position_);
+    return collision_shape_->getBounds(getPosition());
 }
 
 void RigidBody::integrate(float deltaTime) {
-    if (type_ != BodyType::Dynamic || !is_awake_) {
+    if (type_ != BodyType::Dynamic || !isAwake()) {
         return;
     }
     
-    // Apply gravity (if not kinematic)
-    if (type_ == BodyType::Dynamic && mass_ > 0.0f) {
-        // Gravity is applied by the physics world, not here
-    }
-    
-    // Apply drag
-    float drag_factor = std::pow(1.0f - material_.drag, deltaTime);
-    linear_velocity_ = linear_velocity_ * drag_factor;
-    angular_velocity_ *= drag_factor;
-    
-    // Integrate forces to velocity (F = ma, so a = F/m)
-    if (inverse_mass_ > 0.0f) {
-        linear_velocity_ += accumulated_force_ * inverse_mass_ * deltaTime;
-    }
-    
-    if (inverse_inertia_ > 0.0f) {
-        angular_velocity_ += accumulated_torque_ * inverse_inertia_ * deltaTime;
-    }
-    
-    // Integrate velocity to position
-    position_ += linear_velocity_ * deltaTime;
-    rotation_ += angular_velocity_ * deltaTime;
-    
-    // Clear forces for next frame
-    clearForces();
-    
-    // Update sleep state
-    updateSleepState(deltaTime);
+    // Gravity is applied by the physics world, not here
+    store_->integrateScalar(deltaTime, Vector2<float>(0.0f, 0.0f), slot_, slot_ + 1);
 }
 
 Vector2<float> RigidBody::getVelocityAtPoint(const Vector2<float>& worldPoint) const {
-    Vector2<float> r = worldPoint - position_;
-    Vector2<float> tangential_velocity = PhysicsUtils::rotate(Vector2<float>(-r.y, r.x), 0.0f) * angular_velocity_;
-    return linear_velocity_ + tangential_velocity;
+    Vector2<float> r = worldPoint - getPosition();
+    Vector2<float> tangential_velocity = PhysicsUtils::rotate(Vector2<float>(-r.y, r.x), 0.0f) * getAngularVelocity();
+    return getLinearVelocity() + tangential_velocity;
 }
 
 void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration, const Vector2<float>& contactPoint, RigidBody& other) {
@@ -96,9 +118,14 @@ void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration
         return; // Two static bodies don't collide
     }
     
+    const float inverse_mass = getInverseMass();
+    const float inverse_inertia = getInverseInertia();
+    const float other_inverse_mass = other.getInverseMass();
+    const float other_inverse_inertia = other.getInverseInertia();
+    
     // Calculate relative velocity
-    Vector2<float> r1 = contactPoint - position_;
-    Vector2<float> r2 = contactPoint - other.position_;
+    Vector2<float> r1 = contactPoint - getPosition();
+    Vector2<float> r2 = contactPoint - other.getPosition();
     
     Vector2<float> vel1 = getVelocityAtPoint(contactPoint);
     Vector2<float> vel2 = other.getVelocityAtPoint(contactPoint);
@@ -119,12 +146,12 @@ void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration
     float j = -(1.0f + restitution) * velocityAlongNormal;
     
     // Calculate mass terms
-    float invMassSum = inverse_mass_ + other.inverse_mass_;
+    float invMassSum = inverse_mass + other_inverse_mass;
     
     // Add rotational components
     float r1CrossN = PhysicsUtils::cross2D(r1, normal);
     float r2CrossN = PhysicsUtils::cross2D(r2, normal);
-    invMassSum += r1CrossN * r1CrossN * inverse_inertia_ + r2CrossN * r2CrossN * other.inverse_inertia_;
+    invMassSum += r1CrossN * r1CrossN * inverse_inertia + r2CrossN * r2CrossN * other_inverse_inertia;
     
     j /= invMassSum;
     
@@ -132,14 +159,14 @@ void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration
     Vector2<float> impulse = normal * j;
     
     if (type_ == BodyType::Dynamic) {
-        linear_velocity_ -= impulse * inverse_mass_;
-        angular_velocity_ -= PhysicsUtils::cross2D(r1, impulse) * inverse_inertia_;
+        setLinearVelocity(getLinearVelocity() - impulse * inverse_mass);
+        field(BodyField::AngularVelocity) -= PhysicsUtils::cross2D(r1, impulse) * inverse_inertia;
         setAwake(true);
     }
     
     if (other.type_ == BodyType::Dynamic) {
-        other.linear_velocity_ += impulse * other.inverse_mass_;
-        other.angular_velocity_ += PhysicsUtils::cross2D(r2, impulse) * other.inverse_inertia_;
+        other.setLinearVelocity(other.getLinearVelocity() + impulse * other_inverse_mass);
+        other.field(BodyField::AngularVelocity) += PhysicsUtils::cross2D(r2, impulse) * other_inverse_inertia;
         other.setAwake(true);
     }
     
@@ -166,13 +193,13 @@ void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration
         
         // Apply friction impulse
         if (type_ == BodyType::Dynamic) {
-            linear_velocity_ -= frictionImpulse * inverse_mass_;
-            angular_velocity_ -= PhysicsUtils::cross2D(r1, frictionImpulse) * inverse_inertia_;
+            setLinearVelocity(getLinearVelocity() - frictionImpulse * inverse_mass);
+            field(BodyField::AngularVelocity) -= PhysicsUtils::cross2D(r1, frictionImpulse) * inverse_inertia;
         }
         
         if (other.type_ == BodyType::Dynamic) {
-            other.linear_velocity_ += frictionImpulse * other.inverse_mass_;
-            other.angular_velocity_ += PhysicsUtils::cross2D(r2, frictionImpulse) * other.inverse_inertia_;
+            other.setLinearVelocity(other.getLinearVelocity() + frictionImpulse * other_inverse_mass);
+            other.field(BodyField::AngularVelocity) += PhysicsUtils::cross2D(r2, frictionImpulse) * other_inverse_inertia;
         }
     }
     
@@ -184,11 +211,11 @@ void RigidBody::resolveCollision(const Vector2<float>& normal, float penetration
         Vector2<float> correction = normal * (penetration * CORRECTION_PERCENT / invMassSum);
         
         if (type_ == BodyType::Dynamic) {
-            position_ -= correction * inverse_mass_;
+            setPosition(getPosition() - correction * inverse_mass);
         }
         
         if (other.type_ == BodyType::Dynamic) {
-            other.position_ += correction * other.inverse_mass_;
+            other.setPosition(other.getPosition() + correction * other_inverse_mass);
         }
     }
 }
@@ -198,9 +225,9 @@ void RigidBody::updateMassProperties() {
     
     if (type_ == BodyType::Static) {
         mass_ = 0.0f;
-        inverse_mass_ = 0.0f;
+        setInverseMass(0.0f);
         inertia_ = 0.0f;
-        inverse_inertia_ = 0.0f;
+        setInverseInertia(0.0f);
     } else {
         // Calculate mass from shape and material
         float calculatedMass = PhysicsUtils::calculateMass(*collision_shape_, material_.density);
@@ -209,31 +236,11 @@ void RigidBody::updateMassProperties() {
             mass_ = calculatedMass;
         }
         
-        inverse_mass_ = (mass_ > 0.0f) ? 1.0f / mass_ : 0.0f;
+        setInverseMass((mass_ > 0.0f) ? 1.0f / mass_ : 0.0f);
         
         // Calculate inertia
         inertia_ = PhysicsUtils::calculateInertia(*collision_shape_, mass_);
-        inverse_inertia_ = (inertia_ > 0.0f) ? 1.0f / inertia_ : 0.0f;
-    }
-}
-
-void RigidBody::updateSleepState(float deltaTime) {
-    if (type_ != BodyType::Dynamic) return;
-    
-    float linearKineticEnergy = linear_velocity_.dot(linear_velocity_);
-    float angularKineticEnergy = angular_velocity_ * angular_velocity_;
-    
-    if (linearKineticEnergy < SLEEP_LINEAR_THRESHOLD && angularKineticEnergy < SLEEP_ANGULAR_THRESHOLD) {
-        sleep_time_ += deltaTime;
-        
-        if (sleep_time_ >= SLEEP_TIME_THRESHOLD) {
-            setAwake(false);
-            linear_velocity_ = Vector2<float>(0.0f);
-            angular_velocity_ = 0.0f;
-        }
-    } else {
-        sleep_time_ = 0.0f;
-        setAwake(true);
+        setInverseInertia((inertia_ > 0.0f) ? 1.0f / inertia_ : 0.0f);
     }
 }
 
@@ -0,0 +1,261 @@
+#include "physics/spatial_grid.hpp"
+#include "threading/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace PyNovaGE {
+namespace Physics {
+
+namespace {
+
+// Fewer items per chunk are not worth a task
+constexpr size_t kMinChunkItems = 4096;
+
+} // anonymous namespace
+
+SpatialGrid::SpatialGrid(float cell_size, const Vector2<float>& world_min, const Vector2<float>& world_max)
+    : cell_size_(0.0f), inverse_cell_size_(0.0f), grid_width_(0), grid_height_(0) {
+    resize(cell_size, world_min, world_max);
+}
+
+void SpatialGrid::resize(float new_cell_size, const Vector2<float>& new_world_min, const Vector2<float>& new_world_max) {
+    if (!(new_cell_size > 0.0f)) {
+        throw std::invalid_argument("SpatialGrid: cell size must be positive");
+    }
+    if (!(new_world_max.x > new_world_min.x) || !(new_world_max.y > new_world_min.y)) {
+        throw std::invalid_argument("SpatialGrid: world max must be above world min");
+    }
+    cell_size_ = new_cell_size;
+    inverse_cell_size_ = 1.0f / new_cell_size;
+    world_min_ = new_world_min;
+    world_max_ = new_world_max;
+
+    Vector2<float> world_size = world_max_ - world_min_;
+    grid_width_ = static_cast<int>(std::ceil(world_size.x / cell_size_)) + 1;
+    grid_height_ = static_cast<int>(std::ceil(world_size.y / cell_size_)) + 1;
+    clear();
+}
+
+void SpatialGrid::clear() {
+    starts_.assign(static_cast<size_t>(getCellCount()) + 2, 0);
+    sizes_.assign(static_cast<size_t>(getCellCount()) + 1, 0);
+    items_.clear();
+    bounds_.clear();
+    slots_.clear();
+    buckets_.clear();
+}
+
+int SpatialGrid::cellX(float x) const {
+    const float cell = std::floor((x - world_min_.x) * inverse_cell_size_);
+    return static_cast<int>(std::clamp(cell, 0.0f, static_cast<float>(grid_width_ - 1)));
+}
+
+int SpatialGrid::cellY(float y) const {
+    const float cell = std::floor((y - world_min_.y) * inverse_cell_size_);
+    return static_cast<int>(std::clamp(cell, 0.0f, static_cast<float>(grid_height_ - 1)));
+}
+
+int SpatialGrid::getCellIndex(const Vector2<float>& position) const {
+    return cellY(position.y) * grid_width_ + cellX(position.x);
+}
+
+uint32_t SpatialGrid::bucketOf(const BroadPhaseProxy& proxy) const {
+    // Cells are monotonic in the coordinate. An item reaching at most one
+    // cell past its min corner can only overlap items whose min corner is
+    // in one of the 3x3 cells around its own.
+    const int x = cellX(proxy.min_x);
+    const int y = cellY(proxy.min_y);
+    if (cellX(proxy.max_x) > x + 1 || cellY(proxy.max_y) > y + 1) {
+        return static_cast<uint32_t>(getCellCount());
+    }
+    return static_cast<uint32_t>(y * grid_width_ + x);
+}
+
+void SpatialGrid::rebuild(std::span<const BroadPhaseProxy> proxies, Threading::ThreadPool* pool) {
+    const size_t count = proxies.size();
+    const size_t bucket_count = static_cast<size_t>(getCellCount()) + 1;
+
+    // Each chunk counts and places its own items. Chunks take their places
+    // in each bucket in item order, so the layout is the same for any
+    // number of chunks. Per-chunk counters are only worth it when the grid
+    // is not much larger than the item count.
+    size_t chunks = 1;
+    if (pool && count >= 2 * kMinChunkItems) {
+        chunks = std::min({pool->size() + 1, count / kMinChunkItems, std::max<size_t>(1, 4 * count / bucket_count)});
+    }
+    const size_t chunk_size = (count + chunks - 1) / std::max<size_t>(chunks, 1);
+
+    slots_.resize(count);
+    buckets_.resize(count);
+    counts_.assign(chunks * bucket_count, 0);
+
+    auto forEachChunk = [&](auto&& func) {
+        if (chunks > 1) {
+            Threading::parallel_for(0, chunks, func, pool, 1);
+        } else {
+            func(0);
+        }
+    };
+
+    forEachChunk([&](size_t chunk) {
+        uint32_t* counts = counts_.data() + chunk * bucket_count;
+        const size_t end = std::min(count, (chunk + 1) * chunk_size);
+        for (size_t i = chunk * chunk_size; i < end; ++i) {
+            const uint32_t bucket = bucketOf(proxies[i]);
+            buckets_[i] = bucket;
+            counts[bucket]++;
+        }
+    });
+
+    // Turn the counts into each chunk's first slot in each bucket, leaving
+    // kCellSlack free slots after each bucket's items
+    starts_.resize(bucket_count + 1);
+    sizes_.resize(bucket_count);
+    uint32_t running = 0;
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        starts_[bucket] = running;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            uint32_t& counter = counts_[chunk * bucket_count + bucket];
+            const uint32_t bucket_items = counter;
+            counter = running;
+            running += bucket_items;
+        }
+        sizes_[bucket] = running - starts_[bucket];
+        running += kCellSlack;
+    }
+    starts_[bucket_count] = running;
+    items_.resize(running);
+    bounds_.resize(running);
+
+    forEachChunk([&](size_t chunk) {
+        uint32_t* cursors = counts_.data() + chunk * bucket_count;
+        const size_t end = std::min(count, (chunk + 1) * chunk_size);
+        for (size_t i = chunk * chunk_size; i < end; ++i) {
+            const uint32_t slot = cursors[buckets_[i]]++;
+            items_[slot] = static_cast<uint32_t>(i);
+            bounds_[slot] = proxies[i];
+            slots_[i] = slot;
+        }
+    });
+}
+
+size_t SpatialGrid::update(std::span<const BroadPhaseProxy> proxies) {
+    if (proxies.size() != slots_.size()) {
+        rebuild(proxies);
+        return proxies.size();
+    }
+
+    moves_.clear();
+    for (uint32_t i = 0; i < proxies.size(); ++i) {
+        const uint32_t bucket = bucketOf(proxies[i]);
+        if (bucket == buckets_[i]) {
+            bounds_[slots_[i]] = proxies[i];
+        } else {
+            moves_.push_back({i, bucket});
+        }
+    }
+
+    for (const Move& move : moves_) {
+        if (sizes_[move.bucket] == getCapacity(move.bucket)) {
+            rebuild(proxies);
+            return moves_.size();
+        }
+
+        // The last item of the old bucket fills the gap
+        const uint32_t from = buckets_[move.item];
+        const uint32_t slot = slots_[move.item];
+        const uint32_t last = starts_[from] + --sizes_[from];
+        items_[slot] = items_[last];
+        bounds_[slot] = bounds_[last];
+        slots_[items_[slot]] = slot;
+
+        const uint32_t to = starts_[move.bucket] + sizes_[move.bucket]++;
+        items_[to] = move.item;
+        bounds_[to] = proxies[move.item];
+        slots_[move.item] = to;
+        buckets_[move.item] = move.bucket;
+    }
+    return moves_.size();
+}
+
+size_t SpatialGrid::emitPairs(std::span<BroadPhasePair> pairs) const {
+    size_t count = 0;
+    auto test = [&](const BroadPhaseProxy& a, const BroadPhaseProxy& b) {
+        if (a.overlaps(b)) {
+            if (count < pairs.size()) {
+                pairs[count] = BroadPhasePair::make(a.body_index, b.body_index);
+            }
+            ++count;
+        }
+    };
+
+    // Within each cell, then against the forward half of the neighbors so
+    // each pair of neighboring cells is visited once
+    static constexpr int kNeighbors[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    for (int y = 0; y < grid_height_; ++y) {
+        for (int x = 0; x < grid_width_; ++x) {
+            const int cell = y * grid_width_ + x;
+            const uint32_t begin = starts_[cell];
+            const uint32_t end = begin + sizes_[cell];
+            if (begin == end) continue;
+
+            for (uint32_t i = begin; i < end; ++i) {
+                for (uint32_t j = i + 1; j < end; ++j) {
+                    test(bounds_[i], bounds_[j]);
+                }
+            }
+            for (const auto& offset : kNeighbors) {
+                const int nx = x + offset[0];
+                const int ny = y + offset[1];
+                if (nx < 0 || nx >= grid_width_ || ny >= grid_height_) continue;
+                const int neighbor = ny * grid_width_ + nx;
+                const uint32_t neighbor_end = starts_[neighbor] + sizes_[neighbor];
+                for (uint32_t i = begin; i < end; ++i) {
+                    for (uint32_t j = starts_[neighbor]; j < neighbor_end; ++j) {
+                        test(bounds_[i], bounds_[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Oversized items against every item in the cells and each other
+    const uint32_t oversized = starts_[getCellCount()];
+    const uint32_t oversized_end = oversized + sizes_[getCellCount()];
+    for (uint32_t i = oversized; i < oversized_end; ++i) {
+        for (int cell = 0; cell < getCellCount(); ++cell) {
+            const uint32_t cell_end = starts_[cell] + sizes_[cell];
+            for (uint32_t j = starts_[cell]; j < cell_end; ++j) {
+                test(bounds_[i], bounds_[j]);
+            }
+        }
+        for (uint32_t j = i + 1; j < oversized_end; ++j) {
+            test(bounds_[i], bounds_[j]);
+        }
+    }
+    return count;
+}
+
+SpatialGrid::GridStats SpatialGrid::getStats() const {
+    GridStats stats = {};
+    stats.total_cells = getCellCount();
+    stats.total_objects = slots_.size();
+    stats.oversized_objects = getOversized().size();
+
+    for (int cell = 0; cell < getCellCount(); ++cell) {
+        const int objects = static_cast<int>(sizes_[cell]);
+        if (objects > 0) {
+            stats.occupied_cells++;
+            stats.max_objects_per_cell = std::max(stats.max_objects_per_cell, objects);
+        }
+    }
+
+    const size_t in_cells = stats.total_objects - stats.oversized_objects;
+    stats.average_objects_per_occupied_cell = stats.occupied_cells > 0 ?
+        static_cast<double>(in_cells) / stats.occupied_cells : 0.0;
+    return stats;
+}
+
+} // namespace Physics
+} // namespace PyNovaGE
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "physics/physics.hpp"
+#include "memory/frame_allocator.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+using namespace PyNovaGE::Physics;
+using ::PyNovaGE::FrameAllocator;
+
+// Count global heap allocations made while a test has counting enabled.
+// This replaces operator new for the whole binary, so it only lives here.
+namespace {
+std::atomic<bool> g_count_allocations{false};
+std::atomic<size_t> g_allocation_count{0};
+}
+
+void* operator new(std::size_t size) {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+        g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST(PhysicsFrameQueryTest, QueryAABBIntoFrameMemoryDoesNotAllocate) {
+    PhysicsWorld world;
+    for (int i = 0; i < 200; ++i) {
+        auto body = std::make_shared<RigidBody>(
+            std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)),
+            BodyType::Dynamic
+        );
+        body->setPosition(Vector2<float>(static_cast<float>(i % 20) * 2.0f, static_cast<float>(i / 20) * 2.0f));
+        world.addBody(body);
+    }
+
+    AABB<float> query_bounds(
+        SIMD::Vector<float, 3>(-1.0f, -1.0f, 0.0f),
+        SIMD::Vector<float, 3>(15.0f, 15.0f, 0.0f)
+    );
+    const size_t expected = world.queryAABB(query_bounds).size();
+    ASSERT_GT(expected, 0u);
+
+    // Warm up so both frame buffers exist on this thread
+    for (int frame = 0; frame < 4; ++frame) {
+        FrameAllocator::advanceFrame();
+        std::pmr::vector<RigidBody*> results(FrameAllocator::threadLocalResource());
+        world.queryAABB(query_bounds, results);
+    }
+
+    g_allocation_count = 0;
+    g_count_allocations = true;
+    size_t found = 0;
+    for (int frame = 0; frame < 16; ++frame) {
+        FrameAllocator::advanceFrame();
+        std::pmr::vector<RigidBody*> results(FrameAllocator::threadLocalResource());
+        world.queryAABB(query_bounds, results);
+        found = results.size();
+    }
+    g_count_allocations = false;
+
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+}
+
+TEST(PhysicsFrameQueryTest, RebuildingContactColorsDoesNotAllocate) {
+    constexpr uint32_t kBodies = 64;
+    std::vector<uint32_t> body1;
+    std::vector<uint32_t> body2;
+    for (uint32_t i = 0; i < 512; ++i) {
+        body1.push_back(i % kBodies);
+        body2.push_back(i % 7 == 0 ? IslandBuilder::kNoBody : (i * 13 + 1) % kBodies);
+    }
+    std::vector<uint32_t> contacts(body1.size());
+    for (uint32_t i = 0; i < contacts.size(); ++i) contacts[i] = i;
+
+    ContactColoring coloring;
+    coloring.build(contacts, body1.data(), body2.data(), kBodies);
+    const size_t colors = coloring.getColorCount();
+
+    g_allocation_count = 0;
+    g_count_allocations = true;
+    for (int frame = 0; frame < 16; ++frame) {
+        coloring.build(contacts, body1.data(), body2.data(), kBodies);
+    }
+    g_count_allocations = false;
+
+    EXPECT_EQ(coloring.getColorCount(), colors);
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+}
+
+TEST(PhysicsFrameQueryTest, RepeatedCharacterMovesDoNotAllocate) {
+    PhysicsWorld world;
+    auto ground = std::make_shared<RigidBody>(
+        std::make_shared<RectangleShape>(Vector2<float>(40.0f, 1.0f)),
+        BodyType::Static
+    );
+    ground->setPosition(Vector2<float>(0.0f, -0.5f));
+    world.addBody(ground);
+    world.bakeStaticGeometry();
+
+    CharacterConfig config;
+    std::vector<CharacterMove> moves;
+    for (int i = 0; i < 600; ++i) {
+        const float x = -15.0f + static_cast<float>(i % 100) * 0.3f;
+        moves.push_back({Vector2<float>(x, 1.0f), Vector2<float>(0.05f, -0.3f)});
+    }
+    std::vector<CharacterResult> results(moves.size());
+    world.moveCharacters(config, moves, results);
+
+    g_allocation_count = 0;
+    g_count_allocations = true;
+    for (int frame = 0; frame < 16; ++frame) {
+        world.moveCharacters(config, moves, results);
+    }
+    g_count_allocations = false;
+
+    EXPECT_TRUE(results[0].grounded);
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+}
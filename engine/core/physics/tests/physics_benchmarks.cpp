@@ -1,6 +1,12 @@
 #include <benchmark/benchmark.h>
 #include "physics/physics.hpp"
+#include "physics/spatial_grid.hpp"
+#include "threading/thread_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 using namespace PyNovaGE::Physics;
@@ -308,6 +314,129 @@ static void BM_Physics_RigidBodyIntegration(benchmark::State& state) {
 }
 BENCHMARK(BM_Physics_RigidBodyIntegration)->Arg(100)->Arg(1000)->Arg(10000);
 
+// Body layout and integration as they were before BodyStore: one heap object
+// per body, reached through shared_ptr, with gravity applied as a force and
+// the drag factor recomputed every step
+struct LegacyBody {
+    Vector2<float> position{0.0f};
+    float rotation = 0.0f;
+    BodyType type = BodyType::Dynamic;
+    float mass = 1.0f;
+    float inverse_mass = 1.0f;
+    float inertia = 1.0f;
+    float inverse_inertia = 1.0f;
+    Vector2<float> linear_velocity{0.0f};
+    float angular_velocity = 0.0f;
+    Vector2<float> accumulated_force{0.0f};
+    float accumulated_torque = 0.0f;
+    Material material;
+    std::shared_ptr<CollisionShape> collision_shape;
+    bool is_active = true;
+    bool is_awake = true;
+    float sleep_time = 0.0f;
+    
+    void integrate(float deltaTime) {
+        if (type != BodyType::Dynamic || !is_awake) return;
+        
+        float drag_factor = std::pow(1.0f - material.drag, deltaTime);
+        linear_velocity = linear_velocity * drag_factor;
+        angular_velocity *= drag_factor;
+        if (inverse_mass > 0.0f) linear_velocity += accumulated_force * inverse_mass * deltaTime;
+        if (inverse_inertia > 0.0f) angular_velocity += accumulated_torque * inverse_inertia * deltaTime;
+        position += linear_velocity * deltaTime;
+        rotation += angular_velocity * deltaTime;
+        accumulated_force = Vector2<float>(0.0f);
+        accumulated_torque = 0.0f;
+        
+        if (linear_velocity.dot(linear_velocity) < 0.01f && angular_velocity * angular_velocity < 0.01f) {
+            sleep_time += deltaTime;
+            if (sleep_time >= 0.5f) {
+                is_awake = false;
+                linear_velocity = Vector2<float>(0.0f);
+                angular_velocity = 0.0f;
+            }
+        } else {
+            sleep_time = 0.0f;
+        }
+    }
+};
+
+static void BM_Physics_Integration_LegacyAoS(benchmark::State& state) {
+    const int num_bodies = state.range(0);
+    const float deltaTime = 1.0f / 60.0f;
+    const Vector2<float> gravity(0.0f, -9.81f);
+    
+    std::vector<std::shared_ptr<LegacyBody>> bodies;
+    bodies.reserve(num_bodies);
+    for (int i = 0; i < num_bodies; ++i) {
+        auto body = std::make_shared<LegacyBody>();
+        body->collision_shape = std::make_shared<CircleShape>(g_generator.randomRadius());
+        body->position = g_generator.randomPosition();
+        body->linear_velocity = g_generator.randomVelocity();
+        bodies.push_back(body);
+    }
+    
+    for (auto _ : state) {
+        for (auto& body : bodies) {
+            if (body->type == BodyType::Dynamic && body->is_awake) {
+                body->accumulated_force += gravity * body->mass;
+            }
+        }
+        for (auto& body : bodies) {
+            body->integrate(deltaTime);
+        }
+        benchmark::DoNotOptimize(bodies[0]->position);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK(BM_Physics_Integration_LegacyAoS)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void fillBenchmarkStore(BodyStore& store, int num_bodies) {
+    store.reserve(num_bodies);
+    for (int i = 0; i < num_bodies; ++i) {
+        const uint32_t slot = store.add(nullptr);
+        const Vector2<float> position = g_generator.randomPosition();
+        const Vector2<float> velocity = g_generator.randomVelocity();
+        store.at(BodyField::PositionX, slot) = position.x;
+        store.at(BodyField::PositionY, slot) = position.y;
+        store.at(BodyField::VelocityX, slot) = velocity.x;
+        store.at(BodyField::VelocityY, slot) = velocity.y;
+        store.at(BodyField::InverseMass, slot) = 1.0f;
+        store.at(BodyField::InverseInertia, slot) = 1.0f;
+        store.setDrag(slot, Material{}.drag);
+        store.flags()[slot] = BodyStore::kFlagActive | BodyStore::kFlagAwake | BodyStore::kFlagDynamic;
+    }
+}
+
+static void BM_Physics_Integration_BodyStoreScalar(benchmark::State& state) {
+    const int num_bodies = state.range(0);
+    BodyStore store;
+    fillBenchmarkStore(store, num_bodies);
+    
+    for (auto _ : state) {
+        store.integrateScalar(1.0f / 60.0f, Vector2<float>(0.0f, -9.81f), 0, store.size());
+        benchmark::DoNotOptimize(store.data(BodyField::PositionX));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK(BM_Physics_Integration_BodyStoreScalar)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_Physics_Integration_BodyStoreSIMD(benchmark::State& state) {
+    const int num_bodies = state.range(0);
+    BodyStore store;
+    fillBenchmarkStore(store, num_bodies);
+    
+    for (auto _ : state) {
+        store.integrate(1.0f / 60.0f, Vector2<float>(0.0f, -9.81f));
+        benchmark::DoNotOptimize(store.data(BodyField::PositionX));
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK(BM_Physics_Integration_BodyStoreSIMD)->Arg(1000)->Arg(10000)->Arg(100000);
+
 //------------------------------------------------------------------------------
 // Broad Phase Collision Detection (SIMD AABB tests)
 //------------------------------------------------------------------------------
@@ -350,6 +479,775 @@ static void BM_Physics_BroadPhaseCollisionAABB(benchmark::State& state) {
 }
 BENCHMARK(BM_Physics_BroadPhaseCollisionAABB)->Arg(50)->Arg(100)->Arg(200);
 
+//------------------------------------------------------------------------------
+// Pluggable broad phase at scale (1k / 10k / 50k bodies)
+//------------------------------------------------------------------------------
+
+// Bodies spread so density stays constant as the count grows
+static std::vector<BroadPhaseProxy> makeBroadPhaseProxies(int num_bodies) {
+    std::mt19937 rng(1234);
+    const float extent = std::sqrt(static_cast<float>(num_bodies)) * 2.5f;
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    
+    std::vector<BroadPhaseProxy> proxies;
+    proxies.reserve(num_bodies);
+    for (int i = 0; i < num_bodies; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        proxies.push_back({x, y, x + size(rng), y + size(rng), static_cast<uint32_t>(i)});
+    }
+    return proxies;
+}
+
+static void BM_Physics_BroadPhaseFindPairs(benchmark::State& state, BroadPhaseType type) {
+    const int num_bodies = state.range(0);
+    auto proxies = makeBroadPhaseProxies(num_bodies);
+    auto broad_phase = createBroadPhase(type, 4.0f);
+    std::vector<BroadPhasePair> pairs;
+    
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    
+    for (auto _ : state) {
+        // Small per-step motion, as in a running simulation
+        state.PauseTiming();
+        for (auto& proxy : proxies) {
+            const float dx = jitter(rng);
+            proxy.min_x += dx;
+            proxy.max_x += dx;
+        }
+        state.ResumeTiming();
+        
+        broad_phase->findPairs(proxies, pairs);
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    
+    state.counters["pairs"] = static_cast<double>(pairs.size());
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK_CAPTURE(BM_Physics_BroadPhaseFindPairs, BruteForce, BroadPhaseType::BruteForce)
+    ->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_BroadPhaseFindPairs, SweepAndPrune, BroadPhaseType::SweepAndPrune)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_BroadPhaseFindPairs, UniformGrid, BroadPhaseType::UniformGrid)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_BroadPhaseFindPairs, DynamicTree, BroadPhaseType::DynamicTree)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_Physics_WorldStep(benchmark::State& state, BroadPhaseType type) {
+    const int num_bodies = state.range(0);
+    
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.broad_phase = type;
+    PhysicsWorld world(config);
+    
+    std::mt19937 rng(5678);
+    const float extent = std::sqrt(static_cast<float>(num_bodies)) * 2.5f;
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+    
+    for (int i = 0; i < num_bodies; ++i) {
+        std::shared_ptr<CollisionShape> shape;
+        if (i % 2 == 0) {
+            shape = std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f));
+        } else {
+            shape = std::make_shared<CircleShape>(0.5f);
+        }
+        auto body = std::make_shared<RigidBody>(shape, BodyType::Dynamic);
+        body->setPosition(Vector2<float>(position(rng), position(rng)));
+        body->setLinearVelocity(Vector2<float>(velocity(rng), velocity(rng)));
+        world.addBody(body);
+    }
+    
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    state.counters["pairs"] = static_cast<double>(world.getStats().broad_phase_pairs);
+    state.counters["broad_phase_ms"] = world.getStats().broad_phase_time * 1000.0f;
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK_CAPTURE(BM_Physics_WorldStep, BruteForce, BroadPhaseType::BruteForce)
+    ->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_WorldStep, SweepAndPrune, BroadPhaseType::SweepAndPrune)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_WorldStep, UniformGrid, BroadPhaseType::UniformGrid)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Physics_WorldStep, DynamicTree, BroadPhaseType::DynamicTree)
+    ->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+//------------------------------------------------------------------------------
+// Spatial Query Benchmarks
+//------------------------------------------------------------------------------
+
+static std::unique_ptr<PhysicsWorld> makeQueryWorld(int num_bodies, float& extent) {
+    auto world = std::make_unique<PhysicsWorld>();
+    std::mt19937 rng(4321);
+    extent = std::sqrt(static_cast<float>(num_bodies)) * 2.5f;
+    std::uniform_real_distribution<float> position(-extent, extent);
+    
+    for (int i = 0; i < num_bodies; ++i) {
+        auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)),
+                                                BodyType::Static);
+        body->setPosition(Vector2<float>(position(rng), position(rng)));
+        world->addBody(body);
+    }
+    return world;
+}
+
+static std::vector<PhysicsWorld::RaySegment> makeQueryRays(size_t count, float extent) {
+    std::mt19937 rng(8765);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+    
+    // Line-of-sight style rays of up to ~30 units
+    std::vector<PhysicsWorld::RaySegment> rays(count);
+    for (auto& ray : rays) {
+        ray.start = Vector2<float>(position(rng), position(rng));
+        ray.end = ray.start + Vector2<float>(offset(rng), offset(rng));
+    }
+    return rays;
+}
+
+// Closest hit by testing every body, as PhysicsWorld::raycast did before the query tree
+static PhysicsWorld::RaycastHit linearRaycast(const PhysicsWorld& world, const PhysicsWorld::RaySegment& segment) {
+    PhysicsWorld::RaycastHit result;
+    Vector2<float> direction = segment.end - segment.start;
+    const float max_distance = direction.length();
+    direction = direction / max_distance;
+    result.distance = max_distance;
+    
+    const SIMD::Ray<float> ray(SIMD::Vector<float, 3>(segment.start.x, segment.start.y, 0.0f),
+                               SIMD::Vector<float, 3>(direction.x, direction.y, 0.0f));
+    for (const auto& body : world.getBodies()) {
+        float t;
+        if (ray.intersects(body->getWorldBounds(), t) && t <= result.distance && t >= 0.0f) {
+            result.hasHit = true;
+            result.distance = t;
+            result.body = body.get();
+        }
+    }
+    return result;
+}
+
+static void BM_Physics_RaycastBatch_Linear(benchmark::State& state) {
+    float extent;
+    auto world = makeQueryWorld(static_cast<int>(state.range(0)), extent);
+    const auto rays = makeQueryRays(1000, extent);
+    std::vector<PhysicsWorld::RaycastHit> hits(rays.size());
+    
+    for (auto _ : state) {
+        for (size_t i = 0; i < rays.size(); ++i) {
+            hits[i] = linearRaycast(*world, rays[i]);
+        }
+        benchmark::DoNotOptimize(hits.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_Physics_RaycastBatch_Linear)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_Physics_RaycastBatch_Tree(benchmark::State& state) {
+    float extent;
+    auto world = makeQueryWorld(static_cast<int>(state.range(0)), extent);
+    const auto rays = makeQueryRays(1000, extent);
+    std::vector<PhysicsWorld::RaycastHit> hits(rays.size());
+    
+    for (auto _ : state) {
+        world->raycastBatch(rays, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_Physics_RaycastBatch_Tree)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_Physics_RaycastAnyBatch_Tree(benchmark::State& state) {
+    float extent;
+    auto world = makeQueryWorld(static_cast<int>(state.range(0)), extent);
+    const auto rays = makeQueryRays(1000, extent);
+    std::vector<PhysicsWorld::RaycastHit> hits(rays.size());
+    
+    for (auto _ : state) {
+        world->raycastAnyBatch(rays, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(BM_Physics_RaycastAnyBatch_Tree)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_Physics_QueryAABB_Tree(benchmark::State& state) {
+    float extent;
+    auto world = makeQueryWorld(static_cast<int>(state.range(0)), extent);
+    std::mt19937 rng(2468);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    
+    // Area-of-effect style queries, 10 units across
+    std::vector<AABB<float>> queries;
+    for (int i = 0; i < 1000; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        queries.emplace_back(SIMD::Vector<float, 3>(x - 5.0f, y - 5.0f, -1.0f),
+                             SIMD::Vector<float, 3>(x + 5.0f, y + 5.0f, 1.0f));
+    }
+    std::pmr::vector<RigidBody*> results;
+    
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& query : queries) {
+            world->queryAABB(query, results);
+            found += results.size();
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_Physics_QueryAABB_Tree)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+//------------------------------------------------------------------------------
+// Contact Solver Tests
+//------------------------------------------------------------------------------
+
+// Columns of boxes dropped onto the ground, stepped until nothing moves more
+// than 1 mm/s for half a second. Compare warm-started and cold solvers at the
+// same velocity iteration count.
+static void BM_Physics_StackSettle(benchmark::State& state) {
+    const bool warm_starting = state.range(0) != 0;
+    const int velocity_iterations = static_cast<int>(state.range(1));
+    constexpr int kColumns = 20;
+    constexpr int kHeight = 10;
+    constexpr int kMaxSteps = 1200;
+    constexpr float kRestSpeed = 0.001f;
+    constexpr int kRestSteps = 30;
+    
+    int steps_to_rest = kMaxSteps;
+    float solve_time = 0.0f;
+    float top = 0.0f;
+    
+    for (auto _ : state) {
+        PhysicsConfig config;
+        config.velocity_iterations = velocity_iterations;
+        config.enable_warm_starting = warm_starting;
+        PhysicsWorld world(config);
+        
+        auto ground = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(100.0f, 1.0f)),
+                                                  BodyType::Static);
+        world.addBody(ground);
+        std::vector<std::shared_ptr<RigidBody>> boxes;
+        for (int column = 0; column < kColumns; ++column) {
+            for (int level = 0; level < kHeight; ++level) {
+                auto box = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)));
+                box->setPosition(Vector2<float>(static_cast<float>(column) * 2.0f - 20.0f,
+                                                1.0f + static_cast<float>(level) * 1.05f));
+                world.addBody(box);
+                boxes.push_back(box);
+            }
+        }
+        
+        std::vector<Vector2<float>> previous(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) previous[i] = boxes[i]->getPosition();
+        
+        steps_to_rest = kMaxSteps;
+        solve_time = 0.0f;
+        int calm_steps = 0;
+        for (int step = 0; step < kMaxSteps; ++step) {
+            world.step(1.0f / 60.0f);
+            solve_time += world.getStats().solve_time;
+            
+            float max_speed = 0.0f;
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                const Vector2<float> position = boxes[i]->getPosition();
+                max_speed = std::max(max_speed, (position - previous[i]).length() * 60.0f);
+                previous[i] = position;
+            }
+            calm_steps = max_speed < kRestSpeed ? calm_steps + 1 : 0;
+            if (calm_steps == kRestSteps) {
+                steps_to_rest = step + 1 - kRestSteps;
+                break;
+            }
+        }
+        top = boxes[kHeight - 1]->getPosition().y;
+    }
+    
+    // Resting height of the top box is 10 without any penetration
+    state.counters["steps_to_rest"] = steps_to_rest;
+    state.counters["iterations_to_rest"] = static_cast<double>(steps_to_rest) * velocity_iterations;
+    state.counters["solve_ms"] = solve_time * 1000.0f;
+    state.counters["top_height"] = top;
+}
+BENCHMARK(BM_Physics_StackSettle)
+    ->ArgNames({"warm", "iterations"})
+    ->ArgsProduct({{0, 1}, {2, 4, 8, 16}})
+    ->Unit(benchmark::kMillisecond);
+
+// A grid of bodies at rest with every tenth row sliding along itself, so the
+// moving rows never touch anything. With sleeping on, the resting 90% fall
+// asleep and drop out of integration, broad phase and solve.
+static void BM_Physics_MostlyAsleep(benchmark::State& state) {
+    const bool sleeping = state.range(0) != 0;
+    const int num_bodies = static_cast<int>(state.range(1));
+    const int row_length = static_cast<int>(std::sqrt(static_cast<float>(num_bodies)));
+    
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.enable_sleeping = sleeping;
+    PhysicsWorld world(config);
+    
+    std::vector<std::shared_ptr<RigidBody>> moving;
+    for (int i = 0; i < num_bodies; ++i) {
+        const int row = i / row_length;
+        auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)));
+        body->setPosition(Vector2<float>(static_cast<float>(i % row_length) * 2.0f, static_cast<float>(row) * 2.0f));
+        if (row % 10 == 0) moving.push_back(body);
+        world.addBody(body);
+    }
+    for (int step = 0; step < 60; ++step) {
+        for (auto& body : moving) body->setLinearVelocity(Vector2<float>(1.0f, 0.0f));
+        world.step(1.0f / 60.0f);
+    }
+    
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    state.counters["awake"] = static_cast<double>(world.getStats().active_bodies);
+    state.counters["broad_phase_ms"] = world.getStats().broad_phase_time * 1000.0f;
+    state.SetItemsProcessed(state.iterations() * num_bodies);
+}
+BENCHMARK(BM_Physics_MostlyAsleep)
+    ->ArgNames({"sleeping", "bodies"})
+    ->ArgsProduct({{0, 1}, {10000, 50000}})
+    ->Unit(benchmark::kMillisecond);
+
+// Contact solve time against thread count. Scene 0 is 400 separate stacks
+// (many small islands), scene 1 one pile of leaning columns (a single
+// island solved by color). Threads 0 solves on the calling thread.
+static void BM_Physics_IslandSolve(benchmark::State& state) {
+    const int threads = static_cast<int>(state.range(0));
+    const bool pile = state.range(1) != 0;
+    
+    PhysicsConfig config;
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    std::unique_ptr<::PyNovaGE::Threading::ThreadPool> pool;
+    if (threads > 0) {
+        pool = std::make_unique<::PyNovaGE::Threading::ThreadPool>(static_cast<size_t>(threads));
+        world.setThreadPool(pool.get());
+    }
+    
+    world.addBody(std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(2000.0f, 1.0f)),
+                                              BodyType::Static));
+    const int columns = pile ? 100 : 400;
+    for (int column = 0; column < columns; ++column) {
+        for (int level = 0; level < 10; ++level) {
+            const float x = pile ? static_cast<float>(column) * 0.98f : static_cast<float>(column) * 3.0f - 600.0f;
+            auto box = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)));
+            box->setPosition(Vector2<float>(x, 1.0f + static_cast<float>(level) * 1.02f));
+            world.addBody(box);
+        }
+    }
+    for (int step = 0; step < 30; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    float solve_time = 0.0f;
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+        solve_time += world.getStats().solve_time;
+    }
+    
+    state.counters["islands"] = static_cast<double>(world.getStats().islands);
+    state.counters["contacts"] = static_cast<double>(world.getStats().contacts);
+    state.counters["solve_ms"] = solve_time * 1000.0f / static_cast<float>(state.iterations());
+}
+BENCHMARK(BM_Physics_IslandSolve)
+    ->ArgNames({"threads", "pile"})
+    ->ArgsProduct({{0, 2, 4, 8}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// A field of resting boxes plus bullets fired into it every step. Without
+// continuous collision the bullets pass straight through the first rows;
+// with it they stop at the first box. The 0-bullet case is the cost every
+// world pays for the feature existing at all.
+static void BM_Physics_ContinuousCollision(benchmark::State& state) {
+    const bool continuous = state.range(0) != 0;
+    const int num_bullets = static_cast<int>(state.range(1));
+    constexpr int kRowLength = 100;
+    constexpr int kBodies = 10000;
+
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    for (int i = 0; i < kBodies; ++i) {
+        auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(0.5f, 0.5f)));
+        body->setPosition(Vector2<float>(static_cast<float>(i % kRowLength) * 2.0f,
+                                         static_cast<float>(i / kRowLength) * 2.0f));
+        world.addBody(body);
+    }
+
+    std::vector<std::shared_ptr<RigidBody>> bullets;
+    for (int i = 0; i < num_bullets; ++i) {
+        auto bullet = std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.05f));
+        bullet->setContinuousCollision(continuous);
+        bullets.push_back(bullet);
+        world.addBody(bullet);
+    }
+
+    size_t hits = 0;
+    for (auto _ : state) {
+        // 30 units per step, several box spacings
+        for (int i = 0; i < num_bullets; ++i) {
+            bullets[i]->setPosition(Vector2<float>(-3.0f, static_cast<float>(i % kRowLength) * 2.0f));
+            bullets[i]->setLinearVelocity(Vector2<float>(1800.0f, 0.0f));
+        }
+        world.step(1.0f / 60.0f);
+        hits += world.getStats().continuous_hits;
+    }
+
+    state.counters["hits_per_step"] = static_cast<double>(hits) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * (kBodies + num_bullets));
+}
+BENCHMARK(BM_Physics_ContinuousCollision)
+    ->ArgNames({"ccd", "bullets"})
+    ->ArgsProduct({{0, 1}, {0, 100, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+// Narrow phase over a packed 50/50 scene of circles and boxes, per pair
+// through generateManifold() (batched = 0) or bucketed by shape pair with
+// NarrowPhase (batched = 1). narrow_phase_ms is PhysicsStats::narrow_phase_time
+// for the same scene stepped by a PhysicsWorld, contact setup included.
+static void BM_Physics_NarrowPhase(benchmark::State& state) {
+    const bool batched = state.range(0) != 0;
+    const int num_bodies = static_cast<int>(state.range(1));
+    const int row_length = static_cast<int>(std::sqrt(static_cast<float>(num_bodies)));
+    
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    std::mt19937 rng(5);
+    for (int i = 0; i < num_bodies; ++i) {
+        std::shared_ptr<CollisionShape> shape;
+        if (i % 2 == 0) {
+            shape = std::make_shared<CircleShape>(0.55f);
+        } else {
+            shape = std::make_shared<RectangleShape>(Vector2<float>(1.1f, 1.1f));
+        }
+        auto body = std::make_shared<RigidBody>(shape);
+        // Shuffled so the shape pairs come in no particular order
+        const int cell = static_cast<int>(rng() % static_cast<uint32_t>(num_bodies));
+        body->setPosition(Vector2<float>(static_cast<float>(cell % row_length), static_cast<float>(cell / row_length)));
+        world.addBody(body);
+    }
+    
+    // Every pair whose bounds overlap
+    std::vector<BroadPhasePair> pairs;
+    const auto& bodies = world.getBodies();
+    std::unordered_map<const RigidBody*, uint32_t> index_of;
+    for (uint32_t i = 0; i < bodies.size(); ++i) {
+        index_of[bodies[i].get()] = i;
+    }
+    for (uint32_t i = 0; i < bodies.size(); ++i) {
+        for (RigidBody* other : world.queryAABB(bodies[i]->getWorldBounds())) {
+            const uint32_t j = index_of[other];
+            if (i < j) pairs.push_back({i, j});
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    
+    NarrowPhase narrow_phase;
+    size_t hits = 0;
+    for (auto _ : state) {
+        hits = 0;
+        if (batched) {
+            narrow_phase.collide(pairs, world.getBodyStore());
+            hits = narrow_phase.getHits().size();
+        } else {
+            for (const auto& pair : pairs) {
+                const auto& a = bodies[pair.index1];
+                const auto& b = bodies[pair.index2];
+                auto manifold = CollisionDetection::generateManifold(a->getCollisionShape(), a->getPosition(),
+                                                                     b->getCollisionShape(), b->getPosition());
+                hits += manifold.hasCollision ? 1 : 0;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    
+    state.counters["pairs"] = static_cast<double>(pairs.size());
+    state.counters["hits"] = static_cast<double>(hits);
+    if (batched) {
+        float narrow_phase_time = 0.0f;
+        for (int step = 0; step < 20; ++step) {
+            world.step(1.0f / 60.0f);
+            narrow_phase_time += world.getStats().narrow_phase_time;
+        }
+        state.counters["narrow_phase_ms"] = narrow_phase_time * 1000.0f / 20.0f;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pairs.size()));
+}
+BENCHMARK(BM_Physics_NarrowPhase)
+    ->ArgNames({"batched", "bodies"})
+    ->ArgsProduct({{0, 1}, {1000, 10000}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Client-side rollback: each iteration restores the snapshot from 10 ticks
+// ago and simulates those 10 ticks again on a 5k-body world. save_us and
+// restore_us are the snapshot costs alone.
+static void BM_Physics_Rollback(benchmark::State& state) {
+    constexpr int kRollbackTicks = 10;
+    const int num_bodies = static_cast<int>(state.range(0));
+    const int row_length = static_cast<int>(std::sqrt(static_cast<float>(num_bodies)));
+    
+    PhysicsWorld world;
+    auto ground = std::make_shared<RigidBody>(
+        std::make_shared<RectangleShape>(Vector2<float>(static_cast<float>(row_length) * 3.0f, 1.0f)), BodyType::Static);
+    world.addBody(ground);
+    for (int i = 0; i < num_bodies; ++i) {
+        auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)));
+        body->setPosition(Vector2<float>(static_cast<float>(i % row_length) * 1.5f - static_cast<float>(row_length) * 0.75f,
+                                         1.0f + static_cast<float>(i / row_length) * 1.5f));
+        world.addBody(body);
+    }
+    for (int step = 0; step < 30; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    std::vector<std::byte> snapshot;
+    world.saveState(snapshot);
+    for (int tick = 0; tick < kRollbackTicks; ++tick) {
+        world.step(1.0f / 60.0f);
+    }
+    
+    for (auto _ : state) {
+        world.restoreState(snapshot);
+        for (int tick = 0; tick < kRollbackTicks; ++tick) {
+            world.step(1.0f / 60.0f);
+        }
+    }
+    
+    // Snapshot costs on their own
+    constexpr int kRepeats = 100;
+    std::vector<std::byte> scratch;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kRepeats; ++i) {
+        world.saveState(scratch);
+        benchmark::DoNotOptimize(scratch.data());
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kRepeats; ++i) {
+        world.restoreState(snapshot);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    state.counters["state_kb"] = static_cast<double>(snapshot.size()) / 1024.0;
+    state.counters["save_us"] = std::chrono::duration<double, std::micro>(middle - start).count() / kRepeats;
+    state.counters["restore_us"] = std::chrono::duration<double, std::micro>(end - middle).count() / kRepeats;
+    state.counters["ticks_per_s"] = benchmark::Counter(static_cast<double>(state.iterations() * kRollbackTicks),
+                                                       benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Physics_Rollback)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+// Zone-server world: 100k boxes and circles drifting over a 900x900 map in
+// zero gravity, stepped whole (regions = 0, islands solved in parallel) or
+// in 64-unit regions (regions = 1) on pools of 1 to 16 threads.
+static void BM_Physics_RegionScaling(benchmark::State& state) {
+    constexpr int kBodies = 100000;
+    constexpr float kMapSize = 900.0f;
+    const int threads = static_cast<int>(state.range(0));
+    const bool regions = state.range(1) != 0;
+    
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.enable_sleeping = false;
+    config.region_size = regions ? 64.0f : 0.0f;
+    PhysicsWorld world(config);
+    ::PyNovaGE::Threading::ThreadPool pool(static_cast<size_t>(threads));
+    world.setThreadPool(&pool);
+    
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(0.0f, kMapSize);
+    std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+    for (int i = 0; i < kBodies; ++i) {
+        std::shared_ptr<CollisionShape> shape;
+        if (i % 2 == 0) {
+            shape = std::make_shared<CircleShape>(0.5f);
+        } else {
+            shape = std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f));
+        }
+        auto body = std::make_shared<RigidBody>(shape);
+        body->setPosition(Vector2<float>(position(rng), position(rng)));
+        body->setLinearVelocity(Vector2<float>(velocity(rng), velocity(rng)));
+        world.addBody(body);
+    }
+    world.step(1.0f / 60.0f);
+    
+    float broad_phase_time = 0.0f;
+    float narrow_phase_time = 0.0f;
+    float solve_time = 0.0f;
+    for (auto _ : state) {
+        world.step(1.0f / 60.0f);
+        broad_phase_time += world.getStats().broad_phase_time;
+        narrow_phase_time += world.getStats().narrow_phase_time;
+        solve_time += world.getStats().solve_time;
+    }
+    
+    const float per_step = 1000.0f / static_cast<float>(state.iterations());
+    state.counters["contacts"] = static_cast<double>(world.getStats().contacts);
+    state.counters["boundary_contacts"] = static_cast<double>(world.getStats().boundary_contacts);
+    state.counters["broad_phase_ms"] = broad_phase_time * per_step;
+    state.counters["narrow_phase_ms"] = narrow_phase_time * per_step;
+    state.counters["solve_ms"] = solve_time * per_step;
+}
+BENCHMARK(BM_Physics_RegionScaling)
+    ->ArgNames({"threads", "regions"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// SpatialGrid maintenance for items drifting a little each frame: a serial
+// rebuild (mode 0), a rebuild on a 4-thread pool (mode 1) or an
+// incremental update (mode 2), followed by emitting the pairs into a
+// preallocated buffer. emit_us is the pair emission alone.
+static void BM_Physics_SpatialGrid(benchmark::State& state) {
+    const int mode = static_cast<int>(state.range(0));
+    const int num_items = static_cast<int>(state.range(1));
+    const float extent = std::sqrt(static_cast<float>(num_items)) * 2.0f;
+    
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> position(0.0f, extent);
+    std::uniform_real_distribution<float> drift(-0.05f, 0.05f);
+    std::vector<BroadPhaseProxy> proxies;
+    for (int i = 0; i < num_items; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        proxies.push_back({x, y, x + 1.0f, y + 1.0f, static_cast<uint32_t>(i)});
+    }
+    
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    SpatialGrid grid(2.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(extent, extent));
+    grid.rebuild(proxies);
+    std::vector<BroadPhasePair> pairs(grid.emitPairs({}) * 2);
+    
+    size_t moved = 0;
+    size_t pair_count = 0;
+    double emit_time = 0.0;
+    for (auto _ : state) {
+        for (auto& proxy : proxies) {
+            const float dx = drift(rng);
+            const float dy = drift(rng);
+            proxy.min_x += dx;
+            proxy.max_x += dx;
+            proxy.min_y += dy;
+            proxy.max_y += dy;
+        }
+        if (mode == 2) {
+            moved += grid.update(proxies);
+        } else {
+            grid.rebuild(proxies, mode == 1 ? &pool : nullptr);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        pair_count = grid.emitPairs(pairs);
+        auto end = std::chrono::high_resolution_clock::now();
+        emit_time += std::chrono::duration<double, std::micro>(end - start).count();
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    
+    state.counters["pairs"] = static_cast<double>(pair_count);
+    state.counters["moved"] = static_cast<double>(moved) / static_cast<double>(state.iterations());
+    state.counters["emit_us"] = emit_time / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+BENCHMARK(BM_Physics_SpatialGrid)
+    ->ArgNames({"mode", "items"})
+    ->ArgsProduct({{0, 1, 2}, {10000, 100000}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Crowd of NPCs walking back and forth under gravity over a 1000-unit level
+// of ground, ledges and walls (about 2000 static boxes), moved in one
+// moveCharacters() batch per frame on a pool of 1 to 8 threads.
+static void BM_Physics_CharacterBatch(benchmark::State& state) {
+    const int num_agents = static_cast<int>(state.range(0));
+    const int threads = static_cast<int>(state.range(1));
+    constexpr float kLevelWidth = 1000.0f;
+    constexpr float kDt = 1.0f / 60.0f;
+    
+    PhysicsWorld world;
+    auto addStatic = [&](float x, float y, float width, float height) {
+        auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(width, height)),
+                                                BodyType::Static);
+        body->setPosition(Vector2<float>(x, y));
+        world.addBody(body);
+    };
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    addStatic(kLevelWidth * 0.5f, -0.5f, kLevelWidth, 1.0f);
+    for (float x = 0.0f; x < kLevelWidth; x += 0.05f) {
+        const float roll = unit(rng);
+        if (roll < 0.05f) {
+            addStatic(x, 0.1f + 0.1f * unit(rng), 1.0f + 2.0f * unit(rng), 0.2f + 0.2f * unit(rng));    // Ledge
+        } else if (roll < 0.07f) {
+            addStatic(x, 1.5f, 0.5f, 3.0f);                                                             // Wall
+        } else if (roll < 0.12f) {
+            addStatic(x, 3.0f + 6.0f * unit(rng), 2.0f + 4.0f * unit(rng), 0.3f);                       // Platform
+        }
+    }
+    world.bakeStaticGeometry();
+    
+    CharacterConfig config;
+    std::vector<CharacterMove> moves(num_agents);
+    std::vector<CharacterResult> results(num_agents);
+    std::vector<float> speeds(num_agents);
+    std::vector<float> fall_speeds(num_agents, 0.0f);
+    for (int i = 0; i < num_agents; ++i) {
+        moves[i].position = Vector2<float>(kLevelWidth * unit(rng), 1.0f + 8.0f * unit(rng));
+        speeds[i] = (unit(rng) < 0.5f ? -1.0f : 1.0f) * (1.0f + 3.0f * unit(rng));
+    }
+    
+    ::PyNovaGE::Threading::ThreadPool pool(threads);
+    world.setThreadPool(threads > 1 ? &pool : nullptr);
+    
+    size_t grounded = 0;
+    double move_time = 0.0;
+    for (auto _ : state) {
+        for (int i = 0; i < num_agents; ++i) {
+            moves[i].displacement = Vector2<float>(speeds[i] * kDt, -fall_speeds[i] * kDt);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        world.moveCharacters(config, moves, results);
+        auto end = std::chrono::high_resolution_clock::now();
+        move_time += std::chrono::duration<double, std::milli>(end - start).count();
+        grounded = 0;
+        for (int i = 0; i < num_agents; ++i) {
+            moves[i].position = results[i].position;
+            fall_speeds[i] = results[i].grounded ? 0.0f : fall_speeds[i] + 9.81f * kDt;
+            grounded += results[i].grounded ? 1 : 0;
+            // Turn around at walls and at the level ends
+            if ((results[i].collided && !results[i].grounded) || moves[i].position.x < 1.0f ||
+                moves[i].position.x > kLevelWidth - 1.0f) {
+                speeds[i] = moves[i].position.x < kLevelWidth * 0.5f ? std::abs(speeds[i]) : -std::abs(speeds[i]);
+            }
+        }
+    }
+    
+    state.counters["static_shapes"] = static_cast<double>(world.getStaticGeometry().getShapeCount());
+    state.counters["grounded"] = static_cast<double>(grounded);
+    state.counters["agents_per_ms"] = static_cast<double>(state.iterations()) * num_agents / move_time;
+    state.SetItemsProcessed(state.iterations() * num_agents);
+}
+BENCHMARK(BM_Physics_CharacterBatch)
+    ->ArgNames({"agents", "threads"})
+    ->ArgsProduct({{1000, 10000}, {1, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 //------------------------------------------------------------------------------
 // Memory Performance Tests
 //------------------------------------------------------------------------------
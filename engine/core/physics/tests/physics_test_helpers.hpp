@@ -0,0 +1,29 @@
+#pragma once
+
+#include "physics/physics_world.hpp"
+#include <memory>
+
+namespace PyNovaGE {
+namespace Physics {
+namespace Testing {
+
+/**
+ * @brief Box body centred at (x, y)
+ */
+inline std::shared_ptr<RigidBody> makeBox(float x, float y, BodyType type = BodyType::Dynamic,
+                                          const Vector2<float>& size = Vector2<float>(1.0f, 1.0f)) {
+    auto box = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(size), type);
+    box->setPosition(Vector2<float>(x, y));
+    return box;
+}
+
+/**
+ * @brief Static floor slab of the given width, centred on the origin
+ */
+inline std::shared_ptr<RigidBody> makeGround(float width = 200.0f) {
+    return makeBox(0.0f, 0.0f, BodyType::Static, Vector2<float>(width, 1.0f));
+}
+
+} // namespace Testing
+} // namespace Physics
+} // namespace PyNovaGE
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "physics/physics_world.hpp"
+#include <random>
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+void fillStore(BodyStore& store, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> value(-5.0f, 5.0f);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t slot = store.add(nullptr);
+        for (BodyField field : {BodyField::PositionX, BodyField::PositionY, BodyField::Rotation,
+                                BodyField::VelocityX, BodyField::VelocityY, BodyField::AngularVelocity,
+                                BodyField::ForceX, BodyField::ForceY, BodyField::Torque}) {
+            store.at(field, slot) = value(rng);
+        }
+        // Some bodies almost at rest and about to fall asleep
+        if (i % 5 == 0) {
+            store.at(BodyField::VelocityX, slot) = 0.0f;
+            store.at(BodyField::VelocityY, slot) = 0.0f;
+            store.at(BodyField::AngularVelocity, slot) = 0.0f;
+            store.at(BodyField::ForceX, slot) = 0.0f;
+            store.at(BodyField::ForceY, slot) = 0.0f;
+            store.at(BodyField::Torque, slot) = 0.0f;
+            store.at(BodyField::SleepTime, slot) = 0.49f;
+        }
+        store.at(BodyField::InverseMass, slot) = i % 7 == 0 ? 0.0f : 0.5f;
+        store.at(BodyField::InverseInertia, slot) = 0.25f;
+        store.setDrag(slot, 0.01f * static_cast<float>(i % 4));
+
+        // Mix of dynamic, sleeping and static bodies
+        uint32_t flags = BodyStore::kFlagActive;
+        if (i % 3 != 0) flags |= BodyStore::kFlagDynamic;
+        if (i % 4 != 0) flags |= BodyStore::kFlagAwake;
+        store.flags()[slot] = flags;
+    }
+}
+
+} // anonymous namespace
+
+TEST(BodyStoreTest, SimdIntegrationMatchesScalar) {
+    // Not a multiple of the SIMD width, so the scalar tail runs too
+    constexpr size_t kCount = 101;
+    BodyStore simd;
+    BodyStore scalar;
+    fillStore(simd, kCount, 3);
+    fillStore(scalar, kCount, 3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(simd.data(BodyField::PositionX)) % BodyStore::kAlignment, 0u);
+
+    const Vector2<float> gravity(0.0f, -1.0f);
+    for (int step = 0; step < 3; ++step) {
+        simd.integrate(1.0f / 60.0f, gravity);
+        scalar.integrateScalar(1.0f / 60.0f, gravity, 0, scalar.size());
+    }
+
+    for (size_t field = 0; field < BodyStore::kFieldCount; ++field) {
+        for (size_t i = 0; i < kCount; ++i) {
+            EXPECT_FLOAT_EQ(simd.data(static_cast<BodyField>(field))[i], scalar.data(static_cast<BodyField>(field))[i])
+                << "field " << field << " body " << i;
+        }
+    }
+    for (size_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(simd.flags()[i], scalar.flags()[i]) << "body " << i;
+    }
+    // The bodies at rest fell asleep
+    EXPECT_EQ(simd.flags()[5] & BodyStore::kFlagAwake, 0u);
+}
+
+TEST(BodyStoreTest, BodiesKeepStateAcrossWorlds) {
+    auto body = std::make_shared<RigidBody>(std::make_shared<CircleShape>(1.0f));
+    body->setPosition(Vector2<float>(1.0f, 2.0f));
+    body->setLinearVelocity(Vector2<float>(3.0f, 0.0f));
+    const float inverse_mass = body->getInverseMass();
+
+    {
+        PhysicsWorld world;
+        world.addBody(body);
+        EXPECT_EQ(&body->getStore(), &world.getBodyStore());
+        EXPECT_FLOAT_EQ(body->getPosition().x, 1.0f);
+        EXPECT_FLOAT_EQ(body->getInverseMass(), inverse_mass);
+
+        PhysicsWorld other;
+        EXPECT_THROW(other.addBody(body), std::invalid_argument);
+
+        world.step(1.0f / 60.0f);
+        EXPECT_GT(body->getPosition().x, 1.0f);
+    }
+
+    // The world is gone; the body still has its state
+    const float x = body->getPosition().x;
+    EXPECT_GT(x, 1.0f);
+    EXPECT_FLOAT_EQ(body->getInverseMass(), inverse_mass);
+    body->setPosition(Vector2<float>(x + 1.0f, 0.0f));
+    EXPECT_FLOAT_EQ(body->getPosition().x, x + 1.0f);
+}
+
+TEST(BodyStoreTest, RemovingBodiesRenumbersSlots) {
+    PhysicsWorld world;
+    std::vector<std::shared_ptr<RigidBody>> bodies;
+    for (int i = 0; i < 20; ++i) {
+        auto body = std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.5f));
+        body->setPosition(Vector2<float>(static_cast<float>(i) * 3.0f, 0.0f));
+        world.addBody(body);
+        bodies.push_back(body);
+    }
+
+    world.removeBody(bodies[3]);
+    world.removeBody(bodies[10].get());
+    EXPECT_EQ(world.getBodyStore().size(), 18u);
+    EXPECT_FLOAT_EQ(bodies[3]->getPosition().x, 9.0f);
+    EXPECT_FLOAT_EQ(bodies[10]->getPosition().x, 30.0f);
+
+    const auto& remaining = world.getBodies();
+    for (size_t i = 0; i < remaining.size(); ++i) {
+        EXPECT_EQ(remaining[i]->getStoreSlot(), i);
+        EXPECT_EQ(world.getBodyStore().getOwner(static_cast<uint32_t>(i)), remaining[i].get());
+    }
+    EXPECT_FLOAT_EQ(bodies[19]->getPosition().x, 57.0f);
+
+    world.clear();
+    EXPECT_EQ(world.getBodyStore().size(), 0u);
+    EXPECT_FLOAT_EQ(bodies[19]->getPosition().x, 57.0f);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "physics/broad_phase.hpp"
+#include "physics/physics_world.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+std::vector<BroadPhaseProxy> makeProxies(std::mt19937& rng, size_t count, float extent) {
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.2f, 3.0f);
+
+    std::vector<BroadPhaseProxy> proxies;
+    for (size_t i = 0; i < count; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        // Index the bodies out of order to check pairs use body indices
+        proxies.push_back({x, y, x + size(rng), y + size(rng), static_cast<uint32_t>(count - 1 - i)});
+    }
+    return proxies;
+}
+
+std::vector<BroadPhasePair> sortedPairs(BroadPhase& broad_phase, const std::vector<BroadPhaseProxy>& proxies) {
+    std::vector<BroadPhasePair> pairs;
+    broad_phase.findPairs(proxies, pairs);
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // anonymous namespace
+
+TEST(BroadPhaseTest, AllTypesMatchBruteForce) {
+    std::mt19937 rng(42);
+    auto proxies = makeProxies(rng, 2000, 60.0f);
+
+    // One proxy large enough to bypass the grid
+    proxies.push_back({-100.0f, -2.0f, 100.0f, 2.0f, static_cast<uint32_t>(proxies.size())});
+
+    BruteForceBroadPhase reference;
+    SweepAndPruneBroadPhase sap;
+    UniformGridBroadPhase grid(2.0f);
+    DynamicTreeBroadPhase tree(0.1f);
+
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    for (int frame = 0; frame < 5; ++frame) {
+        const auto expected = sortedPairs(reference, proxies);
+        ASSERT_FALSE(expected.empty());
+        for (const auto& pair : expected) {
+            EXPECT_LT(pair.index1, pair.index2);
+        }
+
+        EXPECT_EQ(sortedPairs(sap, proxies), expected) << "frame " << frame;
+        EXPECT_EQ(sortedPairs(grid, proxies), expected) << "frame " << frame;
+        EXPECT_EQ(sortedPairs(tree, proxies), expected) << "frame " << frame;
+
+        // Small moves exercise the incremental re-sort
+        for (auto& proxy : proxies) {
+            const float dx = jitter(rng);
+            const float dy = jitter(rng);
+            proxy.min_x += dx;
+            proxy.max_x += dx;
+            proxy.min_y += dy;
+            proxy.max_y += dy;
+        }
+    }
+
+    // Large moves force the full re-sort path
+    std::shuffle(proxies.begin(), proxies.end(), rng);
+    for (auto& proxy : proxies) {
+        std::swap(proxy.min_x, proxy.min_y);
+        std::swap(proxy.max_x, proxy.max_y);
+    }
+    EXPECT_EQ(sortedPairs(sap, proxies), sortedPairs(reference, proxies));
+
+    // Dropping proxies must remove them from the tree
+    proxies.resize(proxies.size() / 2);
+    EXPECT_EQ(sortedPairs(tree, proxies), sortedPairs(reference, proxies));
+    EXPECT_EQ(tree.getTree().getProxyCount(), proxies.size());
+    EXPECT_TRUE(tree.getTree().validate());
+}
+
+TEST(BroadPhaseTest, GridPairsAreUnique) {
+    // Heavily overlapping proxies spanning many shared cells
+    std::vector<BroadPhaseProxy> proxies;
+    for (uint32_t i = 0; i < 20; ++i) {
+        proxies.push_back({0.0f, 0.0f, 7.5f, 7.5f, i});
+    }
+
+    UniformGridBroadPhase grid(1.0f);
+    std::vector<BroadPhasePair> pairs;
+    grid.findPairs(proxies, pairs);
+    EXPECT_EQ(pairs.size(), 20u * 19u / 2u);
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+    EXPECT_EQ(std::adjacent_find(pairs.begin(), pairs.end()), pairs.end());
+
+    EXPECT_THROW(UniformGridBroadPhase(0.0f), std::invalid_argument);
+}
+
+TEST(BroadPhaseTest, WorldResultsIndependentOfBroadPhase) {
+    auto runScene = [](BroadPhaseType type) {
+        auto world = PhysicsWorldBuilder().setBroadPhase(type, 2.0f).build();
+        EXPECT_EQ(world->getConfig().broad_phase, type);
+
+        auto ground = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(200.0f, 1.0f)),
+                                                  BodyType::Static);
+        ground->setPosition(Vector2<float>(0.0f, -1.0f));
+        world->addBody(ground);
+
+        std::vector<std::shared_ptr<RigidBody>> boxes;
+        for (int i = 0; i < 200; ++i) {
+            auto box = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f)));
+            box->setPosition(Vector2<float>(static_cast<float>(i % 50) * 1.5f - 37.0f,
+                                            static_cast<float>(i / 50) * 1.2f + 0.5f));
+            world->addBody(box);
+            boxes.push_back(box);
+        }
+
+        size_t total_pairs = 0;
+        for (int step = 0; step < 30; ++step) {
+            world->step(1.0f / 60.0f);
+            total_pairs += world->getStats().broad_phase_pairs;
+        }
+
+        std::vector<float> heights;
+        for (const auto& box : boxes) heights.push_back(box->getPosition().y);
+        return std::make_pair(total_pairs, heights);
+    };
+
+    const auto reference = runScene(BroadPhaseType::BruteForce);
+    EXPECT_GT(reference.first, 0u);
+
+    for (BroadPhaseType type : {BroadPhaseType::SweepAndPrune, BroadPhaseType::UniformGrid,
+                                BroadPhaseType::DynamicTree}) {
+        const auto result = runScene(type);
+        EXPECT_EQ(result.first, reference.first);
+        ASSERT_EQ(result.second.size(), reference.second.size());
+        for (size_t i = 0; i < result.second.size(); ++i) {
+            EXPECT_FLOAT_EQ(result.second[i], reference.second[i]);
+        }
+    }
+}
+
+TEST(BroadPhaseTest, SetConfigSwitchesBroadPhase) {
+    PhysicsWorld world;
+    EXPECT_EQ(world.getConfig().broad_phase, BroadPhaseType::SweepAndPrune);
+
+    auto a = std::make_shared<RigidBody>(std::make_shared<CircleShape>(1.0f));
+    auto b = std::make_shared<RigidBody>(std::make_shared<CircleShape>(1.0f));
+    b->setPosition(Vector2<float>(1.5f, 0.0f));
+    world.addBody(a);
+    world.addBody(b);
+
+    PhysicsConfig config = world.getConfig();
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    config.broad_phase = BroadPhaseType::UniformGrid;
+    config.broad_phase_cell_size = 0.5f;
+    world.setConfig(config);
+    EXPECT_EQ(world.getConfig().broad_phase, BroadPhaseType::UniformGrid);
+
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().broad_phase_pairs, 1u);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "physics/physics_world.hpp"
+#include "threading/thread_pool.hpp"
+#include <cmath>
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+void addStaticBox(PhysicsWorld& world, float x, float y, float width, float height) {
+    auto body = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(width, height)),
+                                            BodyType::Static);
+    body->setPosition(Vector2<float>(x, y));
+    world.addBody(body);
+}
+
+// Ground with its top at y = 0, a 0.2 step from x = 5 to a 2 tall wall at
+// x = 12, and a 0.5 ledge left of x = -10
+void buildLevel(PhysicsWorld& world) {
+    addStaticBox(world, 0.0f, -0.5f, 40.0f, 1.0f);
+    addStaticBox(world, -12.0f, 0.25f, 4.0f, 0.5f);
+    addStaticBox(world, 8.5f, 0.1f, 7.0f, 0.2f);
+    addStaticBox(world, 12.5f, 1.0f, 1.0f, 2.0f);
+}
+
+// Walk a character at 3 units/s under gravity, feeding results back in
+CharacterResult walk(PhysicsWorld& world, const CharacterConfig& config, Vector2<float> position,
+                     float speed, int steps) {
+    const float dt = 1.0f / 60.0f;
+    float fall_speed = 0.0f;
+    CharacterResult result;
+    for (int step = 0; step < steps; ++step) {
+        fall_speed = result.grounded ? 0.0f : fall_speed + 9.81f * dt;
+        CharacterMove move{position, Vector2<float>(speed * dt, -fall_speed * dt)};
+        world.moveCharacters(config, std::span<const CharacterMove>(&move, 1), std::span<CharacterResult>(&result, 1));
+        position = result.position;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(CharacterControllerTest, FallsLandsAndIsStoppedByWalls) {
+    PhysicsWorld world;
+    buildLevel(world);
+    world.bakeStaticGeometry();
+    EXPECT_EQ(world.getStaticGeometry().getShapeCount(), 4u);
+
+    CharacterConfig config;
+    const float stand_height = config.height * 0.5f;
+
+    // Dropped from above, lands on the ground and stays there
+    auto result = walk(world, config, Vector2<float>(-5.0f, 3.0f), 0.0f, 90);
+    EXPECT_TRUE(result.grounded);
+    EXPECT_NEAR(result.position.y, stand_height, 0.05f);
+    EXPECT_NEAR(result.position.x, -5.0f, 1e-4f);
+    EXPECT_NEAR(result.ground_normal.y, 1.0f, 1e-4f);
+
+    // Walking into the tall wall stops at it, still on top of the step
+    result = walk(world, config, Vector2<float>(9.0f, stand_height + 0.3f), 3.0f, 120);
+    EXPECT_TRUE(result.grounded);
+    EXPECT_NEAR(result.position.x, 12.0f - config.radius, 0.05f);
+    EXPECT_NEAR(result.position.y, 0.2f + stand_height, 0.05f);
+
+    // Sliding diagonally along the wall keeps the part of the move along it
+    CharacterMove move{Vector2<float>(11.0f, 1.5f), Vector2<float>(2.0f, 0.5f)};
+    config.step_height = 0.0f;
+    world.moveCharacters(config, std::span<const CharacterMove>(&move, 1), std::span<CharacterResult>(&result, 1));
+    EXPECT_TRUE(result.collided);
+    EXPECT_LT(result.position.x, 12.0f - config.radius + 0.001f);
+    EXPECT_NEAR(result.position.y, 2.0f, 0.02f);
+}
+
+TEST(CharacterControllerTest, StepsOntoLowLedgesOnly) {
+    PhysicsWorld world;
+    buildLevel(world);
+    world.bakeStaticGeometry();
+
+    CharacterConfig config;
+    const float stand_height = config.height * 0.5f;
+
+    auto result = walk(world, config, Vector2<float>(2.0f, stand_height), 3.0f, 120);
+    EXPECT_TRUE(result.grounded);
+    EXPECT_GT(result.position.x, 7.5f);
+    EXPECT_FALSE(result.stepped);  // Only on the frame it climbed
+    EXPECT_NEAR(result.position.y, 0.2f + stand_height, 0.05f);
+
+    // With a lower step limit the ledge is a wall
+    config.step_height = 0.1f;
+    result = walk(world, config, Vector2<float>(2.0f, stand_height), 3.0f, 120);
+    EXPECT_TRUE(result.grounded);
+    EXPECT_GT(result.position.x, 4.5f);
+    EXPECT_LT(result.position.x, 4.7f);     // The rounded bottom meets the ledge corner first
+    EXPECT_NEAR(result.position.y, stand_height, 0.05f);
+
+    // Ledges taller than the capsule radius meet its side, not its bottom,
+    // and are stepped onto as a whole
+    config.step_height = 0.6f;
+    result = walk(world, config, Vector2<float>(-7.0f, stand_height), -3.0f, 120);
+    EXPECT_TRUE(result.grounded);
+    EXPECT_LT(result.position.x, -12.5f);
+    EXPECT_NEAR(result.position.y, 0.5f + stand_height, 0.05f);
+    config.step_height = 0.3f;
+    result = walk(world, config, Vector2<float>(-7.0f, stand_height), -3.0f, 120);
+    EXPECT_NEAR(result.position.x, -10.0f + config.radius, 0.05f);
+}
+
+TEST(CharacterControllerTest, BatchesMatchSingleMovesOnAnyPool) {
+    PhysicsWorld world;
+    buildLevel(world);
+
+    // Nothing is baked yet, so nothing blocks
+    CharacterConfig config;
+    CharacterMove through{Vector2<float>(0.0f, 0.5f), Vector2<float>(0.0f, -5.0f)};
+    CharacterResult result;
+    world.moveCharacters(config, std::span<const CharacterMove>(&through, 1), std::span<CharacterResult>(&result, 1));
+    EXPECT_FALSE(result.collided);
+    EXPECT_FLOAT_EQ(result.position.y, -4.5f);
+
+    world.bakeStaticGeometry();
+    std::vector<CharacterMove> moves;
+    for (int i = 0; i < 1000; ++i) {
+        const float x = -15.0f + static_cast<float>(i % 100) * 0.3f;
+        const float y = 0.5f + static_cast<float>(i / 100) * 0.4f;
+        moves.push_back({Vector2<float>(x, y), Vector2<float>(std::sin(static_cast<float>(i)) * 0.5f, -0.3f)});
+    }
+
+    std::vector<CharacterResult> serial(moves.size());
+    world.moveCharacters(config, moves, serial);
+
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    world.setThreadPool(&pool);
+    std::vector<CharacterResult> parallel(moves.size());
+    world.moveCharacters(config, moves, parallel);
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        CharacterResult single;
+        world.moveCharacters(config, std::span<const CharacterMove>(&moves[i], 1), std::span<CharacterResult>(&single, 1));
+        ASSERT_EQ(serial[i].position.x, single.position.x) << "character " << i;
+        ASSERT_EQ(serial[i].position.y, single.position.y) << "character " << i;
+        ASSERT_EQ(parallel[i].position.x, single.position.x) << "character " << i;
+        ASSERT_EQ(parallel[i].position.y, single.position.y) << "character " << i;
+        // Nobody ends up inside the ground
+        EXPECT_GE(serial[i].position.y, config.height * 0.5f - 0.001f) << "character " << i;
+    }
+
+    std::vector<CharacterResult> short_buffer(10);
+    EXPECT_THROW(world.moveCharacters(config, moves, short_buffer), std::invalid_argument);
+    config.height = config.radius;
+    EXPECT_THROW(world.moveCharacters(config, moves, serial), std::invalid_argument);
+}
@@ -200,6 +200,42 @@ TEST_F(CollisionShapesTest, ManifoldGeneration_NoCollision) {
 }
 
 // Performance regression tests
+TEST_F(CollisionShapesTest, CapsuleShapeAndManifolds) {
+    CapsuleShape capsule(0.5f, 3.0f);
+    EXPECT_EQ(capsule.getType(), ShapeType::Capsule);
+    EXPECT_FLOAT_EQ(capsule.getHalfLength(), 1.0f);
+    EXPECT_FLOAT_EQ(capsule.getHeight(), 3.0f);
+    
+    auto bounds = capsule.getBounds(Vector2<float>(1.0f, 1.0f));
+    EXPECT_FLOAT_EQ(bounds.min[0], 0.5f);
+    EXPECT_FLOAT_EQ(bounds.min[1], -0.5f);
+    EXPECT_FLOAT_EQ(bounds.max[1], 2.5f);
+    
+    // Beside the straight part the capsule is as wide as its radius...
+    Vector2<float> origin(0.0f, 0.0f);
+    EXPECT_TRUE(capsule.intersects(*circle_shape, origin, Vector2<float>(2.9f, 0.9f)));
+    EXPECT_TRUE(circle_shape->intersects(capsule, Vector2<float>(2.9f, 0.9f), origin));
+    EXPECT_FALSE(capsule.intersects(*circle_shape, origin, Vector2<float>(3.1f, 0.9f)));
+    // ...and its caps are round, so the bounding-box corner is empty
+    EXPECT_FALSE(capsule.intersects(*rect_shape, origin, Vector2<float>(2.45f, 2.45f)));
+    EXPECT_TRUE(rect_shape->intersects(capsule, Vector2<float>(2.3f, 2.0f), origin));
+    
+    // Resting on a rectangle: pushed straight up by the overlap
+    auto manifold = CollisionDetection::generateManifold(*rect_shape, Vector2<float>(0.0f, 0.0f),
+                                                         capsule, Vector2<float>(0.5f, 2.4f));
+    ASSERT_TRUE(manifold.hasCollision);
+    EXPECT_NEAR(manifold.normal.x, 0.0f, 1e-6f);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, 1e-6f);
+    EXPECT_NEAR(manifold.penetration, 0.1f, 1e-5f);
+    EXPECT_NEAR(manifold.contactPoint.y, 1.0f, 1e-5f);
+    
+    // Capsule against capsule side by side
+    manifold = CollisionDetection::generateManifold(capsule, origin, capsule, Vector2<float>(-0.8f, 0.5f));
+    ASSERT_TRUE(manifold.hasCollision);
+    EXPECT_FLOAT_EQ(manifold.normal.x, -1.0f);
+    EXPECT_NEAR(manifold.penetration, 0.2f, 1e-5f);
+}
+
 TEST_F(CollisionShapesTest, PerformanceRegression_ManyIntersectionTests) {
     auto rect1 = std::make_shared<RectangleShape>(Vector2<float>(2.0f, 2.0f));
     auto rect2 = std::make_shared<RectangleShape>(Vector2<float>(2.0f, 2.0f));
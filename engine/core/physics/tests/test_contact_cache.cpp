@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "physics/physics_world.hpp"
+#include "physics_test_helpers.hpp"
+
+using namespace PyNovaGE::Physics;
+using namespace ::PyNovaGE::Physics::Testing;
+
+namespace {
+
+// Height of the top box of a settled column of the given height
+float settledStackTop(bool warm_starting, int velocity_iterations, int height) {
+    PhysicsConfig config;
+    config.enable_warm_starting = warm_starting;
+    config.velocity_iterations = velocity_iterations;
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    world.addBody(makeGround(40.0f));
+
+    std::shared_ptr<RigidBody> top;
+    for (int level = 0; level < height; ++level) {
+        top = makeBox(0.0f, 1.0f + static_cast<float>(level) * 1.05f);
+        world.addBody(top);
+    }
+    for (int step = 0; step < 600; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+    return top->getPosition().y;
+}
+
+} // anonymous namespace
+
+TEST(ContactCacheTest, RestingContactsAreWarmStarted) {
+    // Stays awake so the contact is solved every step
+    PhysicsConfig config;
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    world.addBody(makeGround(40.0f));
+    auto box = makeBox(0.0f, 1.2f);
+    world.addBody(box);
+
+    for (int step = 0; step < 120; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+
+    // The contact persists from step to step and starts from its cached impulse
+    EXPECT_EQ(world.getStats().contacts, 1u);
+    EXPECT_EQ(world.getStats().warm_started_contacts, 1u);
+    EXPECT_NEAR(box->getPosition().y, 1.0f, 0.02f);
+    EXPECT_NEAR(box->getLinearVelocity().y, 0.0f, 0.01f);
+
+    // Removing a body renumbers the others, so the cache starts over
+    auto other = makeBox(10.0f, 10.0f);
+    world.addBody(other);
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().warm_started_contacts, 1u);
+    world.removeBody(other);
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().contacts, 1u);
+    EXPECT_EQ(world.getStats().warm_started_contacts, 0u);
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().warm_started_contacts, 1u);
+
+    // Disabled warm starting never seeds contacts
+    config.enable_warm_starting = false;
+    world.setConfig(config);
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().contacts, 1u);
+    EXPECT_EQ(world.getStats().warm_started_contacts, 0u);
+}
+
+TEST(ContactCacheTest, WarmStartedStacksHoldWithFewIterations) {
+    constexpr int kHeight = 8;
+
+    // Cached impulses carry the weight of the stack from step to step, so the
+    // result barely depends on the iteration count
+    const float warm_low = settledStackTop(true, 2, kHeight);
+    const float warm_high = settledStackTop(true, 16, kHeight);
+    EXPECT_NEAR(warm_low, warm_high, 0.01f);
+    EXPECT_GT(warm_low, static_cast<float>(kHeight) - 0.5f);
+
+    // Cold-started contacts sink into each other at the same iteration count
+    const float cold_low = settledStackTop(false, 2, kHeight);
+    EXPECT_LT(cold_low, warm_low - 0.5f);
+}
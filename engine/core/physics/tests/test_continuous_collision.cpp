@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "physics/physics_world.hpp"
+#include "physics_test_helpers.hpp"
+#include <cmath>
+
+using namespace PyNovaGE::Physics;
+using namespace ::PyNovaGE::Physics::Testing;
+
+namespace {
+
+std::shared_ptr<RigidBody> makeWall(float x) {
+    // 0.2 thick, far thinner than a projectile moves in one step
+    return makeBox(x, 0.0f, BodyType::Static, Vector2<float>(0.2f, 20.0f));
+}
+
+std::shared_ptr<RigidBody> makeProjectile(bool continuous, float speed) {
+    auto projectile = std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.1f));
+    projectile->setPosition(Vector2<float>(0.0f, 0.0f));
+    projectile->setLinearVelocity(Vector2<float>(speed, 0.0f));
+    projectile->setContinuousCollision(continuous);
+    return projectile;
+}
+
+} // anonymous namespace
+
+TEST(ContinuousCollisionTest, SweepFindsFirstContact) {
+    RectangleShape box(Vector2<float>(2.0f, 2.0f));
+    CircleShape ball(0.5f);
+
+    // Circle into circle
+    auto hit = CollisionDetection::sweep(ball, Vector2<float>(-5.0f, 0.0f), Vector2<float>(10.0f, 0.0f),
+                                         ball, Vector2<float>(0.0f, 0.0f));
+    ASSERT_TRUE(hit.hit);
+    EXPECT_NEAR(hit.toi, 0.4f, 1e-5f);
+    EXPECT_NEAR(hit.normal.x, -1.0f, 1e-5f);
+
+    // Box into box face
+    hit = CollisionDetection::sweep(box, Vector2<float>(0.0f, 10.0f), Vector2<float>(0.5f, -20.0f),
+                                    box, Vector2<float>(0.0f, 0.0f));
+    ASSERT_TRUE(hit.hit);
+    EXPECT_NEAR(hit.toi, 0.4f, 1e-5f);
+    EXPECT_FLOAT_EQ(hit.normal.y, 1.0f);
+
+    // Circle past a box corner: the rounded corner is hit later than the grown box
+    hit = CollisionDetection::sweep(ball, Vector2<float>(-5.0f, 1.3f), Vector2<float>(10.0f, 0.0f),
+                                    box, Vector2<float>(0.0f, 0.0f));
+    ASSERT_TRUE(hit.hit);
+    const float expected_x = -1.0f - std::sqrt(0.25f - 0.09f);
+    EXPECT_NEAR(hit.toi, (expected_x + 5.0f) / 10.0f, 1e-4f);
+    EXPECT_LT(hit.normal.x, 0.0f);
+    EXPECT_GT(hit.normal.y, 0.0f);
+
+    // Box into circle is the same rounded box seen from the other side
+    auto reverse = CollisionDetection::sweep(box, Vector2<float>(5.0f, -1.3f), Vector2<float>(-10.0f, 0.0f),
+                                             ball, Vector2<float>(0.0f, 0.0f));
+    ASSERT_TRUE(reverse.hit);
+    EXPECT_NEAR(reverse.toi, hit.toi, 1e-4f);
+
+    // Starting in the corner square of the grown box but outside the
+    // rounded corner still finds the corner
+    hit = CollisionDetection::sweep(ball, Vector2<float>(-1.45f, 1.3f), Vector2<float>(1.0f, 0.0f),
+                                    box, Vector2<float>(0.0f, 0.0f));
+    ASSERT_TRUE(hit.hit);
+    EXPECT_NEAR(hit.toi, expected_x + 1.45f, 1e-4f);
+
+    // Just missing the corner, too short and already overlapping are not hits
+    EXPECT_FALSE(CollisionDetection::sweep(ball, Vector2<float>(-5.0f, 1.55f), Vector2<float>(10.0f, 0.0f),
+                                           box, Vector2<float>(0.0f, 0.0f)).hit);
+    EXPECT_FALSE(CollisionDetection::sweep(ball, Vector2<float>(-5.0f, 0.0f), Vector2<float>(1.0f, 0.0f),
+                                           box, Vector2<float>(0.0f, 0.0f)).hit);
+    EXPECT_FALSE(CollisionDetection::sweep(ball, Vector2<float>(0.2f, 0.0f), Vector2<float>(10.0f, 0.0f),
+                                           box, Vector2<float>(0.0f, 0.0f)).hit);
+}
+
+TEST(ContinuousCollisionTest, ProjectilesDoNotTunnelThroughThinWalls) {
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+
+    // 1200 units/s is 20 units per step
+    for (bool continuous : {false, true}) {
+        PhysicsWorld world(config);
+        world.addBody(makeWall(30.0f));
+        auto projectile = makeProjectile(continuous, 1200.0f);
+        world.addBody(projectile);
+
+        for (int step = 0; step < 10; ++step) {
+            world.step(1.0f / 60.0f);
+        }
+
+        if (continuous) {
+            EXPECT_LT(projectile->getPosition().x, 30.0f) << "tunnelled";
+            // Bounced back with the default restitution
+            EXPECT_LT(projectile->getLinearVelocity().x, 0.0f);
+        } else {
+            EXPECT_GT(projectile->getPosition().x, 30.0f) << "the discrete test should miss the wall";
+        }
+    }
+}
+
+TEST(ContinuousCollisionTest, ProjectilesKeepMovingAfterGlancingHits) {
+    PhysicsConfig config;
+    config.gravity = Vector2<float>(0.0f, 0.0f);
+    PhysicsWorld world(config);
+
+    // A floor the projectile skims along at a shallow angle
+    auto floor = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(200.0f, 0.2f)),
+                                             BodyType::Static);
+    floor->setPosition(Vector2<float>(0.0f, -1.0f));
+    world.addBody(floor);
+
+    auto projectile = makeProjectile(true, 600.0f);
+    projectile->setLinearVelocity(Vector2<float>(600.0f, -100.0f));
+    Material material = projectile->getMaterial();
+    material.restitution = 0.0f;
+    projectile->setMaterial(material);
+    world.addBody(projectile);
+
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().continuous_hits, 1u);
+    // Stopped at the floor but used the rest of the step to slide along it
+    EXPECT_GT(projectile->getPosition().y, -1.0f);
+    EXPECT_NEAR(projectile->getPosition().x, 10.0f, 0.05f);
+    EXPECT_NEAR(projectile->getLinearVelocity().y, 0.0f, 1e-4f);
+
+    // Bodies that do not opt in are never swept
+    projectile->setContinuousCollision(false);
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().continuous_hits, 0u);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "physics/dynamic_aabb_tree.hpp"
+#include "physics/physics_world.hpp"
+#include "physics_test_helpers.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace PyNovaGE::Physics;
+using namespace ::PyNovaGE::Physics::Testing;
+
+namespace {
+
+Bounds2D randomBounds(std::mt19937& rng, float extent) {
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+    const float x = position(rng);
+    const float y = position(rng);
+    return {x, y, x + size(rng), y + size(rng)};
+}
+
+bool rayHitsBounds(const Bounds2D& b, const Vector2<float>& origin, const Vector2<float>& direction, float max_t) {
+    float t_enter = 0.0f;
+    float t_exit = max_t;
+    const float origins[2] = {origin.x, origin.y};
+    const float directions[2] = {direction.x, direction.y};
+    const float mins[2] = {b.min_x, b.min_y};
+    const float maxs[2] = {b.max_x, b.max_y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::abs(directions[axis]) < 1e-12f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) return false;
+            continue;
+        }
+        float t1 = (mins[axis] - origins[axis]) / directions[axis];
+        float t2 = (maxs[axis] - origins[axis]) / directions[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        t_enter = std::max(t_enter, t1);
+        t_exit = std::min(t_exit, t2);
+    }
+    return t_enter <= t_exit;
+}
+
+} // anonymous namespace
+
+TEST(DynamicAABBTreeTest, StaysValidUnderRandomUpdates) {
+    std::mt19937 rng(7);
+    DynamicAABBTree tree(0.2f);
+
+    std::vector<int32_t> proxies;
+    std::vector<Bounds2D> bounds;
+    for (uint32_t i = 0; i < 500; ++i) {
+        bounds.push_back(randomBounds(rng, 100.0f));
+        proxies.push_back(tree.createProxy(bounds.back(), i));
+    }
+    ASSERT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getProxyCount(), 500u);
+    // Balanced enough that queries stay logarithmic
+    EXPECT_LT(tree.getHeight(), 25);
+
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    for (int round = 0; round < 20; ++round) {
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            const float dx = jitter(rng);
+            const float dy = jitter(rng);
+            bounds[i] = {bounds[i].min_x + dx, bounds[i].min_y + dy, bounds[i].max_x + dx, bounds[i].max_y + dy};
+            tree.moveProxy(proxies[i], bounds[i]);
+            EXPECT_TRUE(tree.getFatBounds(proxies[i]).contains(bounds[i]));
+        }
+
+        // Replace a few proxies to exercise node reuse
+        for (int k = 0; k < 10; ++k) {
+            const size_t victim = rng() % proxies.size();
+            tree.destroyProxy(proxies[victim]);
+            bounds[victim] = randomBounds(rng, 100.0f);
+            proxies[victim] = tree.createProxy(bounds[victim], static_cast<uint32_t>(victim));
+        }
+        ASSERT_TRUE(tree.validate()) << "round " << round;
+    }
+
+    // Small moves inside the margin do not touch the tree
+    EXPECT_FALSE(tree.moveProxy(proxies[0], bounds[0]));
+
+    for (int32_t proxy : proxies) tree.destroyProxy(proxy);
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getProxyCount(), 0u);
+}
+
+TEST(DynamicAABBTreeTest, QueryAndRaycastMatchLinearScan) {
+    std::mt19937 rng(11);
+    DynamicAABBTree tree(0.1f);
+
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        proxies.push_back(tree.createProxy(randomBounds(rng, 50.0f), i));
+    }
+
+    for (int q = 0; q < 50; ++q) {
+        const Bounds2D query = randomBounds(rng, 50.0f);
+
+        std::vector<uint32_t> expected;
+        for (int32_t proxy : proxies) {
+            if (tree.getFatBounds(proxy).overlaps(query)) expected.push_back(tree.getUserData(proxy));
+        }
+        std::vector<uint32_t> found;
+        tree.query(query, [&](int32_t proxy) {
+            found.push_back(tree.getUserData(proxy));
+            return true;
+        });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    for (int r = 0; r < 50; ++r) {
+        const Vector2<float> origin(position(rng), position(rng));
+        // Include axis-aligned rays to exercise the parallel-slab case
+        const Vector2<float> direction = r % 5 == 0 ? Vector2<float>(1.0f, 0.0f)
+                                                    : Vector2<float>(position(rng), position(rng));
+
+        std::vector<uint32_t> expected;
+        for (int32_t proxy : proxies) {
+            if (rayHitsBounds(tree.getFatBounds(proxy), origin, direction, 1.0f)) {
+                expected.push_back(tree.getUserData(proxy));
+            }
+        }
+        std::vector<uint32_t> found;
+        tree.raycast(origin, direction, 1.0f, [&](int32_t proxy, float max_t) {
+            found.push_back(tree.getUserData(proxy));
+            return max_t;
+        });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST(DynamicAABBTreeTest, WorldQueriesFollowMovedBodies) {
+    PhysicsWorld world;
+    std::vector<std::shared_ptr<RigidBody>> bodies;
+    for (int i = 0; i < 100; ++i) {
+        bodies.push_back(makeBox(static_cast<float>(i % 10) * 3.0f, static_cast<float>(i / 10) * 3.0f, BodyType::Static));
+        world.addBody(bodies.back());
+    }
+
+    // Teleport a body far away; queries see it once the tree is refreshed
+    bodies[5]->setPosition(Vector2<float>(500.0f, 500.0f));
+    world.updateQueryTree();
+    EXPECT_TRUE(world.getQueryTree().validate());
+
+    auto hits = world.queryPoint(Vector2<float>(500.2f, 500.2f));
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0], bodies[5].get());
+    EXPECT_TRUE(world.queryPoint(Vector2<float>(15.0f, 0.0f)).empty());
+
+    // Removing a body renumbers the ones after it
+    world.removeBody(bodies[2]);
+    EXPECT_EQ(world.getQueryTree().getProxyCount(), 99u);
+    auto shifted = world.queryPoint(Vector2<float>(9.0f, 0.0f));
+    ASSERT_EQ(shifted.size(), 1u);
+    EXPECT_EQ(shifted[0], bodies[3].get());
+
+    CircleShape probe(2.0f);
+    auto near = world.queryShape(probe, Vector2<float>(27.0f, 27.0f));
+    ASSERT_EQ(near.size(), 1u);
+    EXPECT_EQ(near[0], bodies[99].get());
+
+    std::pmr::vector<RigidBody*> buffer;
+    world.queryShape(probe, Vector2<float>(-50.0f, -50.0f), buffer);
+    EXPECT_TRUE(buffer.empty());
+
+    world.clear();
+    EXPECT_EQ(world.getQueryTree().getProxyCount(), 0u);
+}
+
+TEST(DynamicAABBTreeTest, RaycastsClipToClosestHit) {
+    PhysicsWorld world;
+    std::vector<std::shared_ptr<RigidBody>> row;
+    for (int i = 0; i < 10; ++i) {
+        row.push_back(makeBox(static_cast<float>(i) * 4.0f, 0.0f, BodyType::Static));
+        world.addBody(row.back());
+    }
+
+    auto hit = world.raycast(Vector2<float>(-10.0f, 0.0f), Vector2<float>(100.0f, 0.0f));
+    ASSERT_TRUE(hit.hasHit);
+    EXPECT_EQ(hit.body, row[0].get());
+    EXPECT_NEAR(hit.distance, 9.5f, 1e-2f);
+
+    std::pmr::vector<PhysicsWorld::RaycastHit> all;
+    world.raycastAll(Vector2<float>(-10.0f, 0.0f), Vector2<float>(100.0f, 0.0f), all);
+    ASSERT_EQ(all.size(), row.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i].body, row[i].get());
+    }
+
+    const std::vector<PhysicsWorld::RaySegment> rays = {
+        {Vector2<float>(50.0f, 0.0f), Vector2<float>(-50.0f, 0.0f)},  // Hits the last box first
+        {Vector2<float>(0.0f, 10.0f), Vector2<float>(0.0f, 5.0f)},    // Misses everything
+        {Vector2<float>(-10.0f, 0.0f), Vector2<float>(100.0f, 0.0f)},
+    };
+    std::vector<PhysicsWorld::RaycastHit> hits(rays.size());
+    world.raycastBatch(rays, hits);
+    ASSERT_TRUE(hits[0].hasHit);
+    EXPECT_EQ(hits[0].body, row.back().get());
+    EXPECT_FALSE(hits[1].hasHit);
+    EXPECT_EQ(hits[2].body, row[0].get());
+
+    std::vector<PhysicsWorld::RaycastHit> any(rays.size());
+    world.raycastAnyBatch(rays, any);
+    EXPECT_TRUE(any[0].hasHit);
+    EXPECT_FALSE(any[1].hasHit);
+    EXPECT_TRUE(any[2].hasHit);
+
+    std::vector<PhysicsWorld::RaycastHit> too_small(1);
+    EXPECT_THROW(world.raycastBatch(rays, too_small), std::invalid_argument);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "physics/island.hpp"
+#include "physics/physics_world.hpp"
+#include "threading/thread_pool.hpp"
+#include "physics_test_helpers.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace PyNovaGE::Physics;
+using namespace ::PyNovaGE::Physics::Testing;
+
+namespace {
+
+constexpr uint32_t kNoBody = IslandBuilder::kNoBody;
+
+// A wide pile whose columns lean on each other, large enough to be solved
+// by color, next to a few small separate stacks
+void buildScene(PhysicsWorld& world) {
+    world.addBody(makeGround());
+    for (int column = 0; column < 20; ++column) {
+        for (int level = 0; level < 15; ++level) {
+            world.addBody(makeBox(static_cast<float>(column) * 0.98f, 1.0f + static_cast<float>(level) * 1.02f));
+        }
+    }
+    for (int stack = 0; stack < 8; ++stack) {
+        for (int level = 0; level < 3; ++level) {
+            world.addBody(makeBox(40.0f + static_cast<float>(stack) * 3.0f, 1.0f + static_cast<float>(level) * 1.02f));
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(IslandTest, BuilderGroupsBodiesThroughDynamicContactsOnly) {
+    IslandBuilder builder;
+    builder.reset(7);
+    for (uint32_t body : {0u, 1u, 2u, 4u, 5u, 6u}) {
+        builder.addBody(body);
+    }
+    builder.addContact(0, 5, 1);
+    builder.addContact(1, 1, kNoBody);      // Both rest on the same ground...
+    builder.addContact(2, kNoBody, 2);      // ...which does not join them
+    builder.addContact(3, 6, 0);
+    builder.addContact(4, kNoBody, kNoBody);
+    builder.finish();
+
+    ASSERT_EQ(builder.getIslandCount(), 4u);
+    auto bodies = [&](size_t island) {
+        auto span = builder.getIslandBodies(island);
+        return std::vector<uint32_t>(span.begin(), span.end());
+    };
+    auto contacts = [&](size_t island) {
+        auto span = builder.getIslandContacts(island);
+        return std::vector<uint32_t>(span.begin(), span.end());
+    };
+    EXPECT_EQ(bodies(0), (std::vector<uint32_t>{0, 6}));
+    EXPECT_EQ(contacts(0), (std::vector<uint32_t>{3}));
+    EXPECT_EQ(bodies(1), (std::vector<uint32_t>{1, 5}));
+    EXPECT_EQ(contacts(1), (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(bodies(2), (std::vector<uint32_t>{2}));
+    EXPECT_EQ(contacts(2), (std::vector<uint32_t>{2}));
+    EXPECT_EQ(bodies(3), (std::vector<uint32_t>{4}));
+    EXPECT_TRUE(contacts(3).empty());
+    EXPECT_EQ(builder.getIsland(6), 0u);
+}
+
+TEST(IslandTest, ColorsNeverShareABody) {
+    std::mt19937 rng(3);
+    constexpr uint32_t kBodies = 40;
+    std::vector<uint32_t> body1;
+    std::vector<uint32_t> body2;
+    for (int i = 0; i < 2000; ++i) {
+        const uint32_t a = rng() % kBodies;
+        body1.push_back(a);
+        body2.push_back(i % 5 == 0 ? kNoBody : (a + 1 + rng() % (kBodies - 1)) % kBodies);
+    }
+    std::vector<uint32_t> contacts(body1.size());
+    for (uint32_t i = 0; i < contacts.size(); ++i) contacts[i] = i;
+
+    ContactColoring coloring;
+    coloring.build(contacts, body1.data(), body2.data(), kBodies);
+
+    std::vector<uint32_t> seen;
+    for (size_t color = 0; color < coloring.getColorCount(); ++color) {
+        std::vector<bool> used(kBodies, false);
+        for (uint32_t contact : coloring.getColor(color)) {
+            for (uint32_t body : {body1[contact], body2[contact]}) {
+                if (body == kNoBody) continue;
+                EXPECT_FALSE(used[body]) << "color " << color << " contact " << contact;
+                used[body] = true;
+            }
+            seen.push_back(contact);
+        }
+    }
+    // Denser than 64 contacts per body, so some overflow
+    EXPECT_FALSE(coloring.getOverflow().empty());
+    seen.insert(seen.end(), coloring.getOverflow().begin(), coloring.getOverflow().end());
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen, contacts);
+}
+
+TEST(IslandTest, StacksSleepAndWakeAsAWhole) {
+    PhysicsWorld world;
+    world.addBody(makeGround());
+    std::vector<std::shared_ptr<RigidBody>> stack;
+    for (int level = 0; level < 5; ++level) {
+        stack.push_back(makeBox(0.0f, 1.0f + static_cast<float>(level) * 1.02f));
+        world.addBody(stack.back());
+    }
+
+    int steps = 0;
+    while (world.getStats().sleeping_bodies < stack.size() && steps < 600) {
+        world.step(1.0f / 60.0f);
+        ++steps;
+    }
+    ASSERT_LT(steps, 600);
+    const float resting_top = stack.back()->getPosition().y;
+    EXPECT_NEAR(resting_top, 5.0f, 0.2f);
+
+    // Nothing left to integrate, pair up or solve
+    world.step(1.0f / 60.0f);
+    EXPECT_EQ(world.getStats().broad_phase_proxies, 0u);
+    EXPECT_EQ(world.getStats().contacts, 0u);
+    EXPECT_EQ(world.getStats().islands, 0u);
+    EXPECT_FLOAT_EQ(stack.back()->getPosition().y, resting_top);
+    EXPECT_TRUE(world.getAwakeBodies().empty());
+
+    // A box dropped on top wakes the whole stack
+    auto dropped = makeBox(0.0f, 8.0f);
+    world.addBody(dropped);
+    for (int i = 0; i < 60 && stack[0]->isAwake() == false; ++i) {
+        world.step(1.0f / 60.0f);
+    }
+    for (const auto& box : stack) {
+        EXPECT_TRUE(box->isAwake());
+    }
+    // Everything but the static ground, in body order
+    const std::vector<uint32_t> awake(world.getAwakeBodies().begin(), world.getAwakeBodies().end());
+    EXPECT_EQ(awake, (std::vector<uint32_t>{1, 2, 3, 4, 5, 6}));
+
+    // Removing the bottom box wakes what rested on it, after everything slept again
+    for (int i = 0; i < 600 && world.getStats().sleeping_bodies < stack.size() + 1; ++i) {
+        world.step(1.0f / 60.0f);
+    }
+    ASSERT_FALSE(stack[1]->isAwake());
+    world.removeBody(stack[0]);
+    EXPECT_TRUE(world.getAwakeBodies().empty());
+    EXPECT_TRUE(stack[1]->isAwake());
+    EXPECT_TRUE(dropped->isAwake());
+}
+
+TEST(IslandTest, ParallelSolveMatchesSerial) {
+    PhysicsWorld serial;
+    PhysicsWorld parallel;
+    buildScene(serial);
+    buildScene(parallel);
+
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    parallel.setThreadPool(&pool);
+
+    for (int step = 0; step < 30; ++step) {
+        serial.step(1.0f / 60.0f);
+        parallel.step(1.0f / 60.0f);
+    }
+    // The pile is one island above the coloring threshold, plus the stacks
+    EXPECT_GT(serial.getStats().contacts, 256u);
+    EXPECT_EQ(serial.getStats().islands, 9u);
+    EXPECT_EQ(parallel.getStats().islands, 9u);
+
+    const auto& a = serial.getBodies();
+    const auto& b = parallel.getBodies();
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i]->getPosition().x, b[i]->getPosition().x) << "body " << i;
+        EXPECT_EQ(a[i]->getPosition().y, b[i]->getPosition().y) << "body " << i;
+    }
+}
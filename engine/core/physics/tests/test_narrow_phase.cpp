@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "physics/narrow_phase.hpp"
+#include "physics/physics_world.hpp"
+#include <random>
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+std::shared_ptr<CollisionShape> randomShape(std::mt19937& rng) {
+    std::uniform_real_distribution<float> size(0.2f, 1.5f);
+    switch (rng() % 5) {
+        case 0:
+        case 1:
+            return std::make_shared<CircleShape>(size(rng));
+        case 2:
+        case 3:
+            return std::make_shared<RectangleShape>(Vector2<float>(size(rng), size(rng)));
+        default:
+            return std::make_shared<CapsuleShape>(size(rng) * 0.5f, size(rng) * 2.0f);
+    }
+}
+
+} // anonymous namespace
+
+TEST(NarrowPhaseTest, BatchedKernelsMatchGenerateManifold) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coordinate(0.0f, 12.0f);
+
+    PhysicsWorld world;
+    for (int i = 0; i < 150; ++i) {
+        auto body = std::make_shared<RigidBody>(randomShape(rng));
+        body->setPosition(Vector2<float>(coordinate(rng), coordinate(rng)));
+        world.addBody(body);
+    }
+    // A few exactly coincident centers for the fallback normals
+    for (int i = 0; i < 3; ++i) {
+        world.getBodies()[i + 10]->setPosition(world.getBodies()[i]->getPosition());
+    }
+
+    std::vector<BroadPhasePair> pairs;
+    for (uint32_t a = 0; a < world.getBodyCount(); ++a) {
+        for (uint32_t b = a + 1; b < world.getBodyCount(); ++b) {
+            pairs.push_back({a, b});
+        }
+    }
+
+    NarrowPhase narrow_phase;
+    narrow_phase.collide(pairs, world.getBodyStore());
+    for (size_t t = 0; t < NarrowPhase::kPairTypeCount; ++t) {
+        EXPECT_GT(narrow_phase.getPairCount(static_cast<ShapePairType>(t)), 8u);
+    }
+
+    std::vector<bool> touching(pairs.size(), false);
+    for (uint32_t hit : narrow_phase.getHits()) {
+        touching[hit] = true;
+    }
+    EXPECT_GT(narrow_phase.getHits().size(), 100u);
+
+    const auto& bodies = world.getBodies();
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        const auto& a = bodies[pairs[p].index1];
+        const auto& b = bodies[pairs[p].index2];
+        auto expected = CollisionDetection::generateManifold(a->getCollisionShape(), a->getPosition(),
+                                                             b->getCollisionShape(), b->getPosition());
+        ASSERT_EQ(touching[p], expected.hasCollision) << "pair " << p;
+        if (!expected.hasCollision) continue;
+
+        const auto& manifold = narrow_phase.getManifold(static_cast<uint32_t>(p));
+        EXPECT_NEAR(manifold.normal.x, expected.normal.x, 1e-4f) << "pair " << p;
+        EXPECT_NEAR(manifold.normal.y, expected.normal.y, 1e-4f) << "pair " << p;
+        EXPECT_NEAR(manifold.penetration, expected.penetration, 1e-4f) << "pair " << p;
+        EXPECT_NEAR(manifold.contactPoint.x, expected.contactPoint.x, 1e-4f) << "pair " << p;
+        EXPECT_NEAR(manifold.contactPoint.y, expected.contactPoint.y, 1e-4f) << "pair " << p;
+        EXPECT_EQ(manifold.featureId, expected.featureId) << "pair " << p;
+    }
+}
+
+TEST(NarrowPhaseTest, CapsulesRestOnTheGround) {
+    PhysicsConfig config;
+    config.enable_sleeping = false;
+    PhysicsWorld world(config);
+    auto ground = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(20.0f, 1.0f)),
+                                              BodyType::Static);
+    world.addBody(ground);
+
+    // Bottom cap touches the ground top at y = 0.5 when the center is at 1.5
+    auto capsule = std::make_shared<RigidBody>(std::make_shared<CapsuleShape>(0.5f, 2.0f));
+    capsule->setPosition(Vector2<float>(0.0f, 2.0f));
+    world.addBody(capsule);
+
+    for (int step = 0; step < 180; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+    EXPECT_NEAR(capsule->getPosition().y, 1.5f, 0.02f);
+    EXPECT_NEAR(capsule->getPosition().x, 0.0f, 1e-4f);
+    EXPECT_EQ(world.getStats().contacts, 1u);
+}
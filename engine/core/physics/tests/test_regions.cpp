@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "physics/region_grid.hpp"
+#include "physics/physics_world.hpp"
+#include "threading/thread_pool.hpp"
+#include <cmath>
+#include <random>
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+constexpr uint32_t kNoBody = RegionGrid::kNoBody;
+
+BroadPhaseProxy makeProxy(float x, float y, float half, uint32_t body) {
+    return {x - half, y - half, x + half, y + half, body};
+}
+
+std::vector<uint32_t> toVector(std::span<const uint32_t> span) {
+    return std::vector<uint32_t>(span.begin(), span.end());
+}
+
+// Boxes and circles dropped in overlapping rows onto a long ground, with
+// rows crossing plenty of region borders
+void buildScene(PhysicsWorld& world) {
+    world.addBody(std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(400.0f, 1.0f)),
+                                              BodyType::Static));
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    for (int i = 0; i < 600; ++i) {
+        std::shared_ptr<CollisionShape> shape;
+        if (i % 3 == 0) {
+            shape = std::make_shared<CircleShape>(0.5f);
+        } else {
+            shape = std::make_shared<RectangleShape>(Vector2<float>(1.0f, 1.0f));
+        }
+        auto body = std::make_shared<RigidBody>(shape);
+        body->setPosition(Vector2<float>(static_cast<float>(i % 100) * 0.95f - 45.0f + jitter(rng),
+                                         1.0f + static_cast<float>(i / 100) * 0.95f));
+        world.addBody(body);
+    }
+}
+
+} // anonymous namespace
+
+TEST(RegionTest, GridSplitsInteriorAndBoundaryProxies) {
+    // Regions of 10 over [0, 30) x [0, 10): three columns, one row
+    std::vector<BroadPhaseProxy> proxies = {
+        makeProxy(0.5f, 0.5f, 0.5f, 0),      // Interior to region 0
+        makeProxy(15.0f, 5.0f, 1.0f, 3),     // Interior to region 1
+        makeProxy(10.0f, 5.0f, 1.0f, 5),     // Across the 0/1 border
+        makeProxy(5.0f, 5.0f, 1.0f, 2),      // Interior to region 0
+        makeProxy(29.5f, 9.5f, 0.5f, 4),     // Interior to region 2
+        {3.0f, 1.0f, 27.0f, 3.0f, 1},        // Over all three
+    };
+    RegionGrid grid;
+    grid.build(proxies, 10.0f, 7);
+
+    ASSERT_EQ(grid.getRegionCount(), 3u);
+    EXPECT_EQ(toVector(grid.getRegionProxies(0)), (std::vector<uint32_t>{0, 3, 2, 5}));
+    EXPECT_EQ(grid.getInteriorCount(0), 2u);
+    EXPECT_EQ(toVector(grid.getRegionProxies(1)), (std::vector<uint32_t>{1, 2, 5}));
+    EXPECT_EQ(grid.getInteriorCount(1), 1u);
+    EXPECT_EQ(toVector(grid.getRegionProxies(2)), (std::vector<uint32_t>{4, 5}));
+    EXPECT_EQ(grid.getInteriorCount(2), 1u);
+    EXPECT_EQ(toVector(grid.getBoundaryProxies()), (std::vector<uint32_t>{2, 5}));
+
+    EXPECT_EQ(grid.getRegion(0), 0u);
+    EXPECT_EQ(grid.getRegion(2), 0u);
+    EXPECT_EQ(grid.getRegion(3), 1u);
+    EXPECT_EQ(grid.getRegion(4), 2u);
+    EXPECT_EQ(grid.getRegion(5), RegionGrid::kBoundary);
+    EXPECT_EQ(grid.getRegion(1), RegionGrid::kBoundary);
+    EXPECT_EQ(grid.getRegion(6), RegionGrid::kBoundary);   // No proxy
+
+    // Contacts go to the one region all their moving bodies are interior to
+    const std::vector<uint32_t> body1 = {0, kNoBody, 3, 0, 2, kNoBody, 6};
+    const std::vector<uint32_t> body2 = {2, 4, kNoBody, 3, 5, kNoBody, kNoBody};
+    grid.assignContacts(body1.data(), body2.data(), body1.size());
+    EXPECT_EQ(toVector(grid.getRegionContacts(0)), (std::vector<uint32_t>{0}));
+    EXPECT_EQ(toVector(grid.getRegionContacts(1)), (std::vector<uint32_t>{2}));
+    EXPECT_EQ(toVector(grid.getRegionContacts(2)), (std::vector<uint32_t>{1}));
+    EXPECT_EQ(toVector(grid.getBoundaryContacts()), (std::vector<uint32_t>{3, 4, 5, 6}));
+
+    // Far-off proxies land in the outer regions instead of growing the grid
+    proxies.push_back(makeProxy(1.0e6f, 5.0f, 0.5f, 6));
+    grid.build(proxies, 10.0f, 7);
+    EXPECT_EQ(grid.getRegionCount(), static_cast<size_t>(RegionGrid::kMaxRegionsPerAxis));
+    EXPECT_EQ(grid.getRegion(6), RegionGrid::kMaxRegionsPerAxis - 1u);
+
+    EXPECT_THROW(grid.build(proxies, 0.0f, 7), std::invalid_argument);
+}
+
+TEST(RegionTest, RegionsFindTheSameContacts) {
+    PhysicsConfig config;
+    PhysicsWorld whole(config);
+    config.region_size = 3.0f;
+    PhysicsWorld split(config);
+    buildScene(whole);
+    buildScene(split);
+
+    whole.step(1.0f / 60.0f);
+    split.step(1.0f / 60.0f);
+
+    // Same positions before solving, so the same pairs and contacts
+    EXPECT_GT(split.getStats().regions, 10u);
+    EXPECT_GT(split.getStats().boundary_contacts, 0u);
+    EXPECT_EQ(whole.getStats().regions, 0u);
+    EXPECT_EQ(split.getStats().broad_phase_pairs, whole.getStats().broad_phase_pairs);
+    EXPECT_EQ(split.getStats().contacts, whole.getStats().contacts);
+    EXPECT_GT(split.getStats().contacts, 600u);
+}
+
+TEST(RegionTest, RegionsSettleAndDoNotDependOnThreads) {
+    PhysicsConfig config;
+    config.region_size = 4.0f;
+    PhysicsWorld serial(config);
+    PhysicsWorld parallel(config);
+    buildScene(serial);
+    buildScene(parallel);
+
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    parallel.setThreadPool(&pool);
+
+    for (int step = 0; step < 240; ++step) {
+        serial.step(1.0f / 60.0f);
+        parallel.step(1.0f / 60.0f);
+    }
+
+    const auto& a = serial.getBodies();
+    const auto& b = parallel.getBodies();
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i]->getPosition().x, b[i]->getPosition().x) << "body " << i;
+        ASSERT_EQ(a[i]->getPosition().y, b[i]->getPosition().y) << "body " << i;
+    }
+
+    // Everything came to rest on the ground, including across region borders
+    for (size_t i = 1; i < a.size(); ++i) {
+        EXPECT_GT(a[i]->getPosition().y, 0.9f) << "body " << i;
+        EXPECT_LT(std::abs(a[i]->getLinearVelocity().y), 0.5f) << "body " << i;
+    }
+    EXPECT_EQ(serial.getStats().warm_started_contacts, serial.getStats().contacts);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "physics/spatial_grid.hpp"
+#include "threading/thread_pool.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace PyNovaGE::Physics;
+using PyNovaGE::Vector2;
+
+namespace {
+
+// Mostly small items over a 100x100 world, some straddling the world edge
+// or lying outside it, and a few spanning many cells
+std::vector<BroadPhaseProxy> makeProxies(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-5.0f, 105.0f);
+    std::uniform_real_distribution<float> size(0.2f, 3.0f);
+    std::vector<BroadPhaseProxy> proxies;
+    for (uint32_t i = 0; i < count; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        const float extent = i % 97 == 0 ? 30.0f : size(rng);
+        proxies.push_back({x, y, x + extent, y + size(rng), i * 3 + 1});
+    }
+    return proxies;
+}
+
+std::vector<BroadPhasePair> bruteForcePairs(const std::vector<BroadPhaseProxy>& proxies) {
+    std::vector<BroadPhasePair> pairs;
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        for (size_t j = i + 1; j < proxies.size(); ++j) {
+            if (proxies[i].overlaps(proxies[j])) {
+                pairs.push_back(BroadPhasePair::make(proxies[i].body_index, proxies[j].body_index));
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+std::vector<BroadPhasePair> gridPairs(const SpatialGrid& grid) {
+    std::vector<BroadPhasePair> pairs(grid.emitPairs({}));
+    EXPECT_EQ(grid.emitPairs(pairs), pairs.size());
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // anonymous namespace
+
+TEST(SpatialGridTest, EmitsEveryOverlappingPairOnce) {
+    SpatialGrid grid(4.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(100.0f, 100.0f));
+    auto proxies = makeProxies(2000, 1);
+    grid.rebuild(proxies);
+
+    EXPECT_EQ(grid.getItemCount(), proxies.size());
+    EXPECT_FALSE(grid.getOversized().empty());
+    const auto expected = bruteForcePairs(proxies);
+    ASSERT_GT(expected.size(), 1000u);
+    EXPECT_EQ(gridPairs(grid), expected);
+
+    // A short buffer gets what fits and the count says how many there are
+    std::vector<BroadPhasePair> few(10);
+    EXPECT_EQ(grid.emitPairs(few), expected.size());
+
+    // Cells list their items in item order after a rebuild
+    for (int cell = 0; cell < grid.getCellCount(); ++cell) {
+        auto items = grid.getCell(cell);
+        EXPECT_TRUE(std::is_sorted(items.begin(), items.end()));
+        for (uint32_t item : items) {
+            EXPECT_EQ(grid.getCellIndex(Vector2<float>(proxies[item].min_x, proxies[item].min_y)), cell);
+        }
+    }
+
+    grid.clear();
+    EXPECT_EQ(grid.emitPairs({}), 0u);
+    EXPECT_THROW(SpatialGrid(0.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(1.0f, 1.0f)), std::invalid_argument);
+}
+
+TEST(SpatialGridTest, IncrementalUpdatesMatchRebuilds) {
+    SpatialGrid grid(4.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(100.0f, 100.0f));
+    auto proxies = makeProxies(2000, 2);
+    grid.rebuild(proxies);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> step(-0.2f, 0.2f);
+    size_t moved = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        for (auto& proxy : proxies) {
+            const float dx = step(rng);
+            const float dy = step(rng);
+            proxy.min_x += dx;
+            proxy.max_x += dx;
+            proxy.min_y += dy;
+            proxy.max_y += dy;
+        }
+        moved += grid.update(proxies);
+        EXPECT_EQ(gridPairs(grid), bruteForcePairs(proxies)) << "frame " << frame;
+    }
+    // Only some items change cells each frame
+    EXPECT_GT(moved, 0u);
+    EXPECT_LT(moved, 20u * proxies.size() / 10);
+
+    // Every item is in the cell it would be sorted into from scratch
+    SpatialGrid fresh(4.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(100.0f, 100.0f));
+    fresh.rebuild(proxies);
+    for (int cell = 0; cell <= grid.getCellCount(); ++cell) {
+        auto a = grid.getCell(cell);
+        auto b = fresh.getCell(cell);
+        std::vector<uint32_t> items(a.begin(), a.end());
+        std::sort(items.begin(), items.end());
+        EXPECT_EQ(items, std::vector<uint32_t>(b.begin(), b.end())) << "cell " << cell;
+    }
+}
+
+TEST(SpatialGridTest, ParallelRebuildMatchesSerial) {
+    SpatialGrid serial(2.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(100.0f, 100.0f));
+    SpatialGrid parallel(2.0f, Vector2<float>(0.0f, 0.0f), Vector2<float>(100.0f, 100.0f));
+    auto proxies = makeProxies(40000, 4);
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+
+    serial.rebuild(proxies);
+    parallel.rebuild(proxies, &pool);
+    for (int cell = 0; cell <= serial.getCellCount(); ++cell) {
+        auto a = serial.getCell(cell);
+        auto b = parallel.getCell(cell);
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end())) << "cell " << cell;
+    }
+    EXPECT_EQ(serial.getStats().occupied_cells, parallel.getStats().occupied_cells);
+    EXPECT_EQ(serial.getStats().total_objects, proxies.size());
+}
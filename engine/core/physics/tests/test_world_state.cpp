@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "physics/physics_world.hpp"
+#include "threading/thread_pool.hpp"
+
+using namespace PyNovaGE::Physics;
+
+namespace {
+
+// Boxes and balls dropped onto a floor, with a projectile fired through them
+void buildScene(PhysicsWorld& world) {
+    auto floor = std::make_shared<RigidBody>(std::make_shared<RectangleShape>(Vector2<float>(60.0f, 1.0f)),
+                                             BodyType::Static);
+    world.addBody(floor);
+    for (int i = 0; i < 120; ++i) {
+        std::shared_ptr<CollisionShape> shape;
+        if (i % 3 == 0) {
+            shape = std::make_shared<CircleShape>(0.45f);
+        } else {
+            shape = std::make_shared<RectangleShape>(Vector2<float>(0.9f, 0.9f));
+        }
+        auto body = std::make_shared<RigidBody>(shape);
+        body->setPosition(Vector2<float>(static_cast<float>(i % 12) * 0.95f - 5.0f + 0.1f * static_cast<float>(i / 12),
+                                         1.0f + static_cast<float>(i / 12) * 1.1f));
+        world.addBody(body);
+    }
+    auto projectile = std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.1f));
+    projectile->setPosition(Vector2<float>(-20.0f, 2.0f));
+    projectile->setLinearVelocity(Vector2<float>(400.0f, 0.0f));
+    projectile->setContinuousCollision(true);
+    world.addBody(projectile);
+}
+
+void run(PhysicsWorld& world, int steps) {
+    for (int step = 0; step < steps; ++step) {
+        world.step(1.0f / 60.0f);
+    }
+}
+
+} // anonymous namespace
+
+TEST(WorldStateTest, RollbackReplaysBitForBit) {
+    PhysicsWorld world;
+    buildScene(world);
+    run(world, 30);
+
+    const auto snapshot = world.saveState();
+    run(world, 45);
+    const auto expected = world.saveState();
+    const Vector2<float> expected_position = world.getBodies()[5]->getPosition();
+
+    // Roll back and simulate the same ticks again
+    world.restoreState(snapshot);
+    EXPECT_EQ(world.saveState(), snapshot);
+    run(world, 45);
+    EXPECT_EQ(world.saveState(), expected);
+    EXPECT_EQ(world.getBodies()[5]->getPosition().x, expected_position.x);
+    EXPECT_EQ(world.getBodies()[5]->getPosition().y, expected_position.y);
+
+    // The same snapshot restored into a world built the same way
+    PhysicsWorld replica;
+    buildScene(replica);
+    replica.restoreState(snapshot);
+    run(replica, 45);
+    EXPECT_EQ(replica.saveState(), expected);
+}
+
+TEST(WorldStateTest, ResultsDoNotDependOnBroadPhaseOrThreads) {
+    PhysicsWorld reference;
+    buildScene(reference);
+    run(reference, 90);
+    const auto expected = reference.saveState();
+
+    for (BroadPhaseType type : {BroadPhaseType::BruteForce, BroadPhaseType::UniformGrid, BroadPhaseType::DynamicTree}) {
+        PhysicsConfig config;
+        config.broad_phase = type;
+        PhysicsWorld world(config);
+        buildScene(world);
+        run(world, 90);
+        EXPECT_EQ(world.saveState(), expected) << "broad phase " << static_cast<int>(type);
+    }
+
+    ::PyNovaGE::Threading::ThreadPool pool(3);
+    PhysicsWorld threaded;
+    threaded.setThreadPool(&pool);
+    buildScene(threaded);
+    run(threaded, 90);
+    EXPECT_EQ(threaded.saveState(), expected);
+}
+
+TEST(WorldStateTest, RejectsSnapshotsOfOtherWorlds) {
+    PhysicsWorld world;
+    buildScene(world);
+    auto snapshot = world.saveState();
+
+    PhysicsWorld smaller;
+    smaller.addBody(std::make_shared<RigidBody>(std::make_shared<CircleShape>(1.0f)));
+    EXPECT_THROW(smaller.restoreState(snapshot), std::invalid_argument);
+
+    snapshot.resize(snapshot.size() - 1);
+    EXPECT_THROW(world.restoreState(snapshot), std::invalid_argument);
+    EXPECT_THROW(world.restoreState(std::span<const std::byte>()), std::invalid_argument);
+}
@@ -8,7 +8,9 @@
 #include <array>
 #include <cmath>
 #include <algorithm>
+#include <memory_resource>
 #include <unordered_set>
+#include <vector>
 
 namespace PyNovaGE {
 namespace Renderer {
@@ -403,6 +405,14 @@ public:
     std::vector<std::pair<const Chunk*, Vector3f>> CullChunks(
         const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions);
 
+    /**
+     * @brief Perform frustum culling on chunks with world positions without allocating
+     * @param chunk_positions Vector of (chunk, world_position) pairs
+     * @param visible_chunks Receives the visible chunks (previous contents are replaced)
+     */
+    void CullChunks(const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions,
+                    std::pmr::vector<std::pair<const Chunk*, Vector3f>>& visible_chunks);
+
     /**
      * @brief Test if a single chunk is visible
      * @param chunk_world_bounds World-space AABB of chunk
@@ -501,6 +511,11 @@ private:
     Vector3f camera_forward_;
     Matrix4f view_projection_matrix_;
     CullingResult last_results_;
+    std::vector<ChunkCullInfo> cull_scratch_;  ///< Reused between frames by the pair overloads
+
+    template<typename Output>
+    void CullChunkPositions(const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions,
+                            Output& visible_chunks);
 };
 
 /**
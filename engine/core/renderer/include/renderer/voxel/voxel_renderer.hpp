@@ -6,6 +6,7 @@
 #include "frustum_culler.hpp"
 #include "shader_manager.hpp"
 #include "renderer/texture_array.hpp"
+#include <memory/memory_tracker.h>
 #include <vectors/vector3.hpp>
 #include <matrices/matrix4.hpp>
 #include <unordered_map>
@@ -111,7 +112,7 @@ struct VoxelRenderStats {
     
     // Memory statistics
     size_t gpu_memory_used = 0;      // Estimated GPU memory usage
-    size_t cpu_memory_used = 0;      // CPU memory for chunk data
+    size_t cpu_memory_used = 0;      // Tracked bytes of this renderer's chunk records and pending meshes (0 without memory tracking)
     
     // Performance metrics
     float culling_ratio = 0.0f;      // Percentage of chunks culled
@@ -303,6 +304,13 @@ private:
      * @return Vector of visible chunk render data
      */
     std::vector<ChunkRenderData*> CullChunks(const Camera& camera);
+
+    /**
+     * @brief Perform frustum culling on chunks into an existing vector
+     * @param camera Current camera
+     * @param visible Receives visible chunk render data (previous contents are replaced)
+     */
+    void CullChunks(const Camera& camera, std::vector<ChunkRenderData*>& visible);
     
     /**
      * @brief Render a batch of chunks
@@ -391,6 +399,7 @@ private:
     // Chunk management
     std::unordered_map<size_t, std::unique_ptr<ChunkRenderData>> chunk_render_data_;
     std::vector<ChunkRenderData*> visible_chunks_;
+    std::vector<ChunkCullInfo> cull_infos_;  ///< Culling scratch reused every frame
     
     // Multithreading
     std::vector<std::thread> mesh_workers_;
@@ -400,6 +409,7 @@ private:
     std::mutex completed_mesh_mutex_;
     std::atomic<bool> shutdown_workers_{false};
     std::atomic<uint32_t> next_task_id_{1};
+    MemoryScope memory_scope_{MemoryTag::VoxelMeshing};  ///< Chunk records and meshes awaiting upload
     
     // Statistics and timing
     VoxelRenderStats stats_;
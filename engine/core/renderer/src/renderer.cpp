@@ -3,6 +3,7 @@
 #include "renderer/texture.hpp"
 #include "renderer/sprite_renderer.hpp"
 #include "renderer/batch_renderer.hpp"
+#include <memory/frame_allocator.h>
 #include <glad/gl.h>
 #include <iostream>
 #include <sstream>
@@ -119,6 +120,9 @@ void Renderer::BeginFrame() {
     // Reset statistics
     s_stats_.Reset();
     
+    // Start a new frame for per-thread transient allocations
+    FrameAllocator::advanceFrame();
+    
     // Start frame timer
     static auto start_time = std::chrono::high_resolution_clock::now();
     start_time = std::chrono::high_resolution_clock::now();
@@ -61,26 +61,41 @@ CullingResult FrustumCuller::CullChunks(std::vector<ChunkCullInfo>& chunks) {
 std::vector<std::pair<const Chunk*, Vector3f>> FrustumCuller::CullChunks(
     const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions) {
     
-    // Convert to ChunkCullInfo format
-    std::vector<ChunkCullInfo> cull_infos;
-    cull_infos.reserve(chunk_positions.size());
+    std::vector<std::pair<const Chunk*, Vector3f>> visible_chunks;
+    CullChunkPositions(chunk_positions, visible_chunks);
+    return visible_chunks;
+}
+
+void FrustumCuller::CullChunks(
+    const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions,
+    std::pmr::vector<std::pair<const Chunk*, Vector3f>>& visible_chunks) {
+    
+    CullChunkPositions(chunk_positions, visible_chunks);
+}
+
+template<typename Output>
+void FrustumCuller::CullChunkPositions(
+    const std::vector<std::pair<const Chunk*, Vector3f>>& chunk_positions,
+    Output& visible_chunks) {
+    
+    // Convert to ChunkCullInfo format (scratch keeps its capacity across frames)
+    cull_scratch_.clear();
+    cull_scratch_.reserve(chunk_positions.size());
     
     for (const auto& [chunk, position] : chunk_positions) {
-        cull_infos.emplace_back(chunk, position);
+        cull_scratch_.emplace_back(chunk, position);
     }
     
     // Perform culling
-    CullChunks(cull_infos);
+    CullChunks(cull_scratch_);
     
     // Extract visible chunks
-    std::vector<std::pair<const Chunk*, Vector3f>> visible_chunks;
-    for (const auto& cull_info : cull_infos) {
+    visible_chunks.clear();
+    for (const auto& cull_info : cull_scratch_) {
         if (cull_info.is_visible) {
             visible_chunks.emplace_back(cull_info.chunk, cull_info.world_position);
         }
     }
-    
-    return visible_chunks;
 }
 
 bool FrustumCuller::IsChunkVisible(const AABB& chunk_world_bounds, float distance_to_camera) const {
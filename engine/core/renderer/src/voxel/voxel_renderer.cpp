@@ -6,6 +6,7 @@
 #include <set>
 #include <glad/gl.h>
 #include "renderer/texture_array.hpp"
+#include <memory/memory_tracker.h>
 
 #ifndef PVG_VOXEL_DEBUG_LOGS
 #define PVG_VOXEL_DEBUG_LOGS 0
@@ -15,6 +16,14 @@ namespace PyNovaGE {
 namespace Renderer {
 namespace Voxel {
 
+namespace {
+// CPU bytes held by a mesh that has been generated but not yet uploaded
+size_t GetMeshDataBytes(const GreedyMesher::MeshData& mesh_data) {
+    return mesh_data.vertices.capacity() * sizeof(mesh_data.vertices[0]) +
+           mesh_data.indices.capacity() * sizeof(mesh_data.indices[0]);
+}
+}
+
 VoxelRenderer::VoxelRenderer(const std::string& shader_directory)
     : shader_manager_(shader_directory) {
 }
@@ -229,11 +238,16 @@ void VoxelRenderer::Shutdown() {
     {
         std::lock_guard<std::mutex> lock(completed_mesh_mutex_);
         while (!completed_meshes_.empty()) {
+            const size_t bytes = GetMeshDataBytes(completed_meshes_.front().second);
+            memory_scope_.recordDeallocation(bytes);
             completed_meshes_.pop();
         }
     }
     
     // Clear chunk render data
+    for (size_t i = 0; i < chunk_render_data_.size(); ++i) {
+        memory_scope_.recordDeallocation(sizeof(ChunkRenderData));
+    }
     chunk_render_data_.clear();
     visible_chunks_.clear();
     
@@ -367,7 +381,7 @@ void VoxelRenderer::Render(const Camera& camera) {
     SetupRenderState(camera);
     
     // Cull chunks
-    visible_chunks_ = CullChunks(camera);
+    CullChunks(camera, visible_chunks_);
     
     // Render visible chunks
     RenderChunks(visible_chunks_, camera);
@@ -553,6 +567,8 @@ void VoxelRenderer::UploadMeshesToGPU() {
     while (!completed_meshes_.empty() && uploaded < config_.max_upload_per_frame) {
         auto [task_id, mesh_data] = std::move(completed_meshes_.front());
         completed_meshes_.pop();
+        const size_t mesh_bytes = GetMeshDataBytes(mesh_data);
+        memory_scope_.recordDeallocation(mesh_bytes);
         
         // Find the corresponding chunk render data
         // Look for chunks that have no mesh (regardless of needs_remesh flag)
@@ -585,25 +601,31 @@ void VoxelRenderer::UploadMeshesToGPU() {
     }
 }
 
-std::vector<ChunkRenderData*> VoxelRenderer::CullChunks([[maybe_unused]] const Camera& camera) {
+std::vector<ChunkRenderData*> VoxelRenderer::CullChunks(const Camera& camera) {
     std::vector<ChunkRenderData*> visible;
+    CullChunks(camera, visible);
+    return visible;
+}
+
+void VoxelRenderer::CullChunks([[maybe_unused]] const Camera& camera, std::vector<ChunkRenderData*>& visible) {
+    visible.clear();
     
     // Create culling info for all chunks
-    std::vector<ChunkCullInfo> cull_infos;
-    cull_infos.reserve(chunk_render_data_.size());
+    cull_infos_.clear();
+    cull_infos_.reserve(chunk_render_data_.size());
     
     for (auto& [key, render_data] : chunk_render_data_) {
         const Chunk* chunk = world_->GetChunk(render_data->world_position);
         if (chunk && render_data->mesh && !render_data->needs_remesh) {
-            cull_infos.emplace_back(chunk, render_data->world_position);
+            cull_infos_.emplace_back(chunk, render_data->world_position);
         }
     }
     
     // Perform culling
-    auto cull_result = frustum_culler_.CullChunks(cull_infos);
+    frustum_culler_.CullChunks(cull_infos_);
     
     // Extract visible chunks
-    for (const auto& cull_info : cull_infos) {
+    for (const auto& cull_info : cull_infos_) {
         if (cull_info.is_visible) {
             size_t key = WorldPositionToKey(cull_info.world_position);
             auto it = chunk_render_data_.find(key);
@@ -614,11 +636,9 @@ std::vector<ChunkRenderData*> VoxelRenderer::CullChunks([[maybe_unused]] const C
     }
     
     stats_.visible_chunks = visible.size();
-    stats_.culled_chunks = cull_infos.size() - visible.size();
-    stats_.culling_ratio = cull_infos.empty() ? 0.0f : 
-        static_cast<float>(stats_.culled_chunks) / cull_infos.size();
-    
-    return visible;
+    stats_.culled_chunks = cull_infos_.size() - visible.size();
+    stats_.culling_ratio = cull_infos_.empty() ? 0.0f : 
+        static_cast<float>(stats_.culled_chunks) / cull_infos_.size();
 }
 
 void VoxelRenderer::RenderChunks(const std::vector<ChunkRenderData*>& chunks, const Camera& camera) {
@@ -1176,7 +1196,10 @@ void VoxelRenderer::GenerateMesh(const MeshTask& task) {
     [[maybe_unused]] double generation_time = std::chrono::duration<double, std::milli>(
         end_time - start_time).count();
     
-    // Add to completed queue
+    // Add to completed queue; the mesh is charged to VoxelMeshing until uploaded
+    // TODO: Allocate mesh buffers from a TLSFAllocator instead of the global heap
+    const size_t mesh_bytes = GetMeshDataBytes(mesh_data);
+    memory_scope_.recordAllocation(mesh_bytes);
     {
         std::lock_guard<std::mutex> lock(completed_mesh_mutex_);
         completed_meshes_.emplace(task.task_id, std::move(mesh_data));
@@ -1213,6 +1236,7 @@ ChunkRenderData& VoxelRenderer::GetOrCreateChunkRenderData(const Vector3f& world
         auto render_data = std::make_unique<ChunkRenderData>(world_position);
         auto* ptr = render_data.get();
         chunk_render_data_[key] = std::move(render_data);
+        memory_scope_.recordAllocation(sizeof(ChunkRenderData));
         return *ptr;
     }
     
@@ -1234,8 +1258,9 @@ void VoxelRenderer::UpdateStats() {
         stats_.fps = static_cast<float>(1000.0 / stats_.frame_time_ms);
     }
     
-    // Update memory estimates
-    stats_.cpu_memory_used = chunk_render_data_.size() * sizeof(ChunkRenderData);
+    // This renderer's scope: chunk records plus meshes waiting for upload;
+    // the MemoryTag::VoxelMeshing total covers every renderer
+    stats_.cpu_memory_used = memory_scope_.getStats().current_bytes;
     // TODO: Calculate GPU memory usage from mesh data
 }
 
@@ -0,0 +1,411 @@
+#include <benchmark/benchmark.h>
+#include "scene/entity.hpp"
+#include "scene/components.hpp"
+#include "scene/scene.hpp"
+#include "threading/thread_pool.hpp"
+#include "physics/physics_world.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace PyNovaGE::Scene;
+
+namespace {
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Acceleration {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+// Every entity has a Position, every other one a Velocity and every
+// fourth an Acceleration, so the join matches a quarter of them
+void populate(EntityManager& manager, int count) {
+    for (int i = 0; i < count; ++i) {
+        EntityID entity = manager.CreateEntity();
+        manager.AddComponent<Position>(entity, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0) manager.AddComponent<Velocity>(entity, 1.0f, 0.5f);
+        if (i % 4 == 0) manager.AddComponent<Acceleration>(entity, 0.0f, -9.81f);
+    }
+}
+
+// Velocity += acceleration * dt, position += velocity * dt
+struct Integrate {
+    float dt = 0.016f;
+    void operator()(Position& position, Velocity& velocity, const Acceleration& acceleration) const {
+        velocity.x += acceleration.x * dt;
+        velocity.y += acceleration.y * dt;
+        position.x += velocity.x * dt;
+        position.y += velocity.y * dt;
+    }
+};
+
+// `groups` nodes under the root, each with 64 children holding 16 leaves
+std::vector<std::shared_ptr<SceneNode>> build_hierarchy(Scene& scene, int groups) {
+    std::vector<std::shared_ptr<SceneNode>> nodes;
+    auto add = [&nodes](const std::shared_ptr<SceneNode>& parent) {
+        auto node = std::make_shared<SceneNode>();
+        node->SetPosition(PyNovaGE::Vector2f(1.0f, 0.5f));
+        node->SetRotation(0.01f);
+        parent->AddChild(node);
+        nodes.push_back(node);
+        return node;
+    };
+    for (int i = 0; i < groups; ++i) {
+        auto group = add(scene.GetRootNode());
+        for (int j = 0; j < 64; ++j) {
+            auto child = add(group);
+            for (int k = 0; k < 16; ++k) {
+                add(child);
+            }
+        }
+    }
+    scene.UpdateTransforms();
+    return nodes;
+}
+
+// `count` sprites scattered over the default scene bounds
+std::vector<EntityID> populate_sprites(Scene& scene, int count) {
+    std::vector<EntityID> entities;
+    for (int i = 0; i < count; ++i) {
+        EntityID entity = scene.CreateEntity();
+        const float x = static_cast<float>((i * 7919) % 18000) - 9000.0f;
+        const float y = static_cast<float>((i * 104729) % 18000) - 9000.0f;
+        scene.AddComponent<Transform2DComponent>(entity, PyNovaGE::Vector2f(x, y));
+        scene.AddComponent<SpriteComponent>(entity).SetSize(PyNovaGE::Vector2f(16.0f, 16.0f));
+        entities.push_back(entity);
+    }
+    scene.UpdateSpatialPartitioning();
+    return entities;
+}
+
+// Sprites with a dynamic body each, of which one in awake_every is left
+// awake; they are far enough apart never to touch
+std::vector<EntityID> populate_bodies(Scene& scene, int count, int awake_every) {
+    auto entities = populate_sprites(scene, count);
+    auto shape = std::make_shared<PyNovaGE::Physics::CircleShape>(4.0f);
+    for (EntityID entity : entities) {
+        scene.AddComponent<RigidBody2DComponent>(entity, std::make_shared<PyNovaGE::Physics::RigidBody>(shape));
+    }
+    scene.Update(1.0f / 60.0f);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (i % static_cast<size_t>(awake_every) != 0) {
+            scene.GetComponent<RigidBody2DComponent>(entities[i])->body->setAwake(false);
+        }
+    }
+    return entities;
+}
+
+// The previous storage: one heap allocation per component in a hash map
+template<typename T>
+using LegacyStorage = std::unordered_map<EntityID, std::unique_ptr<T>, EntityID::Hash>;
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Entity Manager Benchmarks
+//------------------------------------------------------------------------------
+
+static void BM_Scene_CreateDestroy(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<EntityID> entities(count);
+    EntityManager manager;
+
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            entities[i] = manager.CreateEntity();
+            manager.AddComponent<Position>(entities[i], 1.0f, 2.0f);
+            manager.AddComponent<Velocity>(entities[i]);
+        }
+        for (int i = 0; i < count; ++i) {
+            manager.DestroyEntity(entities[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Scene_CreateDestroy)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_Scene_IterateSingle(benchmark::State& state) {
+    EntityManager manager;
+    populate(manager, static_cast<int>(state.range(0)));
+    auto& positions = manager.GetOrCreateComponentStorage<Position>();
+
+    for (auto _ : state) {
+        for (Position& position : positions) {
+            position.x += 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * positions.Size());
+}
+BENCHMARK(BM_Scene_IterateSingle)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_IterateSingle_Legacy(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    LegacyStorage<Position> positions;
+    for (int i = 0; i < count; ++i) {
+        positions[EntityID(static_cast<EntityID::IDType>(i + 1), 1)] = std::make_unique<Position>();
+    }
+
+    for (auto _ : state) {
+        for (auto& [entity, position] : positions) {
+            position->x += 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Scene_IterateSingle_Legacy)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_JoinThree(benchmark::State& state) {
+    EntityManager manager;
+    populate(manager, static_cast<int>(state.range(0)));
+    auto view = manager.View<Position, Velocity, const Acceleration>();
+
+    for (auto _ : state) {
+        view.Each(Integrate{});
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * view.SizeHint());
+}
+BENCHMARK(BM_Scene_JoinThree)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_JoinThree_Group(benchmark::State& state) {
+    EntityManager manager;
+    populate(manager, static_cast<int>(state.range(0)));
+    auto group = manager.Group<Position, Velocity, Acceleration>();
+
+    for (auto _ : state) {
+        group.Each(Integrate{});
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * group.Size());
+}
+BENCHMARK(BM_Scene_JoinThree_Group)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_JoinThree_Parallel(benchmark::State& state) {
+    EntityManager manager;
+    populate(manager, static_cast<int>(state.range(0)));
+    auto view = manager.View<Position, Velocity, const Acceleration>();
+    ::PyNovaGE::Threading::ThreadPool pool(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        view.ParallelEach(Integrate{}, &pool);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * view.SizeHint());
+}
+BENCHMARK(BM_Scene_JoinThree_Parallel)->Args({100000, 4})->Args({100000, 8})->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_JoinThree_Legacy(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    LegacyStorage<Position> positions;
+    LegacyStorage<Velocity> velocities;
+    LegacyStorage<Acceleration> accelerations;
+    for (int i = 0; i < count; ++i) {
+        const EntityID entity(static_cast<EntityID::IDType>(i + 1), 1);
+        positions[entity] = std::make_unique<Position>();
+        if (i % 2 == 0) velocities[entity] = std::make_unique<Velocity>();
+        if (i % 4 == 0) accelerations[entity] = std::make_unique<Acceleration>();
+    }
+
+    const float dt = 0.016f;
+    for (auto _ : state) {
+        for (auto& [entity, acceleration] : accelerations) {
+            auto velocity = velocities.find(entity);
+            auto position = positions.find(entity);
+            if (velocity == velocities.end() || position == positions.end()) continue;
+            velocity->second->x += acceleration->x * dt;
+            velocity->second->y += acceleration->y * dt;
+            position->second->x += velocity->second->x * dt;
+            position->second->y += velocity->second->y * dt;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * accelerations.size());
+}
+BENCHMARK(BM_Scene_JoinThree_Legacy)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+//------------------------------------------------------------------------------
+// Scene Graph Benchmarks
+//------------------------------------------------------------------------------
+
+// One node in a hundred moves per frame
+static void BM_Scene_UpdateTransforms_FewDirty(benchmark::State& state) {
+    Scene scene;
+    auto nodes = build_hierarchy(scene, static_cast<int>(state.range(0)));
+    size_t next = 0;
+
+    for (auto _ : state) {
+        for (size_t i = next % 100; i < nodes.size(); i += 100) {
+            nodes[i]->SetPosition(PyNovaGE::Vector2f(1.0f, static_cast<float>(next % 7)));
+        }
+        ++next;
+        scene.UpdateTransforms();
+    }
+
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_Scene_UpdateTransforms_FewDirty)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+// Nothing moves: only the root is looked at
+static void BM_Scene_UpdateTransforms_Clean(benchmark::State& state) {
+    Scene scene;
+    auto nodes = build_hierarchy(scene, static_cast<int>(state.range(0)));
+    scene.UpdateTransforms();
+
+    for (auto _ : state) {
+        scene.UpdateTransforms();
+    }
+
+    state.counters["visited"] = static_cast<double>(scene.GetTransformsVisited());
+}
+BENCHMARK(BM_Scene_UpdateTransforms_Clean)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+// Every node recomputed, as the eager recursive update did
+static void BM_Scene_UpdateTransforms_AllDirty(benchmark::State& state) {
+    Scene scene;
+    auto nodes = build_hierarchy(scene, static_cast<int>(state.range(0)));
+    std::unique_ptr<::PyNovaGE::Threading::ThreadPool> pool;
+    if (state.range(1) > 0) {
+        pool = std::make_unique<::PyNovaGE::Threading::ThreadPool>(static_cast<size_t>(state.range(1)));
+        scene.SetThreadPool(pool.get());
+    }
+
+    for (auto _ : state) {
+        scene.GetRootNode()->MarkTransformDirty();
+        scene.UpdateTransforms();
+    }
+
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_Scene_UpdateTransforms_AllDirty)->Args({64, 0})->Args({64, 4})->Unit(benchmark::kMicrosecond);
+
+static void BM_Scene_UpdateTransforms_Recursive(benchmark::State& state) {
+    Scene scene;
+    auto nodes = build_hierarchy(scene, static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        scene.GetRootNode()->UpdateTransforms();
+    }
+
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_Scene_UpdateTransforms_Recursive)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+//------------------------------------------------------------------------------
+// Spatial Partitioning Benchmarks
+//------------------------------------------------------------------------------
+
+// One sprite in a hundred moves per frame
+static void BM_Scene_SpatialUpdate_FewMoved(benchmark::State& state) {
+    Scene scene;
+    auto entities = populate_sprites(scene, static_cast<int>(state.range(0)));
+    size_t frame = 0;
+
+    for (auto _ : state) {
+        for (size_t i = frame % 100; i < entities.size(); i += 100) {
+            const auto* transform = scene.GetComponent<Transform2DComponent>(entities[i]);
+            scene.SetEntityPosition(entities[i], transform->GetPosition() + PyNovaGE::Vector2f(1.0f, 0.0f));
+        }
+        ++frame;
+        scene.UpdateSpatialPartitioning();
+    }
+
+    state.counters["reindexed"] = static_cast<double>(scene.GetEntitiesReindexed());
+}
+BENCHMARK(BM_Scene_SpatialUpdate_FewMoved)->Arg(20000)->Unit(benchmark::kMicrosecond);
+
+// Every sprite moves, which takes the bulk rebuild
+static void BM_Scene_SpatialUpdate_AllMoved(benchmark::State& state) {
+    Scene scene;
+    auto entities = populate_sprites(scene, static_cast<int>(state.range(0)));
+    std::unique_ptr<::PyNovaGE::Threading::ThreadPool> pool;
+    if (state.range(1) > 0) {
+        pool = std::make_unique<::PyNovaGE::Threading::ThreadPool>(static_cast<size_t>(state.range(1)));
+        scene.SetThreadPool(pool.get());
+    }
+
+    for (auto _ : state) {
+        for (EntityID entity : entities) {
+            scene.MarkSpatialDirty(entity);
+        }
+        scene.UpdateSpatialPartitioning();
+    }
+
+    state.SetItemsProcessed(state.iterations() * entities.size());
+}
+BENCHMARK(BM_Scene_SpatialUpdate_AllMoved)->Args({20000, 0})->Args({20000, 4})->Unit(benchmark::kMicrosecond);
+
+// The previous per-frame path: clear and insert every entity again
+static void BM_Scene_SpatialUpdate_ClearAndInsert(benchmark::State& state) {
+    Scene scene;
+    auto entities = populate_sprites(scene, static_cast<int>(state.range(0)));
+    auto& spatial = scene.GetSpatialManager();
+
+    for (auto _ : state) {
+        spatial.Clear();
+        for (EntityID entity : entities) {
+            const auto* transform = scene.GetComponent<Transform2DComponent>(entity);
+            const auto position = transform->GetPosition();
+            spatial.Insert(entity, AABB2D(position.x - 8.0f, position.y - 8.0f, 16.0f, 16.0f));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * entities.size());
+}
+BENCHMARK(BM_Scene_SpatialUpdate_ClearAndInsert)->Arg(20000)->Unit(benchmark::kMicrosecond);
+
+//------------------------------------------------------------------------------
+// Scene Simulation Benchmarks
+//------------------------------------------------------------------------------
+
+// A whole frame: step, copy awake bodies back, re-index what moved
+static void BM_Scene_PhysicsFrame(benchmark::State& state) {
+    Scene scene;
+    populate_bodies(scene, static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+
+    for (auto _ : state) {
+        scene.Update(1.0f / 60.0f);
+    }
+
+    state.counters["synced"] = static_cast<double>(scene.GetBodiesSynced());
+    state.counters["reindexed"] = static_cast<double>(scene.GetEntitiesReindexed());
+}
+BENCHMARK(BM_Scene_PhysicsFrame)->Args({20000, 1})->Args({20000, 10})->Unit(benchmark::kMicrosecond);
+
+// The previous per-frame path: step, then look up and copy every body
+static void BM_Scene_PhysicsFrame_PerEntitySync(benchmark::State& state) {
+    Scene scene;
+    auto entities = populate_bodies(scene, static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+
+    for (auto _ : state) {
+        scene.GetPhysicsWorld().step(1.0f / 60.0f);
+        for (EntityID entity : entities) {
+            const auto* rigid_body = scene.GetComponent<RigidBody2DComponent>(entity);
+            scene.SetEntityPosition(entity, rigid_body->GetPosition());
+            scene.SetEntityRotation(entity, rigid_body->GetRotation());
+        }
+        scene.UpdateTransforms();
+        scene.UpdateSpatialPartitioning();
+    }
+
+    state.counters["reindexed"] = static_cast<double>(scene.GetEntitiesReindexed());
+}
+BENCHMARK(BM_Scene_PhysicsFrame_PerEntitySync)->Args({20000, 1})->Args({20000, 10})->Unit(benchmark::kMicrosecond);
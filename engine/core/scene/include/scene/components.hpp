@@ -27,7 +27,7 @@ using Vector4f = PyNovaGE::Vector4<float>;
  * Provides 2D transformation (position, rotation, scale) for entities.
  * Integrates with scene graph for hierarchical transforms.
  */
-class Transform2DComponent : public Component {
+class Transform2DComponent {
 public:
     Transform2DComponent() = default;
     Transform2DComponent(const Vector2f& position, float rotation = 0.0f, const Vector2f& scale = Vector2f(1.0f, 1.0f))
@@ -56,7 +56,7 @@ public:
  * Associates an entity with sprite rendering.
  * Integrates with the renderer's sprite system.
  */
-class SpriteComponent : public Component {
+class SpriteComponent {
 public:
     SpriteComponent() = default;
     SpriteComponent(std::shared_ptr<Renderer::Texture> texture, const Vector4f& color = Vector4f(1.0f, 1.0f, 1.0f, 1.0f))
@@ -84,7 +84,7 @@ public:
  * Associates an entity with 2D physics simulation.
  * Integrates with the physics system's RigidBody.
  */
-class RigidBody2DComponent : public Component {
+class RigidBody2DComponent {
 public:
     RigidBody2DComponent() = default;
     explicit RigidBody2DComponent(std::shared_ptr<Physics::RigidBody> body) 
@@ -112,7 +112,7 @@ public:
  * Associates an entity with particle emission.
  * Integrates with the particle system.
  */
-class ParticleEmitter2DComponent : public Component {
+class ParticleEmitter2DComponent {
 public:
     ParticleEmitter2DComponent() = default;
     explicit ParticleEmitter2DComponent(std::shared_ptr<Particles::ParticleEmitter> emitter)
@@ -138,7 +138,7 @@ public:
  * Provides a human-readable name for entities.
  * Useful for debugging and editor tools.
  */
-class NameComponent : public Component {
+class NameComponent {
 public:
     NameComponent() = default;
     explicit NameComponent(const std::string& entity_name) : name(entity_name) {}
@@ -156,7 +156,7 @@ public:
  * Links entities to scene graph nodes for hierarchical transforms.
  * Allows ECS entities to participate in the scene hierarchy.
  */
-class HierarchyComponent : public Component {
+class HierarchyComponent {
 public:
     HierarchyComponent() = default;
     explicit HierarchyComponent(std::shared_ptr<SceneNode> node) : scene_node(node) {}
@@ -176,7 +176,7 @@ public:
  * Defines a 2D camera for rendering the scene from a specific viewpoint.
  * Supports orthographic projection with zoom and viewport controls.
  */
-class CameraComponent : public Component {
+class CameraComponent {
 public:
     CameraComponent() = default;
     CameraComponent(const Vector2f& view_size, float zoom_level = 1.0f) 
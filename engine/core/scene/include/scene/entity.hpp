@@ -1,18 +1,25 @@
 #pragma once
 
-#include <unordered_map>
-#include <typeindex>
-#include <any>
-#include <stdexcept>
-#include <unordered_map>
+#include "threading/thread_pool.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace PyNovaGE {
 namespace Scene {
 
 /**
  * @brief Lightweight entity ID
- * 
+ *
  * Simple integer-based entity identifier for ECS system.
  * Provides unique IDs with generation counter to detect stale references.
  */
@@ -55,25 +62,26 @@ private:
 };
 
 /**
- * @brief Base class for ECS components
- * 
- * All components must inherit from this base class.
- * Provides type information and virtual destructor.
+ * @brief Optional base class for ECS components
+ *
+ * Components are stored by value and do not need a base class; any movable
+ * type can be a component. This one only adds runtime type checks for
+ * components that want them.
  */
 class Component {
 public:
     virtual ~Component() = default;
-    
+
     template<typename T>
     bool IsType() const {
         return typeid(*this) == typeid(T);
     }
-    
+
     template<typename T>
     T* As() {
         return dynamic_cast<T*>(this);
     }
-    
+
     template<typename T>
     const T* As() const {
         return dynamic_cast<const T*>(this);
@@ -81,95 +89,489 @@ public:
 };
 
 /**
- * @brief Component storage interface
- * 
- * Type-erased storage for components of any type.
- * Allows the entity manager to store different component types uniformly.
+ * @brief Dense index identifying a component type
+ */
+using ComponentTypeID = uint32_t;
+
+namespace Detail {
+inline ComponentTypeID NextComponentTypeID() {
+    static std::atomic<ComponentTypeID> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace Detail
+
+/**
+ * @brief Type ID of component type T
+ *
+ * Taken from a counter the first time T is used and a static read after
+ * that, without RTTI. IDs are small and dense, so they index the entity
+ * manager's storage table directly. They are shared by all entity managers
+ * but may differ between runs.
+ */
+template<typename T>
+ComponentTypeID GetComponentTypeID() {
+    static const ComponentTypeID id = Detail::NextComponentTypeID();
+    return id;
+}
+
+/**
+ * @brief Sparse set of entities
+ *
+ * Entities are packed in a dense array, and a sparse array indexed by
+ * entity ID holds each one's position in it. Lookup, insertion and removal
+ * are O(1); removal moves the last entity into the hole (swap-and-pop), so
+ * the dense order changes as entities are removed.
+ */
+class SparseEntitySet {
+public:
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Position of entity in the dense array, or kInvalidIndex
+     *
+     * Stale IDs whose generation does not match are not found.
+     */
+    uint32_t IndexOf(EntityID entity) const {
+        const auto id = entity.GetID();
+        if (id >= sparse_.size()) return kInvalidIndex;
+        const uint32_t index = sparse_[id];
+        return (index != kInvalidIndex && dense_[index] == entity) ? index : kInvalidIndex;
+    }
+
+    bool Contains(EntityID entity) const { return IndexOf(entity) != kInvalidIndex; }
+
+    /**
+     * @brief Append an entity that is not in the set
+     * @return Its position in the dense array
+     */
+    uint32_t Insert(EntityID entity) {
+        const auto id = entity.GetID();
+        if (id >= sparse_.size()) {
+            sparse_.resize(static_cast<size_t>(id) + 1, kInvalidIndex);
+        }
+        const auto index = static_cast<uint32_t>(dense_.size());
+        dense_.push_back(entity);
+        sparse_[id] = index;
+        return index;
+    }
+
+    /**
+     * @brief Remove an entity by moving the last one into its place
+     * @return The position it had, or kInvalidIndex if it was not in the set
+     */
+    uint32_t Erase(EntityID entity) {
+        const uint32_t index = IndexOf(entity);
+        if (index == kInvalidIndex) return kInvalidIndex;
+
+        const EntityID last = dense_.back();
+        dense_[index] = last;
+        sparse_[last.GetID()] = index;
+        dense_.pop_back();
+        sparse_[entity.GetID()] = kInvalidIndex;
+        return index;
+    }
+
+    // Exchange the entities at two dense positions
+    void Swap(uint32_t a, uint32_t b) {
+        std::swap(dense_[a], dense_[b]);
+        sparse_[dense_[a].GetID()] = a;
+        sparse_[dense_[b].GetID()] = b;
+    }
+
+    EntityID operator[](size_t index) const { return dense_[index]; }
+    const std::vector<EntityID>& GetEntities() const { return dense_; }
+    size_t Size() const { return dense_.size(); }
+    bool Empty() const { return dense_.empty(); }
+
+    void Reserve(size_t count) { dense_.reserve(count); }
+    // Resets only the slots in use, so clearing a small set is cheap
+    void Clear() {
+        for (const EntityID entity : dense_) {
+            sparse_[entity.GetID()] = kInvalidIndex;
+        }
+        dense_.clear();
+    }
+
+private:
+    std::vector<uint32_t> sparse_;   // Dense position per entity ID, or kInvalidIndex
+    std::vector<EntityID> dense_;
+};
+
+namespace Detail {
+
+// Keeps the entities matching a group at the front of the storages it owns
+class GroupBase {
+public:
+    virtual ~GroupBase() = default;
+
+    // Call after entity gained an owned component
+    virtual void OnAdd(EntityID entity) = 0;
+    // Call before entity loses an owned component
+    virtual void OnRemove(EntityID entity) = 0;
+
+    const std::vector<ComponentTypeID>& GetTypes() const { return types_; }
+    size_t Size() const { return size_; }
+
+protected:
+    std::vector<ComponentTypeID> types_;   // Owned types, in template order
+    size_t size_ = 0;                      // Matching entities, at the front of every owned storage
+};
+
+// Call func with the entity too if it takes one
+template<typename Func, typename... Components>
+void InvokeEach(Func& func, EntityID entity, Components&... components) {
+    if constexpr (std::is_invocable_v<Func&, EntityID, Components&...>) {
+        func(entity, components...);
+    } else {
+        func(components...);
+    }
+}
+
+} // namespace Detail
+
+/**
+ * @brief Type-erased part of a component storage
+ *
+ * Holds the set of entities that have the component, so membership tests
+ * and entity lists need no knowledge of the component type.
  */
-class IComponentStorage {
+class ComponentStorageBase {
 public:
-    virtual ~IComponentStorage() = default;
+    virtual ~ComponentStorageBase() = default;
     virtual void RemoveComponent(EntityID entity) = 0;
-    virtual bool HasComponent(EntityID entity) const = 0;
-    virtual Component* GetComponent(EntityID entity) = 0;
-    virtual const Component* GetComponent(EntityID entity) const = 0;
+    virtual void Clear() = 0;
+
+    bool HasComponent(EntityID entity) const { return entities_.Contains(entity); }
+
+    // Position of entity's component, or SparseEntitySet::kInvalidIndex
+    uint32_t IndexOf(EntityID entity) const { return entities_.IndexOf(entity); }
+
+    // Entities with the component, in the same order as the components
+    const std::vector<EntityID>& GetEntities() const { return entities_.GetEntities(); }
+    size_t Size() const { return entities_.Size(); }
+
+    // Whether a group keeps this storage ordered (see EntityManager::Group())
+    bool IsGrouped() const { return group_ != nullptr; }
+
+protected:
+    friend class EntityManager;
+
+    SparseEntitySet entities_;
+    Detail::GroupBase* group_ = nullptr;
 };
 
 /**
- * @brief Template component storage implementation
- * 
- * Stores components of a specific type T in a hash map.
+ * @brief Packed storage for components of type T
+ *
+ * Components are stored by value in one contiguous array, parallel to the
+ * entity array of the base class, so iterating them is a linear walk.
+ * Removal is swap-and-pop. Adding or removing a component of this type may
+ * move the others, which invalidates pointers and references to them;
+ * components of other types are unaffected.
  */
 template<typename T>
-class ComponentStorage : public IComponentStorage {
-    static_assert(std::is_base_of_v<Component, T>, "T must be a Component");
+class ComponentStorage final : public ComponentStorageBase {
+    static_assert(std::is_move_assignable_v<T>, "Components must be movable");
 
 public:
-    void AddComponent(EntityID entity, T&& component) {
-        components_[entity] = std::make_unique<T>(std::move(component));
-    }
-    
+    /**
+     * @brief Construct a component for entity, replacing any it already has
+     *
+     * Aggregates are brace-initialized from args.
+     */
     template<typename... Args>
     T& EmplaceComponent(EntityID entity, Args&&... args) {
-        auto ptr = std::make_unique<T>(std::forward<Args>(args)...);
-        T& ref = *ptr;
-        components_[entity] = std::move(ptr);
-        return ref;
+        const uint32_t index = entities_.IndexOf(entity);
+        if (index != SparseEntitySet::kInvalidIndex) {
+            components_[index] = Construct(std::forward<Args>(args)...);
+            return components_[index];
+        }
+
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            components_.emplace_back(std::forward<Args>(args)...);
+        } else {
+            components_.push_back(T{std::forward<Args>(args)...});
+        }
+        entities_.Insert(entity);
+        return components_.back();
     }
 
-    void RemoveComponent(EntityID entity) override {
-        components_.erase(entity);
+    void AddComponent(EntityID entity, T&& component) {
+        EmplaceComponent(entity, std::move(component));
     }
 
-    bool HasComponent(EntityID entity) const override {
-        return components_.find(entity) != components_.end();
+    void RemoveComponent(EntityID entity) override {
+        const uint32_t index = entities_.Erase(entity);
+        if (index == SparseEntitySet::kInvalidIndex) return;
+
+        if (index + 1 != components_.size()) {
+            components_[index] = std::move(components_.back());
+        }
+        components_.pop_back();
     }
 
-    Component* GetComponent(EntityID entity) override {
-        auto it = components_.find(entity);
-        return (it != components_.end()) ? it->second.get() : nullptr;
+    T* GetComponent(EntityID entity) {
+        const uint32_t index = entities_.IndexOf(entity);
+        return index != SparseEntitySet::kInvalidIndex ? &components_[index] : nullptr;
     }
 
-    const Component* GetComponent(EntityID entity) const override {
-        auto it = components_.find(entity);
-        return (it != components_.end()) ? it->second.get() : nullptr;
+    const T* GetComponent(EntityID entity) const {
+        const uint32_t index = entities_.IndexOf(entity);
+        return index != SparseEntitySet::kInvalidIndex ? &components_[index] : nullptr;
     }
 
-    T* GetTypedComponent(EntityID entity) {
-        auto it = components_.find(entity);
-        return (it != components_.end()) ? it->second.get() : nullptr;
+    /**
+     * @brief Owner of a component in this storage, or a null ID if it is not one of ours
+     */
+    EntityID GetEntity(const T* component) const {
+        const T* data = components_.data();
+        if (std::less<const T*>{}(component, data) || !std::less<const T*>{}(component, data + components_.size())) {
+            return EntityID();
+        }
+        return entities_[static_cast<size_t>(component - data)];
     }
 
-    const T* GetTypedComponent(EntityID entity) const {
-        auto it = components_.find(entity);
-        return (it != components_.end()) ? it->second.get() : nullptr;
+    // Exchange the components, and their entities, at two positions
+    void Swap(uint32_t a, uint32_t b) {
+        if (a == b) return;
+        entities_.Swap(a, b);
+        std::swap(components_[a], components_[b]);
     }
 
-    // Iterator support for system queries
+    // Components in entity order (see GetEntities())
+    std::vector<T>& GetComponents() { return components_; }
+    const std::vector<T>& GetComponents() const { return components_; }
+
     auto begin() { return components_.begin(); }
     auto end() { return components_.end(); }
     auto begin() const { return components_.begin(); }
     auto end() const { return components_.end(); }
 
-    size_t Size() const { return components_.size(); }
-    void Clear() { components_.clear(); }
+    void Reserve(size_t count) {
+        entities_.Reserve(count);
+        components_.reserve(count);
+    }
+
+    void Clear() override {
+        entities_.Clear();
+        components_.clear();
+    }
 
 private:
-    std::unordered_map<EntityID, std::unique_ptr<T>, EntityID::Hash> components_;
+    template<typename... Args>
+    static T Construct(Args&&... args) {
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+
+    std::vector<T> components_;
+};
+
+/**
+ * @brief Entities that have all of the components Ts
+ *
+ * Returned by EntityManager::View(). Walks the entities of the smallest of
+ * the storages and probes the others, so the cost follows the rarest
+ * component. const component types give read-only access. The view holds
+ * pointers to the storages, not a copy of the matches, so it is cheap to
+ * make and always current; adding or removing components of the viewed
+ * types while it is being walked is not allowed.
+ *
+ * Each() and ParallelEach() call func(EntityID, Ts&...) or func(Ts&...),
+ * whichever it accepts.
+ */
+template<typename... Ts>
+class ComponentView {
+    static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    template<typename T>
+    using Storage = std::conditional_t<std::is_const_v<T>,
+                                       const ComponentStorage<std::remove_const_t<T>>,
+                                       ComponentStorage<T>>;
+
+public:
+    // A null storage, for a type never added, makes the view empty
+    explicit ComponentView(Storage<Ts>*... storages) : storages_(storages...) {}
+
+    bool Contains(EntityID entity) const {
+        return std::apply([entity](auto*... storages) {
+            return ((storages && storages->HasComponent(entity)) && ...);
+        }, storages_);
+    }
+
+    // Number of entities walked: the size of the smallest storage
+    size_t SizeHint() const {
+        const ComponentStorageBase* lead = GetLead();
+        return lead ? lead->Size() : 0;
+    }
+
+    template<typename Func>
+    void Each(Func func) const {
+        const ComponentStorageBase* lead = GetLead();
+        if (!lead) return;
+        for (EntityID entity : lead->GetEntities()) {
+            Visit(entity, func, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    /**
+     * @brief Each() split over a thread pool
+     *
+     * func runs concurrently for different entities, so it may write their
+     * components but nothing shared without synchronization.
+     *
+     * @param pool Thread pool to use (nullptr = default_thread_pool())
+     * @param grain_size Minimum entities per chunk (0 = automatic)
+     */
+    template<typename Func>
+    void ParallelEach(Func func, Threading::ThreadPool* pool = nullptr, size_t grain_size = 0) const {
+        const ComponentStorageBase* lead = GetLead();
+        if (!lead) return;
+        const auto& entities = lead->GetEntities();
+        Threading::parallel_for(0, entities.size(), [this, &entities, &func](size_t i) {
+            Visit(entities[i], func, std::index_sequence_for<Ts...>{});
+        }, pool, grain_size);
+    }
+
+private:
+    // Smallest storage, or nullptr if any is missing
+    const ComponentStorageBase* GetLead() const {
+        return std::apply([](auto*... storages) -> const ComponentStorageBase* {
+            if (((storages == nullptr) || ...)) return nullptr;
+            const ComponentStorageBase* lead = nullptr;
+            ((lead = (!lead || storages->Size() < lead->Size()) ? storages : lead), ...);
+            return lead;
+        }, storages_);
+    }
+
+    template<typename Func, size_t... I>
+    void Visit(EntityID entity, Func& func, std::index_sequence<I...>) const {
+        const std::array<uint32_t, sizeof...(Ts)> indices{std::get<I>(storages_)->IndexOf(entity)...};
+        for (uint32_t index : indices) {
+            if (index == SparseEntitySet::kInvalidIndex) return;
+        }
+        Detail::InvokeEach(func, entity, std::get<I>(storages_)->GetComponents()[indices[I]]...);
+    }
+
+    std::tuple<Storage<Ts>*...> storages_;
+};
+
+namespace Detail {
+
+template<typename... Ts>
+class GroupData final : public GroupBase {
+public:
+    explicit GroupData(ComponentStorage<Ts>*... storages) : storages_(storages...) {
+        types_ = {GetComponentTypeID<Ts>()...};
+    }
+
+    void OnAdd(EntityID entity) override {
+        const uint32_t index = std::get<0>(storages_)->IndexOf(entity);
+        if (index != SparseEntitySet::kInvalidIndex && index < size_) return;   // Already in
+        const bool matches = std::apply([entity](auto*... storages) {
+            return (storages->HasComponent(entity) && ...);
+        }, storages_);
+        if (!matches) return;
+
+        const auto slot = static_cast<uint32_t>(size_++);
+        std::apply([entity, slot](auto*... storages) {
+            (storages->Swap(storages->IndexOf(entity), slot), ...);
+        }, storages_);
+    }
+
+    void OnRemove(EntityID entity) override {
+        const uint32_t index = std::get<0>(storages_)->IndexOf(entity);
+        if (index == SparseEntitySet::kInvalidIndex || index >= size_) return;
+
+        const auto slot = static_cast<uint32_t>(--size_);
+        std::apply([entity, slot](auto*... storages) {
+            (storages->Swap(storages->IndexOf(entity), slot), ...);
+        }, storages_);
+    }
+
+    const std::tuple<ComponentStorage<Ts>*...>& GetStorages() const { return storages_; }
+
+private:
+    std::tuple<ComponentStorage<Ts>*...> storages_;
+};
+
+} // namespace Detail
+
+/**
+ * @brief Cached group of the entities that have all of the components Ts
+ *
+ * Returned by EntityManager::Group(). The group owns the storages of Ts:
+ * every add and remove through the EntityManager keeps the matching
+ * entities in the first Size() slots of each of them, in the same order.
+ * Walking the group is then a linear pass over parallel arrays, with no
+ * lookups, at the cost of a few swaps per add and remove.
+ *
+ * Each() and ParallelEach() behave as in ComponentView.
+ */
+template<typename... Ts>
+class ComponentGroup {
+public:
+    explicit ComponentGroup(Detail::GroupData<Ts...>* data) : data_(data) {}
+
+    size_t Size() const { return data_->Size(); }
+
+    // The matching entities are the first Size() of these
+    const std::vector<EntityID>& GetEntities() const { return std::get<0>(data_->GetStorages())->GetEntities(); }
+
+    template<typename Func>
+    void Each(Func func) const {
+        EachIn(0, Size(), func, std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @param pool Thread pool to use (nullptr = default_thread_pool())
+     * @param grain_size Minimum entities per chunk (0 = automatic)
+     */
+    template<typename Func>
+    void ParallelEach(Func func, Threading::ThreadPool* pool = nullptr, size_t grain_size = 0) const {
+        Threading::parallel_for(0, Size(), [this, &func](size_t i) {
+            EachIn(i, i + 1, func, std::index_sequence_for<Ts...>{});
+        }, pool, grain_size);
+    }
+
+private:
+    template<typename Func, size_t... I>
+    void EachIn(size_t begin, size_t end, Func& func, std::index_sequence<I...>) const {
+        const auto& storages = data_->GetStorages();
+        const EntityID* entities = std::get<0>(storages)->GetEntities().data();
+        const auto components = std::make_tuple(std::get<I>(storages)->GetComponents().data()...);
+        for (size_t i = begin; i < end; ++i) {
+            Detail::InvokeEach(func, entities[i], std::get<I>(components)[i]...);
+        }
+    }
+
+    Detail::GroupData<Ts...>* data_;
 };
 
 /**
  * @brief Entity manager for lightweight ECS
- * 
- * Manages entity creation/destruction and component storage.
- * Uses type-erased storage to handle different component types.
+ *
+ * Manages entity creation/destruction and component storage. Each
+ * component type gets a ComponentStorage, found by indexing a table with
+ * its GetComponentTypeID(), so a component lookup is two array reads and
+ * no hashing. Living entities are kept in a sparse set of their own.
+ * Destroyed IDs are reused with the next generation, which keeps the
+ * sparse arrays as small as the peak entity count.
+ *
+ * View() and Group() query entities by the components they have. Grouped
+ * storages are kept in order by AddComponent(), RemoveComponent() and
+ * DestroyEntity(), so components of grouped types must be added and
+ * removed through the manager rather than the storages.
  */
 class EntityManager {
 public:
     // Entity management
     EntityID CreateEntity();
     void DestroyEntity(EntityID entity);
-    bool IsEntityValid(EntityID entity) const;
+    bool IsEntityValid(EntityID entity) const { return entities_.Contains(entity); }
 
     // Component management
     template<typename T, typename... Args>
@@ -177,92 +579,160 @@ public:
         if (!IsEntityValid(entity)) {
             throw std::runtime_error("Invalid entity ID");
         }
-
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        
-        if (it == component_storages_.end()) {
-            auto storage = std::make_unique<ComponentStorage<T>>();
-            auto* storage_ptr = storage.get();
-            component_storages_[type_index] = std::move(storage);
-            return storage_ptr->EmplaceComponent(entity, std::forward<Args>(args)...);
+        auto& storage = GetOrCreateComponentStorage<T>();
+        T& component = storage.EmplaceComponent(entity, std::forward<Args>(args)...);
+        if (storage.group_) {
+            storage.group_->OnAdd(entity);
+            return *storage.GetComponent(entity);   // The group may have moved it
         }
-        
-        auto* storage = static_cast<ComponentStorage<T>*>(it->second.get());
-        return storage->EmplaceComponent(entity, std::forward<Args>(args)...);
+        return component;
     }
 
     template<typename T>
     void RemoveComponent(EntityID entity) {
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        if (it != component_storages_.end()) {
-            it->second->RemoveComponent(entity);
+        if (auto* storage = GetComponentStorage<T>()) {
+            if (storage->group_) {
+                storage->group_->OnRemove(entity);
+            }
+            storage->RemoveComponent(entity);
         }
     }
 
     template<typename T>
     bool HasComponent(EntityID entity) const {
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        return (it != component_storages_.end()) && it->second->HasComponent(entity);
+        const auto* storage = GetComponentStorage<T>();
+        return storage && storage->HasComponent(entity);
     }
 
+    /**
+     * @brief Component of entity, or nullptr
+     *
+     * Valid until a component of the same type is added or removed.
+     */
     template<typename T>
     T* GetComponent(EntityID entity) {
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        if (it != component_storages_.end()) {
-            auto* storage = static_cast<ComponentStorage<T>*>(it->second.get());
-            return storage->GetTypedComponent(entity);
-        }
-        return nullptr;
+        auto* storage = GetComponentStorage<T>();
+        return storage ? storage->GetComponent(entity) : nullptr;
     }
 
     template<typename T>
     const T* GetComponent(EntityID entity) const {
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        if (it != component_storages_.end()) {
-            const auto* storage = static_cast<const ComponentStorage<T>*>(it->second.get());
-            return storage->GetTypedComponent(entity);
+        const auto* storage = GetComponentStorage<T>();
+        return storage ? storage->GetComponent(entity) : nullptr;
+    }
+
+    /**
+     * @brief Entities that have all of Ts, walked from the rarest component
+     *
+     * Use const component types for read-only access.
+     */
+    template<typename... Ts>
+    ComponentView<Ts...> View() {
+        return ComponentView<Ts...>(GetComponentStorage<std::remove_const_t<Ts>>()...);
+    }
+
+    template<typename... Ts>
+    ComponentView<const Ts...> View() const {
+        return ComponentView<const Ts...>(GetComponentStorage<std::remove_const_t<Ts>>()...);
+    }
+
+    /**
+     * @brief Group of the entities that have all of Ts, kept packed
+     *
+     * The first call for a set of types sorts their storages and every
+     * later add or remove keeps them sorted; later calls return the same
+     * group. A storage can belong to one group only. The group lives until
+     * Clear().
+     *
+     * @throws std::runtime_error If one of Ts already belongs to a different group
+     */
+    template<typename... Ts>
+    ComponentGroup<Ts...> Group() {
+        static_assert(sizeof...(Ts) > 0, "A group needs at least one component type");
+
+        const std::vector<ComponentTypeID> types{GetComponentTypeID<Ts>()...};
+        std::array<ComponentStorageBase*, sizeof...(Ts)> storages{&GetOrCreateComponentStorage<Ts>()...};
+        if (Detail::GroupBase* existing = storages[0]->group_; existing && existing->GetTypes() == types) {
+            return ComponentGroup<Ts...>(static_cast<Detail::GroupData<Ts...>*>(existing));
+        }
+        for (const auto* storage : storages) {
+            if (storage->group_) {
+                throw std::runtime_error("EntityManager::Group: component type already belongs to another group");
+            }
         }
-        return nullptr;
+
+        auto group = std::make_unique<Detail::GroupData<Ts...>>(&GetOrCreateComponentStorage<Ts>()...);
+        auto* data = group.get();
+        for (auto* storage : storages) {
+            storage->group_ = data;
+        }
+        groups_.push_back(std::move(group));
+
+        // Pull in the entities that already match, walking the smallest storage
+        const ComponentStorageBase* lead = storages[0];
+        for (const auto* storage : storages) {
+            if (storage->Size() < lead->Size()) lead = storage;
+        }
+        const auto& entities = lead->GetEntities();
+        for (size_t i = 0; i < entities.size(); ++i) {
+            data->OnAdd(entities[i]);
+        }
+        return ComponentGroup<Ts...>(data);
     }
 
-    // Get access to the component storages
-    const std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>>& GetStorages() const {
+    // Component storages indexed by ComponentTypeID; null for types this manager has not seen
+    const std::vector<std::unique_ptr<ComponentStorageBase>>& GetStorages() const {
         return component_storages_;
     }
 
+    const ComponentStorageBase* GetComponentStorage(ComponentTypeID type) const {
+        return type < component_storages_.size() ? component_storages_[type].get() : nullptr;
+    }
+
     // Initialization
     void Initialize() { Clear(); }
-    std::vector<EntityID> GetAllEntities() const {
-        std::vector<EntityID> result;
-        for (const auto& [id, gen] : entities_) {
-            result.emplace_back(EntityID(id, gen));
-        }
-        return result;
-    }
+
+    // Living entities, packed; destroying an entity reorders them
+    const std::vector<EntityID>& GetAllEntities() const { return entities_.GetEntities(); }
 
     template<typename T>
     ComponentStorage<T>* GetComponentStorage() {
-        auto type_index = std::type_index(typeid(T));
-        auto it = component_storages_.find(type_index);
-        return (it != component_storages_.end()) ? 
-               static_cast<ComponentStorage<T>*>(it->second.get()) : nullptr;
+        const auto type = GetComponentTypeID<T>();
+        return type < component_storages_.size() ?
+               static_cast<ComponentStorage<T>*>(component_storages_[type].get()) : nullptr;
+    }
+
+    template<typename T>
+    const ComponentStorage<T>* GetComponentStorage() const {
+        const auto type = GetComponentTypeID<T>();
+        return type < component_storages_.size() ?
+               static_cast<const ComponentStorage<T>*>(component_storages_[type].get()) : nullptr;
+    }
+
+    template<typename T>
+    ComponentStorage<T>& GetOrCreateComponentStorage() {
+        const auto type = GetComponentTypeID<T>();
+        if (type >= component_storages_.size()) {
+            component_storages_.resize(static_cast<size_t>(type) + 1);
+        }
+        auto& storage = component_storages_[type];
+        if (!storage) {
+            storage = std::make_unique<ComponentStorage<T>>();
+        }
+        return static_cast<ComponentStorage<T>&>(*storage);
     }
 
     // Utility
-    size_t GetEntityCount() const { return entities_.size(); }
+    size_t GetEntityCount() const { return entities_.Size(); }
     void Clear();
 
 private:
-    EntityID::IDType next_id_ = 1;
-    EntityID::GenerationType next_generation_ = 1;
-    std::unordered_map<EntityID::IDType, EntityID::GenerationType> entities_;
-    std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>> component_storages_;
+    SparseEntitySet entities_;
+    std::vector<EntityID::GenerationType> generations_{EntityID::NULL_GENERATION};   // Current generation per ID; ID 0 is null
+    std::vector<EntityID::IDType> free_ids_;
+    std::vector<std::unique_ptr<ComponentStorageBase>> component_storages_;
+    std::vector<std::unique_ptr<Detail::GroupBase>> groups_;
 };
 
 } // namespace Scene
-} // namespace PyNovaGE
\ No newline at end of file
+} // namespace PyNovaGE
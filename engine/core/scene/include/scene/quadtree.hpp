@@ -3,10 +3,11 @@
 #include <vectors/vectors.hpp>
 #include <matrices/matrices.hpp>
 #include "scene/entity.hpp"
+#include "threading/thread_pool.hpp"
 #include <vector>
 #include <memory>
 #include <functional>
-#include <unordered_set>
+#include <memory_resource>
 
 namespace PyNovaGE {
 namespace Scene {
@@ -106,6 +107,29 @@ public:
     bool Update(EntityID entity, const AABB2D& new_bounds);
     void Clear();
 
+    // Known-bounds variants: descend straight to the object's node instead of
+    // searching the whole tree. An object that stays in its node is updated in place.
+    bool Remove(EntityID entity, const AABB2D& bounds);
+    bool Update(EntityID entity, const AABB2D& old_bounds, const AABB2D& new_bounds);
+
+    /**
+     * @brief Replace the contents with objects in one pass
+     *
+     * Partitions the whole set down the tree instead of inserting objects
+     * one at a time, building the four subtrees of large nodes in parallel.
+     * The result matches inserting the objects one by one.
+     *
+     * @param objects Objects to store
+     * @param pool Pool for the subtree builds; nullptr builds on the calling thread
+     */
+    void Build(std::vector<SpatialObject> objects, Threading::ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Replace the bounds as well as the contents
+     * @see Build(std::vector<SpatialObject>, Threading::ThreadPool*)
+     */
+    void Build(const AABB2D& bounds, std::vector<SpatialObject> objects, Threading::ThreadPool* pool = nullptr);
+
     // Spatial queries
     std::vector<SpatialObject> QueryPoint(const Vector2f& point) const;
     std::vector<SpatialObject> QueryAABB(const AABB2D& aabb) const;
@@ -118,6 +142,9 @@ public:
     void QueryAABB(const AABB2D& aabb, const QueryCallback& callback) const;
     void QueryCircle(const Vector2f& center, float radius, const QueryCallback& callback) const;
 
+    // Allocation-free query: replaces the contents of results (e.g. a per-frame pmr vector)
+    void QueryAABB(const AABB2D& aabb, std::pmr::vector<SpatialObject>& results) const;
+
     // Raycasting
     struct RayHit {
         SpatialObject object;
@@ -135,6 +162,7 @@ public:
     
     // For rebuilding purposes
     const std::vector<SpatialObject>& GetObjectsInNode() const { return objects_; }
+    void GetAllObjects(std::vector<SpatialObject>& objects) const;
     
     const AABB2D& GetBounds() const { return bounds_; }
     bool IsEmpty() const { return objects_.empty() && children_[0] == nullptr; }
@@ -153,7 +181,10 @@ private:
     std::array<std::unique_ptr<Quadtree>, 4> children_;
     
     // Internal methods
+    void CreateChildren();
     void Subdivide();
+    void BuildRecursive(std::vector<SpatialObject>&& objects, Threading::ThreadPool* pool);
+    Quadtree* GetTargetNode(const AABB2D& bounds);
     void Merge();
     bool ShouldSubdivide() const;
     bool ShouldMerge() const;
@@ -162,7 +193,8 @@ private:
     
     // Query helpers
     void QueryPointRecursive(const Vector2f& point, std::vector<SpatialObject>& results) const;
-    void QueryAABBRecursive(const AABB2D& aabb, std::vector<SpatialObject>& results) const;
+    template<typename Container>
+    void QueryAABBRecursive(const AABB2D& aabb, Container& results) const;
     void QueryCircleRecursive(const Vector2f& center, float radius, std::vector<SpatialObject>& results) const;
     
     void QueryPointRecursive(const Vector2f& point, const QueryCallback& callback) const;
@@ -193,6 +225,11 @@ public:
     void Initialize();
     void Clear();
 
+    // Replace every registered object, one entry per entity (see Quadtree::Build())
+    void Rebuild(std::vector<SpatialObject> objects, Threading::ThreadPool* pool = nullptr);
+
+    bool Contains(EntityID entity) const { return registered_objects_.Contains(entity); }
+
     // Object management
     void RegisterObject(EntityID entity, const AABB2D& bounds, void* user_data = nullptr);
     void UnregisterObject(EntityID entity);
@@ -216,9 +253,10 @@ public:
     void QueryPoint(const Vector2f& point, const Quadtree::QueryCallback& callback) const { quadtree_.QueryPoint(point, callback); }
     void QueryAABB(const AABB2D& aabb, const Quadtree::QueryCallback& callback) const { quadtree_.QueryAABB(aabb, callback); }
     void QueryCircle(const Vector2f& center, float radius, const Quadtree::QueryCallback& callback) const { quadtree_.QueryCircle(center, radius, callback); }
+    void QueryAABB(const AABB2D& aabb, std::pmr::vector<SpatialObject>& results) const { quadtree_.QueryAABB(aabb, results); }
 
     // Statistics
-    size_t GetObjectCount() const { return quadtree_.GetObjectCount(); }
+    size_t GetObjectCount() const { return registered_objects_.Size(); }
     size_t GetNodeCount() const { return quadtree_.GetNodeCount(); }
     const AABB2D& GetWorldBounds() const { return quadtree_.GetBounds(); }
 
@@ -227,7 +265,8 @@ public:
 
 private:
     mutable Quadtree quadtree_;
-    std::unordered_set<EntityID, EntityID::Hash> registered_objects_;
+    SparseEntitySet registered_objects_;
+    std::vector<AABB2D> registered_bounds_;   // Parallel to registered_objects_
     bool auto_expand_ = true;
 
     void RebuildQuadtree(const AABB2D& new_bounds);
@@ -5,10 +5,14 @@
 #include "scene/components.hpp"
 #include "scene/quadtree.hpp"
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <functional>
 
 namespace PyNovaGE {
+namespace Physics { class PhysicsWorld; }
+namespace Particles { class ParticleSystem; }
+
 namespace Scene {
 
 /**
@@ -31,11 +35,11 @@ public:
     /**
      * @brief Destructor
      */
-    ~Scene() = default;
+    ~Scene();
 
     // Scene graph access
     std::shared_ptr<SceneNode> GetRootNode() const { return root_node_; }
-    void SetRootNode(std::shared_ptr<SceneNode> root) { root_node_ = root; }
+    void SetRootNode(std::shared_ptr<SceneNode> root) { root_node_ = root; transform_order_.root = nullptr; }
 
     // Entity management
     EntityManager& GetEntityManager() { return entity_manager_; }
@@ -45,6 +49,11 @@ public:
     SpatialManager& GetSpatialManager() { return spatial_manager_; }
     const SpatialManager& GetSpatialManager() const { return spatial_manager_; }
 
+    // Simulation; bodies and emitters join it, at their entity's position, when their component is added
+    Physics::PhysicsWorld& GetPhysicsWorld() { return *physics_world_; }
+    const Physics::PhysicsWorld& GetPhysicsWorld() const { return *physics_world_; }
+    Particles::ParticleSystem* GetParticleSystem() { return particle_system_.get(); }   // nullptr when built without particles
+
     // Entity creation helpers
     EntityID CreateEntity(const std::string& name = "");
     EntityID CreateEntityWithNode(const std::string& name = "", std::shared_ptr<SceneNode> parent = nullptr);
@@ -53,7 +62,21 @@ public:
     // Component shortcuts
     template<typename T, typename... Args>
     T& AddComponent(EntityID entity, Args&&... args) {
-        return entity_manager_.AddComponent<T>(entity, std::forward<Args>(args)...);
+        if constexpr (std::is_same_v<T, RigidBody2DComponent>) {
+            DetachBody(entity);
+        } else if constexpr (std::is_same_v<T, ParticleEmitter2DComponent>) {
+            DetachEmitter(entity);
+        }
+        T& component = entity_manager_.AddComponent<T>(entity, std::forward<Args>(args)...);
+        if constexpr (kAffectsBounds<T>) {
+            MarkSpatialDirty(entity);
+        }
+        if constexpr (std::is_same_v<T, RigidBody2DComponent>) {
+            AttachBody(entity);
+        } else if constexpr (std::is_same_v<T, ParticleEmitter2DComponent>) {
+            AttachEmitter(entity);
+        }
+        return component;
     }
 
     template<typename T>
@@ -73,14 +96,78 @@ public:
 
     template<typename T>
     void RemoveComponent(EntityID entity) {
+        if constexpr (std::is_same_v<T, RigidBody2DComponent>) {
+            DetachBody(entity);
+        } else if constexpr (std::is_same_v<T, ParticleEmitter2DComponent>) {
+            DetachEmitter(entity);
+        }
         entity_manager_.RemoveComponent<T>(entity);
+        if constexpr (kAffectsBounds<T>) {
+            MarkSpatialDirty(entity);
+        }
+    }
+
+    // Queries (see EntityManager::View() and EntityManager::Group())
+    template<typename... Ts>
+    ComponentView<Ts...> View() {
+        return entity_manager_.View<Ts...>();
+    }
+
+    template<typename... Ts>
+    ComponentView<const Ts...> View() const {
+        return entity_manager_.View<Ts...>();
+    }
+
+    template<typename... Ts>
+    ComponentGroup<Ts...> Group() {
+        return entity_manager_.Group<Ts...>();
     }
 
     // Scene updates
     void Update(float delta_time);
+
+    /**
+     * @brief Bring the world transforms of the scene graph up to date
+     *
+     * Only nodes that were marked dirty, and their descendants, are
+     * recomputed, and subtrees with nothing dirty are not visited, so a
+     * frame with nothing dirty only looks at the root. The pass runs over a
+     * breadth-first copy of the tree, level by level, and large levels are
+     * split across the thread pool. The copy is rebuilt only when nodes are
+     * added or removed.
+     */
     void UpdateTransforms();
+
+    /**
+     * @brief Re-index the entities whose bounds may have changed
+     *
+     * Entities are recorded by MarkSpatialDirty(), which the scene calls
+     * itself when components are added or removed, when scene graph nodes
+     * move, and from the Set* helpers below and the physics sync. When a
+     * large share of the scene is recorded, the quadtree is rebuilt from
+     * scratch instead (see SpatialManager::Rebuild()).
+     */
     void UpdateSpatialPartitioning();
+
+    /**
+     * @brief Step the physics world and copy the results to the transforms
+     *
+     * Transforms recorded by MarkSpatialDirty() since the last update are
+     * first pushed to their bodies, which are woken. After the step, one
+     * pass over the RigidBody2DComponent storage copies every awake,
+     * non-static body back to its transform and scene graph node; sleeping
+     * bodies are skipped.
+     */
     void UpdatePhysics(float delta_time);
+
+    /**
+     * @brief Move the emitters of changed entities and step the particles
+     *
+     * Only entities recorded by MarkSpatialDirty() are visited, so this
+     * belongs after UpdatePhysics() and UpdateTransforms() and before
+     * UpdateSpatialPartitioning(), which clears the record. Does nothing
+     * when the scene is built without particles.
+     */
     void UpdateParticles(float delta_time);
 
     // Camera management
@@ -92,17 +179,18 @@ public:
 
     // Culling and rendering support
     std::vector<EntityID> GetVisibleEntities(const CameraComponent* camera) const;
+    void GetVisibleEntities(const CameraComponent* camera, std::pmr::vector<EntityID>& entities) const;
     std::vector<EntityID> GetEntitiesInBounds(const AABB2D& bounds) const;
     void GetRenderableSprites(const CameraComponent* camera, std::vector<std::pair<EntityID, SpriteComponent*>>& sprites) const;
 
     // Scene queries
     EntityID FindEntityByName(const std::string& name) const;
     std::vector<EntityID> FindEntitiesByName(const std::string& name) const;
-    std::vector<EntityID> FindEntitiesWithComponent(const std::type_index& component_type) const;
+    std::vector<EntityID> FindEntitiesWithComponent(ComponentTypeID component_type) const;
 
     template<typename T>
     std::vector<EntityID> FindEntitiesWithComponent() const {
-        return FindEntitiesWithComponent(std::type_index(typeid(T)));
+        return FindEntitiesWithComponent(GetComponentTypeID<T>());
     }
 
     // Spatial queries
@@ -111,6 +199,14 @@ public:
     std::vector<EntityID> QueryCircle(const Vector2f& center, float radius) const;
     std::vector<Quadtree::RayHit> Raycast(const Vector2f& origin, const Vector2f& direction, float max_distance = std::numeric_limits<float>::infinity()) const;
 
+    // Spatial change tracking; call MarkSpatialDirty() after editing a
+    // Transform2DComponent or SpriteComponent in place
+    void MarkSpatialDirty(EntityID entity);
+    void SetEntityPosition(EntityID entity, const Vector2f& position);
+    void SetEntityRotation(EntityID entity, float rotation);
+    void SetEntityScale(EntityID entity, const Vector2f& scale);
+    void SetSpriteSize(EntityID entity, const Vector2f& size);
+
     // Scene hierarchy utilities
     void AttachEntityToNode(EntityID entity, std::shared_ptr<SceneNode> node);
     void DetachEntityFromNode(EntityID entity);
@@ -125,8 +221,16 @@ public:
     void Shutdown();
     void Clear();
 
+    // Pool for the parallel parts of Update(); nullptr runs them on the calling thread
+    void SetThreadPool(Threading::ThreadPool* pool);
+    Threading::ThreadPool* GetThreadPool() const { return thread_pool_; }
+
     // Statistics
     size_t GetEntityCount() const { return entity_manager_.GetEntityCount(); }
+    size_t GetTransformsUpdated() const { return transforms_updated_; }   // Nodes recomputed by the last UpdateTransforms()
+    size_t GetTransformsVisited() const { return transform_order_.visit.size(); }   // Nodes looked at by the last UpdateTransforms()
+    size_t GetEntitiesReindexed() const { return entities_reindexed_; }   // Entities re-indexed by the last UpdateSpatialPartitioning()
+    size_t GetBodiesSynced() const { return bodies_synced_; }             // Bodies copied to transforms by the last UpdatePhysics()
     size_t GetSpatialObjectCount() const { return spatial_manager_.GetObjectCount(); }
     const AABB2D& GetWorldBounds() const { return spatial_manager_.GetWorldBounds(); }
 
@@ -149,16 +253,53 @@ private:
     EntityID primary_camera_;
     UpdateCallback update_callback_;
     RenderCallback render_callback_;
+    Threading::ThreadPool* thread_pool_ = nullptr;
+
+    // Scene graph flattened breadth-first, so each node's children are a contiguous range
+    struct TransformOrder {
+        const SceneNode* root = nullptr;        // Tree this was built from
+        std::vector<SceneNode*> nodes;
+        std::vector<uint32_t> parents;          // Index of each node's parent; the root's is 0
+        std::vector<uint32_t> child_starts;     // Children of node i are [child_starts[i], child_starts[i + 1])
+        std::vector<uint8_t> states;            // Per-node result of the current pass; valid for visited nodes
+        std::vector<uint32_t> visit;            // Nodes visited by the current pass, level by level
+    };
+    TransformOrder transform_order_;
+    size_t transforms_updated_ = 0;
+
+    SparseEntitySet spatial_dirty_;   // Entities to re-index in the next UpdateSpatialPartitioning()
+    size_t entities_reindexed_ = 0;
+
+    std::unique_ptr<Physics::PhysicsWorld> physics_world_;
+    std::shared_ptr<Particles::ParticleSystem> particle_system_;   // Shared so it may stay incomplete without particles
+    size_t bodies_synced_ = 0;
+    std::vector<EntityID> body_entities_;   // Entity per physics body index, for the awake-body writeback
+    bool body_entities_dirty_ = true;       // Set when bodies join or leave the world
+
+    // Components that CalculateEntityBounds() reads
+    template<typename T>
+    static constexpr bool kAffectsBounds = std::is_same_v<T, Transform2DComponent> ||
+                                           std::is_same_v<T, SpriteComponent> ||
+                                           std::is_same_v<T, HierarchyComponent>;
 
     // Internal methods
+    void RebuildTransformOrder();
+    bool UpdateTransformAt(size_t index);
+    void RebuildSpatialPartitioning();
     void SyncTransformToNode(EntityID entity);
     void SyncNodeToTransform(EntityID entity);
     void SyncPhysicsToTransform(EntityID entity);
     void SyncTransformToPhysics(EntityID entity);
     void SyncParticleEmitterPosition(EntityID entity);
-    void UpdateEntitySpatialBounds(EntityID entity);
+    void AttachBody(EntityID entity);
+    void DetachBody(EntityID entity);
+    void RebuildBodyEntities();
+    void AttachEmitter(EntityID entity);
+    void DetachEmitter(EntityID entity);
+    bool UpdateEntitySpatialBounds(EntityID entity);
     
     AABB2D CalculateEntityBounds(EntityID entity) const;
+    bool GetCameraViewBounds(const CameraComponent* camera, AABB2D& view_bounds) const;
     void RegisterEntityForSpatialPartitioning(EntityID entity);
     void UnregisterEntityFromSpatialPartitioning(EntityID entity);
 };
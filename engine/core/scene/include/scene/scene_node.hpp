@@ -12,12 +12,19 @@
 namespace PyNovaGE {
 namespace Scene {
 
+class Scene;
+
 /**
  * @brief Scene graph node for hierarchical transform management
  * 
  * Represents a node in the scene graph tree with parent/child relationships.
  * Each node has a local transform and computes world transform from parent chain.
  * Optionally associated with an Entity for ECS component storage.
+ *
+ * World transforms are updated lazily: the transform setters and
+ * reparenting only mark the node dirty, and world values are current after
+ * the next Scene::UpdateTransforms(), or UpdateTransforms() on a node of a
+ * tree that no scene owns.
  */
 class SceneNode {
 public:
@@ -74,7 +81,8 @@ public:
     const SceneNode* GetRoot() const;
     size_t GetDepth() const;
 
-    // Transform access
+    // Transform access; call MarkTransformDirty() after changing the local
+    // transform through the mutable reference
     Transform2D& GetTransform() { return transform_; }
     const Transform2D& GetTransform() const { return transform_; }
 
@@ -102,9 +110,18 @@ public:
     int GetZOrder() const { return z_order_; }
 
     // Update and traversal
+    /**
+     * @brief Recompute the world transforms of this node and all its descendants now
+     *
+     * A node without a parent gets the identity world transform.
+     */
     void UpdateTransforms();
     void UpdateTransforms(const Matrix3f& parent_world_matrix);
 
+    // Dirty tracking for the lazy update in Scene::UpdateTransforms()
+    void MarkTransformDirty();
+    bool IsTransformDirty() const { return transform_dirty_; }
+
     void VisitChildren(const NodeVisitor& func) const;
     void VisitDescendants(const NodeVisitor& func) const;
 
@@ -122,6 +139,8 @@ protected:
     virtual void OnWorldTransformChanged() {}
 
 private:
+    friend class Scene;
+
     std::string name_;
     EntityID entity_;
     Transform2D transform_;
@@ -129,6 +148,9 @@ private:
     bool visible_ = true;
     int z_order_ = 0;
     bool z_order_dirty_ = false;
+    bool transform_dirty_ = true;     // Local transform or parent changed since the last update
+    bool descendant_dirty_ = false;   // Some node below has transform_dirty_ set
+    bool hierarchy_dirty_ = true;     // Children changed here or below since the scene last flattened the tree
 
     SceneNode* parent_ = nullptr;
     std::vector<std::shared_ptr<SceneNode>> children_;
@@ -137,6 +159,7 @@ private:
     // Internal methods
     void SetParent(SceneNode* parent);
     void MarkZOrderDirty();
+    void MarkHierarchyDirty();
     void UpdateWorldTransform();
     void UpdateWorldTransform(const Matrix3f& parent_world_matrix);
 };
@@ -1,6 +1,10 @@
 #include "scene/components.hpp"
 #include "physics/rigid_body.hpp"
 
+#if PYNOVAGE_HAS_PARTICLES
+#include "particles/particle_emitter.hpp"
+#endif
+
 namespace PyNovaGE {
 namespace Scene {
 
@@ -68,5 +72,56 @@ void RigidBody2DComponent::ApplyImpulse(const Vector2f& impulse) {
     }
 }
 
+#if PYNOVAGE_HAS_PARTICLES
+void ParticleEmitter2DComponent::SetPosition(const Vector2f& position) {
+    if (emitter) {
+        emitter->SetPosition(position);
+    }
+}
+
+Vector2f ParticleEmitter2DComponent::GetPosition() const {
+    if (emitter) {
+        return emitter->GetPosition();
+    }
+    return Vector2f{0.0f, 0.0f};
+}
+
+void ParticleEmitter2DComponent::Start() {
+    if (emitter) {
+        emitter->Start();
+    }
+}
+
+void ParticleEmitter2DComponent::Stop() {
+    if (emitter) {
+        emitter->Stop();
+    }
+}
+
+void ParticleEmitter2DComponent::SetPaused(bool paused) {
+    if (emitter) {
+        emitter->SetPaused(paused);
+    }
+}
+
+bool ParticleEmitter2DComponent::IsActive() const {
+    return emitter && emitter->IsActive();
+}
+
+void ParticleEmitter2DComponent::EmitBurst(int count) {
+    if (emitter) {
+        emitter->EmitBurst(count);
+    }
+}
+#endif
+
+Vector2f CameraComponent::GetViewMin(const Vector2f& camera_world_pos) const {
+    return camera_world_pos + offset - GetViewSize() * 0.5f;
+}
+
+Vector2f CameraComponent::GetViewMax(const Vector2f& camera_world_pos) const {
+    return camera_world_pos + offset + GetViewSize() * 0.5f;
+}
+
 } // namespace Scene
 } // namespace PyNovaGE
\ No newline at end of file
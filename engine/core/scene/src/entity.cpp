@@ -4,37 +4,52 @@ namespace PyNovaGE {
 namespace Scene {
 
 EntityID EntityManager::CreateEntity() {
-    EntityID::IDType id = next_id_++;
-    EntityID::GenerationType gen = next_generation_++;
-    entities_[id] = gen;
-    return EntityID(id, gen);
+    EntityID::IDType id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    } else {
+        id = static_cast<EntityID::IDType>(generations_.size());
+        generations_.push_back(EntityID::NULL_GENERATION + 1);
+    }
+
+    EntityID entity(id, generations_[id]);
+    entities_.Insert(entity);
+    return entity;
 }
 
 void EntityManager::DestroyEntity(EntityID entity) {
-    auto id = entity.GetID();
-    auto it = entities_.find(id);
-    if (it != entities_.end() && it->second == entity.GetGeneration()) {
-        // Entity exists and generation matches
-        entities_.erase(it);
-
-        // Remove all components
-        for (auto& [type, storage] : component_storages_) {
+    if (entities_.Erase(entity) == SparseEntitySet::kInvalidIndex) {
+        return;
+    }
+
+    // Remove all components, letting groups give up the entity first
+    for (auto& storage : component_storages_) {
+        if (storage && storage->group_) {
+            storage->group_->OnRemove(entity);
+        }
+    }
+    for (auto& storage : component_storages_) {
+        if (storage) {
             storage->RemoveComponent(entity);
         }
     }
-}
 
-bool EntityManager::IsEntityValid(EntityID entity) const {
-    auto it = entities_.find(entity.GetID());
-    return it != entities_.end() && it->second == entity.GetGeneration();
+    // Old handles to this ID go stale; the null generation is never handed out
+    auto& generation = generations_[entity.GetID()];
+    if (++generation == EntityID::NULL_GENERATION) {
+        ++generation;
+    }
+    free_ids_.push_back(entity.GetID());
 }
 
 void EntityManager::Clear() {
-    entities_.clear();
+    entities_.Clear();
+    groups_.clear();
     component_storages_.clear();
-    next_id_ = 1;
-    next_generation_ = 1;
+    generations_.assign(1, EntityID::NULL_GENERATION);
+    free_ids_.clear();
 }
 
 } // namespace Scene
-} // namespace PyNovaGE
\ No newline at end of file
+} // namespace PyNovaGE
@@ -1,8 +1,17 @@
 #include "scene/quadtree.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace PyNovaGE {
 namespace Scene {
 
+namespace {
+
+// Nodes with fewer objects than this build their subtrees on the calling thread
+constexpr size_t kParallelBuildSize = 4096;
+
+} // anonymous namespace
+
 // AABB2D implementation
 bool AABB2D::Contains(const Vector2f& point) const {
     return point.x >= min.x && point.x <= max.x &&
@@ -87,6 +96,11 @@ bool SpatialManager::Update(EntityID entity, const AABB2D& bounds) {
 }
 
 void SpatialManager::RegisterObject(EntityID entity, const AABB2D& bounds, void* user_data) {
+    if (registered_objects_.Contains(entity)) {
+        UpdateObject(entity, bounds);
+        return;
+    }
+
     // First check if we should expand world bounds
     if (auto_expand_) {
         const AABB2D& world_bounds = quadtree_.GetBounds();
@@ -98,15 +112,23 @@ void SpatialManager::RegisterObject(EntityID entity, const AABB2D& bounds, void*
 
     // Insert the object into the quadtree
     quadtree_.Insert(entity, bounds, user_data);
-    registered_objects_.insert(entity);
+    registered_objects_.Insert(entity);
+    registered_bounds_.push_back(bounds);
 }
 
 void SpatialManager::UnregisterObject(EntityID entity) {
-    quadtree_.Remove(entity);
-    registered_objects_.erase(entity);
+    const uint32_t index = registered_objects_.Erase(entity);
+    if (index == SparseEntitySet::kInvalidIndex) return;
+
+    quadtree_.Remove(entity, registered_bounds_[index]);
+    registered_bounds_[index] = registered_bounds_.back();
+    registered_bounds_.pop_back();
 }
 
 void SpatialManager::UpdateObject(EntityID entity, const AABB2D& new_bounds) {
+    const uint32_t index = registered_objects_.IndexOf(entity);
+    if (index == SparseEntitySet::kInvalidIndex) return;
+
     // Check if we need to expand world bounds
     if (auto_expand_) {
         const AABB2D& world_bounds = quadtree_.GetBounds();
@@ -116,8 +138,13 @@ void SpatialManager::UpdateObject(EntityID entity, const AABB2D& new_bounds) {
         }
     }
 
-    // Update the object in the quadtree
-    quadtree_.Update(entity, new_bounds);
+    // Update the object in the quadtree; if it is not where its old bounds
+    // lead, search the whole tree rather than lose it
+    if (!quadtree_.Update(entity, registered_bounds_[index], new_bounds) &&
+        !quadtree_.Update(entity, new_bounds)) {
+        quadtree_.Insert(entity, new_bounds);
+    }
+    registered_bounds_[index] = new_bounds;
 }
 
 void SpatialManager::Initialize() {
@@ -126,7 +153,21 @@ void SpatialManager::Initialize() {
 
 void SpatialManager::Clear() {
     quadtree_.Clear();
-    registered_objects_.clear();
+    registered_objects_.Clear();
+    registered_bounds_.clear();
+}
+
+void SpatialManager::Rebuild(std::vector<SpatialObject> objects, Threading::ThreadPool* pool) {
+    registered_objects_.Clear();
+    registered_bounds_.clear();
+    registered_objects_.Reserve(objects.size());
+    registered_bounds_.reserve(objects.size());
+    for (const auto& object : objects) {
+        registered_objects_.Insert(object.entity);
+        registered_bounds_.push_back(object.bounds);
+    }
+
+    quadtree_.Build(std::move(objects), pool);
 }
 
 void SpatialManager::ClearAll() {
@@ -142,14 +183,18 @@ void SpatialManager::ExpandWorldBounds(const AABB2D& bounds) {
     RebuildQuadtree(new_bounds);
 }
 
-void SpatialManager::RebuildQuadtree(const AABB2D& /*new_bounds*/) {
-    // Fallback: we cannot assign Quadtree due to unique_ptr members.
-    // Instead, clear and reinsert into existing quadtree without changing bounds.
-    auto all_objects = quadtree_.QueryAABB(quadtree_.GetBounds());
-    quadtree_.Clear();
-    for (const auto& obj : all_objects) {
-        quadtree_.Insert(obj);
+void SpatialManager::RebuildQuadtree(const AABB2D& new_bounds) {
+    // Grow to enclose everything registered, not just the object that triggered the rebuild
+    AABB2D bounds = new_bounds;
+    for (const auto& registered : registered_bounds_) {
+        bounds.Expand(registered);
     }
+
+    // Objects outside the old bounds sit in the root, so gather them from every node
+    std::vector<SpatialObject> all_objects;
+    all_objects.reserve(registered_bounds_.size());
+    quadtree_.GetAllObjects(all_objects);
+    quadtree_.Build(bounds, std::move(all_objects));
 }
 
 // Quadtree implementation
@@ -214,6 +259,99 @@ bool Quadtree::Update(EntityID entity, const AABB2D& new_bounds) {
     return false;
 }
 
+bool Quadtree::Remove(EntityID entity, const AABB2D& bounds) {
+    auto& objects = GetTargetNode(bounds)->objects_;
+    for (auto it = objects.begin(); it != objects.end(); ++it) {
+        if (it->entity == entity) {
+            *it = objects.back();
+            objects.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Quadtree::Update(EntityID entity, const AABB2D& old_bounds, const AABB2D& new_bounds) {
+    Quadtree* from = GetTargetNode(old_bounds);
+    auto it = std::find_if(from->objects_.begin(), from->objects_.end(),
+        [entity](const SpatialObject& object) { return object.entity == entity; });
+    if (it == from->objects_.end()) return false;
+
+    Quadtree* to = GetTargetNode(new_bounds);
+    if (to == from) {
+        it->bounds = new_bounds;
+        return true;
+    }
+
+    SpatialObject object = *it;
+    object.bounds = new_bounds;
+    *it = from->objects_.back();
+    from->objects_.pop_back();
+    to->Insert(object);
+    return true;
+}
+
+void Quadtree::Build(std::vector<SpatialObject> objects, Threading::ThreadPool* pool) {
+    Clear();
+    BuildRecursive(std::move(objects), pool);
+}
+
+void Quadtree::Build(const AABB2D& bounds, std::vector<SpatialObject> objects, Threading::ThreadPool* pool) {
+    Clear();
+    bounds_ = bounds;
+    BuildRecursive(std::move(objects), pool);
+}
+
+void Quadtree::GetAllObjects(std::vector<SpatialObject>& objects) const {
+    objects.insert(objects.end(), objects_.begin(), objects_.end());
+    if (children_[0]) {
+        for (const auto& child : children_) {
+            child->GetAllObjects(objects);
+        }
+    }
+}
+
+void Quadtree::BuildRecursive(std::vector<SpatialObject>&& objects, Threading::ThreadPool* pool) {
+    // Same rule as Insert(): split once a node holds more than max_objects_
+    if (objects.size() <= max_objects_ || depth_ >= max_depth_) {
+        objects_ = std::move(objects);
+        return;
+    }
+
+    CreateChildren();
+    std::array<std::vector<SpatialObject>, 4> child_objects;
+    for (const auto& obj : objects) {
+        int index = GetChildIndex(obj.bounds);
+        if (index != -1) {
+            child_objects[index].push_back(obj);
+        } else {
+            objects_.push_back(obj);
+        }
+    }
+
+    auto build_child = [this, &child_objects, pool](size_t index) {
+        children_[index]->BuildRecursive(std::move(child_objects[index]), pool);
+    };
+    if (pool && objects.size() >= kParallelBuildSize) {
+        Threading::parallel_for(0, children_.size(), build_child, pool, 1);
+    } else {
+        for (size_t i = 0; i < children_.size(); ++i) {
+            build_child(i);
+        }
+    }
+}
+
+Quadtree* Quadtree::GetTargetNode(const AABB2D& bounds) {
+    // Where Insert() would put an object with these bounds
+    Quadtree* node = this;
+    while (node->children_[0]) {
+        int index = node->GetChildIndex(bounds);
+        if (index == -1) break;
+        node = node->children_[index].get();
+    }
+    return node;
+}
+
 void Quadtree::Clear() {
     objects_.clear();
     for (auto& child : children_) {
@@ -221,13 +359,16 @@ void Quadtree::Clear() {
     }
 }
 
-void Quadtree::Subdivide() {
-    // Create child nodes
+void Quadtree::CreateChildren() {
     auto child_bounds = bounds_.Subdivide();
     for (size_t i = 0; i < 4; ++i) {
         children_[i] = std::make_unique<Quadtree>(child_bounds[i], max_objects_, max_depth_);
         children_[i]->depth_ = depth_ + 1;
     }
+}
+
+void Quadtree::Subdivide() {
+    CreateChildren();
 
     // Redistribute objects to children
     std::vector<SpatialObject> remaining_objects;
@@ -245,16 +386,20 @@ void Quadtree::Subdivide() {
 }
 
 int Quadtree::GetChildIndex(const AABB2D& bounds) const {
+    // Objects reaching outside this node stay in it, where queries always test them
+    if (!bounds_.Contains(bounds)) return -1;
+
+    // Indices follow AABB2D::Subdivide()
     Vector2f center = bounds_.GetCenter();
-    bool top = bounds.max.y <= center.y;
-    bool bottom = bounds.min.y >= center.y;
+    bool bottom = bounds.max.y <= center.y;
+    bool top = bounds.min.y >= center.y;
     bool left = bounds.max.x <= center.x;
     bool right = bounds.min.x >= center.x;
 
-    if (top && right) return 0;
-    if (top && left) return 1;
-    if (bottom && right) return 2;
-    if (bottom && left) return 3;
+    if (bottom && left) return 0;
+    if (bottom && right) return 1;
+    if (top && left) return 2;
+    if (top && right) return 3;
 
     return -1; // Overlaps multiple quadrants
 }
@@ -269,13 +414,29 @@ size_t Quadtree::GetObjectCount() const {
     return count;
 }
 
+size_t Quadtree::GetNodeCount() const {
+    size_t count = 1;
+    if (children_[0]) {
+        for (const auto& child : children_) {
+            count += child->GetNodeCount();
+        }
+    }
+    return count;
+}
+
 std::vector<SpatialObject> Quadtree::QueryAABB(const AABB2D& aabb) const {
     std::vector<SpatialObject> results;
     QueryAABBRecursive(aabb, results);
     return results;
 }
 
-void Quadtree::QueryAABBRecursive(const AABB2D& aabb, std::vector<SpatialObject>& results) const {
+void Quadtree::QueryAABB(const AABB2D& aabb, std::pmr::vector<SpatialObject>& results) const {
+    results.clear();
+    QueryAABBRecursive(aabb, results);
+}
+
+template<typename Container>
+void Quadtree::QueryAABBRecursive(const AABB2D& aabb, Container& results) const {
     // Check objects in this node
     for (const auto& obj : objects_) {
         if (aabb.Intersects(obj.bounds)) {
@@ -293,7 +454,40 @@ void Quadtree::QueryAABBRecursive(const AABB2D& aabb, std::vector<SpatialObject>
     }
 }
 
+void Quadtree::QueryAABB(const AABB2D& aabb, const QueryCallback& callback) const {
+    QueryAABBRecursive(aabb, callback);
+}
+
+void Quadtree::QueryAABBRecursive(const AABB2D& aabb, const QueryCallback& callback) const {
+    for (const auto& obj : objects_) {
+        if (aabb.Intersects(obj.bounds)) {
+            callback(obj);
+        }
+    }
+
+    if (children_[0]) {
+        for (const auto& child : children_) {
+            if (aabb.Intersects(child->bounds_)) {
+                child->QueryAABBRecursive(aabb, callback);
+            }
+        }
+    }
+}
+
 namespace SpatialUtils {
+    AABB2D TransformAABB(const AABB2D& aabb, const Matrix3f& transform) {
+        // Transform the center, and project the half extents onto the world axes
+        const Vector2f center = aabb.GetCenter();
+        const Vector2f extent = aabb.GetSize() * 0.5f;
+        const Vector2f world_center(
+            transform(0, 0) * center.x + transform(0, 1) * center.y + transform(0, 2),
+            transform(1, 0) * center.x + transform(1, 1) * center.y + transform(1, 2));
+        const Vector2f world_extent(
+            std::abs(transform(0, 0)) * extent.x + std::abs(transform(0, 1)) * extent.y,
+            std::abs(transform(1, 0)) * extent.x + std::abs(transform(1, 1)) * extent.y);
+        return AABB2D(world_center - world_extent, world_center + world_extent);
+    }
+
     bool CircleAABBIntersect(const Vector2f& center, float radius, const AABB2D& aabb) {
         // Find closest point on AABB to circle center
         Vector2f closest_point = center;
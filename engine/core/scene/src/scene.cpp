@@ -1,11 +1,47 @@
 #include "scene/scene.hpp"
+#include "physics/physics_world.hpp"
+#include <functional>
+#include <limits>
+
+#if PYNOVAGE_HAS_PARTICLES
+#include "particles/particle_system.hpp"
+#endif
 
 namespace PyNovaGE {
 namespace Scene {
 
+namespace {
+
+// Depth levels smaller than this are updated on the calling thread
+constexpr size_t kParallelTransformLevel = 1024;
+
+// UpdateSpatialPartitioning() rebuilds the quadtree once at least this many
+// entities, and at least a quarter of those indexed, are waiting
+constexpr size_t kSpatialRebuildMinimum = 1024;
+constexpr size_t kSpatialRebuildDivisor = 4;
+
+// TransformOrder::states bits
+constexpr uint8_t kTransformUpdated = 1;    // World matrix recomputed
+constexpr uint8_t kTransformDescend = 2;    // Children need a look
+
+} // anonymous namespace
+
 // Constructor
-Scene::Scene(const AABB2D& world_bounds) : spatial_manager_(world_bounds) {
+Scene::Scene(const AABB2D& world_bounds)
+    : spatial_manager_(world_bounds)
+    , physics_world_(std::make_unique<Physics::PhysicsWorld>()) {
     root_node_ = std::make_shared<SceneNode>("root");
+#if PYNOVAGE_HAS_PARTICLES
+    particle_system_ = std::make_shared<Particles::ParticleSystem>();
+    particle_system_->Initialize();
+#endif
+}
+
+Scene::~Scene() = default;
+
+void Scene::SetThreadPool(Threading::ThreadPool* pool) {
+    thread_pool_ = pool;
+    physics_world_->setThreadPool(pool);
 }
 
 // Entity creation helpers
@@ -26,7 +62,7 @@ EntityID Scene::CreateEntityWithNode(const std::string& name, std::shared_ptr<Sc
     }
     parent->AddChild(node);
 
-    auto& hierarchy = entity_manager_.AddComponent<HierarchyComponent>(entity);
+    auto& hierarchy = AddComponent<HierarchyComponent>(entity);
     hierarchy.scene_node = node;
 
     return entity;
@@ -42,6 +78,11 @@ void Scene::DestroyEntity(EntityID entity) {
 
     // Unregister from spatial manager
     UnregisterEntityFromSpatialPartitioning(entity);
+    spatial_dirty_.Erase(entity);
+
+    // Take its body and emitter out of the simulation
+    DetachBody(entity);
+    DetachEmitter(entity);
     
     // Destroy the entity
     entity_manager_.DestroyEntity(entity);
@@ -51,18 +92,18 @@ void Scene::DestroyEntity(EntityID entity) {
 void Scene::Update(float delta_time) {
     OnPreUpdate(delta_time);
 
+    // Physics update; moved bodies mark their nodes and entities dirty
+    UpdatePhysics(delta_time);
+
     // Update transforms
     UpdateTransforms();
 
+    // Particles update; reads the entities the spatial update is about to clear
+    UpdateParticles(delta_time);
+
     // Update spatial partitioning
     UpdateSpatialPartitioning();
 
-    // Physics update
-    UpdatePhysics(delta_time);
-
-    // Particles update
-    UpdateParticles(delta_time);
-    
     // User update callback
     if (update_callback_) {
         update_callback_(delta_time);
@@ -72,30 +113,201 @@ void Scene::Update(float delta_time) {
 }
 
 void Scene::UpdateTransforms() {
+    transforms_updated_ = 0;
     if (!root_node_) return;
-    root_node_->UpdateTransforms();
+
+    if (transform_order_.root != root_node_.get() || root_node_->hierarchy_dirty_) {
+        RebuildTransformOrder();
+    }
+
+    // Walk down level by level, queueing only the children of nodes that
+    // were recomputed or have something dirty below; clean subtrees are
+    // never visited. Parents are a level above their children, so each
+    // level only reads finished results.
+    auto& order = transform_order_;
+    auto& visit = order.visit;
+    visit.clear();
+    visit.push_back(0);
+    size_t level_begin = 0;
+    while (level_begin < visit.size()) {
+        const size_t level_end = visit.size();
+        if (thread_pool_ && level_end - level_begin >= kParallelTransformLevel) {
+            transforms_updated_ += Threading::parallel_reduce(level_begin, level_end, size_t{0},
+                [this, &visit](size_t k) -> size_t { return UpdateTransformAt(visit[k]) ? 1 : 0; },
+                std::plus<size_t>(), thread_pool_, kParallelTransformLevel / 4);
+        } else {
+            for (size_t k = level_begin; k < level_end; ++k) {
+                transforms_updated_ += UpdateTransformAt(visit[k]) ? 1 : 0;
+            }
+        }
+
+        for (size_t k = level_begin; k < level_end; ++k) {
+            const uint32_t index = visit[k];
+            if (order.states[index] & kTransformDescend) {
+                for (uint32_t child = order.child_starts[index]; child < order.child_starts[index + 1]; ++child) {
+                    visit.push_back(child);
+                }
+            }
+        }
+        level_begin = level_end;
+    }
+
+    // Moved entity nodes need re-indexing
+    if (transforms_updated_ > 0) {
+        for (const uint32_t index : visit) {
+            if (order.states[index] & kTransformUpdated) {
+                const SceneNode* node = order.nodes[index];
+                if (node->HasEntity()) {
+                    MarkSpatialDirty(node->GetEntity());
+                }
+            }
+        }
+    }
+
     OnTransformsUpdated();
 }
 
-void Scene::UpdateSpatialPartitioning() {
-    // Rebuild spatial partitioning structures
-    spatial_manager_.Clear();
+void Scene::RebuildTransformOrder() {
+    auto& order = transform_order_;
+    order.nodes.clear();
+    order.parents.clear();
+    order.child_starts.clear();
+
+    // Breadth-first, so each node's children end up next to each other
+    order.nodes.push_back(root_node_.get());
+    order.parents.push_back(0);
+    for (size_t index = 0; index < order.nodes.size(); ++index) {
+        SceneNode* node = order.nodes[index];
+        node->hierarchy_dirty_ = false;
+        order.child_starts.push_back(static_cast<uint32_t>(order.nodes.size()));
+        for (const auto& child : node->children_) {
+            order.nodes.push_back(child.get());
+            order.parents.push_back(static_cast<uint32_t>(index));
+        }
+    }
+    order.child_starts.push_back(static_cast<uint32_t>(order.nodes.size()));
+
+    order.states.assign(order.nodes.size(), 0);
+    order.root = root_node_.get();
+}
 
-    // Update all entities
-    std::vector<EntityID> entities = entity_manager_.GetAllEntities();
-    for (const EntityID& entity : entities) {
-        UpdateEntitySpatialBounds(entity);
+bool Scene::UpdateTransformAt(size_t index) {
+    auto& order = transform_order_;
+    // Only called for nodes whose parent was visited and asked to descend
+    const uint8_t parent_state = index == 0 ? kTransformDescend : order.states[order.parents[index]];
+
+    SceneNode* node = order.nodes[index];
+    const bool dirty = node->transform_dirty_ || (parent_state & kTransformUpdated);
+    order.states[index] = static_cast<uint8_t>((dirty ? kTransformUpdated | kTransformDescend : 0) |
+                                               (node->descendant_dirty_ ? kTransformDescend : 0));
+    node->descendant_dirty_ = false;
+    if (!dirty) return false;
+
+    // The root's own transform is not applied, as in SceneNode::UpdateTransforms()
+    if (index == 0) {
+        node->transform_.SetWorldMatrix(Matrix3f::Identity());
+    } else {
+        const Transform2D& local = node->transform_;
+        node->transform_.SetWorldMatrix(order.nodes[order.parents[index]]->GetWorldMatrix() *
+            TransformUtils::CreateTRSMatrix(local.GetPosition(), local.GetRotation(), local.GetScale()));
     }
+    node->transform_dirty_ = false;
+
+    node->OnTransformChanged();
+    node->OnWorldTransformChanged();
+    return true;
+}
+
+void Scene::UpdateSpatialPartitioning() {
+    entities_reindexed_ = 0;
+
+    const size_t pending = spatial_dirty_.Size();
+    if (pending >= kSpatialRebuildMinimum &&
+        pending * kSpatialRebuildDivisor >= spatial_manager_.GetObjectCount()) {
+        RebuildSpatialPartitioning();
+    } else {
+        for (const EntityID entity : spatial_dirty_.GetEntities()) {
+            entities_reindexed_ += UpdateEntitySpatialBounds(entity) ? 1 : 0;
+        }
+    }
+    spatial_dirty_.Clear();
 
     OnSpatialPartitioningUpdated();
 }
 
-void Scene::UpdatePhysics([[maybe_unused]] float delta_time) {
-    // TODO: Implement physics system update
+void Scene::RebuildSpatialPartitioning() {
+    const auto& entities = entity_manager_.GetAllEntities();
+    std::vector<AABB2D> bounds(entities.size());
+    auto calculate = [this, &entities, &bounds](size_t index) {
+        bounds[index] = CalculateEntityBounds(entities[index]);
+    };
+    if (thread_pool_) {
+        Threading::parallel_for(0, entities.size(), calculate, thread_pool_, 256);
+    } else {
+        for (size_t index = 0; index < entities.size(); ++index) {
+            calculate(index);
+        }
+    }
+
+    std::vector<SpatialObject> objects;
+    objects.reserve(entities.size());
+    for (size_t index = 0; index < entities.size(); ++index) {
+        if (bounds[index].IsValid()) {
+            objects.emplace_back(entities[index], bounds[index]);
+        }
+    }
+    entities_reindexed_ = objects.size();
+    spatial_manager_.Rebuild(std::move(objects), thread_pool_);
+}
+
+void Scene::UpdatePhysics(float delta_time) {
+    bodies_synced_ = 0;
+    if (physics_world_->getBodyCount() == 0) return;
+
+    // Transforms moved since the last update lead their bodies
+    for (const EntityID entity : spatial_dirty_.GetEntities()) {
+        SyncTransformToPhysics(entity);
+    }
+
+    physics_world_->step(delta_time);
+
+    // Sleeping and static bodies cannot have moved, so only the world's awake list is visited
+    if (body_entities_dirty_ || body_entities_.size() != physics_world_->getBodyCount()) {
+        RebuildBodyEntities();
+    }
+    const auto& bodies = physics_world_->getBodies();
+    for (const uint32_t index : physics_world_->getAwakeBodies()) {
+        const EntityID entity = body_entities_[index];
+        if (!entity.IsValid()) continue;   // Added to the world directly, not through a component
+
+        auto* rigid_body = GetComponent<RigidBody2DComponent>(entity);
+        auto* transform = GetComponent<Transform2DComponent>(entity);
+        const auto& body = bodies[index];
+        if (!rigid_body || rigid_body->body != body) {
+            body_entities_dirty_ = true;   // The world was changed behind our back
+            continue;
+        }
+        if (!transform || !rigid_body->auto_sync_transform) continue;
+
+        const Vector2f position = body->getPosition();
+        const float rotation = body->getRotation();
+        const Vector2f current = transform->GetPosition();
+        if (position.x == current.x && position.y == current.y && rotation == transform->GetRotation()) continue;
+
+        transform->SetPosition(position);
+        transform->SetRotation(rotation);
+        SyncTransformToNode(entity);
+        ++bodies_synced_;
+    }
 }
 
 void Scene::UpdateParticles([[maybe_unused]] float delta_time) {
-    // TODO: Implement particle system update
+#if PYNOVAGE_HAS_PARTICLES
+    for (const EntityID entity : spatial_dirty_.GetEntities()) {
+        SyncParticleEmitterPosition(entity);
+    }
+    particle_system_->Update(delta_time);
+#endif
 }
 
 // Camera management
@@ -117,6 +329,65 @@ std::vector<EntityID> Scene::GetAllCameras() const {
     return FindEntitiesWithComponent<CameraComponent>();
 }
 
+// Culling and rendering support
+std::vector<EntityID> Scene::GetVisibleEntities(const CameraComponent* camera) const {
+    std::vector<EntityID> entities;
+    AABB2D view_bounds;
+    if (GetCameraViewBounds(camera, view_bounds)) {
+        spatial_manager_.QueryAABB(view_bounds, [&entities](const SpatialObject& object) {
+            entities.push_back(object.entity);
+        });
+    }
+    return entities;
+}
+
+void Scene::GetVisibleEntities(const CameraComponent* camera, std::pmr::vector<EntityID>& entities) const {
+    entities.clear();
+    AABB2D view_bounds;
+    if (!GetCameraViewBounds(camera, view_bounds)) {
+        return;
+    }
+
+    // Gather hits in scratch taken from the caller's resource, so frame memory stays frame memory
+    std::pmr::vector<SpatialObject> objects(entities.get_allocator().resource());
+    spatial_manager_.QueryAABB(view_bounds, objects);
+    entities.reserve(objects.size());
+    for (const auto& object : objects) {
+        entities.push_back(object.entity);
+    }
+}
+
+// Spatial queries
+std::vector<EntityID> Scene::QueryPoint(const Vector2f& point) const {
+    return QueryAABB(AABB2D(point, point));
+}
+
+std::vector<EntityID> Scene::QueryAABB(const AABB2D& aabb) const {
+    std::vector<EntityID> entities;
+    spatial_manager_.QueryAABB(aabb, [&entities](const SpatialObject& object) {
+        entities.push_back(object.entity);
+    });
+    return entities;
+}
+
+bool Scene::GetCameraViewBounds(const CameraComponent* camera, AABB2D& view_bounds) const {
+    if (!camera) return false;
+
+    // Find the entity owning this camera to get its world position
+    const auto* cameras = entity_manager_.GetComponentStorage<CameraComponent>();
+    if (!cameras) return false;
+
+    const EntityID entity = cameras->GetEntity(camera);
+    if (!entity.IsValid()) return false;
+
+    Vector2f position(0.0f, 0.0f);
+    if (const auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        position = transform->GetWorldPosition();
+    }
+    view_bounds = AABB2D(camera->GetViewMin(position), camera->GetViewMax(position));
+    return true;
+}
+
 // Initialization and shutdown
 void Scene::Initialize() {
     // Initialize components
@@ -140,9 +411,17 @@ void Scene::Shutdown() {
         root_node_->ClearChildren();
     }
     root_node_.reset();
+    transform_order_ = TransformOrder{};
 
     // Clear spatial manager
     spatial_manager_.Clear();
+    spatial_dirty_.Clear();
+
+    // Clear simulation
+    physics_world_->clear();
+#if PYNOVAGE_HAS_PARTICLES
+    particle_system_->ClearEmitters();
+#endif
 
     // Clear callbacks
     update_callback_ = nullptr;
@@ -160,8 +439,10 @@ void Scene::SyncTransformToNode(EntityID entity) {
         if (auto* hierarchy = GetComponent<HierarchyComponent>(entity)) {
             if (auto node = hierarchy->GetSceneNode()) {
                 node->GetTransform() = transform->transform;
+                node->MarkTransformDirty();
             }
         }
+        MarkSpatialDirty(entity);
     }
 }
 
@@ -175,15 +456,178 @@ void Scene::SyncNodeToTransform(EntityID entity) {
     }
 }
 
-void Scene::UpdateEntitySpatialBounds(EntityID entity) {
-    if (auto bounds = CalculateEntityBounds(entity); bounds.IsValid()) {
-        RegisterEntityForSpatialPartitioning(entity);
+void Scene::SyncPhysicsToTransform(EntityID entity) {
+    auto* rigid_body = GetComponent<RigidBody2DComponent>(entity);
+    auto* transform = GetComponent<Transform2DComponent>(entity);
+    if (!rigid_body || !rigid_body->body || !rigid_body->auto_sync_transform || !transform) return;
+
+    transform->SetPosition(rigid_body->GetPosition());
+    transform->SetRotation(rigid_body->GetRotation());
+    SyncTransformToNode(entity);
+}
+
+void Scene::SyncTransformToPhysics(EntityID entity) {
+    auto* rigid_body = GetComponent<RigidBody2DComponent>(entity);
+    const auto* transform = GetComponent<Transform2DComponent>(entity);
+    if (!rigid_body || !rigid_body->body || !rigid_body->auto_sync_transform || !transform) return;
+
+    // Leave bodies asleep unless the transform really moved
+    auto& body = *rigid_body->body;
+    const Vector2f position = transform->GetPosition();
+    const Vector2f current = body.getPosition();
+    if (position.x == current.x && position.y == current.y && transform->GetRotation() == body.getRotation()) return;
+
+    body.setPosition(position);
+    body.setRotation(transform->GetRotation());
+    if (!body.isStatic()) {
+        body.setAwake(true);
+    }
+}
+
+void Scene::SyncParticleEmitterPosition([[maybe_unused]] EntityID entity) {
+#if PYNOVAGE_HAS_PARTICLES
+    auto* emitter = GetComponent<ParticleEmitter2DComponent>(entity);
+    if (!emitter || !emitter->emitter || !emitter->auto_sync_position) return;
+
+    Vector2f position(0.0f, 0.0f);
+    const auto* hierarchy = GetComponent<HierarchyComponent>(entity);
+    if (hierarchy && hierarchy->GetSceneNode()) {
+        position = hierarchy->GetSceneNode()->GetWorldPosition();
+    } else if (const auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        position = transform->GetPosition();   // A lone transform is its own world
+    } else {
+        return;
+    }
+    emitter->SetPosition(position + emitter->position_offset);
+#endif
+}
+
+// Simulation membership
+void Scene::AttachBody(EntityID entity) {
+    if (auto* rigid_body = GetComponent<RigidBody2DComponent>(entity)) {
+        physics_world_->addBody(rigid_body->body);
+        body_entities_dirty_ = true;
+        SyncTransformToPhysics(entity);
+    }
+}
+
+void Scene::DetachBody(EntityID entity) {
+    if (auto* rigid_body = GetComponent<RigidBody2DComponent>(entity)) {
+        if (rigid_body->body) {
+            physics_world_->removeBody(rigid_body->body);
+            body_entities_dirty_ = true;
+        }
+    }
+}
+
+void Scene::RebuildBodyEntities() {
+    // Body indices shift whenever a body leaves the world, so map them afresh
+    const auto& bodies = physics_world_->getBodies();
+    body_entities_.assign(bodies.size(), EntityID());
+    View<RigidBody2DComponent>().Each([this, &bodies](EntityID entity, RigidBody2DComponent& rigid_body) {
+        const auto& body = rigid_body.body;
+        if (!body) return;
+        const uint32_t index = body->getStoreSlot();
+        if (index < bodies.size() && bodies[index] == body) {
+            body_entities_[index] = entity;
+        }
+    });
+    body_entities_dirty_ = false;
+}
+
+void Scene::AttachEmitter([[maybe_unused]] EntityID entity) {
+#if PYNOVAGE_HAS_PARTICLES
+    if (auto* emitter = GetComponent<ParticleEmitter2DComponent>(entity)) {
+        particle_system_->AddEmitter(emitter->emitter);
+        SyncParticleEmitterPosition(entity);
+    }
+#endif
+}
+
+void Scene::DetachEmitter([[maybe_unused]] EntityID entity) {
+#if PYNOVAGE_HAS_PARTICLES
+    if (auto* emitter = GetComponent<ParticleEmitter2DComponent>(entity)) {
+        if (emitter->emitter) {
+            particle_system_->RemoveEmitter(emitter->emitter);
+        }
     }
+#endif
 }
 
-AABB2D Scene::CalculateEntityBounds([[maybe_unused]] EntityID entity) const {
-    // TODO: Implement bounds calculation based on components
-    return AABB2D{};
+// Spatial change tracking
+void Scene::MarkSpatialDirty(EntityID entity) {
+    if (!spatial_dirty_.Contains(entity) && entity_manager_.IsEntityValid(entity)) {
+        spatial_dirty_.Insert(entity);
+    }
+}
+
+void Scene::SetEntityPosition(EntityID entity, const Vector2f& position) {
+    if (auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        transform->SetPosition(position);
+        SyncTransformToNode(entity);
+    }
+}
+
+void Scene::SetEntityRotation(EntityID entity, float rotation) {
+    if (auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        transform->SetRotation(rotation);
+        SyncTransformToNode(entity);
+    }
+}
+
+void Scene::SetEntityScale(EntityID entity, const Vector2f& scale) {
+    if (auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        transform->SetScale(scale);
+        SyncTransformToNode(entity);
+    }
+}
+
+void Scene::SetSpriteSize(EntityID entity, const Vector2f& size) {
+    if (auto* sprite = GetComponent<SpriteComponent>(entity)) {
+        sprite->SetSize(size);
+        MarkSpatialDirty(entity);
+    }
+}
+
+bool Scene::UpdateEntitySpatialBounds(EntityID entity) {
+    const AABB2D bounds = CalculateEntityBounds(entity);
+    if (!bounds.IsValid()) {
+        UnregisterEntityFromSpatialPartitioning(entity);
+        return false;
+    }
+
+    if (spatial_manager_.Contains(entity)) {
+        spatial_manager_.Update(entity, bounds);
+    } else {
+        spatial_manager_.Insert(entity, bounds);
+    }
+    return true;
+}
+
+AABB2D Scene::CalculateEntityBounds(EntityID entity) const {
+    // Scene graph nodes carry world transforms; a lone transform is its own world
+    const Matrix3f* world = nullptr;
+    std::shared_ptr<SceneNode> node;
+    if (const auto* hierarchy = GetComponent<HierarchyComponent>(entity)) {
+        node = hierarchy->GetSceneNode();
+    }
+    if (node) {
+        world = &node->GetWorldMatrix();
+    } else if (const auto* transform = GetComponent<Transform2DComponent>(entity)) {
+        world = &transform->transform.GetLocalToParentMatrix();
+    } else {
+        // Nothing places the entity in the world
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        return AABB2D(Vector2f(inf, inf), Vector2f(-inf, -inf));
+    }
+
+    // Sprites cover their size around the pivot; anything else is a point
+    AABB2D local;
+    if (const auto* sprite = GetComponent<SpriteComponent>(entity)) {
+        local.min = Vector2f(-sprite->pivot.x * sprite->size.x, -sprite->pivot.y * sprite->size.y);
+        local.max = local.min + sprite->size;
+    }
+    return SpatialUtils::TransformAABB(local, *world);
 }
 
 void Scene::RegisterEntityForSpatialPartitioning([[maybe_unused]] EntityID entity) {
@@ -197,17 +641,11 @@ void Scene::UnregisterEntityFromSpatialPartitioning(EntityID entity) {
     spatial_manager_.UnregisterObject(entity);
 }
 
-std::vector<EntityID> Scene::FindEntitiesWithComponent(const std::type_index& component_type) const {
-    std::vector<EntityID> result;
-    for (const auto& entity : entity_manager_.GetAllEntities()) {
-        // We need to get the component storage for this type index
-        if (const auto& storages = entity_manager_.GetStorages(); storages.find(component_type) != storages.end()) {
-            if (storages.at(component_type)->HasComponent(entity)) {
-                result.push_back(entity);
-            }
-        }
+std::vector<EntityID> Scene::FindEntitiesWithComponent(ComponentTypeID component_type) const {
+    if (const auto* storage = entity_manager_.GetComponentStorage(component_type)) {
+        return storage->GetEntities();
     }
-    return result;
+    return {};
 }
 
 } // namespace Scene
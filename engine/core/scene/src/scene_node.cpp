@@ -36,9 +36,7 @@ void SceneNode::AddChild(std::shared_ptr<SceneNode> child) {
     // Set parent and add to children
     child->SetParent(this);
     children_.push_back(child);
-
-    // Update transforms to reflect new hierarchy
-    child->UpdateTransforms(transform_.GetWorldMatrix());
+    MarkHierarchyDirty();
 }
 
 void SceneNode::RemoveChild(std::shared_ptr<SceneNode> child) {
@@ -46,6 +44,7 @@ void SceneNode::RemoveChild(std::shared_ptr<SceneNode> child) {
     if (it != children_.end()) {
         (*it)->SetParent(nullptr);
         children_.erase(it);
+        MarkHierarchyDirty();
     }
 }
 
@@ -56,6 +55,7 @@ void SceneNode::RemoveChild(SceneNode* child) {
     if (it != children_.end()) {
         (*it)->SetParent(nullptr);
         children_.erase(it);
+        MarkHierarchyDirty();
     }
 }
 
@@ -115,17 +115,17 @@ size_t SceneNode::GetDepth() const {
 
 void SceneNode::SetPosition(const Vector2f& position) {
     transform_.SetPosition(position);
-    UpdateTransforms();
+    MarkTransformDirty();
 }
 
 void SceneNode::SetRotation(float rotation) {
     transform_.SetRotation(rotation);
-    UpdateTransforms();
+    MarkTransformDirty();
 }
 
 void SceneNode::SetScale(const Vector2f& scale) {
     transform_.SetScale(scale);
-    UpdateTransforms();
+    MarkTransformDirty();
 }
 
 Vector2f SceneNode::GetWorldPosition() const {
@@ -157,19 +157,9 @@ bool SceneNode::IsWorldVisible() const {
 }
 
 void SceneNode::UpdateTransforms() {
-    if (!parent_) {
-        // Reset to identity world matrix
-        transform_.SetWorldMatrix(Matrix3f::Identity());
-    } else {
-        // Update world matrix based on parent
-        Matrix3f world_matrix = TransformUtils::CreateTRSMatrix(
-            transform_.GetPosition(),
-            transform_.GetRotation(),
-            transform_.GetScale()
-        );
-        world_matrix = parent_->GetWorldMatrix() * world_matrix;
-        transform_.SetWorldMatrix(world_matrix);
-    }
+    UpdateWorldTransform();
+    transform_dirty_ = false;
+    descendant_dirty_ = false;
 
     OnTransformChanged();
     OnWorldTransformChanged();
@@ -188,6 +178,8 @@ void SceneNode::UpdateTransforms(const Matrix3f& parent_world_matrix) {
     );
     Matrix3f world_matrix = parent_world_matrix * local_matrix;
     transform_.SetWorldMatrix(world_matrix);
+    transform_dirty_ = false;
+    descendant_dirty_ = false;
 
     OnTransformChanged();
     OnWorldTransformChanged();
@@ -250,11 +242,7 @@ std::string SceneNode::GetPath() const {
 
 void SceneNode::SetParent(SceneNode* parent) {
     parent_ = parent;
-    if (parent) {
-        UpdateTransforms(parent->GetWorldMatrix());
-    } else {
-        UpdateTransforms();
-    }
+    MarkTransformDirty();
 }
 
 void SceneNode::MarkZOrderDirty() {
@@ -264,6 +252,21 @@ void SceneNode::MarkZOrderDirty() {
     }
 }
 
+void SceneNode::MarkTransformDirty() {
+    transform_dirty_ = true;
+    // Lets the scene skip clean subtrees; marked nodes have marked ancestors
+    for (SceneNode* node = parent_; node && !node->descendant_dirty_; node = node->parent_) {
+        node->descendant_dirty_ = true;
+    }
+}
+
+void SceneNode::MarkHierarchyDirty() {
+    // Flattening clears the whole tree, so a marked node has marked ancestors
+    for (SceneNode* node = this; node && !node->hierarchy_dirty_; node = node->parent_) {
+        node->hierarchy_dirty_ = true;
+    }
+}
+
 std::shared_ptr<SceneNode> SceneNode::GetSharedPtr() {
     return weak_self_.lock();
 }
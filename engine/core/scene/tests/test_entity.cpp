@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "scene/entity.hpp"
+#include "scene/components.hpp"
+#include "threading/thread_pool.hpp"
+#include <string>
+#include <vector>
+
+using namespace PyNovaGE::Scene;
+
+namespace {
+
+// Components need no base class
+struct Velocity {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Health {
+    int value;
+};
+
+} // anonymous namespace
+
+TEST(EntityManagerTest, CreateDestroyAndReuseIDs) {
+    EntityManager manager;
+    EntityID a = manager.CreateEntity();
+    EntityID b = manager.CreateEntity();
+    EXPECT_TRUE(a.IsValid());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(manager.GetEntityCount(), 2u);
+
+    manager.DestroyEntity(a);
+    EXPECT_FALSE(manager.IsEntityValid(a));
+    EXPECT_TRUE(manager.IsEntityValid(b));
+    EXPECT_EQ(manager.GetEntityCount(), 1u);
+    ASSERT_EQ(manager.GetAllEntities().size(), 1u);
+    EXPECT_EQ(manager.GetAllEntities()[0], b);
+
+    // The freed ID comes back with a new generation, so the old handle stays stale
+    EntityID c = manager.CreateEntity();
+    EXPECT_EQ(c.GetID(), a.GetID());
+    EXPECT_NE(c.GetGeneration(), a.GetGeneration());
+    EXPECT_TRUE(manager.IsEntityValid(c));
+    EXPECT_FALSE(manager.IsEntityValid(a));
+
+    // Destroying a stale handle does nothing
+    manager.DestroyEntity(a);
+    EXPECT_TRUE(manager.IsEntityValid(c));
+    EXPECT_FALSE(manager.IsEntityValid(EntityID()));
+
+    manager.Clear();
+    EXPECT_EQ(manager.GetEntityCount(), 0u);
+    EXPECT_FALSE(manager.IsEntityValid(b));
+}
+
+TEST(EntityManagerTest, ComponentsAreStoredByValue) {
+    EntityManager manager;
+    EntityID entity = manager.CreateEntity();
+
+    auto& velocity = manager.AddComponent<Velocity>(entity, 1.0f, 2.0f);
+    EXPECT_FLOAT_EQ(velocity.y, 2.0f);
+    manager.AddComponent<Health>(entity, 10);
+    manager.AddComponent<NameComponent>(entity, "player");
+
+    EXPECT_TRUE(manager.HasComponent<Velocity>(entity));
+    EXPECT_EQ(manager.GetComponent<Health>(entity)->value, 10);
+    EXPECT_EQ(manager.GetComponent<NameComponent>(entity)->GetName(), "player");
+    EXPECT_FALSE(manager.HasComponent<Transform2DComponent>(entity));
+    EXPECT_EQ(manager.GetComponent<Transform2DComponent>(entity), nullptr);
+
+    // Adding again replaces the component
+    manager.AddComponent<Health>(entity, 5);
+    EXPECT_EQ(manager.GetComponent<Health>(entity)->value, 5);
+    EXPECT_EQ(manager.GetComponentStorage<Health>()->Size(), 1u);
+
+    // Type IDs are per type and stable
+    EXPECT_NE(GetComponentTypeID<Velocity>(), GetComponentTypeID<Health>());
+    EXPECT_EQ(GetComponentTypeID<Velocity>(), GetComponentTypeID<Velocity>());
+    ASSERT_NE(manager.GetComponentStorage(GetComponentTypeID<Health>()), nullptr);
+    EXPECT_TRUE(manager.GetComponentStorage(GetComponentTypeID<Health>())->HasComponent(entity));
+
+    EXPECT_THROW(manager.AddComponent<Health>(EntityID(), 1), std::runtime_error);
+
+    // Destroying the entity removes its components, and a reused ID starts without them
+    manager.DestroyEntity(entity);
+    EXPECT_EQ(manager.GetComponentStorage<Velocity>()->Size(), 0u);
+    EntityID reused = manager.CreateEntity();
+    ASSERT_EQ(reused.GetID(), entity.GetID());
+    EXPECT_FALSE(manager.HasComponent<Health>(reused));
+    EXPECT_FALSE(manager.HasComponent<Health>(entity));
+}
+
+TEST(EntityManagerTest, RemovalKeepsStoragePacked) {
+    EntityManager manager;
+    std::vector<EntityID> entities;
+    for (int i = 0; i < 100; ++i) {
+        EntityID entity = manager.CreateEntity();
+        manager.AddComponent<Health>(entity, i);
+        entities.push_back(entity);
+    }
+
+    // Remove every third component; the last ones move into the holes
+    for (int i = 0; i < 100; i += 3) {
+        manager.RemoveComponent<Health>(entities[i]);
+    }
+    manager.RemoveComponent<Health>(entities[0]);   // Already gone
+
+    const auto* storage = manager.GetComponentStorage<Health>();
+    ASSERT_NE(storage, nullptr);
+    EXPECT_EQ(storage->Size(), 66u);
+    ASSERT_EQ(storage->GetEntities().size(), storage->GetComponents().size());
+    for (int i = 0; i < 100; ++i) {
+        const Health* health = manager.GetComponent<Health>(entities[i]);
+        if (i % 3 == 0) {
+            EXPECT_EQ(health, nullptr) << "entity " << i;
+        } else {
+            ASSERT_NE(health, nullptr) << "entity " << i;
+            EXPECT_EQ(health->value, i);
+            EXPECT_EQ(storage->GetEntity(health), entities[i]);
+        }
+    }
+
+    // Entities and components stay parallel
+    int sum = 0;
+    for (size_t i = 0; i < storage->Size(); ++i) {
+        const EntityID entity = storage->GetEntities()[i];
+        EXPECT_EQ(&storage->GetComponents()[i], manager.GetComponent<Health>(entity));
+        sum += storage->GetComponents()[i].value;
+    }
+    int expected = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 != 0) expected += i;
+    }
+    EXPECT_EQ(sum, expected);
+
+    const Health outside{0};
+    EXPECT_FALSE(storage->GetEntity(&outside).IsValid());
+}
+
+TEST(EntityManagerTest, ViewsVisitEntitiesWithAllComponents) {
+    EntityManager manager;
+    std::vector<EntityID> entities;
+    for (int i = 0; i < 1000; ++i) {
+        EntityID entity = manager.CreateEntity();
+        manager.AddComponent<Health>(entity, i);
+        if (i % 2 == 0) manager.AddComponent<Velocity>(entity, static_cast<float>(i), 0.0f);
+        if (i % 3 == 0) manager.AddComponent<NameComponent>(entity, "third");
+        entities.push_back(entity);
+    }
+
+    auto view = manager.View<Health, Velocity, const NameComponent>();
+    EXPECT_EQ(view.SizeHint(), 334u);     // Walks the names, the rarest
+    EXPECT_TRUE(view.Contains(entities[6]));
+    EXPECT_FALSE(view.Contains(entities[3]));
+
+    int visited = 0;
+    view.Each([&](EntityID entity, Health& health, Velocity& velocity, const NameComponent& name) {
+        EXPECT_EQ(health.value % 6, 0);
+        EXPECT_EQ(entities[health.value], entity);
+        EXPECT_FLOAT_EQ(velocity.x, static_cast<float>(health.value));
+        EXPECT_EQ(name.GetName(), "third");
+        health.value += 10000;
+        ++visited;
+    });
+    EXPECT_EQ(visited, 167);
+
+    // The entity is optional, and the parallel walk does the same work
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    manager.View<Health, const Velocity>().ParallelEach([](Health& health, const Velocity&) {
+        health.value += 1;
+    }, &pool);
+    for (int i = 0; i < 1000; ++i) {
+        const int expected = i + (i % 6 == 0 ? 10000 : 0) + (i % 2 == 0 ? 1 : 0);
+        EXPECT_EQ(manager.GetComponent<Health>(entities[i])->value, expected) << "entity " << i;
+    }
+
+    // Types never added make the view empty
+    const EntityManager& read_only = manager;
+    int transforms = 0;
+    read_only.View<Transform2DComponent, Health>().Each([&](const Transform2DComponent&, const Health&) {
+        ++transforms;
+    });
+    EXPECT_EQ(transforms, 0);
+    EXPECT_EQ(read_only.View<Health>().SizeHint(), 1000u);
+}
+
+TEST(EntityManagerTest, GroupsKeepMatchesPacked) {
+    EntityManager manager;
+    std::vector<EntityID> entities;
+    for (int i = 0; i < 200; ++i) {
+        EntityID entity = manager.CreateEntity();
+        manager.AddComponent<Health>(entity, i);
+        if (i % 2 == 0) manager.AddComponent<Velocity>(entity, static_cast<float>(i), 0.0f);
+        entities.push_back(entity);
+    }
+
+    auto group = manager.Group<Velocity, Health>();
+    EXPECT_EQ(group.Size(), 100u);
+    EXPECT_TRUE(manager.GetComponentStorage<Health>()->IsGrouped());
+    EXPECT_THROW(manager.Group<Health>(), std::runtime_error);
+    EXPECT_EQ((manager.Group<Velocity, Health>().Size()), 100u);   // Same group
+
+    // Matching entities sit at the front of both storages, in the same order
+    auto check = [&](size_t expected) {
+        ASSERT_EQ(group.Size(), expected);
+        const auto* healths = manager.GetComponentStorage<Health>();
+        const auto* velocities = manager.GetComponentStorage<Velocity>();
+        for (size_t i = 0; i < group.Size(); ++i) {
+            ASSERT_EQ(healths->GetEntities()[i], velocities->GetEntities()[i]);
+            EXPECT_FLOAT_EQ(velocities->GetComponents()[i].x, static_cast<float>(healths->GetComponents()[i].value));
+        }
+        size_t visited = 0;
+        group.Each([&](EntityID entity, Velocity& velocity, Health& health) {
+            EXPECT_EQ(manager.GetComponent<Health>(entity), &health);
+            EXPECT_FLOAT_EQ(velocity.x, static_cast<float>(health.value));
+            ++visited;
+        });
+        EXPECT_EQ(visited, expected);
+    };
+    check(100);
+
+    // Adds, removes and destroys through the manager keep the group in order
+    manager.AddComponent<Velocity>(entities[1], 1.0f, 0.0f);
+    Velocity& added = manager.AddComponent<Velocity>(entities[3], 3.0f, 0.0f);
+    EXPECT_FLOAT_EQ(added.x, 3.0f);
+    check(102);
+    manager.RemoveComponent<Health>(entities[0]);
+    manager.RemoveComponent<Velocity>(entities[2]);
+    manager.RemoveComponent<Velocity>(entities[5]);   // Not in the group
+    check(100);
+    manager.DestroyEntity(entities[4]);
+    manager.DestroyEntity(entities[7]);
+    check(99);
+    EntityID late = manager.CreateEntity();
+    manager.AddComponent<Velocity>(late, 500.0f, 0.0f);
+    check(99);
+    manager.AddComponent<Health>(late, 500);
+    check(100);
+
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    group.ParallelEach([](Velocity& velocity, Health& health) {
+        health.value = -static_cast<int>(velocity.x);
+    }, &pool);
+    group.Each([](const Velocity& velocity, const Health& health) {
+        EXPECT_EQ(health.value, -static_cast<int>(velocity.x));
+    });
+}
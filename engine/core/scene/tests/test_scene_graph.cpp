@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "scene/scene.hpp"
+#include "threading/thread_pool.hpp"
+#include <memory>
+#include <vector>
+
+using namespace PyNovaGE::Scene;
+using PyNovaGE::Vector2f;
+
+namespace {
+
+std::shared_ptr<SceneNode> AddNode(const std::shared_ptr<SceneNode>& parent, const Vector2f& position) {
+    auto node = std::make_shared<SceneNode>();
+    node->SetPosition(position);
+    parent->AddChild(node);
+    return node;
+}
+
+void ExpectWorldPosition(const SceneNode& node, float x, float y) {
+    const Vector2f position = node.GetWorldPosition();
+    EXPECT_NEAR(position.x, x, 1e-4f);
+    EXPECT_NEAR(position.y, y, 1e-4f);
+}
+
+} // anonymous namespace
+
+TEST(SceneGraphTest, OnlyDirtySubtreesAreRecomputed) {
+    Scene scene;
+    auto root = scene.GetRootNode();
+    auto a = AddNode(root, Vector2f(10.0f, 0.0f));
+    auto a1 = AddNode(a, Vector2f(1.0f, 2.0f));
+    auto a2 = AddNode(a1, Vector2f(0.0f, 5.0f));
+    auto b = AddNode(root, Vector2f(-3.0f, 4.0f));
+    auto b1 = AddNode(b, Vector2f(1.0f, 1.0f));
+
+    // Setters only mark nodes dirty
+    EXPECT_TRUE(a2->IsTransformDirty());
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 6u);
+    EXPECT_FALSE(a2->IsTransformDirty());
+    ExpectWorldPosition(*a2, 11.0f, 7.0f);
+    ExpectWorldPosition(*b1, -2.0f, 5.0f);
+
+    // With nothing dirty only the root is looked at
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 0u);
+    EXPECT_EQ(scene.GetTransformsVisited(), 1u);
+
+    // Moving a node recomputes it and its descendants only; b's subtree is skipped
+    a1->SetPosition(Vector2f(2.0f, 2.0f));
+    EXPECT_TRUE(a1->IsTransformDirty());
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 2u);
+    EXPECT_EQ(scene.GetTransformsVisited(), 5u);   // root, a, b, a1, a2
+    ExpectWorldPosition(*a1, 12.0f, 2.0f);
+    ExpectWorldPosition(*a2, 12.0f, 7.0f);
+
+    // Rotation and scale carry down the hierarchy
+    b->SetRotation(1.57079632679f);
+    b->SetScale(Vector2f(2.0f, 2.0f));
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 2u);
+    ExpectWorldPosition(*b, -3.0f, 4.0f);
+    ExpectWorldPosition(*b1, -5.0f, 6.0f);
+
+    // Edits through the mutable transform need an explicit mark
+    a->GetTransform().SetPosition(Vector2f(20.0f, 0.0f));
+    a->MarkTransformDirty();
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 3u);
+    ExpectWorldPosition(*a2, 22.0f, 7.0f);
+}
+
+TEST(SceneGraphTest, ReparentingRebuildsTheOrder) {
+    Scene scene;
+    auto root = scene.GetRootNode();
+    auto a = AddNode(root, Vector2f(10.0f, 0.0f));
+    auto b = AddNode(root, Vector2f(0.0f, 10.0f));
+    auto child = AddNode(a, Vector2f(1.0f, 1.0f));
+    scene.UpdateTransforms();
+    ExpectWorldPosition(*child, 11.0f, 1.0f);
+
+    // The moved node takes its new parent's transform
+    b->AddChild(child);
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 1u);
+    ExpectWorldPosition(*child, 1.0f, 11.0f);
+
+    // A subtree attached later is picked up, and a detached one is left alone
+    auto extra = std::make_shared<SceneNode>();
+    extra->SetPosition(Vector2f(5.0f, 5.0f));
+    auto extra_child = AddNode(extra, Vector2f(1.0f, 0.0f));
+    child->AddChild(extra);
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 2u);
+    ExpectWorldPosition(*extra_child, 7.0f, 16.0f);
+
+    child->RemoveChild(extra);
+    extra->SetPosition(Vector2f(0.0f, 0.0f));
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 0u);
+
+    // Entity nodes join and leave the order with their entities
+    EntityID entity = scene.CreateEntityWithNode("mover", a);
+    auto mover = scene.GetComponent<HierarchyComponent>(entity)->GetSceneNode();
+    mover->SetPosition(Vector2f(0.0f, 3.0f));
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 1u);
+    ExpectWorldPosition(*mover, 10.0f, 3.0f);
+
+    scene.DestroyEntity(entity);
+    scene.UpdateTransforms();
+    EXPECT_EQ(scene.GetTransformsUpdated(), 0u);
+}
+
+TEST(SceneGraphTest, PooledUpdateMatchesSerial) {
+    // Wide levels so the pooled pass actually splits them
+    auto build = [](Scene& scene, std::vector<std::shared_ptr<SceneNode>>& leaves) {
+        for (int i = 0; i < 64; ++i) {
+            auto branch = AddNode(scene.GetRootNode(), Vector2f(static_cast<float>(i), 0.0f));
+            branch->SetRotation(0.01f * static_cast<float>(i));
+            for (int j = 0; j < 40; ++j) {
+                auto leaf = AddNode(branch, Vector2f(0.0f, static_cast<float>(j)));
+                leaves.push_back(AddNode(leaf, Vector2f(1.0f, 1.0f)));
+            }
+        }
+    };
+
+    Scene serial;
+    Scene pooled;
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    pooled.SetThreadPool(&pool);
+    EXPECT_EQ(pooled.GetThreadPool(), &pool);
+
+    std::vector<std::shared_ptr<SceneNode>> serial_leaves;
+    std::vector<std::shared_ptr<SceneNode>> pooled_leaves;
+    build(serial, serial_leaves);
+    build(pooled, pooled_leaves);
+
+    for (int frame = 0; frame < 3; ++frame) {
+        for (size_t i = frame; i < serial_leaves.size(); i += 7) {
+            serial_leaves[i]->GetParent()->SetScale(Vector2f(1.0f + 0.1f * static_cast<float>(frame), 1.0f));
+            pooled_leaves[i]->GetParent()->SetScale(Vector2f(1.0f + 0.1f * static_cast<float>(frame), 1.0f));
+        }
+        serial.UpdateTransforms();
+        pooled.UpdateTransforms();
+        ASSERT_EQ(serial.GetTransformsUpdated(), pooled.GetTransformsUpdated());
+
+        for (size_t i = 0; i < serial_leaves.size(); ++i) {
+            const Vector2f expected = serial_leaves[i]->GetWorldPosition();
+            ExpectWorldPosition(*pooled_leaves[i], expected.x, expected.y);
+        }
+    }
+}
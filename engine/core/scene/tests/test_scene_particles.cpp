@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "scene/scene.hpp"
+
+#if PYNOVAGE_HAS_PARTICLES
+#include "particles/particle_system.hpp"
+#include <memory>
+
+using namespace PyNovaGE::Scene;
+using PyNovaGE::Vector2f;
+using PyNovaGE::Particles::EmitterConfig;
+using PyNovaGE::Particles::ParticleEmitter;
+
+namespace {
+
+std::shared_ptr<ParticleEmitter> MakeEmitter() {
+    EmitterConfig config;
+    config.emission_rate = 100.0f;
+    config.initial.velocity_min = Vector2f(0.0f, 0.0f);
+    config.initial.velocity_max = Vector2f(0.0f, 0.0f);
+    return std::make_shared<ParticleEmitter>(config);
+}
+
+void ExpectPosition(const Vector2f& position, float x, float y) {
+    EXPECT_FLOAT_EQ(position.x, x);
+    EXPECT_FLOAT_EQ(position.y, y);
+}
+
+} // anonymous namespace
+
+TEST(SceneParticlesTest, EmittersFollowTheirEntities) {
+    Scene scene;
+    auto* particles = scene.GetParticleSystem();
+    ASSERT_NE(particles, nullptr);
+
+    EntityID entity = scene.CreateEntity();
+    scene.AddComponent<Transform2DComponent>(entity, Vector2f(5.0f, 5.0f));
+    auto& component = scene.AddComponent<ParticleEmitter2DComponent>(entity, MakeEmitter());
+    component.position_offset = Vector2f(1.0f, 0.0f);
+    EXPECT_EQ(particles->GetActiveEmitterCount(), 1u);
+    ExpectPosition(component.GetPosition(), 5.0f, 5.0f);
+
+    // The offset is picked up on the next update, with the move
+    scene.SetEntityPosition(entity, Vector2f(10.0f, -2.0f));
+    scene.Update(0.016f);
+    ExpectPosition(component.GetPosition(), 11.0f, -2.0f);
+
+    // Entities on scene graph nodes follow their world position
+    EntityID parent = scene.CreateEntityWithNode("parent");
+    EntityID child = scene.CreateEntityWithNode("child", scene.GetComponent<HierarchyComponent>(parent)->GetSceneNode());
+    scene.AddComponent<Transform2DComponent>(child, Vector2f(0.0f, 3.0f));
+    auto& child_emitter = scene.AddComponent<ParticleEmitter2DComponent>(child, MakeEmitter());
+    scene.SetEntityPosition(child, Vector2f(0.0f, 3.0f));
+    scene.GetComponent<HierarchyComponent>(parent)->GetSceneNode()->SetPosition(Vector2f(20.0f, 0.0f));
+    scene.Update(0.016f);
+    ExpectPosition(child_emitter.GetPosition(), 20.0f, 3.0f);
+
+    // Unchanged entities are left alone (adding components may have moved the first one)
+    auto& first = *scene.GetComponent<ParticleEmitter2DComponent>(entity);
+    first.emitter->SetPosition(Vector2f(0.0f, 0.0f));
+    scene.Update(0.016f);
+    ExpectPosition(first.GetPosition(), 0.0f, 0.0f);
+}
+
+TEST(SceneParticlesTest, EmittersAreSteppedByUpdate) {
+    Scene scene;
+    auto* particles = scene.GetParticleSystem();
+    ASSERT_NE(particles, nullptr);
+
+    EntityID entity = scene.CreateEntity();
+    scene.AddComponent<Transform2DComponent>(entity, Vector2f(5.0f, 5.0f));
+    auto& component = scene.AddComponent<ParticleEmitter2DComponent>(entity, MakeEmitter());
+    component.Start();
+
+    for (int frame = 0; frame < 10; ++frame) {
+        scene.Update(0.016f);
+    }
+    EXPECT_GT(particles->GetActiveParticleCount(), 0u);
+
+    // Components take their emitters out of the system when they go
+    EntityID other = scene.CreateEntity();
+    scene.AddComponent<ParticleEmitter2DComponent>(other, MakeEmitter());
+    EXPECT_EQ(particles->GetActiveEmitterCount(), 2u);
+    scene.RemoveComponent<ParticleEmitter2DComponent>(entity);
+    EXPECT_EQ(particles->GetActiveEmitterCount(), 1u);
+    scene.DestroyEntity(other);
+    EXPECT_EQ(particles->GetActiveEmitterCount(), 0u);
+}
+
+#else
+
+TEST(SceneParticlesTest, ParticlesNotBuiltIn) {
+    PyNovaGE::Scene::Scene scene;
+    EXPECT_EQ(scene.GetParticleSystem(), nullptr);
+}
+
+#endif
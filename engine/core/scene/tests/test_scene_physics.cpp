@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "scene/scene.hpp"
+#include "physics/physics_world.hpp"
+#include <algorithm>
+#include <memory>
+
+using namespace PyNovaGE::Scene;
+using PyNovaGE::Vector2f;
+using PyNovaGE::Physics::BodyType;
+using PyNovaGE::Physics::CircleShape;
+using PyNovaGE::Physics::RigidBody;
+
+namespace {
+
+constexpr float kFrame = 1.0f / 60.0f;
+
+EntityID AddBodyEntity(Scene& scene, const Vector2f& position, BodyType type) {
+    EntityID entity = scene.CreateEntity();
+    scene.AddComponent<Transform2DComponent>(entity, position);
+    scene.AddComponent<SpriteComponent>(entity).SetSize(Vector2f(1.0f, 1.0f));
+    scene.AddComponent<RigidBody2DComponent>(entity, std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.5f), type));
+    return entity;
+}
+
+bool Contains(const std::vector<EntityID>& entities, EntityID entity) {
+    return std::find(entities.begin(), entities.end(), entity) != entities.end();
+}
+
+} // anonymous namespace
+
+TEST(ScenePhysicsTest, BodiesJoinAndLeaveTheWorld) {
+    Scene scene;
+    EntityID a = AddBodyEntity(scene, Vector2f(0.0f, 0.0f), BodyType::Dynamic);
+    EntityID b = AddBodyEntity(scene, Vector2f(10.0f, 0.0f), BodyType::Dynamic);
+    EntityID c = AddBodyEntity(scene, Vector2f(20.0f, 0.0f), BodyType::Static);
+    EXPECT_EQ(scene.GetPhysicsWorld().getBodyCount(), 3u);
+    EXPECT_FLOAT_EQ(scene.GetComponent<RigidBody2DComponent>(b)->GetPosition().x, 10.0f);
+
+    // Replacing a body swaps it in the world
+    scene.AddComponent<RigidBody2DComponent>(a, std::make_shared<RigidBody>(std::make_shared<CircleShape>(1.0f)));
+    EXPECT_EQ(scene.GetPhysicsWorld().getBodyCount(), 3u);
+
+    scene.RemoveComponent<RigidBody2DComponent>(b);
+    scene.DestroyEntity(c);
+    EXPECT_EQ(scene.GetPhysicsWorld().getBodyCount(), 1u);
+    EXPECT_EQ(scene.GetPhysicsWorld().getBodies()[0], scene.GetComponent<RigidBody2DComponent>(a)->body);
+
+    scene.Clear();
+    EXPECT_EQ(scene.GetPhysicsWorld().getBodyCount(), 0u);
+}
+
+TEST(ScenePhysicsTest, OnlyAwakeBodiesMoveTheirEntities) {
+    Scene scene;
+    EntityID falling = AddBodyEntity(scene, Vector2f(0.0f, 0.0f), BodyType::Dynamic);
+    EntityID sleeping = AddBodyEntity(scene, Vector2f(10.0f, 0.0f), BodyType::Dynamic);
+    EntityID wall = AddBodyEntity(scene, Vector2f(20.0f, 0.0f), BodyType::Static);
+    EntityID node = scene.CreateEntityWithNode("node");
+    scene.AddComponent<Transform2DComponent>(node, Vector2f(30.0f, 0.0f));
+    scene.AddComponent<RigidBody2DComponent>(node, std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.5f)));
+
+    scene.Update(kFrame);
+    EXPECT_FLOAT_EQ(scene.GetComponent<RigidBody2DComponent>(wall)->GetPosition().x, 20.0f);
+    scene.GetComponent<RigidBody2DComponent>(sleeping)->body->setAwake(false);
+    const Vector2f asleep = scene.GetComponent<Transform2DComponent>(sleeping)->GetPosition();
+
+    for (int frame = 0; frame < 30; ++frame) {
+        scene.Update(kFrame);
+    }
+    EXPECT_EQ(scene.GetBodiesSynced(), 2u);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 2u);
+
+    const Vector2f fallen = scene.GetComponent<Transform2DComponent>(falling)->GetPosition();
+    EXPECT_LT(fallen.y, 0.0f);
+    EXPECT_FLOAT_EQ(fallen.y, scene.GetComponent<RigidBody2DComponent>(falling)->GetPosition().y);
+    EXPECT_TRUE(Contains(scene.QueryAABB(AABB2D(Vector2f(-0.1f, fallen.y - 0.1f), Vector2f(0.1f, fallen.y + 0.1f))), falling));
+    EXPECT_FALSE(Contains(scene.QueryPoint(Vector2f(0.0f, 0.0f)), falling));
+
+    // The scene graph node follows its body
+    const Vector2f node_position = scene.GetComponent<HierarchyComponent>(node)->GetSceneNode()->GetWorldPosition();
+    EXPECT_FLOAT_EQ(node_position.x, 30.0f);
+    EXPECT_FLOAT_EQ(node_position.y, scene.GetComponent<RigidBody2DComponent>(node)->GetPosition().y);
+
+    EXPECT_FLOAT_EQ(scene.GetComponent<Transform2DComponent>(sleeping)->GetPosition().y, asleep.y);
+    EXPECT_FLOAT_EQ(scene.GetComponent<Transform2DComponent>(wall)->GetPosition().y, 0.0f);
+    EXPECT_FALSE(scene.GetComponent<RigidBody2DComponent>(sleeping)->body->isAwake());
+
+    // Bodies that opt out of syncing keep their transforms
+    scene.GetComponent<RigidBody2DComponent>(falling)->auto_sync_transform = false;
+    scene.Update(kFrame);
+    EXPECT_EQ(scene.GetBodiesSynced(), 1u);
+    EXPECT_FLOAT_EQ(scene.GetComponent<Transform2DComponent>(falling)->GetPosition().y, fallen.y);
+}
+
+TEST(ScenePhysicsTest, MovedTransformsLeadTheirBodies) {
+    Scene scene;
+    EntityID sleeping = AddBodyEntity(scene, Vector2f(0.0f, 0.0f), BodyType::Dynamic);
+    EntityID wall = AddBodyEntity(scene, Vector2f(20.0f, 0.0f), BodyType::Static);
+    auto body = scene.GetComponent<RigidBody2DComponent>(sleeping)->body;
+    body->setAwake(false);
+
+    // A transform that already matches its body leaves it asleep
+    scene.Update(kFrame);
+    EXPECT_FALSE(body->isAwake());
+    EXPECT_EQ(scene.GetBodiesSynced(), 0u);
+
+    // Game code moves a sleeping body: it wakes and falls from the new spot
+    scene.SetEntityPosition(sleeping, Vector2f(100.0f, 50.0f));
+    scene.SetEntityPosition(wall, Vector2f(-20.0f, 0.0f));
+    scene.Update(kFrame);
+    EXPECT_TRUE(body->isAwake());
+    EXPECT_FLOAT_EQ(body->getPosition().x, 100.0f);
+    EXPECT_LE(body->getPosition().y, 50.0f);
+    EXPECT_EQ(scene.GetBodiesSynced(), 1u);
+    EXPECT_FLOAT_EQ(scene.GetComponent<Transform2DComponent>(sleeping)->GetPosition().y, body->getPosition().y);
+
+    const auto& wall_body = scene.GetComponent<RigidBody2DComponent>(wall)->body;
+    EXPECT_FLOAT_EQ(wall_body->getPosition().x, -20.0f);
+    EXPECT_TRUE(Contains(scene.QueryPoint(Vector2f(-20.0f, 0.0f)), wall));
+}
+
+TEST(ScenePhysicsTest, WritebackFollowsTheWorldsAwakeBodies) {
+    Scene scene;
+    EntityID a = AddBodyEntity(scene, Vector2f(0.0f, 0.0f), BodyType::Dynamic);
+    EntityID b = AddBodyEntity(scene, Vector2f(10.0f, 0.0f), BodyType::Dynamic);
+    auto& world = scene.GetPhysicsWorld();
+
+    // A body added to the world directly has no entity to write to
+    auto loose = std::make_shared<RigidBody>(std::make_shared<CircleShape>(0.5f));
+    loose->setPosition(Vector2f(-10.0f, 0.0f));
+    world.addBody(loose);
+    scene.Update(kFrame);
+    EXPECT_EQ(scene.GetBodiesSynced(), 2u);
+
+    // Removing a body renumbers the ones after it
+    scene.RemoveComponent<RigidBody2DComponent>(a);
+    scene.GetComponent<RigidBody2DComponent>(b)->body->setAwake(false);
+    scene.Update(kFrame);
+    EXPECT_EQ(scene.GetBodiesSynced(), 0u);
+
+    // So does changing the world behind the scene's back, even if the count stays
+    auto b_body = scene.GetComponent<RigidBody2DComponent>(b)->body;
+    b_body->setAwake(true);
+    world.removeBody(b_body);
+    world.addBody(b_body);
+    scene.Update(kFrame);
+    EXPECT_EQ(scene.GetBodiesSynced(), 0u);
+    scene.Update(kFrame);
+    EXPECT_EQ(scene.GetBodiesSynced(), 1u);
+    EXPECT_FLOAT_EQ(scene.GetComponent<Transform2DComponent>(b)->GetPosition().y, b_body->getPosition().y);
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "scene/scene.hpp"
+#include "threading/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+using namespace PyNovaGE::Scene;
+using PyNovaGE::Vector2f;
+
+namespace {
+
+std::vector<SpatialObject> RandomObjects(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.0f, 40.0f);
+    std::vector<SpatialObject> objects;
+    for (size_t i = 0; i < count; ++i) {
+        const Vector2f min(position(rng), position(rng));
+        objects.emplace_back(EntityID(static_cast<EntityID::IDType>(i + 1), 1),
+                             AABB2D(min, min + Vector2f(size(rng), size(rng))));
+    }
+    return objects;
+}
+
+std::vector<EntityID> Sorted(std::vector<SpatialObject> objects) {
+    std::vector<EntityID> entities;
+    for (const auto& object : objects) {
+        entities.push_back(object.entity);
+    }
+    std::sort(entities.begin(), entities.end(), [](EntityID a, EntityID b) { return a.GetID() < b.GetID(); });
+    return entities;
+}
+
+std::vector<EntityID> BruteForce(const std::vector<SpatialObject>& objects, const AABB2D& area) {
+    std::vector<SpatialObject> hits;
+    for (const auto& object : objects) {
+        if (area.Intersects(object.bounds)) hits.push_back(object);
+    }
+    return Sorted(hits);
+}
+
+bool Contains(const std::vector<EntityID>& entities, EntityID entity) {
+    return std::find(entities.begin(), entities.end(), entity) != entities.end();
+}
+
+} // anonymous namespace
+
+TEST(QuadtreeTest, BulkBuildMatchesInsertion) {
+    const AABB2D world(-1024.0f, -1024.0f, 2048.0f, 2048.0f);
+    auto objects = RandomObjects(20000, 7);
+    objects.emplace_back(EntityID(30000, 1), AABB2D(5000.0f, 5000.0f, 1.0f, 1.0f));   // Outside the world
+
+    Quadtree inserted(world);
+    for (const auto& object : objects) {
+        inserted.Insert(object);
+    }
+    Quadtree serial(world);
+    serial.Build(objects);
+    Quadtree pooled(world);
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    pooled.Build(objects, &pool);
+
+    EXPECT_EQ(serial.GetObjectCount(), objects.size());
+    EXPECT_EQ(pooled.GetObjectCount(), objects.size());
+    EXPECT_EQ(serial.GetNodeCount(), inserted.GetNodeCount());
+    EXPECT_EQ(pooled.GetNodeCount(), inserted.GetNodeCount());
+
+    const std::vector<AABB2D> areas = {
+        AABB2D(-100.0f, -100.0f, 200.0f, 200.0f), AABB2D(500.0f, -900.0f, 64.0f, 300.0f),
+        AABB2D(-1024.0f, -1024.0f, 2048.0f, 2048.0f), AABB2D(4990.0f, 4990.0f, 20.0f, 20.0f)};
+    for (const auto& area : areas) {
+        const auto expected = BruteForce(objects, area);
+        EXPECT_EQ(Sorted(inserted.QueryAABB(area)), expected);
+        EXPECT_EQ(Sorted(serial.QueryAABB(area)), expected);
+        EXPECT_EQ(Sorted(pooled.QueryAABB(area)), expected);
+    }
+}
+
+TEST(QuadtreeTest, KnownBoundsUpdateAndRemove) {
+    Quadtree tree(AABB2D(-1024.0f, -1024.0f, 2048.0f, 2048.0f));
+    auto objects = RandomObjects(2000, 11);
+    tree.Build(objects);
+
+    // Small moves stay in their node, large ones change node; both are found afterwards
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> jitter(-300.0f, 300.0f);
+    for (size_t i = 0; i < objects.size(); i += 3) {
+        AABB2D moved = objects[i].bounds;
+        const Vector2f offset(jitter(rng), jitter(rng));
+        moved.min += offset;
+        moved.max += offset;
+        ASSERT_TRUE(tree.Update(objects[i].entity, objects[i].bounds, moved));
+        objects[i].bounds = moved;
+    }
+    EXPECT_FALSE(tree.Update(EntityID(99999, 1), objects[0].bounds, objects[0].bounds));
+
+    std::vector<SpatialObject> kept;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (i % 5 == 1) {
+            ASSERT_TRUE(tree.Remove(objects[i].entity, objects[i].bounds));
+        } else {
+            kept.push_back(objects[i]);
+        }
+    }
+    EXPECT_FALSE(tree.Remove(objects[1].entity, objects[1].bounds));
+    objects = kept;
+
+    const AABB2D everything(-2000.0f, -2000.0f, 4000.0f, 4000.0f);
+    EXPECT_EQ(Sorted(tree.QueryAABB(everything)), BruteForce(objects, everything));
+    const AABB2D area(-200.0f, 0.0f, 400.0f, 300.0f);
+    EXPECT_EQ(Sorted(tree.QueryAABB(area)), BruteForce(objects, area));
+}
+
+TEST(ScenePartitioningTest, ObjectsOutsideTheWorldAreKept) {
+    // Registered out of bounds on opposite sides: the second expansion must keep the first
+    SpatialManager manager(AABB2D(-100.0f, -100.0f, 200.0f, 200.0f));
+    const EntityID a(1, 1);
+    const EntityID b(2, 1);
+    manager.RegisterObject(a, AABB2D(499.0f, -1.0f, 2.0f, 2.0f));
+    manager.RegisterObject(b, AABB2D(-501.0f, -1.0f, 2.0f, 2.0f));
+    EXPECT_TRUE(manager.GetWorldBounds().Contains(AABB2D(-501.0f, -1.0f, 1002.0f, 2.0f)));
+    EXPECT_EQ(manager.QueryAABB(manager.GetWorldBounds()).size(), 2u);
+
+    auto hits = [&manager](const Vector2f& point) { return Sorted(manager.QueryAABB(AABB2D(point, point))); };
+    EXPECT_EQ(hits(Vector2f(500.0f, 0.0f)), std::vector<EntityID>{a});
+    EXPECT_EQ(hits(Vector2f(-500.0f, 0.0f)), std::vector<EntityID>{b});
+
+    manager.UpdateObject(a, AABB2D(599.0f, -1.0f, 2.0f, 2.0f));
+    EXPECT_EQ(hits(Vector2f(600.0f, 0.0f)), std::vector<EntityID>{a});
+    EXPECT_TRUE(hits(Vector2f(500.0f, 0.0f)).empty());
+    EXPECT_EQ(manager.QueryAABB(manager.GetWorldBounds()).size(), 2u);
+
+    // The same through a scene
+    Scene scene(AABB2D(-100.0f, -100.0f, 200.0f, 200.0f));
+    EntityID left = scene.CreateEntity();
+    scene.AddComponent<Transform2DComponent>(left, Vector2f(500.0f, 0.0f));
+    scene.AddComponent<SpriteComponent>(left).SetSize(Vector2f(2.0f, 2.0f));
+    scene.Update(0.016f);
+    EntityID right = scene.CreateEntity();
+    scene.AddComponent<Transform2DComponent>(right, Vector2f(-500.0f, 0.0f));
+    scene.AddComponent<SpriteComponent>(right).SetSize(Vector2f(2.0f, 2.0f));
+    scene.Update(0.016f);
+    EXPECT_TRUE(Contains(scene.QueryPoint(Vector2f(500.0f, 0.0f)), left));
+    EXPECT_TRUE(Contains(scene.QueryPoint(Vector2f(-500.0f, 0.0f)), right));
+
+    scene.SetEntityPosition(left, Vector2f(600.0f, 0.0f));
+    scene.Update(0.016f);
+    EXPECT_TRUE(Contains(scene.QueryPoint(Vector2f(600.0f, 0.0f)), left));
+    EXPECT_FALSE(Contains(scene.QueryPoint(Vector2f(500.0f, 0.0f)), left));
+}
+
+TEST(ScenePartitioningTest, OnlyChangedEntitiesAreReindexed) {
+    Scene scene;
+    std::vector<EntityID> entities;
+    for (int i = 0; i < 100; ++i) {
+        EntityID entity = scene.CreateEntity();
+        scene.AddComponent<Transform2DComponent>(entity, Vector2f(static_cast<float>(i * 10), 0.0f));
+        scene.AddComponent<SpriteComponent>(entity).SetSize(Vector2f(4.0f, 4.0f));
+        entities.push_back(entity);
+    }
+    EntityID unplaced = scene.CreateEntity("no transform");
+
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 100u);
+    EXPECT_EQ(scene.GetSpatialObjectCount(), 100u);
+    EXPECT_FALSE(Contains(scene.QueryAABB(AABB2D(-1.0f, -1.0f, 2.0f, 2.0f)), unplaced));
+
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 0u);
+
+    // Sprites are centred on the transform by default
+    auto hits = scene.QueryAABB(AABB2D(49.0f, -1.0f, 2.0f, 2.0f));
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0], entities[5]);
+
+    scene.SetEntityPosition(entities[5], Vector2f(0.0f, 500.0f));
+    scene.SetSpriteSize(entities[6], Vector2f(30.0f, 4.0f));
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 2u);
+    EXPECT_FALSE(Contains(scene.QueryAABB(AABB2D(49.0f, -1.0f, 2.0f, 2.0f)), entities[5]));
+    EXPECT_TRUE(Contains(scene.QueryAABB(AABB2D(-1.0f, 499.0f, 2.0f, 2.0f)), entities[5]));
+    EXPECT_TRUE(Contains(scene.QueryAABB(AABB2D(72.0f, -1.0f, 2.0f, 2.0f)), entities[6]));
+
+    // Removing what places an entity takes it out of the index
+    scene.RemoveComponent<Transform2DComponent>(entities[7]);
+    scene.DestroyEntity(entities[8]);
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 0u);
+    EXPECT_EQ(scene.GetSpatialObjectCount(), 98u);
+    hits = scene.QueryAABB(AABB2D(69.0f, -1.0f, 12.0f, 2.0f));
+    EXPECT_FALSE(Contains(hits, entities[7]));
+    EXPECT_FALSE(Contains(hits, entities[8]));
+    EXPECT_TRUE(Contains(hits, entities[6]));
+}
+
+TEST(ScenePartitioningTest, MovedSceneNodesAreReindexed) {
+    Scene scene;
+    EntityID parent = scene.CreateEntityWithNode("parent");
+    EntityID child = scene.CreateEntityWithNode("child", scene.GetComponent<HierarchyComponent>(parent)->GetSceneNode());
+    EntityID other = scene.CreateEntityWithNode("other");
+    scene.GetComponent<HierarchyComponent>(child)->GetSceneNode()->SetPosition(Vector2f(10.0f, 0.0f));
+
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 3u);
+    EXPECT_TRUE(Contains(scene.QueryPoint(Vector2f(10.0f, 0.0f)), child));
+
+    // Moving the parent drags the child along; the other node is untouched
+    scene.GetComponent<HierarchyComponent>(parent)->GetSceneNode()->SetPosition(Vector2f(0.0f, 100.0f));
+    scene.Update(0.016f);
+    EXPECT_EQ(scene.GetEntitiesReindexed(), 2u);
+    EXPECT_TRUE(Contains(scene.QueryAABB(AABB2D(9.0f, 99.0f, 2.0f, 2.0f)), child));
+    EXPECT_TRUE(Contains(scene.QueryAABB(AABB2D(-1.0f, -1.0f, 2.0f, 2.0f)), other));
+}
+
+TEST(ScenePartitioningTest, LargeBatchesRebuildTheTree) {
+    auto populate = [](Scene& scene) {
+        std::vector<EntityID> entities;
+        for (int i = 0; i < 5000; ++i) {
+            EntityID entity = scene.CreateEntity();
+            scene.AddComponent<Transform2DComponent>(entity, Vector2f(static_cast<float>(i % 100) * 20.0f - 1000.0f,
+                                                                      static_cast<float>(i / 100) * 20.0f - 500.0f));
+            scene.AddComponent<SpriteComponent>(entity).SetSize(Vector2f(8.0f, 8.0f));
+            entities.push_back(entity);
+        }
+        return entities;
+    };
+
+    Scene serial;
+    Scene pooled;
+    ::PyNovaGE::Threading::ThreadPool pool(4);
+    pooled.SetThreadPool(&pool);
+    auto serial_entities = populate(serial);
+    auto pooled_entities = populate(pooled);
+
+    serial.Update(0.016f);
+    pooled.Update(0.016f);
+    EXPECT_EQ(serial.GetEntitiesReindexed(), 5000u);
+    EXPECT_EQ(pooled.GetSpatialObjectCount(), 5000u);
+
+    // Move half of them: past the threshold, so both rebuild
+    for (size_t i = 0; i < serial_entities.size(); i += 2) {
+        serial.SetEntityPosition(serial_entities[i], Vector2f(3000.0f, static_cast<float>(i)));
+        pooled.SetEntityPosition(pooled_entities[i], Vector2f(3000.0f, static_cast<float>(i)));
+    }
+    serial.Update(0.016f);
+    pooled.Update(0.016f);
+    EXPECT_EQ(serial.GetEntitiesReindexed(), 5000u);
+    EXPECT_EQ(pooled.GetEntitiesReindexed(), 5000u);
+
+    const std::vector<AABB2D> areas = {
+        AABB2D(-1000.0f, -500.0f, 400.0f, 400.0f), AABB2D(2990.0f, 0.0f, 20.0f, 1000.0f),
+        AABB2D(-5000.0f, -5000.0f, 10000.0f, 10000.0f)};
+    for (const auto& area : areas) {
+        auto serial_hits = serial.QueryAABB(area);
+        auto pooled_hits = pooled.QueryAABB(area);
+        EXPECT_FALSE(serial_hits.empty());
+        std::sort(serial_hits.begin(), serial_hits.end(), [](EntityID a, EntityID b) { return a.GetID() < b.GetID(); });
+        std::sort(pooled_hits.begin(), pooled_hits.end(), [](EntityID a, EntityID b) { return a.GetID() < b.GetID(); });
+        EXPECT_EQ(serial_hits, pooled_hits);
+    }
+    EXPECT_EQ(serial.QueryAABB(AABB2D(-5000.0f, -5000.0f, 10000.0f, 10000.0f)).size(), 5000u);
+}
+
+TEST(ScenePartitioningTest, VisibleEntitiesIntoFrameMemory) {
+    Scene scene;
+    for (int i = 0; i < 400; ++i) {
+        EntityID entity = scene.CreateEntity();
+        scene.AddComponent<Transform2DComponent>(entity, Vector2f(static_cast<float>(i % 20) * 20.0f - 200.0f,
+                                                                  static_cast<float>(i / 20) * 20.0f - 200.0f));
+        scene.AddComponent<SpriteComponent>(entity).SetSize(Vector2f(8.0f, 8.0f));
+    }
+    EntityID camera_entity = scene.CreateEntity();
+    const auto& camera = scene.AddComponent<CameraComponent>(camera_entity, Vector2f(200.0f, 100.0f));
+    scene.Update(0.016f);
+
+    auto expected = scene.GetVisibleEntities(&camera);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_LT(expected.size(), 400u);
+
+    // Everything, scratch included, must come out of the caller's buffer
+    alignas(std::max_align_t) std::array<std::byte, 16384> buffer;
+    std::pmr::monotonic_buffer_resource frame(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    std::pmr::vector<EntityID> visible(&frame);
+    scene.GetVisibleEntities(&camera, visible);
+    std::pmr::set_default_resource(previous);
+
+    std::vector<EntityID> actual(visible.begin(), visible.end());
+    auto by_id = [](EntityID a, EntityID b) { return a.GetID() < b.GetID(); };
+    std::sort(expected.begin(), expected.end(), by_id);
+    std::sort(actual.begin(), actual.end(), by_id);
+    EXPECT_EQ(actual, expected);
+
+    // Reusing the vector starts from scratch
+    scene.GetVisibleEntities(nullptr, visible);
+    EXPECT_TRUE(visible.empty());
+}
@@ -4,11 +4,18 @@
 #include <memory>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
 
 #include "memory/allocator.h"
 #include "memory/memory_pool.h"
 #include "memory/stack_allocator.h"
 #include "memory/object_pool.h"
+#include "memory/paged_object_pool.h"
+#include "memory/tlsf_allocator.h"
+#include "memory/concurrent_memory_pool.h"
+#include "memory/concurrent_object_pool.h"
 
 using namespace PyNovaGE;
 
@@ -574,6 +581,303 @@ static void BM_TypicalFrameScenario_MixedAllocators(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * frame_operations);
 }
 
+//------------------------------------------------------------------------------
+// Multi-threaded Allocation Throughput
+//------------------------------------------------------------------------------
+
+// Blocks each thread keeps live per iteration (mesh-worker sized burst)
+constexpr size_t THREADED_BURST = 256;
+
+static void BM_Threaded_SystemAllocator(benchmark::State& state) {
+    // Per-thread wrapper: SystemAllocator's stats are not synchronized,
+    // the underlying malloc is shared
+    SystemAllocator allocator;
+    std::vector<void*> pointers(THREADED_BURST);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            pointers[i] = allocator.allocate(PARTICLE_SIZE, 16);
+        }
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            allocator.deallocate(pointers[i]);
+        }
+        benchmark::DoNotOptimize(pointers.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * THREADED_BURST * 2);
+}
+
+static ConcurrentMemoryPool* g_shared_pool = nullptr;
+
+static void BM_Threaded_ConcurrentMemoryPool(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_shared_pool = new ConcurrentMemoryPool(PARTICLE_SIZE, THREADED_BURST * 2 * 64);
+    }
+    std::vector<void*> pointers(THREADED_BURST);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            pointers[i] = g_shared_pool->allocate(PARTICLE_SIZE, 16);
+        }
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            g_shared_pool->deallocate(pointers[i]);
+        }
+        benchmark::DoNotOptimize(pointers.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * THREADED_BURST * 2);
+    if (state.thread_index() == 0) {
+        state.counters["peak_kb"] = static_cast<double>(g_shared_pool->getPeakAllocated()) / 1024.0;
+        delete g_shared_pool;
+        g_shared_pool = nullptr;
+    }
+}
+
+// Producer/consumer: each thread frees the burst its neighbour allocated
+static std::vector<std::vector<void*>> g_handoff;
+static std::mutex g_handoff_mutex;
+
+static void BM_Threaded_ConcurrentMemoryPool_CrossThreadFree(benchmark::State& state) {
+    const size_t threads = static_cast<size_t>(state.threads());
+    const size_t me = static_cast<size_t>(state.thread_index());
+    if (me == 0) {
+        g_shared_pool = new ConcurrentMemoryPool(PARTICLE_SIZE, THREADED_BURST * 4 * 64);
+        g_handoff.assign(threads, std::vector<void*>());
+    }
+    std::vector<void*> pointers(THREADED_BURST);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            pointers[i] = g_shared_pool->allocate(PARTICLE_SIZE, 16);
+        }
+        // Swap our burst into the neighbour's slot and free whatever was
+        // there (usually a burst allocated by another thread)
+        {
+            std::lock_guard<std::mutex> lock(g_handoff_mutex);
+            std::swap(g_handoff[(me + 1) % threads], pointers);
+        }
+        for (void* ptr : pointers) {
+            g_shared_pool->deallocate(ptr);
+        }
+        pointers.resize(THREADED_BURST);
+    }
+
+    state.SetItemsProcessed(state.iterations() * THREADED_BURST * 2);
+    if (me == 0) {
+        delete g_shared_pool;
+        g_shared_pool = nullptr;
+        g_handoff.clear();
+    }
+}
+
+static ConcurrentObjectPool<Particle>* g_particle_pool = nullptr;
+
+static void BM_Threaded_ConcurrentObjectPool_Particles(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_particle_pool = new ConcurrentObjectPool<Particle>(THREADED_BURST * 2 * 64);
+    }
+    std::vector<Particle*> particles(THREADED_BURST);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            particles[i] = g_particle_pool->acquire();
+        }
+        for (size_t i = 0; i < THREADED_BURST; ++i) {
+            g_particle_pool->release(particles[i]);
+        }
+        benchmark::DoNotOptimize(particles.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * THREADED_BURST * 2);
+    if (state.thread_index() == 0) {
+        delete g_particle_pool;
+        g_particle_pool = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Burst spawn + clear (particle system reset pattern)
+//------------------------------------------------------------------------------
+
+static void BM_ParticleBurstClear_ObjectPool(benchmark::State& state) {
+    const size_t N = state.range(0);
+    ObjectPool<Particle> pool(N);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < N; ++i) {
+            benchmark::DoNotOptimize(pool.acquire());
+        }
+        pool.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_ParticleBurstClear_PagedObjectPool(benchmark::State& state) {
+    const size_t N = state.range(0);
+    PagedObjectPool<Particle> pool(1024, N, N / 1024 + 1);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < N; ++i) {
+            benchmark::DoNotOptimize(pool.acquire());
+        }
+        pool.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_ParticleUpdate_PagedObjectPool_ForEachLive(benchmark::State& state) {
+    const size_t N = state.range(0);
+    PagedObjectPool<Particle> pool(1024, N);
+    std::vector<Particle*> particles;
+    for (size_t i = 0; i < N; ++i) {
+        particles.push_back(pool.acquire());
+    }
+    // Leave a sparse pool behind, as after a wave of particle deaths
+    for (size_t i = 0; i < N; i += 3) {
+        pool.release(particles[i]);
+    }
+
+    for (auto _ : state) {
+        pool.for_each_live([](Particle& p) {
+            p.position[0] += p.velocity[0];
+            p.life_time -= 0.016f;
+        });
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * pool.getAllocatedCount());
+}
+
+//------------------------------------------------------------------------------
+// Chunk streaming (variable-size long-lived allocations)
+//------------------------------------------------------------------------------
+
+// One step of a synthetic allocation trace; size 0 frees the slot
+struct StreamingOp {
+    uint32_t slot;
+    uint32_t size;
+};
+
+struct StreamingTrace {
+    std::vector<StreamingOp> ops;
+    uint32_t slot_count = 0;
+    size_t peak_bytes = 0;
+};
+
+// Synthetic stand-in for voxel chunks streaming around a moving camera:
+// meshes load and unload in FIFO order, resident chunks get remeshed at new
+// sizes, and glyph/audio buffers churn alongside them. Sizes come from a
+// seeded distribution, not from a capture of the engine.
+// TODO: Replace with a trace captured from VoxelRenderer once chunk meshes
+// are allocated through TLSFAllocator
+static const StreamingTrace& chunkStreamingTrace() {
+    static const StreamingTrace trace = [] {
+        constexpr uint32_t kResidentChunks = 512;
+        constexpr uint32_t kSmallSlots = 128;
+        constexpr uint32_t kChunkLoads = 4000;
+
+        StreamingTrace t;
+        t.slot_count = kResidentChunks * 2 + kSmallSlots;
+        std::vector<uint32_t> live(t.slot_count, 0);
+        size_t live_bytes = 0;
+
+        std::mt19937 rng(7);
+        std::lognormal_distribution<double> vertex_dist(10.5, 0.8);  // ~36 KB median
+        std::uniform_int_distribution<uint32_t> small_dist(64, 16 * 1024);
+
+        auto free_slot = [&](uint32_t slot) {
+            if (live[slot] == 0) return;
+            t.ops.push_back({slot, 0});
+            live_bytes -= live[slot];
+            live[slot] = 0;
+        };
+        auto alloc_slot = [&](uint32_t slot, uint32_t size) {
+            free_slot(slot);
+            t.ops.push_back({slot, size});
+            live[slot] = size;
+            live_bytes += size;
+            t.peak_bytes = std::max(t.peak_bytes, live_bytes);
+        };
+        auto mesh_size = [&] {
+            return static_cast<uint32_t>(std::clamp(vertex_dist(rng), 1024.0, 512.0 * 1024.0));
+        };
+
+        for (uint32_t chunk = 0; chunk < kChunkLoads; ++chunk) {
+            // Loading a chunk into a ring slot evicts the oldest resident chunk
+            const uint32_t ring = chunk % kResidentChunks;
+            const uint32_t vertices = mesh_size();
+            alloc_slot(ring * 2, vertices);
+            alloc_slot(ring * 2 + 1, vertices / 4);
+
+            if (rng() % 2 == 0) {
+                const uint32_t remesh = static_cast<uint32_t>(rng() % std::min(chunk + 1, kResidentChunks));
+                const uint32_t new_vertices = mesh_size();
+                alloc_slot(remesh * 2, new_vertices);
+                alloc_slot(remesh * 2 + 1, new_vertices / 4);
+            }
+            for (int i = 0; i < 4; ++i) {
+                alloc_slot(kResidentChunks * 2 + static_cast<uint32_t>(rng() % kSmallSlots), small_dist(rng));
+            }
+        }
+        return t;
+    }();
+    return trace;
+}
+
+static void BM_ChunkStreaming_Malloc(benchmark::State& state) {
+    const StreamingTrace& trace = chunkStreamingTrace();
+    std::vector<void*> slots(trace.slot_count, nullptr);
+
+    for (auto _ : state) {
+        for (const StreamingOp& op : trace.ops) {
+            std::free(slots[op.slot]);
+            slots[op.slot] = op.size ? std::malloc(op.size) : nullptr;
+        }
+        benchmark::DoNotOptimize(slots.data());
+        for (void*& ptr : slots) {
+            std::free(ptr);
+            ptr = nullptr;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * trace.ops.size());
+}
+
+static void BM_ChunkStreaming_TLSF(benchmark::State& state) {
+    const StreamingTrace& trace = chunkStreamingTrace();
+    TLSFAllocator allocator(trace.peak_bytes * 2);
+    std::vector<void*> slots(trace.slot_count, nullptr);
+    size_t failures = 0;
+    float fragmentation = 0.0f;
+    size_t largest_free = 0;
+
+    for (auto _ : state) {
+        for (const StreamingOp& op : trace.ops) {
+            allocator.deallocate(slots[op.slot]);
+            slots[op.slot] = op.size ? allocator.allocate(op.size) : nullptr;
+            failures += (op.size && !slots[op.slot]) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(slots.data());
+
+        state.PauseTiming();
+        fragmentation = allocator.getFragmentation();
+        largest_free = allocator.getLargestFreeBlock();
+        state.ResumeTiming();
+
+        for (void*& ptr : slots) {
+            allocator.deallocate(ptr);
+            ptr = nullptr;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * trace.ops.size());
+    state.counters["fragmentation"] = fragmentation;
+    state.counters["largest_free_MB"] = static_cast<double>(largest_free) / (1024.0 * 1024.0);
+    state.counters["failed_allocs"] = static_cast<double>(failures);
+}
+
 //------------------------------------------------------------------------------
 // Benchmark Registration
 //------------------------------------------------------------------------------
@@ -628,4 +932,48 @@ BENCHMARK(BM_ScopeBasedAllocations_StackAllocator)
 BENCHMARK(BM_TypicalFrameScenario_MixedAllocators)
     ->RangeMultiplier(2)
     ->Range(1<<6, 1<<12)
-    ->Unit(benchmark::kNanosecond);
\ No newline at end of file
+    ->Unit(benchmark::kNanosecond);
+
+// Multi-threaded throughput (1/4/16 threads)
+BENCHMARK(BM_Threaded_SystemAllocator)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Threaded_ConcurrentMemoryPool)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Threaded_ConcurrentMemoryPool_CrossThreadFree)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Threaded_ConcurrentObjectPool_Particles)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Burst spawn + clear
+BENCHMARK(BM_ParticleBurstClear_ObjectPool)
+    ->RangeMultiplier(4)
+    ->Range(1<<12, 1<<17)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ParticleBurstClear_PagedObjectPool)
+    ->RangeMultiplier(4)
+    ->Range(1<<12, 1<<17)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ParticleUpdate_PagedObjectPool_ForEachLive)
+    ->RangeMultiplier(4)
+    ->Range(1<<12, 1<<17)
+    ->Unit(benchmark::kMicrosecond);
+
+// Chunk streaming trace
+BENCHMARK(BM_ChunkStreaming_Malloc)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ChunkStreaming_TLSF)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "allocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace PyNovaGE {
+
+/**
+ * @brief Thread-safe fixed-size memory pool with per-thread caches
+ *
+ * Concurrent counterpart of MemoryPool for pools shared by worker threads.
+ * Each thread allocates from and frees into its own cache (a small stack of
+ * block indices) without synchronization. Caches refill from and spill to a
+ * lock-free global free list one magazine (batch of blocks) at a time, so
+ * the shared list is touched once per kMagazineSize operations.
+ *
+ * Blocks may be freed by any thread, not just the one that allocated them.
+ * Free blocks parked in another thread's cache are not visible to the
+ * caller, so a nearly exhausted pool can fail an allocation while other
+ * caches still hold blocks; flushThreadCache() returns them early.
+ */
+class ConcurrentMemoryPool : public Allocator {
+public:
+    static constexpr uint32_t kMagazineSize = 32;
+    static constexpr size_t kMaxThreadCaches = 64;
+
+    /**
+     * @brief Construct concurrent memory pool
+     * @param block_size Size of each allocation block (will be aligned)
+     * @param block_count Number of blocks in the pool
+     * @param alignment Block alignment, power of two (at least 16)
+     */
+    ConcurrentMemoryPool(size_t block_size, size_t block_count, size_t alignment = 16);
+    ~ConcurrentMemoryPool();
+
+    ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+    ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+
+    void* allocate(size_t size, size_t alignment = 16) override;
+    void deallocate(void* ptr) override;
+
+    /**
+     * @brief Bytes currently allocated, summed over all threads
+     */
+    size_t getTotalAllocated() const override;
+
+    /**
+     * @brief Peak bytes taken out of the global free list
+     *
+     * Sampled at magazine granularity, so it includes blocks parked in
+     * thread caches and is an upper bound on the true peak.
+     */
+    size_t getPeakAllocated() const override;
+
+    /**
+     * @brief Reset peak statistics to the current usage
+     */
+    void resetStats() override;
+
+    /**
+     * @brief Bytes allocated minus bytes freed by the calling thread
+     *
+     * Negative balances (freeing another thread's blocks) report as zero.
+     */
+    size_t getThreadAllocated() const;
+
+    /**
+     * @brief Peak of getThreadAllocated() for the calling thread
+     */
+    size_t getThreadPeakAllocated() const;
+
+    /**
+     * @brief Return the calling thread's cached blocks to the global list
+     */
+    void flushThreadCache();
+
+    /**
+     * @brief Get number of allocated blocks
+     */
+    size_t getAllocatedBlocks() const;
+
+    /**
+     * @brief Get number of free blocks (global list plus all thread caches)
+     */
+    size_t getFreeBlocks() const { return block_count_ - getAllocatedBlocks(); }
+
+    /**
+     * @brief Get size of each block in bytes
+     */
+    size_t getBlockSize() const { return block_size_; }
+
+    /**
+     * @brief Check if pointer belongs to this pool
+     */
+    bool ownsPointer(const void* ptr) const;
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr uint32_t kCacheCapacity = kMagazineSize * 2;
+
+    // Overlaid on the first bytes of a free block
+    struct FreeHeader {
+        uint32_t next_batch;    // Next magazine in the global list (batch heads only)
+        uint32_t next;          // Next block within this magazine
+        uint32_t count;         // Blocks in this magazine (batch heads only)
+    };
+
+    struct alignas(64) ThreadCache {
+        uint32_t blocks[kCacheCapacity];
+        uint32_t count = 0;
+        std::atomic<int64_t> allocated{0};  // Written by the owning thread only
+        std::atomic<int64_t> peak{0};
+    };
+
+    FreeHeader* header(uint32_t index) const {
+        return reinterpret_cast<FreeHeader*>(buffer_ + static_cast<size_t>(index) * block_size_);
+    }
+    uint32_t indexOf(const void* ptr) const {
+        return static_cast<uint32_t>((static_cast<const uint8_t*>(ptr) - buffer_) / block_size_);
+    }
+
+    uint32_t popBatch();
+    void pushBatch(uint32_t first, uint32_t count);
+    void refill(ThreadCache& cache);
+    void spill(ThreadCache& cache, uint32_t count);
+    void recordAllocation(ThreadCache& cache, int64_t delta);
+    ThreadCache* currentCache() const;
+
+    uint8_t* buffer_;
+    size_t buffer_size_;
+    size_t block_size_;
+    size_t block_alignment_;
+    size_t block_count_;
+    std::unique_ptr<ThreadCache[]> caches_;
+
+    // Magazine stack: high 32 bits are an ABA tag, low 32 bits the head block index
+    alignas(64) std::atomic<uint64_t> global_head_;
+    alignas(64) std::atomic<int64_t> outstanding_blocks_;   // Blocks outside the global list
+    std::atomic<int64_t> peak_outstanding_;
+    std::atomic<int64_t> uncached_allocated_;                // Threads without a cache slot
+};
+
+} // namespace PyNovaGE
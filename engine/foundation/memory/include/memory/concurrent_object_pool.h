@@ -0,0 +1,108 @@
+#pragma once
+
+#include "concurrent_memory_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace PyNovaGE {
+
+/**
+ * @brief Thread-safe type-safe object pool
+ *
+ * ObjectPool counterpart backed by ConcurrentMemoryPool: any thread may
+ * acquire objects and any thread may release them. Construction and
+ * destruction run on the calling thread.
+ */
+template<typename T>
+class ConcurrentObjectPool {
+public:
+    /**
+     * @brief Construct object pool
+     * @param pool_size Number of objects the pool can hold
+     */
+    explicit ConcurrentObjectPool(size_t pool_size)
+        : pool_(sizeof(T), pool_size, std::max<size_t>(alignof(T), 16)) {}
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    /**
+     * @brief Acquire an object from the pool
+     * @param args Arguments to forward to T's constructor
+     * @return Pointer to constructed object, or nullptr if pool is full
+     */
+    template<typename... Args>
+    T* acquire(Args&&... args) {
+        void* memory = pool_.allocate(sizeof(T), alignof(T));
+        if (!memory) {
+            return nullptr; // Pool exhausted
+        }
+
+        try {
+            return new(memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_.deallocate(memory);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Release an object back to the pool
+     * @param object Pointer to object to release
+     */
+    void release(T* object) {
+        if (!object || !pool_.ownsPointer(object)) {
+            return;
+        }
+
+        object->~T();
+        pool_.deallocate(object);
+    }
+
+    /**
+     * @brief Check if pointer belongs to this pool
+     */
+    bool ownsPointer(const void* ptr) const { return pool_.ownsPointer(ptr); }
+
+    /**
+     * @brief Get number of allocated objects (all threads)
+     */
+    size_t getAllocatedCount() const { return pool_.getAllocatedBlocks(); }
+
+    /**
+     * @brief Get number of free objects
+     */
+    size_t getFreeCount() const { return pool_.getFreeBlocks(); }
+
+    /**
+     * @brief Get peak allocated count (magazine granularity, see ConcurrentMemoryPool)
+     */
+    size_t getPeakAllocated() const { return pool_.getPeakAllocated() / pool_.getBlockSize(); }
+
+    /**
+     * @brief Get number of objects held by the calling thread
+     */
+    size_t getThreadAllocatedCount() const { return pool_.getThreadAllocated() / pool_.getBlockSize(); }
+
+    /**
+     * @brief Reset statistics
+     */
+    void resetStats() { pool_.resetStats(); }
+
+    /**
+     * @brief Return the calling thread's cached slots to the shared free list
+     */
+    void flushThreadCache() { pool_.flushThreadCache(); }
+
+    /**
+     * @brief Underlying block allocator
+     */
+    ConcurrentMemoryPool& getMemoryPool() { return pool_; }
+
+private:
+    ConcurrentMemoryPool pool_;
+};
+
+} // namespace PyNovaGE
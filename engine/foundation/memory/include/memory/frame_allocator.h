@@ -0,0 +1,126 @@
+#pragma once
+
+#include "allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace PyNovaGE {
+
+/**
+ * @brief Double-buffered bump allocator for transient per-frame data
+ *
+ * Allocations come from the current frame's buffer and stay valid until the
+ * end of the following frame: beginFrame() switches to the other buffer and
+ * resets it, so results produced in frame N can still be consumed in frame
+ * N+1 (e.g. by the render thread).
+ *
+ * When a frame outgrows its buffer the excess is served from the system
+ * allocator and the buffer is resized at its next reset, so a steady-state
+ * frame makes no heap allocations. Not thread-safe; use threadLocal() to get
+ * the calling thread's instance.
+ */
+class FrameAllocator : public Allocator {
+public:
+    static constexpr size_t kDefaultBufferSize = 256 * 1024;
+
+    /**
+     * @brief Construct frame allocator
+     * @param buffer_size Initial size of each of the two buffers
+     */
+    explicit FrameAllocator(size_t buffer_size = kDefaultBufferSize);
+    ~FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    void* allocate(size_t size, size_t alignment = 16) override;
+    void deallocate(void* ptr) override { (void)ptr; } // Freed at frame reset
+
+    size_t getTotalAllocated() const override { return total_allocated_; }
+    size_t getPeakAllocated() const override { return peak_usage_; }
+    void resetStats() override { total_allocated_ = 0; peak_usage_ = 0; overflow_count_ = 0; }
+
+    /**
+     * @brief Switch buffers, releasing everything allocated two frames ago
+     */
+    void beginFrame();
+
+    /**
+     * @brief Bytes allocated in the current frame (including overflow)
+     */
+    size_t getCurrentUsage() const;
+
+    /**
+     * @brief Size of the current frame's buffer
+     */
+    size_t getBufferSize() const { return buffers_[current_].size; }
+
+    /**
+     * @brief Number of allocations that did not fit a frame buffer
+     */
+    size_t getOverflowCount() const { return overflow_count_; }
+
+    /**
+     * @brief std::pmr adapter allocating from this frame allocator
+     */
+    std::pmr::memory_resource* getMemoryResource() { return &resource_; }
+
+    /**
+     * @brief Advance the engine-wide frame counter
+     *
+     * Called once per frame by the frame loop. Each thread's allocator
+     * notices the new frame the next time threadLocal() is called.
+     */
+    static void advanceFrame();
+
+    /**
+     * @brief Current engine-wide frame index
+     */
+    static uint64_t getFrameIndex();
+
+    /**
+     * @brief Get the calling thread's frame allocator, synced to the current frame
+     */
+    static FrameAllocator& threadLocal();
+
+    /**
+     * @brief Shorthand for threadLocal().getMemoryResource()
+     */
+    static std::pmr::memory_resource* threadLocalResource() { return threadLocal().getMemoryResource(); }
+
+private:
+    class Resource : public std::pmr::memory_resource {
+    public:
+        explicit Resource(FrameAllocator& owner) : owner_(owner) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        FrameAllocator& owner_;
+    };
+
+    struct Buffer {
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+        size_t overflow_bytes = 0;
+        std::vector<void*> overflow;
+    };
+
+    void resetBuffer(Buffer& buffer);
+    void syncToFrame(uint64_t frame);
+
+    Buffer buffers_[2];
+    size_t current_ = 0;
+    uint64_t frame_index_ = 0;
+    size_t total_allocated_ = 0;
+    size_t peak_usage_ = 0;
+    size_t overflow_count_ = 0;
+    Resource resource_{*this};
+};
+
+} // namespace PyNovaGE
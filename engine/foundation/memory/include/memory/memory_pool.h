@@ -11,6 +11,7 @@ namespace PyNovaGE {
  * 
  * Efficient allocator for objects of uniform size.
  * Uses a free list for O(1) allocation and deallocation.
+ * Not thread-safe; use ConcurrentMemoryPool for pools shared between threads.
  */
 class MemoryPool : public Allocator {
 private:
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "allocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Set by the PYNOVAGE_MEMORY_TRACKING CMake option as a public definition of
+// the memory target. It must not be decided per translation unit: tracking
+// changes which MemoryTracker functions are inline, so a library and its
+// consumers built with different values would not link together correctly.
+#ifndef PYNOVAGE_MEMORY_TRACKING
+    #error "PYNOVAGE_MEMORY_TRACKING is not defined; link the memory target or define it to 0 or 1"
+#endif
+
+namespace PyNovaGE {
+
+/**
+ * @brief Memory categories used to attribute allocations to engine systems
+ */
+enum class MemoryTag : uint8_t {
+    General,
+    Renderer,
+    VoxelMeshing,
+    Particles,
+    Physics,
+    Scene,
+    Assets,
+    Audio,
+    Count
+};
+
+/**
+ * @brief Get human-readable name of a memory tag
+ */
+constexpr const char* getMemoryTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::General:      return "General";
+        case MemoryTag::Renderer:     return "Renderer";
+        case MemoryTag::VoxelMeshing: return "VoxelMeshing";
+        case MemoryTag::Particles:    return "Particles";
+        case MemoryTag::Physics:      return "Physics";
+        case MemoryTag::Scene:        return "Scene";
+        case MemoryTag::Assets:       return "Assets";
+        case MemoryTag::Audio:        return "Audio";
+        default:                      return "Unknown";
+    }
+}
+
+/**
+ * @brief Snapshot of one tag's counters
+ */
+struct MemoryTagStats {
+    size_t current_bytes = 0;       ///< Live bytes
+    size_t peak_bytes = 0;          ///< Highest live bytes since the last peak reset
+    size_t total_allocations = 0;   ///< Allocations recorded since startup
+    size_t live_allocations = 0;    ///< Allocations not yet freed
+};
+
+/**
+ * @brief Process-wide per-tag memory accounting
+ *
+ * Counters are lock-free atomics, so recording is safe from any thread.
+ * Optional callstack sampling captures the stack of every Nth allocation
+ * into a small ring buffer that is included in the JSON snapshot (raw
+ * return addresses; symbolize offline).
+ *
+ * With PYNOVAGE_MEMORY_TRACKING == 0 every recording call is an empty
+ * inline function, getStats() returns zeros and the snapshot only reports
+ * that tracking is disabled.
+ */
+class MemoryTracker {
+public:
+    static constexpr bool kEnabled = PYNOVAGE_MEMORY_TRACKING != 0;
+    static constexpr size_t kMaxSampledFrames = 16;
+    static constexpr size_t kMaxSamples = 256;
+
+#if PYNOVAGE_MEMORY_TRACKING
+    /**
+     * @brief Record bytes becoming live under a tag
+     */
+    static void recordAllocation(MemoryTag tag, size_t bytes);
+
+    /**
+     * @brief Record bytes previously recorded under the same tag being freed
+     */
+    static void recordDeallocation(MemoryTag tag, size_t bytes);
+
+    /**
+     * @brief Get counters for one tag
+     */
+    static MemoryTagStats getStats(MemoryTag tag);
+
+    /**
+     * @brief Reset every tag's peak to its current usage
+     */
+    static void resetPeaks();
+
+    /**
+     * @brief Capture the callstack of every Nth allocation (0 disables sampling)
+     */
+    static void setCallstackSampleRate(uint32_t every_n_allocations);
+#else
+    static void recordAllocation(MemoryTag, size_t) {}
+    static void recordDeallocation(MemoryTag, size_t) {}
+    static MemoryTagStats getStats(MemoryTag) { return {}; }
+    static void resetPeaks() {}
+    static void setCallstackSampleRate(uint32_t) {}
+#endif
+
+    /**
+     * @brief Serialize all tag counters and callstack samples as JSON
+     */
+    static std::string toJson();
+
+    /**
+     * @brief Write toJson() to a file
+     * @return false if the file could not be written
+     */
+    static bool writeJson(const std::string& path);
+};
+
+/**
+ * @brief One owner's share of a tag
+ *
+ * Records go to the tag's process-wide counters and to the scope's own, so
+ * a system reports its usage from the same numbers as the tag total, e.g.
+ * one of several particle systems charging MemoryTag::Particles. Bytes must
+ * be released through the scope they were recorded in.
+ *
+ * Compiled out along with the tracker; getStats() then returns zeros.
+ */
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag) : tag_(tag) {}
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+#if PYNOVAGE_MEMORY_TRACKING
+    /**
+     * @brief Record bytes becoming live in this scope and its tag
+     */
+    void recordAllocation(size_t bytes);
+
+    /**
+     * @brief Record bytes previously recorded in this scope being freed
+     */
+    void recordDeallocation(size_t bytes);
+
+    /**
+     * @brief Get this scope's counters (peak since construction)
+     */
+    MemoryTagStats getStats() const;
+#else
+    void recordAllocation(size_t) {}
+    void recordDeallocation(size_t) {}
+    MemoryTagStats getStats() const { return {}; }
+#endif
+
+    /**
+     * @brief Get tag the scope rolls up into
+     */
+    MemoryTag getTag() const { return tag_; }
+
+private:
+    MemoryTag tag_;
+#if PYNOVAGE_MEMORY_TRACKING
+    std::atomic<size_t> current_bytes_{0};
+    std::atomic<size_t> peak_bytes_{0};
+    std::atomic<size_t> total_allocations_{0};
+    std::atomic<size_t> live_allocations_{0};
+#endif
+};
+
+/**
+ * @brief Allocator wrapper that attributes everything it allocates to a tag
+ *
+ * Forwards to another allocator and records each allocation under the tag.
+ * The allocation size is kept in a small header in front of the returned
+ * block so deallocate() can record it. When tracking is compiled out the
+ * wrapper forwards directly with no header.
+ */
+class TrackingAllocator : public Allocator {
+public:
+    /**
+     * @brief Construct tracking allocator
+     * @param upstream Allocator that provides the memory (must outlive this)
+     * @param tag Tag charged for every allocation
+     */
+    TrackingAllocator(Allocator& upstream, MemoryTag tag)
+        : upstream_(upstream), tag_(tag) {}
+
+    void* allocate(size_t size, size_t alignment = 16) override;
+    void deallocate(void* ptr) override;
+
+    size_t getTotalAllocated() const override;
+    size_t getPeakAllocated() const override;
+    void resetStats() override;
+
+    /**
+     * @brief Get tag charged for allocations
+     */
+    MemoryTag getTag() const { return tag_; }
+
+    /**
+     * @brief Get wrapped allocator
+     */
+    Allocator& getUpstream() const { return upstream_; }
+
+private:
+    Allocator& upstream_;
+    MemoryTag tag_;
+    size_t total_allocated_ = 0;
+    size_t peak_allocated_ = 0;
+};
+
+} // namespace PyNovaGE
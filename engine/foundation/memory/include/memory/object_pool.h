@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #ifdef _WIN32
     #include <malloc.h>
@@ -16,6 +17,7 @@ namespace PyNovaGE {
  * 
  * Template-based object pool for efficient allocation and deallocation
  * of objects of a specific type. Handles construction/destruction automatically.
+ * Not thread-safe; use ConcurrentObjectPool for pools shared between threads.
  */
 template<typename T>
 class ObjectPool {
@@ -175,19 +177,17 @@ public:
      * @brief Clear all objects and reset pool
      */
     void clear() {
-        // Destroy all allocated objects
-        for (size_t i = 0; i < pool_size_; ++i) {
-            // Check if this block is not in the free list
-            bool is_free = false;
+        // Mark free blocks in one pass over the free list, then destroy the rest
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::vector<bool> is_free(pool_size_, false);
             for (FreeNode* node = free_list_; node; node = node->next) {
-                if (node == &buffer_[i].free_node) {
-                    is_free = true;
-                    break;
-                }
+                is_free[static_cast<size_t>(reinterpret_cast<Block*>(node) - buffer_)] = true;
             }
-            
-            if (!is_free) {
-                buffer_[i].object.~T();
+
+            for (size_t i = 0; i < pool_size_; ++i) {
+                if (!is_free[i]) {
+                    buffer_[i].object.~T();
+                }
             }
         }
 
@@ -0,0 +1,440 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_tracker.h"
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace PyNovaGE {
+
+/**
+ * @brief Growable object pool built from fixed-size slabs
+ *
+ * Unlike ObjectPool, the pool grows on demand one slab at a time (up to an
+ * optional object limit) and never moves live objects, so pointers stay
+ * valid for an object's whole lifetime. Each slab keeps an occupancy
+ * bitmap: clear() and for_each_live() cost one bit scan per slot word plus
+ * one visit per live object, and clear() on trivially destructible types
+ * only resets the bitmaps.
+ *
+ * Slabs that become empty while more than the high-water mark are
+ * allocated are returned to the system immediately; trim() does the same
+ * on demand. Slab storage is reported to MemoryTracker under the pool's
+ * tag (MemoryTag::General unless set). Not thread-safe.
+ */
+template<typename T>
+class PagedObjectPool {
+private:
+    static constexpr uint32_t kNoFreeSlot = std::numeric_limits<uint32_t>::max();
+
+    union Block {
+        T object;
+        uint32_t next_free;
+
+        Block() {} // Don't initialize - we'll handle it manually
+        ~Block() {} // Don't destruct - we'll handle it manually
+    };
+
+    struct Slab {
+        Block* blocks = nullptr;
+        std::unique_ptr<uint64_t[]> occupancy;
+        uint32_t live = 0;
+        uint32_t next_unused = 0;           // Slots at or above this were never handed out
+        uint32_t free_head = kNoFreeSlot;   // Released slots below next_unused
+    };
+
+    struct SlabRange {
+        const uint8_t* begin;
+        size_t slab;
+    };
+
+    std::vector<Slab> slabs_;                   // blocks == nullptr marks a released slab
+    std::vector<SlabRange> ranges_;             // Live slabs sorted by address
+    size_t slab_capacity_;
+    size_t words_per_slab_;
+    size_t max_objects_;
+    size_t high_water_slabs_;
+    size_t allocated_slabs_ = 0;
+    size_t first_free_slab_ = 0;                // No slab below this has a free slot
+    size_t allocated_objects_ = 0;
+    size_t peak_allocated_ = 0;
+    MemoryTag memory_tag_ = MemoryTag::General;
+    MemoryScope* memory_scope_ = nullptr;      // Takes precedence over memory_tag_
+
+public:
+    /**
+     * @brief Construct paged object pool (no memory is allocated until first use)
+     * @param slab_capacity Objects per slab
+     * @param max_objects Upper bound on live objects (acquire() fails beyond it)
+     * @param high_water_slabs Slabs kept allocated when they become empty
+     */
+    explicit PagedObjectPool(size_t slab_capacity = 1024,
+                             size_t max_objects = std::numeric_limits<size_t>::max(),
+                             size_t high_water_slabs = 4)
+        : slab_capacity_(slab_capacity)
+        , words_per_slab_((slab_capacity + 63) / 64)
+        , max_objects_(max_objects)
+        , high_water_slabs_(high_water_slabs) {
+        if (slab_capacity_ == 0 || slab_capacity_ >= kNoFreeSlot) {
+            throw std::invalid_argument("PagedObjectPool: invalid slab capacity");
+        }
+    }
+
+    ~PagedObjectPool() {
+        clear();
+        for (auto& slab : slabs_) {
+            if (slab.blocks) freeSlabStorage(slab);
+        }
+    }
+
+    // Non-copyable
+    PagedObjectPool(const PagedObjectPool&) = delete;
+    PagedObjectPool& operator=(const PagedObjectPool&) = delete;
+
+    /**
+     * @brief Acquire an object, growing the pool by one slab if needed
+     * @param args Arguments to forward to T's constructor
+     * @return Pointer to constructed object, or nullptr at the max_objects limit
+     */
+    template<typename... Args>
+    T* acquire(Args&&... args) {
+        if (allocated_objects_ >= max_objects_) {
+            return nullptr;
+        }
+
+        Slab& slab = slabs_[findSlabWithSpace()];
+
+        uint32_t slot;
+        if (slab.free_head != kNoFreeSlot) {
+            slot = slab.free_head;
+            slab.free_head = slab.blocks[slot].next_free;
+        } else {
+            slot = slab.next_unused++;
+        }
+
+        T* object;
+        try {
+            object = new(&slab.blocks[slot].object) T(std::forward<Args>(args)...);
+        } catch (...) {
+            slab.blocks[slot].next_free = slab.free_head;
+            slab.free_head = slot;
+            throw;
+        }
+
+        slab.occupancy[slot / 64] |= uint64_t(1) << (slot % 64);
+        ++slab.live;
+        ++allocated_objects_;
+        if (allocated_objects_ > peak_allocated_) {
+            peak_allocated_ = allocated_objects_;
+        }
+        return object;
+    }
+
+    /**
+     * @brief Release an object back to the pool
+     * @param object Pointer to object to release (ignored if not owned or not live)
+     */
+    void release(T* object) {
+        size_t slab_index;
+        uint32_t slot;
+        if (!object || !locate(object, slab_index, slot)) {
+            return;
+        }
+
+        Slab& slab = slabs_[slab_index];
+        uint64_t& word = slab.occupancy[slot / 64];
+        const uint64_t bit = uint64_t(1) << (slot % 64);
+        if (!(word & bit)) {
+            return; // Double release
+        }
+
+        object->~T();
+        word &= ~bit;
+        slab.blocks[slot].next_free = slab.free_head;
+        slab.free_head = slot;
+        --slab.live;
+        --allocated_objects_;
+
+        if (slab.live == 0 && allocated_slabs_ > high_water_slabs_) {
+            releaseSlab(slab_index);
+        } else {
+            first_free_slab_ = std::min(first_free_slab_, slab_index);
+        }
+    }
+
+    /**
+     * @brief Check if pointer points into one of the pool's slabs
+     */
+    bool ownsPointer(const void* ptr) const {
+        size_t slab_index;
+        uint32_t slot;
+        return ptr && locate(ptr, slab_index, slot);
+    }
+
+    /**
+     * @brief Call func(T&) for every live object, in slab and address order
+     *
+     * func must not acquire from or release to this pool.
+     */
+    template<typename Func>
+    void for_each_live(Func&& func) {
+        for (auto& slab : slabs_) {
+            if (slab.live == 0) continue;
+            for (size_t w = 0; w < words_per_slab_; ++w) {
+                uint64_t bits = slab.occupancy[w];
+                while (bits) {
+                    const size_t slot = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+                    func(slab.blocks[slot].object);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    template<typename Func>
+    void for_each_live(Func&& func) const {
+        const_cast<PagedObjectPool*>(this)->for_each_live([&func](const T& object) { func(object); });
+    }
+
+    /**
+     * @brief Destroy all live objects and release slabs above the high-water mark
+     */
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for_each_live([](T& object) { object.~T(); });
+        }
+
+        // Release from the back so the low slabs are the ones kept
+        for (size_t i = slabs_.size(); i > 0; --i) {
+            if (!slabs_[i - 1].blocks) continue;
+            if (allocated_slabs_ > high_water_slabs_) {
+                releaseSlab(i - 1);
+                continue;
+            }
+            resetSlab(slabs_[i - 1]);
+        }
+
+        allocated_objects_ = 0;
+        first_free_slab_ = 0;
+    }
+
+    /**
+     * @brief Return empty slabs above the high-water mark to the system
+     * @return Number of slabs released
+     */
+    size_t trim() {
+        size_t released = 0;
+        for (size_t i = slabs_.size(); i > 0 && allocated_slabs_ > high_water_slabs_; --i) {
+            if (slabs_[i - 1].blocks && slabs_[i - 1].live == 0) {
+                releaseSlab(i - 1);
+                ++released;
+            }
+        }
+        return released;
+    }
+
+    /**
+     * @brief Get number of allocated objects
+     */
+    size_t getAllocatedCount() const { return allocated_objects_; }
+
+    /**
+     * @brief Get number of objects that can still be acquired (bounded by max_objects)
+     */
+    size_t getFreeCount() const { return max_objects_ - allocated_objects_; }
+
+    /**
+     * @brief Get number of objects that fit in the currently allocated slabs
+     */
+    size_t getCapacity() const { return allocated_slabs_ * slab_capacity_; }
+
+    /**
+     * @brief Get number of currently allocated slabs
+     */
+    size_t getSlabCount() const { return allocated_slabs_; }
+
+    /**
+     * @brief Get objects per slab
+     */
+    size_t getSlabCapacity() const { return slab_capacity_; }
+
+    /**
+     * @brief Get peak allocated count
+     */
+    size_t getPeakAllocated() const { return peak_allocated_; }
+
+    /**
+     * @brief Get bytes of slab storage currently held
+     */
+    size_t getReservedBytes() const { return allocated_slabs_ * slab_capacity_ * sizeof(Block); }
+
+    /**
+     * @brief Set how many slabs are kept when they become empty
+     */
+    void setHighWaterMark(size_t slabs) { high_water_slabs_ = slabs; }
+
+    /**
+     * @brief Set the tag slab storage is charged to
+     *
+     * Slabs already allocated are moved to the new tag.
+     */
+    void setMemoryTag(MemoryTag tag) {
+        for (size_t i = 0; i < allocated_slabs_; ++i) releaseSlabCharge();
+        memory_tag_ = tag;
+        for (size_t i = 0; i < allocated_slabs_; ++i) chargeSlab();
+    }
+
+    /**
+     * @brief Charge slab storage to an owner's scope, and through it the scope's tag
+     *
+     * Slabs already allocated are moved to the scope. The scope must outlive
+     * the pool; nullptr goes back to the tag set by setMemoryTag().
+     */
+    void setMemoryScope(MemoryScope* scope) {
+        for (size_t i = 0; i < allocated_slabs_; ++i) releaseSlabCharge();
+        memory_scope_ = scope;
+        for (size_t i = 0; i < allocated_slabs_; ++i) chargeSlab();
+    }
+
+    /**
+     * @brief Get the tag slab storage is charged to
+     */
+    MemoryTag getMemoryTag() const { return memory_scope_ ? memory_scope_->getTag() : memory_tag_; }
+
+    /**
+     * @brief Reset statistics
+     */
+    void resetStats() { peak_allocated_ = allocated_objects_; }
+
+private:
+    size_t findSlabWithSpace() {
+        // Fast path: the lowest slab with space usually still has space
+        if (first_free_slab_ < slabs_.size()) {
+            const Slab& slab = slabs_[first_free_slab_];
+            if (slab.blocks && slab.live < slab_capacity_) {
+                return first_free_slab_;
+            }
+        }
+        return findOrAllocateSlab();
+    }
+
+    size_t findOrAllocateSlab() {
+        for (size_t i = first_free_slab_; i < slabs_.size(); ++i) {
+            const Slab& slab = slabs_[i];
+            if (slab.blocks && slab.live < slab_capacity_) {
+                first_free_slab_ = i;
+                return i;
+            }
+        }
+
+        // Reuse a released entry in slabs_ so indices stay dense
+        size_t index = 0;
+        while (index < slabs_.size() && slabs_[index].blocks) ++index;
+        if (index == slabs_.size()) slabs_.emplace_back();
+
+        Slab slab;
+        constexpr size_t alignment = std::max(alignof(Block), alignof(void*));
+        const size_t bytes = (sizeof(Block) * slab_capacity_ + alignment - 1) & ~(alignment - 1);
+#ifdef _WIN32
+        slab.blocks = reinterpret_cast<Block*>(_aligned_malloc(bytes, alignment));
+#else
+        slab.blocks = reinterpret_cast<Block*>(std::aligned_alloc(alignment, bytes));
+#endif
+        if (!slab.blocks) {
+            throw std::bad_alloc();
+        }
+        slab.occupancy = std::make_unique<uint64_t[]>(words_per_slab_);
+
+        const SlabRange range{reinterpret_cast<const uint8_t*>(slab.blocks), index};
+        ranges_.insert(std::upper_bound(ranges_.begin(), ranges_.end(), range,
+                                        [](const SlabRange& a, const SlabRange& b) { return a.begin < b.begin; }),
+                       range);
+
+        slabs_[index] = std::move(slab);
+        ++allocated_slabs_;
+        chargeSlab();
+        first_free_slab_ = std::min(first_free_slab_, index);
+        return index;
+    }
+
+    bool locate(const void* ptr, size_t& slab_index, uint32_t& slot) const {
+        const uint8_t* byte_ptr = static_cast<const uint8_t*>(ptr);
+        auto it = std::upper_bound(ranges_.begin(), ranges_.end(), byte_ptr,
+                                   [](const uint8_t* p, const SlabRange& r) { return p < r.begin; });
+        if (it == ranges_.begin()) {
+            return false;
+        }
+        --it;
+
+        const size_t offset = static_cast<size_t>(byte_ptr - it->begin);
+        if (offset >= sizeof(Block) * slab_capacity_ || offset % sizeof(Block) != 0) {
+            return false;
+        }
+        slab_index = it->slab;
+        slot = static_cast<uint32_t>(offset / sizeof(Block));
+        return true;
+    }
+
+    void resetSlab(Slab& slab) {
+        std::fill(slab.occupancy.get(), slab.occupancy.get() + words_per_slab_, uint64_t(0));
+        slab.live = 0;
+        slab.next_unused = 0;
+        slab.free_head = kNoFreeSlot;
+    }
+
+    void releaseSlab(size_t index) {
+        Slab& slab = slabs_[index];
+        const uint8_t* begin = reinterpret_cast<const uint8_t*>(slab.blocks);
+        ranges_.erase(std::find_if(ranges_.begin(), ranges_.end(),
+                                   [begin](const SlabRange& r) { return r.begin == begin; }));
+        freeSlabStorage(slab);
+        slab = Slab{};
+        --allocated_slabs_;
+    }
+
+    size_t getSlabBytes() const {
+        return sizeof(Block) * slab_capacity_ + sizeof(uint64_t) * words_per_slab_;
+    }
+
+    void chargeSlab() {
+        if (memory_scope_) {
+            memory_scope_->recordAllocation(getSlabBytes());
+        } else {
+            MemoryTracker::recordAllocation(memory_tag_, getSlabBytes());
+        }
+    }
+
+    void releaseSlabCharge() {
+        if (memory_scope_) {
+            memory_scope_->recordDeallocation(getSlabBytes());
+        } else {
+            MemoryTracker::recordDeallocation(memory_tag_, getSlabBytes());
+        }
+    }
+
+    void freeSlabStorage(Slab& slab) {
+        releaseSlabCharge();
+#ifdef _WIN32
+        _aligned_free(slab.blocks);
+#else
+        std::free(slab.blocks);
+#endif
+        slab.blocks = nullptr;
+    }
+};
+
+} // namespace PyNovaGE
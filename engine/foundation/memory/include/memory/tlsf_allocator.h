@@ -0,0 +1,112 @@
+#pragma once
+
+#include "allocator.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace PyNovaGE {
+
+/**
+ * @brief Two-Level Segregated Fit allocator for variable-size allocations
+ *
+ * General-purpose heap over a single fixed buffer with O(1) allocate and
+ * deallocate: free blocks are kept in size-class lists indexed by a
+ * two-level bitmap (power-of-two first level, 32 linear subdivisions per
+ * level), and freed blocks are merged with free neighbours immediately.
+ * Worst-case internal fragmentation is bounded by the subdivision width
+ * (~3%). No system calls after construction, so it is safe to use on
+ * real-time threads. Not thread-safe.
+ *
+ * TODO: Nothing allocates through this yet; route voxel chunk meshes and
+ * streamed asset buffers through it (see VoxelRenderer::GenerateMesh).
+ */
+class TLSFAllocator : public Allocator {
+public:
+    static constexpr size_t kAlignment = 16;
+
+    /**
+     * @brief Construct TLSF allocator
+     * @param capacity Size of the managed buffer in bytes
+     */
+    explicit TLSFAllocator(size_t capacity);
+    ~TLSFAllocator();
+
+    TLSFAllocator(const TLSFAllocator&) = delete;
+    TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+    void* allocate(size_t size, size_t alignment = kAlignment) override;
+    void deallocate(void* ptr) override;
+
+    size_t getTotalAllocated() const override { return allocated_bytes_; }
+    size_t getPeakAllocated() const override { return peak_allocated_; }
+    void resetStats() override { peak_allocated_ = allocated_bytes_; }
+
+    /**
+     * @brief Check if pointer lies inside the managed buffer
+     */
+    bool ownsPointer(const void* ptr) const;
+
+    /**
+     * @brief Usable size of an allocation (at least the requested size)
+     */
+    size_t getAllocationSize(const void* ptr) const;
+
+    /**
+     * @brief Number of live allocations
+     */
+    size_t getAllocationCount() const { return allocation_count_; }
+
+    /**
+     * @brief Size of the managed buffer
+     */
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Total bytes available in free blocks
+     */
+    size_t getFreeBytes() const { return free_bytes_; }
+
+    /**
+     * @brief Size of the largest free block (largest allocation that can succeed)
+     */
+    size_t getLargestFreeBlock() const;
+
+    /**
+     * @brief External fragmentation: 1 - largest free block / total free bytes
+     *
+     * 0 means all free memory is one contiguous block.
+     */
+    float getFragmentation() const;
+
+private:
+    static constexpr int kSecondLevelLog2 = 5;
+    static constexpr int kSecondLevelCount = 1 << kSecondLevelLog2;
+    static constexpr int kFirstLevelShift = kSecondLevelLog2 + 4;  // log2(kAlignment)
+    static constexpr int kFirstLevelMax = 39;  // Fits the first-level index in a uint32_t bitmap
+    static constexpr int kFirstLevelCount = kFirstLevelMax - kFirstLevelShift + 1;
+    static constexpr size_t kSmallBlockSize = size_t(1) << kFirstLevelShift;
+
+    struct BlockHeader;
+
+    BlockHeader* searchSuitableBlock(int& fl, int& sl) const;
+    void insertFreeBlock(BlockHeader* block);
+    void removeFreeBlock(BlockHeader* block);
+    BlockHeader* splitBlock(BlockHeader* block, size_t size);
+    BlockHeader* mergeWithNeighbours(BlockHeader* block);
+
+    static void mappingInsert(size_t size, int& fl, int& sl);
+    static void mappingSearch(size_t size, int& fl, int& sl);
+
+    uint8_t* buffer_;
+    size_t capacity_;
+    uint32_t fl_bitmap_ = 0;
+    uint32_t sl_bitmap_[kFirstLevelCount] = {};
+    BlockHeader* free_lists_[kFirstLevelCount][kSecondLevelCount] = {};
+
+    size_t allocated_bytes_ = 0;
+    size_t peak_allocated_ = 0;
+    size_t free_bytes_ = 0;
+    size_t allocation_count_ = 0;
+};
+
+} // namespace PyNovaGE
@@ -0,0 +1,323 @@
+#include "memory/concurrent_memory_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace PyNovaGE {
+
+namespace {
+
+/**
+ * @brief Hands out process-wide cache slot indices to threads
+ *
+ * A slot is held for the lifetime of a thread and recycled when it exits,
+ * so every ConcurrentMemoryPool can index its caches by slot without
+ * per-pool thread_local state.
+ */
+class ThreadSlotRegistry {
+public:
+    int acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_slots_.empty()) {
+            int slot = free_slots_.back();
+            free_slots_.pop_back();
+            return slot;
+        }
+        if (next_slot_ < ConcurrentMemoryPool::kMaxThreadCaches) {
+            return static_cast<int>(next_slot_++);
+        }
+        return -1;
+    }
+
+    void release(int slot) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_slots_.push_back(slot);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int> free_slots_;
+    size_t next_slot_ = 0;
+};
+
+ThreadSlotRegistry& slotRegistry() {
+    // Intentionally leaked: threads may exit after static destruction
+    static ThreadSlotRegistry* registry = new ThreadSlotRegistry();
+    return *registry;
+}
+
+struct ThreadSlot {
+    int index;
+    ThreadSlot() : index(slotRegistry().acquire()) {}
+    ~ThreadSlot() {
+        if (index >= 0) slotRegistry().release(index);
+    }
+};
+
+int currentThreadSlot() {
+    thread_local ThreadSlot slot;
+    return slot.index;
+}
+
+} // anonymous namespace
+
+ConcurrentMemoryPool::ConcurrentMemoryPool(size_t block_size, size_t block_count, size_t alignment)
+    : block_alignment_(std::max<size_t>(alignment, 16))
+    , block_count_(block_count)
+    , global_head_(kNil)
+    , outstanding_blocks_(0)
+    , peak_outstanding_(0)
+    , uncached_allocated_(0) {
+
+    if ((block_alignment_ & (block_alignment_ - 1)) != 0) {
+        throw std::invalid_argument("ConcurrentMemoryPool: alignment must be a power of two");
+    }
+    if (block_count_ >= kNil) {
+        throw std::invalid_argument("ConcurrentMemoryPool: too many blocks");
+    }
+
+    // Blocks must hold the free-list header and keep every block aligned
+    block_size_ = std::max(block_size, sizeof(FreeHeader));
+    block_size_ = (block_size_ + block_alignment_ - 1) & ~(block_alignment_ - 1);
+
+    buffer_size_ = block_size_ * block_count_;
+
+#ifdef _WIN32
+    buffer_ = static_cast<uint8_t*>(_aligned_malloc(buffer_size_, block_alignment_));
+#else
+    buffer_ = static_cast<uint8_t*>(std::aligned_alloc(block_alignment_, buffer_size_));
+#endif
+
+    if (!buffer_) {
+        throw std::bad_alloc();
+    }
+
+    caches_ = std::make_unique<ThreadCache[]>(kMaxThreadCaches);
+
+    // Carve the buffer into magazines; the lowest indices end up on top
+    uint32_t head = kNil;
+    const uint32_t count = static_cast<uint32_t>(block_count_);
+    for (uint32_t end = count; end > 0;) {
+        const uint32_t begin = end > kMagazineSize ? end - kMagazineSize : 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            header(i)->next = (i + 1 < end) ? i + 1 : kNil;
+        }
+        header(begin)->count = end - begin;
+        header(begin)->next_batch = head;
+        head = begin;
+        end = begin;
+    }
+    global_head_.store(head, std::memory_order_release);
+}
+
+ConcurrentMemoryPool::~ConcurrentMemoryPool() {
+    if (buffer_) {
+#ifdef _WIN32
+        _aligned_free(buffer_);
+#else
+        free(buffer_);
+#endif
+    }
+}
+
+void* ConcurrentMemoryPool::allocate(size_t size, size_t alignment) {
+    if (size > block_size_ || alignment > block_alignment_) {
+        return nullptr;
+    }
+
+    ThreadCache* cache = currentCache();
+    if (!cache) {
+        // No cache slot left for this thread: take one block straight from the global list
+        const uint32_t first = popBatch();
+        if (first == kNil) {
+            return nullptr;
+        }
+        FreeHeader* block = header(first);
+        if (block->count > 1) {
+            pushBatch(block->next, block->count - 1);
+        }
+        uncached_allocated_.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    if (cache->count == 0) {
+        refill(*cache);
+        if (cache->count == 0) {
+            return nullptr; // Pool exhausted
+        }
+    }
+
+    const uint32_t index = cache->blocks[--cache->count];
+    recordAllocation(*cache, 1);
+    return buffer_ + static_cast<size_t>(index) * block_size_;
+}
+
+void ConcurrentMemoryPool::deallocate(void* ptr) {
+    if (!ptr || !ownsPointer(ptr)) {
+        return;
+    }
+
+    const uint32_t index = indexOf(ptr);
+    ThreadCache* cache = currentCache();
+    if (!cache) {
+        header(index)->next = kNil;
+        pushBatch(index, 1);
+        uncached_allocated_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (cache->count == kCacheCapacity) {
+        spill(*cache, kMagazineSize);
+    }
+    cache->blocks[cache->count++] = index;
+    recordAllocation(*cache, -1);
+}
+
+size_t ConcurrentMemoryPool::getAllocatedBlocks() const {
+    int64_t total = uncached_allocated_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kMaxThreadCaches; ++i) {
+        total += caches_[i].allocated.load(std::memory_order_relaxed);
+    }
+    return total > 0 ? static_cast<size_t>(total) : 0;
+}
+
+size_t ConcurrentMemoryPool::getTotalAllocated() const {
+    return getAllocatedBlocks() * block_size_;
+}
+
+size_t ConcurrentMemoryPool::getPeakAllocated() const {
+    return static_cast<size_t>(peak_outstanding_.load(std::memory_order_relaxed)) * block_size_;
+}
+
+void ConcurrentMemoryPool::resetStats() {
+    peak_outstanding_.store(outstanding_blocks_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (size_t i = 0; i < kMaxThreadCaches; ++i) {
+        const int64_t current = caches_[i].allocated.load(std::memory_order_relaxed);
+        caches_[i].peak.store(std::max<int64_t>(current, 0), std::memory_order_relaxed);
+    }
+}
+
+size_t ConcurrentMemoryPool::getThreadAllocated() const {
+    const ThreadCache* cache = currentCache();
+    if (!cache) return 0;
+    const int64_t allocated = cache->allocated.load(std::memory_order_relaxed);
+    return allocated > 0 ? static_cast<size_t>(allocated) * block_size_ : 0;
+}
+
+size_t ConcurrentMemoryPool::getThreadPeakAllocated() const {
+    const ThreadCache* cache = currentCache();
+    return cache ? static_cast<size_t>(cache->peak.load(std::memory_order_relaxed)) * block_size_ : 0;
+}
+
+void ConcurrentMemoryPool::flushThreadCache() {
+    ThreadCache* cache = currentCache();
+    if (!cache) return;
+    while (cache->count > 0) {
+        spill(*cache, std::min(cache->count, kMagazineSize));
+    }
+}
+
+bool ConcurrentMemoryPool::ownsPointer(const void* ptr) const {
+    if (!ptr || !buffer_) return false;
+
+    const uint8_t* byte_ptr = static_cast<const uint8_t*>(ptr);
+    if (byte_ptr < buffer_ || byte_ptr >= buffer_ + buffer_size_) {
+        return false;
+    }
+
+    // Check if pointer is at a valid block boundary
+    return (static_cast<size_t>(byte_ptr - buffer_) % block_size_) == 0;
+}
+
+uint32_t ConcurrentMemoryPool::popBatch() {
+    uint64_t head = global_head_.load(std::memory_order_acquire);
+    uint32_t index;
+    while (true) {
+        index = static_cast<uint32_t>(head);
+        if (index == kNil) {
+            return kNil;
+        }
+        // The block may already have been popped and reused by another thread;
+        // the tag then no longer matches and the CAS below fails
+        const uint32_t next = std::atomic_ref<uint32_t>(header(index)->next_batch).load(std::memory_order_relaxed);
+        const uint64_t desired = (((head >> 32) + 1) << 32) | next;
+        if (global_head_.compare_exchange_weak(head, desired,
+                                               std::memory_order_acquire,
+                                               std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    const int64_t count = header(index)->count;
+    const int64_t outstanding = outstanding_blocks_.fetch_add(count, std::memory_order_relaxed) + count;
+    int64_t peak = peak_outstanding_.load(std::memory_order_relaxed);
+    while (outstanding > peak &&
+           !peak_outstanding_.compare_exchange_weak(peak, outstanding, std::memory_order_relaxed)) {
+    }
+    return index;
+}
+
+void ConcurrentMemoryPool::pushBatch(uint32_t first, uint32_t count) {
+    FreeHeader* batch = header(first);
+    batch->count = count;
+
+    uint64_t head = global_head_.load(std::memory_order_relaxed);
+    uint64_t desired;
+    do {
+        std::atomic_ref<uint32_t>(batch->next_batch).store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        desired = (((head >> 32) + 1) << 32) | first;
+    } while (!global_head_.compare_exchange_weak(head, desired,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+
+    outstanding_blocks_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void ConcurrentMemoryPool::refill(ThreadCache& cache) {
+    const uint32_t first = popBatch();
+    if (first == kNil) {
+        return;
+    }
+
+    // Magazines never exceed kMagazineSize, and refill only runs on an empty cache
+    uint32_t index = first;
+    const uint32_t count = header(first)->count;
+    for (uint32_t i = 0; i < count; ++i) {
+        cache.blocks[cache.count++] = index;
+        index = header(index)->next;
+    }
+}
+
+void ConcurrentMemoryPool::spill(ThreadCache& cache, uint32_t count) {
+    // Return the oldest (coldest) entries and keep the recently freed ones
+    for (uint32_t i = 0; i + 1 < count; ++i) {
+        header(cache.blocks[i])->next = cache.blocks[i + 1];
+    }
+    header(cache.blocks[count - 1])->next = kNil;
+    pushBatch(cache.blocks[0], count);
+
+    std::copy(cache.blocks + count, cache.blocks + cache.count, cache.blocks);
+    cache.count -= count;
+}
+
+void ConcurrentMemoryPool::recordAllocation(ThreadCache& cache, int64_t delta) {
+    const int64_t allocated = cache.allocated.load(std::memory_order_relaxed) + delta;
+    cache.allocated.store(allocated, std::memory_order_relaxed);
+    if (allocated > cache.peak.load(std::memory_order_relaxed)) {
+        cache.peak.store(allocated, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentMemoryPool::ThreadCache* ConcurrentMemoryPool::currentCache() const {
+    const int slot = currentThreadSlot();
+    return slot >= 0 ? &caches_[static_cast<size_t>(slot)] : nullptr;
+}
+
+} // namespace PyNovaGE
@@ -0,0 +1,147 @@
+#include "memory/frame_allocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace PyNovaGE {
+
+namespace {
+
+constexpr size_t kBufferAlignment = 64;
+
+std::atomic<uint64_t> g_frame_index{0};
+
+uint8_t* allocateAligned(size_t size, size_t alignment) {
+    size = (size + alignment - 1) & ~(alignment - 1);
+#ifdef _WIN32
+    return static_cast<uint8_t*>(_aligned_malloc(size, alignment));
+#else
+    return static_cast<uint8_t*>(std::aligned_alloc(alignment, size));
+#endif
+}
+
+void freeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+} // anonymous namespace
+
+FrameAllocator::FrameAllocator(size_t buffer_size) {
+    buffer_size = std::max(buffer_size, kBufferAlignment);
+    for (auto& buffer : buffers_) {
+        buffer.data = allocateAligned(buffer_size, kBufferAlignment);
+        if (!buffer.data) {
+            throw std::bad_alloc();
+        }
+        buffer.size = buffer_size;
+    }
+}
+
+FrameAllocator::~FrameAllocator() {
+    for (auto& buffer : buffers_) {
+        for (void* ptr : buffer.overflow) {
+            freeAligned(ptr);
+        }
+        freeAligned(buffer.data);
+    }
+}
+
+void* FrameAllocator::allocate(size_t size, size_t alignment) {
+    if (size == 0) return nullptr;
+
+    Buffer& buffer = buffers_[current_];
+    const size_t aligned_offset = (buffer.offset + alignment - 1) & ~(alignment - 1);
+
+    void* ptr;
+    if (alignment <= kBufferAlignment && aligned_offset + size <= buffer.size) {
+        ptr = buffer.data + aligned_offset;
+        buffer.offset = aligned_offset + size;
+    } else {
+        // Out of frame memory: fall back to the system, grow at the next reset
+        ptr = allocateAligned(size, std::max(alignment, alignof(std::max_align_t)));
+        if (!ptr) {
+            return nullptr;
+        }
+        buffer.overflow.push_back(ptr);
+        buffer.overflow_bytes += size;
+        ++overflow_count_;
+    }
+
+    total_allocated_ += size;
+    peak_usage_ = std::max(peak_usage_, getCurrentUsage());
+    return ptr;
+}
+
+void FrameAllocator::beginFrame() {
+    current_ ^= 1;
+    resetBuffer(buffers_[current_]);
+}
+
+size_t FrameAllocator::getCurrentUsage() const {
+    const Buffer& buffer = buffers_[current_];
+    return buffer.offset + buffer.overflow_bytes;
+}
+
+void FrameAllocator::advanceFrame() {
+    g_frame_index.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t FrameAllocator::getFrameIndex() {
+    return g_frame_index.load(std::memory_order_relaxed);
+}
+
+FrameAllocator& FrameAllocator::threadLocal() {
+    thread_local FrameAllocator allocator;
+    allocator.syncToFrame(g_frame_index.load(std::memory_order_relaxed));
+    return allocator;
+}
+
+void FrameAllocator::resetBuffer(Buffer& buffer) {
+    if (!buffer.overflow.empty()) {
+        for (void* ptr : buffer.overflow) {
+            freeAligned(ptr);
+        }
+        buffer.overflow.clear();
+
+        // Size the buffer so the same workload fits next time
+        const size_t new_size = std::max(buffer.size * 2, buffer.offset + buffer.overflow_bytes);
+        if (uint8_t* data = allocateAligned(new_size, kBufferAlignment)) {
+            freeAligned(buffer.data);
+            buffer.data = data;
+            buffer.size = new_size;
+        }
+    }
+
+    buffer.offset = 0;
+    buffer.overflow_bytes = 0;
+}
+
+void FrameAllocator::syncToFrame(uint64_t frame) {
+    if (frame == frame_index_) return;
+
+    // A thread idle for several frames has nothing live in either buffer
+    beginFrame();
+    if (frame - frame_index_ > 1) {
+        beginFrame();
+    }
+    frame_index_ = frame;
+}
+
+void* FrameAllocator::Resource::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr = owner_.allocate(bytes == 0 ? 1 : bytes, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace PyNovaGE
@@ -0,0 +1,306 @@
+#include "memory/memory_tracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#if PYNOVAGE_MEMORY_TRACKING
+    #include <array>
+    #include <atomic>
+    #include <mutex>
+
+    #if defined(_WIN32)
+        #ifndef WIN32_LEAN_AND_MEAN
+            #define WIN32_LEAN_AND_MEAN
+        #endif
+        #ifndef NOMINMAX
+            #define NOMINMAX
+        #endif
+        #include <windows.h>
+    #elif defined(__GLIBC__) || defined(__APPLE__)
+        #include <execinfo.h>
+        #define PYNOVAGE_HAS_EXECINFO 1
+    #endif
+#endif
+
+namespace PyNovaGE {
+
+#if PYNOVAGE_MEMORY_TRACKING
+
+namespace {
+
+constexpr size_t kTagCount = static_cast<size_t>(MemoryTag::Count);
+
+struct TagCounters {
+    std::atomic<size_t> current_bytes{0};
+    std::atomic<size_t> peak_bytes{0};
+    std::atomic<size_t> total_allocations{0};
+    std::atomic<size_t> live_allocations{0};
+};
+
+struct CallstackSample {
+    MemoryTag tag;
+    size_t bytes;
+    size_t frame_count;
+    void* frames[MemoryTracker::kMaxSampledFrames];
+};
+
+struct TrackerState {
+    std::array<TagCounters, kTagCount> tags;
+
+    std::atomic<uint32_t> sample_rate{0};
+    std::atomic<uint64_t> sample_counter{0};
+
+    std::mutex sample_mutex;
+    std::array<CallstackSample, MemoryTracker::kMaxSamples> samples;
+    size_t next_sample = 0;
+    size_t sample_count = 0;
+};
+
+TrackerState& state() {
+    static TrackerState instance;
+    return instance;
+}
+
+size_t captureCallstack(void** frames, size_t max_frames) {
+#if defined(_WIN32)
+    return CaptureStackBackTrace(2, static_cast<DWORD>(max_frames), frames, nullptr);
+#elif defined(PYNOVAGE_HAS_EXECINFO)
+    const int count = backtrace(frames, static_cast<int>(max_frames));
+    return count > 0 ? static_cast<size_t>(count) : 0;
+#else
+    (void)frames;
+    (void)max_frames;
+    return 0;
+#endif
+}
+
+void sampleCallstack(TrackerState& tracker, MemoryTag tag, size_t bytes) {
+    CallstackSample sample;
+    sample.tag = tag;
+    sample.bytes = bytes;
+    sample.frame_count = captureCallstack(sample.frames, MemoryTracker::kMaxSampledFrames);
+
+    std::lock_guard<std::mutex> lock(tracker.sample_mutex);
+    tracker.samples[tracker.next_sample] = sample;
+    tracker.next_sample = (tracker.next_sample + 1) % MemoryTracker::kMaxSamples;
+    tracker.sample_count = std::min(tracker.sample_count + 1, MemoryTracker::kMaxSamples);
+}
+
+void addBytes(std::atomic<size_t>& current_bytes, std::atomic<size_t>& peak_bytes, size_t bytes) {
+    const size_t current = current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+} // anonymous namespace
+
+void MemoryTracker::recordAllocation(MemoryTag tag, size_t bytes) {
+    TrackerState& tracker = state();
+    TagCounters& counters = tracker.tags[static_cast<size_t>(tag)];
+
+    addBytes(counters.current_bytes, counters.peak_bytes, bytes);
+    counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (const uint32_t rate = tracker.sample_rate.load(std::memory_order_relaxed); rate != 0) {
+        if (tracker.sample_counter.fetch_add(1, std::memory_order_relaxed) % rate == 0) {
+            sampleCallstack(tracker, tag, bytes);
+        }
+    }
+}
+
+void MemoryTracker::recordDeallocation(MemoryTag tag, size_t bytes) {
+    TagCounters& counters = state().tags[static_cast<size_t>(tag)];
+    counters.current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag) {
+    const TagCounters& counters = state().tags[static_cast<size_t>(tag)];
+    MemoryTagStats stats;
+    stats.current_bytes = counters.current_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+    stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+    stats.live_allocations = counters.live_allocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryTracker::resetPeaks() {
+    for (TagCounters& counters : state().tags) {
+        counters.peak_bytes.store(counters.current_bytes.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+    }
+}
+
+void MemoryTracker::setCallstackSampleRate(uint32_t every_n_allocations) {
+    state().sample_rate.store(every_n_allocations, std::memory_order_relaxed);
+}
+
+void MemoryScope::recordAllocation(size_t bytes) {
+    addBytes(current_bytes_, peak_bytes_, bytes);
+    total_allocations_.fetch_add(1, std::memory_order_relaxed);
+    live_allocations_.fetch_add(1, std::memory_order_relaxed);
+    MemoryTracker::recordAllocation(tag_, bytes);
+}
+
+void MemoryScope::recordDeallocation(size_t bytes) {
+    current_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    live_allocations_.fetch_sub(1, std::memory_order_relaxed);
+    MemoryTracker::recordDeallocation(tag_, bytes);
+}
+
+MemoryTagStats MemoryScope::getStats() const {
+    MemoryTagStats stats;
+    stats.current_bytes = current_bytes_.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+    stats.total_allocations = total_allocations_.load(std::memory_order_relaxed);
+    stats.live_allocations = live_allocations_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string MemoryTracker::toJson() {
+    std::string json = "{\"enabled\":true,\"tags\":[";
+    for (size_t i = 0; i < kTagCount; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = getStats(tag);
+        if (i != 0) json += ',';
+        json += "{\"name\":\"";
+        json += getMemoryTagName(tag);
+        json += "\",\"current_bytes\":" + std::to_string(stats.current_bytes);
+        json += ",\"peak_bytes\":" + std::to_string(stats.peak_bytes);
+        json += ",\"total_allocations\":" + std::to_string(stats.total_allocations);
+        json += ",\"live_allocations\":" + std::to_string(stats.live_allocations);
+        json += '}';
+    }
+    json += "],\"samples\":[";
+
+    TrackerState& tracker = state();
+    std::lock_guard<std::mutex> lock(tracker.sample_mutex);
+    // Oldest sample first
+    const size_t first = (tracker.next_sample + kMaxSamples - tracker.sample_count) % kMaxSamples;
+    for (size_t i = 0; i < tracker.sample_count; ++i) {
+        const CallstackSample& sample = tracker.samples[(first + i) % kMaxSamples];
+        if (i != 0) json += ',';
+        json += "{\"tag\":\"";
+        json += getMemoryTagName(sample.tag);
+        json += "\",\"bytes\":" + std::to_string(sample.bytes);
+        json += ",\"frames\":[";
+        for (size_t f = 0; f < sample.frame_count; ++f) {
+            char address[32];
+            std::snprintf(address, sizeof(address), "\"0x%llx\"",
+                          static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(sample.frames[f])));
+            if (f != 0) json += ',';
+            json += address;
+        }
+        json += "]}";
+    }
+    json += "]}";
+    return json;
+}
+
+#else
+
+std::string MemoryTracker::toJson() {
+    return "{\"enabled\":false}";
+}
+
+#endif
+
+bool MemoryTracker::writeJson(const std::string& path) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << toJson();
+    return static_cast<bool>(file);
+}
+
+#if PYNOVAGE_MEMORY_TRACKING
+
+namespace {
+
+// Sits directly in front of the returned block
+struct TrackingHeader {
+    size_t offset;  // Distance from the upstream block to the returned block
+    size_t size;
+};
+
+} // anonymous namespace
+
+void* TrackingAllocator::allocate(size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;
+    }
+
+    // A multiple of the alignment, so the returned block stays aligned
+    const size_t offset = std::max(alignment, sizeof(TrackingHeader));
+    if (size > SIZE_MAX - offset) {
+        return nullptr;
+    }
+
+    auto* base = static_cast<uint8_t*>(upstream_.allocate(size + offset, alignment));
+    if (!base) {
+        return nullptr;
+    }
+
+    uint8_t* ptr = base + offset;
+    *reinterpret_cast<TrackingHeader*>(ptr - sizeof(TrackingHeader)) = {offset, size};
+
+    total_allocated_ += size;
+    peak_allocated_ = std::max(peak_allocated_, total_allocated_);
+    MemoryTracker::recordAllocation(tag_, size);
+    return ptr;
+}
+
+void TrackingAllocator::deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    auto* bytes = static_cast<uint8_t*>(ptr);
+    const TrackingHeader header = *reinterpret_cast<const TrackingHeader*>(bytes - sizeof(TrackingHeader));
+
+    total_allocated_ -= header.size;
+    MemoryTracker::recordDeallocation(tag_, header.size);
+    upstream_.deallocate(bytes - header.offset);
+}
+
+size_t TrackingAllocator::getTotalAllocated() const {
+    return total_allocated_;
+}
+
+size_t TrackingAllocator::getPeakAllocated() const {
+    return peak_allocated_;
+}
+
+void TrackingAllocator::resetStats() {
+    peak_allocated_ = total_allocated_;
+}
+
+#else
+
+void* TrackingAllocator::allocate(size_t size, size_t alignment) {
+    return upstream_.allocate(size, alignment);
+}
+
+void TrackingAllocator::deallocate(void* ptr) {
+    upstream_.deallocate(ptr);
+}
+
+size_t TrackingAllocator::getTotalAllocated() const {
+    return upstream_.getTotalAllocated();
+}
+
+size_t TrackingAllocator::getPeakAllocated() const {
+    return upstream_.getPeakAllocated();
+}
+
+void TrackingAllocator::resetStats() {
+    upstream_.resetStats();
+}
+
+#endif
+
+} // namespace PyNovaGE
@@ -0,0 +1,308 @@
+#include "memory/tlsf_allocator.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace PyNovaGE {
+
+/**
+ * Physical block layout: prev_phys and size precede the payload; the free
+ * list links live in the payload and are only valid while the block is free.
+ * Sizes are payload bytes, always a multiple of kAlignment, so the low bits
+ * carry the free flag.
+ */
+struct TLSFAllocator::BlockHeader {
+    BlockHeader* prev_phys;
+    size_t size;
+    BlockHeader* next_free;
+    BlockHeader* prev_free;
+
+    static constexpr size_t kFreeBit = 1;
+
+    size_t getSize() const { return size & ~(kAlignment - 1); }
+    bool isFree() const { return (size & kFreeBit) != 0; }
+    void setSize(size_t bytes, bool free) { size = bytes | (free ? kFreeBit : 0); }
+
+    uint8_t* payload() { return reinterpret_cast<uint8_t*>(this) + 2 * sizeof(void*); }
+    BlockHeader* nextPhys() { return reinterpret_cast<BlockHeader*>(payload() + getSize()); }
+
+    static BlockHeader* fromPayload(const void* ptr) {
+        return reinterpret_cast<BlockHeader*>(const_cast<uint8_t*>(static_cast<const uint8_t*>(ptr)) - 2 * sizeof(void*));
+    }
+};
+
+namespace {
+
+constexpr size_t kHeaderSize = 2 * sizeof(void*);   // prev_phys + size
+constexpr size_t kMinBlockSize = 2 * sizeof(void*); // Room for the free list links
+constexpr size_t kBufferAlignment = 64;
+
+static_assert(kHeaderSize % TLSFAllocator::kAlignment == 0, "Header must keep payloads aligned");
+
+constexpr size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+TLSFAllocator::TLSFAllocator(size_t capacity)
+    : capacity_(capacity & ~(kAlignment - 1)) {
+
+    if (capacity_ < 2 * kHeaderSize + kMinBlockSize) {
+        throw std::invalid_argument("TLSFAllocator: capacity too small");
+    }
+    if (capacity_ - 2 * kHeaderSize >= (size_t(1) << kFirstLevelMax)) {
+        throw std::invalid_argument("TLSFAllocator: capacity too large");
+    }
+
+#ifdef _WIN32
+    buffer_ = static_cast<uint8_t*>(_aligned_malloc(capacity_, kBufferAlignment));
+#else
+    buffer_ = static_cast<uint8_t*>(std::aligned_alloc(kBufferAlignment, alignUp(capacity_, kBufferAlignment)));
+#endif
+    if (!buffer_) {
+        throw std::bad_alloc();
+    }
+
+    // One free block spanning the buffer, followed by a zero-size used sentinel
+    auto* block = reinterpret_cast<BlockHeader*>(buffer_);
+    block->prev_phys = nullptr;
+    block->setSize(capacity_ - 2 * kHeaderSize, true);
+
+    auto* sentinel = block->nextPhys();
+    sentinel->prev_phys = block;
+    sentinel->setSize(0, false);
+
+    insertFreeBlock(block);
+}
+
+TLSFAllocator::~TLSFAllocator() {
+#ifdef _WIN32
+    _aligned_free(buffer_);
+#else
+    free(buffer_);
+#endif
+}
+
+void* TLSFAllocator::allocate(size_t size, size_t alignment) {
+    if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;
+    }
+
+    const size_t adjusted = alignUp(std::max(size, kMinBlockSize), kAlignment);
+    size_t search = adjusted;
+    if (alignment > kAlignment) {
+        // Room to split off a leading free block and still reach the alignment
+        search += alignment + kHeaderSize + kMinBlockSize;
+    }
+    if (adjusted < size || search >= (size_t(1) << kFirstLevelMax)) {
+        return nullptr;
+    }
+
+    int fl, sl;
+    mappingSearch(search, fl, sl);
+    if (fl >= kFirstLevelCount) {
+        return nullptr;
+    }
+    BlockHeader* block = searchSuitableBlock(fl, sl);
+    if (!block) {
+        return nullptr; // Out of memory (or too fragmented)
+    }
+    removeFreeBlock(block);
+
+    if (alignment > kAlignment) {
+        const uintptr_t payload = reinterpret_cast<uintptr_t>(block->payload());
+        uintptr_t aligned = alignUp(payload, alignment);
+        if (aligned != payload && aligned - payload < kHeaderSize + kMinBlockSize) {
+            aligned = alignUp(payload + kHeaderSize + kMinBlockSize, alignment);
+        }
+
+        if (const size_t gap = aligned - payload; gap != 0) {
+            // The leading gap becomes a free block of its own. Its physical
+            // predecessor is in use: free neighbours are always merged.
+            auto* aligned_block = reinterpret_cast<BlockHeader*>(aligned - kHeaderSize);
+            aligned_block->prev_phys = block;
+            aligned_block->setSize(block->getSize() - gap, false);
+            aligned_block->nextPhys()->prev_phys = aligned_block;
+
+            block->setSize(gap - kHeaderSize, true);
+            insertFreeBlock(block);
+            block = aligned_block;
+        }
+    }
+
+    block = splitBlock(block, adjusted);
+    block->setSize(block->getSize(), false);
+
+    allocated_bytes_ += block->getSize();
+    peak_allocated_ = std::max(peak_allocated_, allocated_bytes_);
+    ++allocation_count_;
+    return block->payload();
+}
+
+void TLSFAllocator::deallocate(void* ptr) {
+    if (!ptr || !ownsPointer(ptr)) {
+        return;
+    }
+
+    BlockHeader* block = BlockHeader::fromPayload(ptr);
+    if (block->isFree()) {
+        return; // Double free
+    }
+
+    allocated_bytes_ -= block->getSize();
+    --allocation_count_;
+
+    block->setSize(block->getSize(), true);
+    insertFreeBlock(mergeWithNeighbours(block));
+}
+
+bool TLSFAllocator::ownsPointer(const void* ptr) const {
+    const uint8_t* byte_ptr = static_cast<const uint8_t*>(ptr);
+    return byte_ptr >= buffer_ + kHeaderSize && byte_ptr < buffer_ + capacity_ - kHeaderSize;
+}
+
+size_t TLSFAllocator::getAllocationSize(const void* ptr) const {
+    if (!ptr || !ownsPointer(ptr)) {
+        return 0;
+    }
+    return BlockHeader::fromPayload(ptr)->getSize();
+}
+
+size_t TLSFAllocator::getLargestFreeBlock() const {
+    if (fl_bitmap_ == 0) {
+        return 0;
+    }
+
+    // The largest block lives in the highest non-empty size class
+    const int fl = std::bit_width(fl_bitmap_) - 1;
+    const int sl = std::bit_width(sl_bitmap_[fl]) - 1;
+
+    size_t largest = 0;
+    for (const BlockHeader* block = free_lists_[fl][sl]; block; block = block->next_free) {
+        largest = std::max(largest, block->getSize());
+    }
+    return largest;
+}
+
+float TLSFAllocator::getFragmentation() const {
+    if (free_bytes_ == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(getLargestFreeBlock()) / static_cast<float>(free_bytes_);
+}
+
+void TLSFAllocator::mappingInsert(size_t size, int& fl, int& sl) {
+    if (size < kSmallBlockSize) {
+        // Small sizes are split linearly into kAlignment-wide classes
+        fl = 0;
+        sl = static_cast<int>(size / (kSmallBlockSize / kSecondLevelCount));
+    } else {
+        const int top_bit = std::bit_width(size) - 1;
+        sl = static_cast<int>(size >> (top_bit - kSecondLevelLog2)) ^ kSecondLevelCount;
+        fl = top_bit - (kFirstLevelShift - 1);
+    }
+}
+
+void TLSFAllocator::mappingSearch(size_t size, int& fl, int& sl) {
+    // Round up to the next class boundary so any block found is large enough
+    if (size >= kSmallBlockSize) {
+        size += (size_t(1) << (std::bit_width(size) - 1 - kSecondLevelLog2)) - 1;
+    }
+    mappingInsert(size, fl, sl);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::searchSuitableBlock(int& fl, int& sl) const {
+    uint32_t sl_map = sl_bitmap_[fl] & (~uint32_t(0) << sl);
+    if (sl_map == 0) {
+        const uint32_t fl_map = fl_bitmap_ & (~uint32_t(0) << (fl + 1));
+        if (fl_map == 0) {
+            return nullptr;
+        }
+        fl = std::countr_zero(fl_map);
+        sl_map = sl_bitmap_[fl];
+    }
+    sl = std::countr_zero(sl_map);
+    return free_lists_[fl][sl];
+}
+
+void TLSFAllocator::insertFreeBlock(BlockHeader* block) {
+    int fl, sl;
+    mappingInsert(block->getSize(), fl, sl);
+
+    BlockHeader*& head = free_lists_[fl][sl];
+    block->prev_free = nullptr;
+    block->next_free = head;
+    if (head) {
+        head->prev_free = block;
+    }
+    head = block;
+
+    fl_bitmap_ |= uint32_t(1) << fl;
+    sl_bitmap_[fl] |= uint32_t(1) << sl;
+    free_bytes_ += block->getSize();
+}
+
+void TLSFAllocator::removeFreeBlock(BlockHeader* block) {
+    int fl, sl;
+    mappingInsert(block->getSize(), fl, sl);
+
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists_[fl][sl] = block->next_free;
+        if (!block->next_free) {
+            sl_bitmap_[fl] &= ~(uint32_t(1) << sl);
+            if (sl_bitmap_[fl] == 0) {
+                fl_bitmap_ &= ~(uint32_t(1) << fl);
+            }
+        }
+    }
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    free_bytes_ -= block->getSize();
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::splitBlock(BlockHeader* block, size_t size) {
+    const size_t block_size = block->getSize();
+    if (block_size < size + kHeaderSize + kMinBlockSize) {
+        return block; // Remainder too small to stand alone
+    }
+
+    auto* remainder = reinterpret_cast<BlockHeader*>(block->payload() + size);
+    remainder->prev_phys = block;
+    remainder->setSize(block_size - size - kHeaderSize, true);
+    remainder->nextPhys()->prev_phys = remainder;
+    block->setSize(size, block->isFree());
+
+    // The block came off a free list, so its successor is in use: nothing to merge
+    insertFreeBlock(remainder);
+    return block;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::mergeWithNeighbours(BlockHeader* block) {
+    BlockHeader* prev = block->prev_phys;
+    if (prev && prev->isFree()) {
+        removeFreeBlock(prev);
+        prev->setSize(prev->getSize() + kHeaderSize + block->getSize(), true);
+        prev->nextPhys()->prev_phys = prev;
+        block = prev;
+    }
+
+    BlockHeader* next = block->nextPhys();
+    if (next->isFree()) {
+        removeFreeBlock(next);
+        block->setSize(block->getSize() + kHeaderSize + next->getSize(), true);
+        block->nextPhys()->prev_phys = block;
+    }
+    return block;
+}
+
+} // namespace PyNovaGE
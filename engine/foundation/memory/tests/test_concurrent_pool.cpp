@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "memory/concurrent_memory_pool.h"
+#include "memory/concurrent_object_pool.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace PyNovaGE;
+
+TEST(ConcurrentMemoryPoolTest, BasicAllocationAndDeallocation) {
+    ConcurrentMemoryPool pool(64, 100);
+
+    EXPECT_EQ(pool.getAllocatedBlocks(), 0);
+    EXPECT_EQ(pool.getFreeBlocks(), 100);
+
+    void* ptr1 = pool.allocate(32);
+    void* ptr2 = pool.allocate(64);
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+    EXPECT_NE(ptr1, ptr2);
+    EXPECT_TRUE(pool.ownsPointer(ptr1));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr1) % 16, 0u);
+    EXPECT_EQ(pool.getAllocatedBlocks(), 2);
+    EXPECT_EQ(pool.getTotalAllocated(), 2 * pool.getBlockSize());
+    EXPECT_EQ(pool.getThreadAllocated(), 2 * pool.getBlockSize());
+
+    EXPECT_EQ(pool.allocate(65), nullptr); // Larger than a block
+
+    pool.deallocate(ptr1);
+    pool.deallocate(ptr2);
+    EXPECT_EQ(pool.getAllocatedBlocks(), 0);
+    EXPECT_EQ(pool.getFreeBlocks(), 100);
+    EXPECT_EQ(pool.getThreadPeakAllocated(), 2 * pool.getBlockSize());
+}
+
+TEST(ConcurrentMemoryPoolTest, ExhaustsAndRecovers) {
+    ConcurrentMemoryPool pool(32, 70);
+
+    std::vector<void*> blocks;
+    while (void* ptr = pool.allocate(32)) {
+        blocks.push_back(ptr);
+    }
+    EXPECT_EQ(blocks.size(), 70u);
+    EXPECT_EQ(pool.getFreeBlocks(), 0);
+    EXPECT_EQ(std::set<void*>(blocks.begin(), blocks.end()).size(), 70u);
+
+    for (void* ptr : blocks) pool.deallocate(ptr);
+    pool.flushThreadCache();
+    EXPECT_EQ(pool.getAllocatedBlocks(), 0);
+
+    // Everything is back in the global list and can be handed out again
+    blocks.clear();
+    while (void* ptr = pool.allocate(32)) {
+        blocks.push_back(ptr);
+    }
+    EXPECT_EQ(blocks.size(), 70u);
+    for (void* ptr : blocks) pool.deallocate(ptr);
+}
+
+TEST(ConcurrentMemoryPoolTest, HonorsLargeAlignment) {
+    ConcurrentMemoryPool pool(40, 16, 64);
+    EXPECT_EQ(pool.getBlockSize(), 64u);
+
+    void* ptr = pool.allocate(40, 64);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+    EXPECT_EQ(pool.allocate(8, 128), nullptr);
+    pool.deallocate(ptr);
+
+    EXPECT_THROW(ConcurrentMemoryPool(32, 4, 48), std::invalid_argument);
+}
+
+TEST(ConcurrentMemoryPoolTest, ConcurrentAllocationsAreUnique) {
+    constexpr int kThreads = 8;
+    constexpr size_t kPerThread = 500;
+    // Headroom for blocks parked in other threads' caches
+    constexpr size_t kHeadroom = kThreads * ConcurrentMemoryPool::kMagazineSize * 2;
+    ConcurrentMemoryPool pool(sizeof(uint64_t), kThreads * kPerThread + kHeadroom);
+
+    std::vector<std::vector<void*>> per_thread(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 20; ++round) {
+                auto& mine = per_thread[static_cast<size_t>(t)];
+                for (size_t i = 0; i < kPerThread; ++i) {
+                    auto* value = static_cast<uint64_t*>(pool.allocate(sizeof(uint64_t)));
+                    ASSERT_NE(value, nullptr);
+                    *value = (static_cast<uint64_t>(t) << 32) | i;
+                    mine.push_back(value);
+                }
+                // Verify no other thread was handed the same block
+                for (size_t i = 0; i < mine.size(); ++i) {
+                    ASSERT_EQ(*static_cast<uint64_t*>(mine[i]), (static_cast<uint64_t>(t) << 32) | i);
+                }
+                if (round + 1 < 20) {
+                    for (void* ptr : mine) pool.deallocate(ptr);
+                    mine.clear();
+                    pool.flushThreadCache();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::set<void*> unique;
+    for (const auto& mine : per_thread) unique.insert(mine.begin(), mine.end());
+    EXPECT_EQ(unique.size(), static_cast<size_t>(kThreads) * kPerThread);
+    EXPECT_EQ(pool.getAllocatedBlocks(), static_cast<size_t>(kThreads) * kPerThread);
+    EXPECT_LE(pool.getTotalAllocated(), pool.getPeakAllocated());
+}
+
+TEST(ConcurrentMemoryPoolTest, CrossThreadFrees) {
+    ConcurrentMemoryPool pool(64, 4096);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 2000; ++i) {
+        blocks.push_back(pool.allocate(64));
+    }
+
+    // A different thread frees everything the main thread allocated
+    std::thread consumer([&] {
+        for (void* ptr : blocks) pool.deallocate(ptr);
+        EXPECT_EQ(pool.getThreadAllocated(), 0u);
+        pool.flushThreadCache();
+    });
+    consumer.join();
+
+    EXPECT_EQ(pool.getAllocatedBlocks(), 0);
+    EXPECT_EQ(pool.getFreeBlocks(), 4096);
+}
+
+struct PooledMesh {
+    int id;
+    std::vector<float> vertices;
+    static std::atomic<int> live;
+
+    explicit PooledMesh(int i) : id(i), vertices(8, static_cast<float>(i)) { ++live; }
+    ~PooledMesh() { --live; }
+};
+std::atomic<int> PooledMesh::live{0};
+
+TEST(ConcurrentObjectPoolTest, AcquireReleaseAcrossThreads) {
+    ConcurrentObjectPool<PooledMesh> pool(4000);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<PooledMesh*> meshes;
+            for (int i = 0; i < 5000; ++i) {
+                PooledMesh* mesh = pool.acquire(t * 10000 + i);
+                if (!mesh || mesh->vertices[0] != static_cast<float>(t * 10000 + i)) {
+                    ++failures;
+                    continue;
+                }
+                meshes.push_back(mesh);
+                if (meshes.size() > 200) {
+                    for (auto* m : meshes) pool.release(m);
+                    meshes.clear();
+                }
+            }
+            for (auto* m : meshes) pool.release(m);
+            pool.flushThreadCache();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(PooledMesh::live.load(), 0);
+    EXPECT_EQ(pool.getAllocatedCount(), 0u);
+    EXPECT_EQ(pool.getFreeCount(), 4000u);
+    EXPECT_GT(pool.getPeakAllocated(), 0u);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "memory/frame_allocator.h"
+
+#include <cstring>
+#include <thread>
+
+using namespace PyNovaGE;
+
+TEST(FrameAllocatorTest, AllocationsSurviveOneFrame) {
+    FrameAllocator allocator(4096);
+
+    auto* previous = static_cast<int*>(allocator.allocate(sizeof(int) * 16));
+    ASSERT_NE(previous, nullptr);
+    for (int i = 0; i < 16; ++i) previous[i] = i;
+    EXPECT_EQ(allocator.getCurrentUsage(), sizeof(int) * 16);
+
+    // Next frame writes to the other buffer; last frame's data is intact
+    allocator.beginFrame();
+    EXPECT_EQ(allocator.getCurrentUsage(), 0u);
+    void* current = allocator.allocate(sizeof(int) * 16);
+    std::memset(current, 0xFF, sizeof(int) * 16);
+    for (int i = 0; i < 16; ++i) EXPECT_EQ(previous[i], i);
+
+    // Two frames later the first buffer is reused from the start
+    allocator.beginFrame();
+    EXPECT_EQ(allocator.allocate(sizeof(int) * 16), previous);
+}
+
+TEST(FrameAllocatorTest, HonorsAlignment) {
+    FrameAllocator allocator(4096);
+    allocator.allocate(3, 1);
+    void* ptr = allocator.allocate(32, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+}
+
+TEST(FrameAllocatorTest, OverflowGrowsBufferAtReset) {
+    FrameAllocator allocator(1024);
+
+    EXPECT_NE(allocator.allocate(4000), nullptr);
+    EXPECT_EQ(allocator.getOverflowCount(), 1u);
+    EXPECT_EQ(allocator.getCurrentUsage(), 4000u);
+
+    allocator.beginFrame();
+    allocator.beginFrame();
+    EXPECT_GE(allocator.getBufferSize(), 4000u);
+
+    EXPECT_NE(allocator.allocate(4000), nullptr);
+    EXPECT_EQ(allocator.getOverflowCount(), 1u);
+    EXPECT_GE(allocator.getPeakAllocated(), 4000u);
+}
+
+TEST(FrameAllocatorTest, PmrVectorUsesFrameMemory) {
+    FrameAllocator allocator(64 * 1024);
+    std::pmr::vector<int> values(allocator.getMemoryResource());
+    for (int i = 0; i < 1000; ++i) values.push_back(i);
+
+    EXPECT_EQ(values.back(), 999);
+    EXPECT_GE(allocator.getCurrentUsage(), 1000 * sizeof(int));
+    EXPECT_EQ(allocator.getOverflowCount(), 0u);
+}
+
+TEST(FrameAllocatorTest, ThreadLocalFollowsFrameCounter) {
+    FrameAllocator& allocator = FrameAllocator::threadLocal();
+    allocator.allocate(128);
+    EXPECT_GE(allocator.getCurrentUsage(), 128u);
+
+    FrameAllocator::advanceFrame();
+    EXPECT_EQ(&FrameAllocator::threadLocal(), &allocator);
+    EXPECT_EQ(FrameAllocator::threadLocal().getCurrentUsage(), 0u);
+
+    // Each thread has its own allocator
+    FrameAllocator* other = nullptr;
+    std::thread worker([&other] { other = &FrameAllocator::threadLocal(); });
+    worker.join();
+    EXPECT_NE(other, &allocator);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "memory/memory_tracker.h"
+#include "memory/paged_object_pool.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace PyNovaGE;
+
+#if PYNOVAGE_MEMORY_TRACKING
+
+TEST(MemoryTrackerTest, RecordsPerTagCounters) {
+    const MemoryTagStats before = MemoryTracker::getStats(MemoryTag::Audio);
+
+    MemoryTracker::recordAllocation(MemoryTag::Audio, 1000);
+    MemoryTracker::recordAllocation(MemoryTag::Audio, 500);
+    MemoryTracker::recordDeallocation(MemoryTag::Audio, 1000);
+
+    const MemoryTagStats after = MemoryTracker::getStats(MemoryTag::Audio);
+    EXPECT_EQ(after.current_bytes, before.current_bytes + 500);
+    EXPECT_GE(after.peak_bytes, before.current_bytes + 1500);
+    EXPECT_EQ(after.total_allocations, before.total_allocations + 2);
+    EXPECT_EQ(after.live_allocations, before.live_allocations + 1);
+
+    MemoryTracker::recordDeallocation(MemoryTag::Audio, 500);
+    MemoryTracker::resetPeaks();
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Audio).peak_bytes, before.current_bytes);
+}
+
+TEST(MemoryTrackerTest, CountersAreThreadSafe) {
+    const size_t before = MemoryTracker::getStats(MemoryTag::Physics).current_bytes;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10000; ++i) {
+                MemoryTracker::recordAllocation(MemoryTag::Physics, 16);
+            }
+            for (int i = 0; i < 5000; ++i) {
+                MemoryTracker::recordDeallocation(MemoryTag::Physics, 16);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Physics).current_bytes, before + 4 * 5000 * 16);
+}
+
+TEST(MemoryTrackerTest, TrackingAllocatorChargesTag) {
+    SystemAllocator system;
+    TrackingAllocator tracking(system, MemoryTag::Assets);
+    const MemoryTagStats before = MemoryTracker::getStats(MemoryTag::Assets);
+
+    void* a = tracking.allocate(100);
+    void* b = tracking.allocate(300, 64);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    std::memset(a, 0xAA, 100);
+    std::memset(b, 0xBB, 300);
+
+    EXPECT_EQ(tracking.getTotalAllocated(), 400u);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Assets).current_bytes, before.current_bytes + 400);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Assets).live_allocations, before.live_allocations + 2);
+
+    tracking.deallocate(a);
+    tracking.deallocate(b);
+    EXPECT_EQ(tracking.getTotalAllocated(), 0u);
+    EXPECT_EQ(tracking.getPeakAllocated(), 400u);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Assets).current_bytes, before.current_bytes);
+}
+
+TEST(MemoryTrackerTest, PagedObjectPoolReportsSlabs) {
+    const size_t before = MemoryTracker::getStats(MemoryTag::Particles).current_bytes;
+    {
+        PagedObjectPool<int> pool(64, 1000, 0);
+        pool.setMemoryTag(MemoryTag::Particles);
+        for (int i = 0; i < 100; ++i) pool.acquire(i);
+
+        ASSERT_EQ(pool.getSlabCount(), 2u);
+        EXPECT_GE(MemoryTracker::getStats(MemoryTag::Particles).current_bytes,
+                  before + pool.getReservedBytes());
+    }
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Particles).current_bytes, before);
+}
+
+TEST(MemoryTrackerTest, ScopesRollUpIntoTheirTag) {
+    const size_t before = MemoryTracker::getStats(MemoryTag::Renderer).current_bytes;
+    MemoryScope first(MemoryTag::Renderer);
+    MemoryScope second(MemoryTag::Renderer);
+
+    first.recordAllocation(1000);
+    first.recordAllocation(200);
+    second.recordAllocation(50);
+    first.recordDeallocation(1000);
+
+    EXPECT_EQ(first.getStats().current_bytes, 200u);
+    EXPECT_EQ(first.getStats().peak_bytes, 1200u);
+    EXPECT_EQ(first.getStats().total_allocations, 2u);
+    EXPECT_EQ(first.getStats().live_allocations, 1u);
+    EXPECT_EQ(second.getStats().current_bytes, 50u);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Renderer).current_bytes, before + 250);
+
+    // A pool charges its scope, including slabs it already held
+    {
+        PagedObjectPool<int> pool(64, 1000, 0);
+        pool.acquire(0);
+        pool.setMemoryScope(&second);
+        for (int i = 1; i < 100; ++i) pool.acquire(i);
+        EXPECT_EQ(pool.getMemoryTag(), MemoryTag::Renderer);
+        EXPECT_GE(second.getStats().current_bytes, 50u + pool.getReservedBytes());
+    }
+    EXPECT_EQ(second.getStats().current_bytes, 50u);
+
+    first.recordDeallocation(200);
+    second.recordDeallocation(50);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::Renderer).current_bytes, before);
+}
+
+TEST(MemoryTrackerTest, JsonSnapshotContainsTagsAndSamples) {
+    MemoryTracker::setCallstackSampleRate(1);
+    MemoryTracker::recordAllocation(MemoryTag::Scene, 4096);
+    MemoryTracker::setCallstackSampleRate(0);
+
+    const std::string json = MemoryTracker::toJson();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"enabled\":true"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"VoxelMeshing\""), std::string::npos);
+    EXPECT_NE(json.find("{\"tag\":\"Scene\",\"bytes\":4096"), std::string::npos);
+
+    MemoryTracker::recordDeallocation(MemoryTag::Scene, 4096);
+}
+
+#else
+
+TEST(MemoryTrackerTest, CompiledOut) {
+    MemoryTracker::recordAllocation(MemoryTag::General, 1024);
+    EXPECT_EQ(MemoryTracker::getStats(MemoryTag::General).current_bytes, 0u);
+    EXPECT_EQ(MemoryTracker::toJson(), "{\"enabled\":false}");
+
+    MemoryScope scope(MemoryTag::General);
+    scope.recordAllocation(1024);
+    EXPECT_EQ(scope.getStats().current_bytes, 0u);
+
+    SystemAllocator system;
+    TrackingAllocator tracking(system, MemoryTag::General);
+    void* ptr = tracking.allocate(64);
+    EXPECT_EQ(tracking.getTotalAllocated(), system.getTotalAllocated());
+    tracking.deallocate(ptr);
+}
+
+#endif
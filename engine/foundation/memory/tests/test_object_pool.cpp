@@ -79,4 +79,26 @@ TEST(ObjectPoolTest, Clear) {
     pool.clear();
     EXPECT_EQ(pool.getAllocatedCount(), 0);
     EXPECT_EQ(pool.getFreeCount(), 5);
-}
\ No newline at end of file
+}
+
+TEST(ObjectPoolTest, ClearDestroysOnlyLiveObjects) {
+    static int live = 0;
+    struct Counted {
+        Counted() { ++live; }
+        ~Counted() { --live; }
+    };
+
+    ObjectPool<Counted> pool(1000);
+    std::vector<Counted*> objects;
+    for (int i = 0; i < 1000; ++i) {
+        objects.push_back(pool.acquire());
+    }
+    for (size_t i = 0; i < objects.size(); i += 2) {
+        pool.release(objects[i]);
+    }
+    EXPECT_EQ(live, 500);
+
+    pool.clear();
+    EXPECT_EQ(live, 0);
+    EXPECT_EQ(pool.getFreeCount(), 1000);
+}
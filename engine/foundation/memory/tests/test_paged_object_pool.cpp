@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "memory/paged_object_pool.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace PyNovaGE;
+
+namespace {
+
+struct TrackedObject {
+    static int live;
+    int value;
+    std::string name;
+
+    explicit TrackedObject(int v = 0) : value(v), name("object") { ++live; }
+    ~TrackedObject() { --live; }
+};
+int TrackedObject::live = 0;
+
+} // namespace
+
+TEST(PagedObjectPoolTest, GrowsWithoutMovingObjects) {
+    PagedObjectPool<TrackedObject> pool(16);
+    EXPECT_EQ(pool.getSlabCount(), 0u);
+
+    std::vector<TrackedObject*> objects;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(pool.acquire(i));
+        ASSERT_NE(objects.back(), nullptr);
+    }
+
+    EXPECT_EQ(pool.getAllocatedCount(), 100u);
+    EXPECT_EQ(pool.getSlabCount(), 7u);
+    EXPECT_GE(pool.getCapacity(), 100u);
+
+    // Earlier objects are untouched by growth
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(objects[static_cast<size_t>(i)]->value, i);
+        EXPECT_TRUE(pool.ownsPointer(objects[static_cast<size_t>(i)]));
+    }
+
+    for (auto* object : objects) pool.release(object);
+    EXPECT_EQ(pool.getAllocatedCount(), 0u);
+    EXPECT_EQ(TrackedObject::live, 0);
+}
+
+TEST(PagedObjectPoolTest, RespectsMaxObjects) {
+    PagedObjectPool<TrackedObject> pool(8, 20);
+
+    std::vector<TrackedObject*> objects;
+    while (TrackedObject* object = pool.acquire()) {
+        objects.push_back(object);
+    }
+    EXPECT_EQ(objects.size(), 20u);
+    EXPECT_EQ(pool.getFreeCount(), 0u);
+
+    pool.release(objects.back());
+    EXPECT_EQ(pool.getFreeCount(), 1u);
+    EXPECT_NE(pool.acquire(), nullptr);
+    pool.clear();
+}
+
+TEST(PagedObjectPoolTest, ReusesReleasedSlots) {
+    PagedObjectPool<TrackedObject> pool(8);
+
+    TrackedObject* a = pool.acquire(1);
+    TrackedObject* b = pool.acquire(2);
+    pool.release(a);
+    pool.release(a); // Double release is ignored
+    EXPECT_EQ(pool.getAllocatedCount(), 1u);
+
+    TrackedObject* c = pool.acquire(3);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(b->value, 2);
+    pool.clear();
+}
+
+TEST(PagedObjectPoolTest, ForEachLiveVisitsOnlyLiveObjects) {
+    PagedObjectPool<TrackedObject> pool(64);
+
+    std::vector<TrackedObject*> objects;
+    for (int i = 0; i < 500; ++i) {
+        objects.push_back(pool.acquire(i));
+    }
+    for (size_t i = 0; i < objects.size(); i += 3) {
+        pool.release(objects[i]);
+    }
+
+    std::set<int> seen;
+    pool.for_each_live([&seen](TrackedObject& object) { seen.insert(object.value); });
+
+    EXPECT_EQ(seen.size(), pool.getAllocatedCount());
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(seen.count(i) == 1, i % 3 != 0) << "value " << i;
+    }
+
+    const auto& const_pool = pool;
+    size_t count = 0;
+    const_pool.for_each_live([&count](const TrackedObject&) { ++count; });
+    EXPECT_EQ(count, seen.size());
+    pool.clear();
+}
+
+TEST(PagedObjectPoolTest, ClearDestroysEverythingAndTrimsSlabs) {
+    PagedObjectPool<TrackedObject> pool(32, SIZE_MAX, 2);
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.acquire(i);
+    }
+    EXPECT_EQ(TrackedObject::live, 1000);
+    EXPECT_EQ(pool.getSlabCount(), 32u);
+
+    pool.clear();
+    EXPECT_EQ(TrackedObject::live, 0);
+    EXPECT_EQ(pool.getAllocatedCount(), 0u);
+    EXPECT_EQ(pool.getSlabCount(), 2u);
+    EXPECT_EQ(pool.getPeakAllocated(), 1000u);
+
+    // Pool is fully usable after clear
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_NE(pool.acquire(i), nullptr);
+    }
+    EXPECT_EQ(pool.getAllocatedCount(), 100u);
+}
+
+TEST(PagedObjectPoolTest, ReleasesEmptySlabsAboveHighWaterMark) {
+    PagedObjectPool<TrackedObject> pool(16, SIZE_MAX, 1);
+
+    std::vector<TrackedObject*> objects;
+    for (int i = 0; i < 64; ++i) {
+        objects.push_back(pool.acquire(i));
+    }
+    EXPECT_EQ(pool.getSlabCount(), 4u);
+
+    // Empty the last two slabs; they go back to the system as they empty
+    for (size_t i = 32; i < 64; ++i) {
+        pool.release(objects[i]);
+    }
+    EXPECT_EQ(pool.getSlabCount(), 2u);
+    EXPECT_FALSE(pool.ownsPointer(objects[40]));
+
+    // Remaining objects are intact
+    for (size_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(objects[i]->value, static_cast<int>(i));
+    }
+
+    pool.setHighWaterMark(4);
+    for (size_t i = 0; i < 32; ++i) {
+        pool.release(objects[i]);
+    }
+    EXPECT_EQ(pool.getSlabCount(), 2u);
+    pool.setHighWaterMark(0);
+    EXPECT_EQ(pool.trim(), 2u);
+    EXPECT_EQ(pool.getSlabCount(), 0u);
+    EXPECT_EQ(pool.getReservedBytes(), 0u);
+}
+
+TEST(PagedObjectPoolTest, TriviallyDestructibleClear) {
+    PagedObjectPool<uint64_t> pool(128);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        *pool.acquire() = i;
+    }
+    pool.clear();
+    EXPECT_EQ(pool.getAllocatedCount(), 0u);
+
+    size_t count = 0;
+    pool.for_each_live([&count](uint64_t&) { ++count; });
+    EXPECT_EQ(count, 0u);
+}
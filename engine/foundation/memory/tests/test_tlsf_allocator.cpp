@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "memory/tlsf_allocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace PyNovaGE;
+
+TEST(TLSFAllocatorTest, BasicAllocationAndDeallocation) {
+    TLSFAllocator allocator(64 * 1024);
+    const size_t initial_free = allocator.getFreeBytes();
+    EXPECT_EQ(allocator.getLargestFreeBlock(), initial_free);
+    EXPECT_FLOAT_EQ(allocator.getFragmentation(), 0.0f);
+
+    void* a = allocator.allocate(100);
+    void* b = allocator.allocate(3000);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_TRUE(allocator.ownsPointer(a));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % TLSFAllocator::kAlignment, 0u);
+    EXPECT_GE(allocator.getAllocationSize(a), 100u);
+    EXPECT_EQ(allocator.getAllocationCount(), 2u);
+    EXPECT_EQ(allocator.getTotalAllocated(), allocator.getAllocationSize(a) + allocator.getAllocationSize(b));
+
+    std::memset(a, 0xAB, 100);
+    std::memset(b, 0xCD, 3000);
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(b); // Double free is ignored
+
+    // Everything merges back into one block
+    EXPECT_EQ(allocator.getAllocationCount(), 0u);
+    EXPECT_EQ(allocator.getTotalAllocated(), 0u);
+    EXPECT_EQ(allocator.getFreeBytes(), initial_free);
+    EXPECT_EQ(allocator.getLargestFreeBlock(), initial_free);
+}
+
+TEST(TLSFAllocatorTest, RejectsInvalidRequests) {
+    TLSFAllocator allocator(4096);
+    EXPECT_EQ(allocator.allocate(0), nullptr);
+    EXPECT_EQ(allocator.allocate(16, 24), nullptr);  // Alignment not a power of two
+    EXPECT_EQ(allocator.allocate(1 << 20), nullptr); // Larger than the heap
+    EXPECT_THROW(TLSFAllocator(16), std::invalid_argument);
+}
+
+TEST(TLSFAllocatorTest, HonorsLargeAlignment) {
+    TLSFAllocator allocator(64 * 1024);
+    std::vector<void*> blocks;
+    for (size_t alignment : {32u, 64u, 256u, 4096u}) {
+        allocator.allocate(24); // Knock the next block off any natural alignment
+        void* ptr = allocator.allocate(200, alignment);
+        ASSERT_NE(ptr, nullptr) << "alignment " << alignment;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+        std::memset(ptr, 0x11, 200);
+        blocks.push_back(ptr);
+    }
+    for (void* ptr : blocks) allocator.deallocate(ptr);
+}
+
+TEST(TLSFAllocatorTest, ReportsFragmentation) {
+    TLSFAllocator allocator(64 * 1024);
+
+    std::vector<void*> blocks;
+    while (void* ptr = allocator.allocate(1024)) {
+        blocks.push_back(ptr);
+    }
+    ASSERT_GT(blocks.size(), 32u);
+
+    // Free every other block: lots of free memory, none of it contiguous
+    for (size_t i = 0; i < blocks.size(); i += 2) {
+        allocator.deallocate(blocks[i]);
+    }
+
+    EXPECT_GT(allocator.getFreeBytes(), 16u * 1024u);
+    EXPECT_LT(allocator.getLargestFreeBlock(), 2048u);
+    EXPECT_GT(allocator.getFragmentation(), 0.9f);
+    EXPECT_EQ(allocator.allocate(2048), nullptr);
+
+    for (size_t i = 1; i < blocks.size(); i += 2) {
+        allocator.deallocate(blocks[i]);
+    }
+    EXPECT_FLOAT_EQ(allocator.getFragmentation(), 0.0f);
+}
+
+TEST(TLSFAllocatorTest, RandomWorkloadKeepsDataIntact) {
+    TLSFAllocator allocator(4 * 1024 * 1024);
+    const size_t initial_free = allocator.getFreeBytes();
+
+    struct Live { uint8_t* ptr; size_t size; uint8_t fill; };
+    std::vector<Live> live;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> size_dist(1, 16 * 1024);
+
+    for (int step = 0; step < 20000; ++step) {
+        if (live.empty() || rng() % 3 != 0) {
+            const size_t size = size_dist(rng);
+            auto* ptr = static_cast<uint8_t*>(allocator.allocate(size, (rng() % 4 == 0) ? 64 : 16));
+            if (!ptr) continue;
+            const uint8_t fill = static_cast<uint8_t>(step);
+            std::memset(ptr, fill, size);
+            live.push_back({ptr, size, fill});
+        } else {
+            const size_t index = rng() % live.size();
+            const Live entry = live[index];
+            ASSERT_TRUE(std::all_of(entry.ptr, entry.ptr + entry.size,
+                                    [&entry](uint8_t b) { return b == entry.fill; }));
+            allocator.deallocate(entry.ptr);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    EXPECT_EQ(allocator.getAllocationCount(), live.size());
+    for (const Live& entry : live) allocator.deallocate(entry.ptr);
+    EXPECT_EQ(allocator.getFreeBytes(), initial_free);
+    EXPECT_GT(allocator.getPeakAllocated(), 0u);
+}
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include "threading/coroutine.hpp"
+
+using namespace PyNovaGE::Threading;
+
+namespace {
+
+Task<int> square_on_pool(ThreadPool& pool, int x) {
+    co_await pool.schedule();
+    co_return x * x;
+}
+
+Task<int> fan_out(ThreadPool& pool, int count) {
+    std::vector<Task<int>> tasks;
+    tasks.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        tasks.push_back(square_on_pool(pool, i));
+    }
+    auto results = co_await when_all(std::move(tasks));
+    int sum = 0;
+    for (int r : results) sum += r;
+    co_return sum;
+}
+
+} // namespace
+
+// Fan-out/fan-in of small jobs through coroutines and when_all
+static void BM_Coroutine_WhenAll(benchmark::State& state) {
+    const auto count = static_cast<int>(state.range(0));
+    ThreadPool pool(0, SchedulingPolicy::WorkStealing);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync_wait(fan_out(pool, count)));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel("Coroutine");
+}
+
+// Same fan-out through enqueue() and futures
+static void BM_Coroutine_FutureBaseline(benchmark::State& state) {
+    const auto count = static_cast<int>(state.range(0));
+    ThreadPool pool(0, SchedulingPolicy::WorkStealing);
+
+    for (auto _ : state) {
+        std::vector<std::future<int>> futures;
+        futures.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            futures.emplace_back(pool.enqueue([i] { return i * i; }));
+        }
+        int sum = 0;
+        for (auto& f : futures) sum += f.get();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel("Futures");
+}
+
+BENCHMARK(BM_Coroutine_WhenAll)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Coroutine_FutureBaseline)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include "threading/task_graph.hpp"
+#include <chrono>
+
+using namespace PyNovaGE::Threading;
+
+namespace {
+
+// Busy-wait for a fixed duration to stand in for a pipeline stage
+std::function<void()> SimulatedStage(double microseconds) {
+    return [microseconds]() {
+        const auto end = std::chrono::steady_clock::now() +
+            std::chrono::duration<double, std::micro>(microseconds);
+        while (std::chrono::steady_clock::now() < end) {}
+    };
+}
+
+// Synthetic 60 Hz frame: roughly the Scene::Update stages plus the
+// voxel/AI/audio work that runs alongside them in the MMO demo
+void BuildFrameGraph(TaskGraph& graph) {
+    auto input      = graph.declare_resource("input");
+    auto transforms = graph.declare_resource("transforms");
+    auto spatial    = graph.declare_resource("spatial");
+    auto bodies     = graph.declare_resource("bodies");
+    auto contacts   = graph.declare_resource("contacts");
+    auto particles  = graph.declare_resource("particles");
+    auto meshes     = graph.declare_resource("meshes");
+    auto ai         = graph.declare_resource("ai");
+    auto audio      = graph.declare_resource("audio");
+    auto draw_list  = graph.declare_resource("draw_list");
+
+    graph.add_job("poll_input",      SimulatedStage(150),  {},                              {input});
+    graph.add_job("ai_update",       SimulatedStage(2500), {input, spatial},                {ai});
+    graph.add_job("transforms",      SimulatedStage(800),  {input, ai},                     {transforms});
+    graph.add_job("spatial_rebuild", SimulatedStage(1200), {transforms},                    {spatial});
+    graph.add_job("broad_phase",     SimulatedStage(900),  {transforms, spatial},           {contacts});
+    graph.add_job("narrow_phase",    SimulatedStage(1100), {contacts},                      {contacts});
+    graph.add_job("solve",           SimulatedStage(1500), {contacts},                      {bodies, transforms});
+    graph.add_job("particles",       SimulatedStage(2000), {},                              {particles});
+    graph.add_job("voxel_remesh_a",  SimulatedStage(2200), {},                              {meshes});
+    graph.add_job("voxel_remesh_b",  SimulatedStage(2200), {meshes},                        {meshes});
+    graph.add_job("audio_mix",       SimulatedStage(700),  {transforms},                    {audio});
+    graph.add_job("build_draw_list", SimulatedStage(900),  {transforms, particles, meshes}, {draw_list});
+}
+
+} // namespace
+
+// Executes the frame graph on a work-stealing pool and reports how close
+// wall time gets to the critical path (the theoretical lower bound)
+static void BM_TaskGraph_Frame60Hz(benchmark::State& state) {
+    const auto policy = static_cast<SchedulingPolicy>(state.range(0));
+    ThreadPool pool(0, policy);
+    TaskGraph graph;
+    BuildFrameGraph(graph);
+    graph.compile();
+
+    double wall = 0.0, critical = 0.0, work = 0.0;
+    for (auto _ : state) {
+        graph.execute(pool);
+        wall += graph.stats().wall_time_ms;
+        critical += graph.stats().critical_path_ms;
+        work += graph.stats().total_work_ms;
+    }
+
+    const double frames = static_cast<double>(state.iterations());
+    state.counters["wall_ms"] = wall / frames;
+    state.counters["critical_path_ms"] = critical / frames;
+    state.counters["serial_work_ms"] = work / frames;
+    state.counters["frame_budget_ms"] = 1000.0 / 60.0;
+    state.counters["parallelism"] = wall > 0.0 ? work / wall : 0.0;
+    state.SetLabel(policy == SchedulingPolicy::WorkStealing ? "WorkStealing" : "SharedQueue");
+}
+
+// Baseline: the same stages run strictly one after another
+static void BM_TaskGraph_Frame60Hz_Serial(benchmark::State& state) {
+    TaskGraph graph;
+    BuildFrameGraph(graph);
+    graph.compile();
+
+    double wall = 0.0, critical = 0.0;
+    for (auto _ : state) {
+        graph.execute_serial();
+        wall += graph.stats().wall_time_ms;
+        critical += graph.stats().critical_path_ms;
+    }
+
+    const double frames = static_cast<double>(state.iterations());
+    state.counters["wall_ms"] = wall / frames;
+    state.counters["critical_path_ms"] = critical / frames;
+    state.counters["frame_budget_ms"] = 1000.0 / 60.0;
+    state.SetLabel("Serial");
+}
+
+// Scheduling overhead of a wide graph of empty jobs
+static void BM_TaskGraph_EmptyJobs(benchmark::State& state) {
+    const auto width = static_cast<int>(state.range(0));
+    ThreadPool pool(0, SchedulingPolicy::WorkStealing);
+    TaskGraph graph;
+
+    auto shared = graph.declare_resource("shared");
+    for (int i = 0; i < width; ++i) {
+        graph.add_job("leaf", []() {}, {shared}, {});
+    }
+    graph.add_job("join", []() {}, {}, {shared});
+    graph.compile();
+
+    for (auto _ : state) {
+        graph.execute(pool);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (width + 1));
+}
+
+BENCHMARK(BM_TaskGraph_Frame60Hz)
+    ->Arg(static_cast<int>(SchedulingPolicy::SharedQueue))
+    ->Arg(static_cast<int>(SchedulingPolicy::WorkStealing))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_TaskGraph_Frame60Hz_Serial)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_TaskGraph_EmptyJobs)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -4,6 +4,8 @@
 #include <numeric>
 #include <chrono>
 #include <random>
+#include <atomic>
+#include <functional>
 
 using namespace PyNovaGE::Threading;
 
@@ -85,7 +87,7 @@ static void BM_ParallelBatch_Updates(benchmark::State& state) {
     ThreadPool pool;
     
     for (auto _ : state) {
-        parallel_batch(objects, batch_size, [work_per_object](const std::vector<int>& batch) {
+        parallel_batch(objects, batch_size, [work_per_object](Span<const int> batch) {
             for (size_t i = 0; i < batch.size(); ++i) {
                 CPUIntensiveWork(work_per_object);
             }
@@ -96,6 +98,57 @@ static void BM_ParallelBatch_Updates(benchmark::State& state) {
     state.SetLabel("ParallelBatch");
 }
 
+// parallel_for on the persistent default pool with automatic chunking
+static void BM_ParallelFor_DefaultPool(benchmark::State& state) {
+    const auto num_objects = static_cast<size_t>(state.range(0));
+    std::vector<float> positions(num_objects, 0.0f);
+    std::vector<float> velocities(num_objects, 1.0f);
+
+    for (auto _ : state) {
+        parallel_for(0, num_objects, [&](size_t i) {
+            positions[i] += velocities[i] * 0.016f;
+        });
+    }
+
+    benchmark::DoNotOptimize(positions.data());
+    state.SetItemsProcessed(state.iterations() * num_objects);
+    state.SetLabel("DefaultPool");
+}
+
+// Same loop with the pool constructed per call, as parallel_for used to do
+static void BM_ParallelFor_TemporaryPool(benchmark::State& state) {
+    const auto num_objects = static_cast<size_t>(state.range(0));
+    std::vector<float> positions(num_objects, 0.0f);
+    std::vector<float> velocities(num_objects, 1.0f);
+
+    for (auto _ : state) {
+        ThreadPool pool;
+        parallel_for(0, num_objects, [&](size_t i) {
+            positions[i] += velocities[i] * 0.016f;
+        }, &pool);
+    }
+
+    benchmark::DoNotOptimize(positions.data());
+    state.SetItemsProcessed(state.iterations() * num_objects);
+    state.SetLabel("TemporaryPool");
+}
+
+// Reduction over an array, e.g. total kinetic energy for sleep heuristics
+static void BM_ParallelReduce_Sum(benchmark::State& state) {
+    const auto num_objects = static_cast<size_t>(state.range(0));
+    std::vector<float> values(num_objects, 0.5f);
+
+    for (auto _ : state) {
+        float total = parallel_reduce(size_t(0), num_objects, 0.0f,
+            [&values](size_t i) { return values[i] * values[i]; },
+            [](float a, float b) { return a + b; });
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_objects);
+    state.SetLabel("ParallelReduce");
+}
+
 // Benchmark thread pool overhead
 static void BM_ThreadPool_Overhead(benchmark::State& state) {
     const auto num_tasks = static_cast<int>(state.range(0));
@@ -165,6 +218,82 @@ static void BM_ParallelObjectCreation(benchmark::State& state) {
     state.SetLabel("ParallelObjectCreation");
 }
 
+// Fine-grained tasks: many tiny fire-and-forget jobs, dominated by scheduling cost.
+// Arg 0 = task count, Arg 1 = SchedulingPolicy
+static void BM_FineGrainedTasks(benchmark::State& state) {
+    const auto num_tasks = static_cast<int>(state.range(0));
+    const auto policy = static_cast<SchedulingPolicy>(state.range(1));
+    ThreadPool pool(0, policy);
+    std::atomic<int> counter{0};
+
+    for (auto _ : state) {
+        for (int i = 0; i < num_tasks; ++i) {
+            pool.submit([&counter]() {
+                CPUIntensiveWork(50);
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        pool.wait_for_all();
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * num_tasks);
+    state.SetLabel(policy == SchedulingPolicy::WorkStealing ? "WorkStealing" : "SharedQueue");
+}
+
+// Fine-grained tasks fanned out from inside a worker (e.g. a physics job
+// splitting its island list), so work-stealing pushes go to the local deque
+static void BM_FineGrainedTasks_FromWorker(benchmark::State& state) {
+    const auto num_tasks = static_cast<int>(state.range(0));
+    const auto policy = static_cast<SchedulingPolicy>(state.range(1));
+    ThreadPool pool(0, policy);
+    std::atomic<int> counter{0};
+
+    for (auto _ : state) {
+        pool.submit([&pool, &counter, num_tasks]() {
+            for (int i = 0; i < num_tasks; ++i) {
+                pool.submit([&counter]() {
+                    CPUIntensiveWork(50);
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+        pool.wait_for_all();
+    }
+
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * num_tasks);
+    state.SetLabel(policy == SchedulingPolicy::WorkStealing ? "WorkStealing" : "SharedQueue");
+}
+
+// Nested spawn: recursive binary fan-out (divide-and-conquer meshing/culling).
+// Arg 0 = tree depth, Arg 1 = SchedulingPolicy
+static void BM_NestedSpawn(benchmark::State& state) {
+    const auto depth = static_cast<int>(state.range(0));
+    const auto policy = static_cast<SchedulingPolicy>(state.range(1));
+    ThreadPool pool(0, policy);
+    std::atomic<int> leaves{0};
+
+    std::function<void(int)> spawn = [&](int level) {
+        if (level == 0) {
+            CPUIntensiveWork(100);
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pool.submit([&spawn, level]() { spawn(level - 1); });
+        pool.submit([&spawn, level]() { spawn(level - 1); });
+    };
+
+    for (auto _ : state) {
+        pool.submit([&spawn, depth]() { spawn(depth); });
+        pool.wait_for_all();
+    }
+
+    benchmark::DoNotOptimize(leaves.load());
+    state.SetItemsProcessed(state.iterations() * (int64_t(1) << depth));
+    state.SetLabel(policy == SchedulingPolicy::WorkStealing ? "WorkStealing" : "SharedQueue");
+}
+
 // Register benchmarks with different object counts (MMO scale)
 BENCHMARK(BM_SingleThreaded_AIUpdates)
     ->RangeMultiplier(2)
@@ -186,6 +315,24 @@ BENCHMARK(BM_ParallelBatch_Updates)
     ->Range(100, 2000)
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_ParallelFor_DefaultPool)
+    ->RangeMultiplier(8)
+    ->Range(1000, 512000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ParallelFor_TemporaryPool)
+    ->RangeMultiplier(8)
+    ->Range(1000, 512000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ParallelReduce_Sum)
+    ->RangeMultiplier(8)
+    ->Range(1000, 512000)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_ThreadPool_Overhead)
     ->RangeMultiplier(2)
     ->Range(1000, 16000)
@@ -196,4 +343,22 @@ BENCHMARK(BM_ParallelObjectCreation)
     ->Range(500, 4000)
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_FineGrainedTasks)
+    ->ArgsProduct({{10000, 100000}, {static_cast<int>(SchedulingPolicy::SharedQueue),
+                                     static_cast<int>(SchedulingPolicy::WorkStealing)}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_FineGrainedTasks_FromWorker)
+    ->ArgsProduct({{10000, 100000}, {static_cast<int>(SchedulingPolicy::SharedQueue),
+                                     static_cast<int>(SchedulingPolicy::WorkStealing)}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_NestedSpawn)
+    ->ArgsProduct({{10, 14}, {static_cast<int>(SchedulingPolicy::SharedQueue),
+                              static_cast<int>(SchedulingPolicy::WorkStealing)}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
\ No newline at end of file
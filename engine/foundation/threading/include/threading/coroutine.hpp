@@ -0,0 +1,434 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "threading/coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "threading/io_thread.hpp"
+#include "threading/thread_pool.hpp"
+
+namespace PyNovaGE {
+namespace Threading {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    // Symmetric transfer back to whoever awaited us; keeps deep await
+    // chains from growing the native stack
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr exception;
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
+
+    T take_result() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*result);
+    }
+
+    std::optional<T> result;
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take_result() {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * Nothing runs until the task is awaited (`co_await std::move(task)`),
+ * passed to when_all(), or driven by sync_wait(). The body runs on
+ * whichever thread resumes it; `co_await pool.schedule()` moves it onto a
+ * ThreadPool worker. A suspended coroutine holds no thread, so nesting
+ * depth is not limited by the number of workers.
+ *
+ * Exceptions thrown by the body are rethrown to the awaiter.
+ */
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : handle_(handle) {}
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { destroy(); }
+
+    bool valid() const { return static_cast<bool>(handle_); }
+    bool done() const { return handle_ && handle_.done(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take_result(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void destroy() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Outcome of a task driven by sync_wait() or when_all()
+ */
+template<typename T>
+struct ResultSlot {
+    std::optional<T> value;
+    std::exception_ptr error;
+};
+
+template<>
+struct ResultSlot<void> {
+    std::exception_ptr error;
+};
+
+/**
+ * @brief Root coroutine that runs a Task to completion and then calls back
+ *
+ * Bridges coroutine completion to non-coroutine waiters. The callback runs
+ * after the frame is suspended for the last time, so it may destroy it.
+ */
+class CompletionTask {
+public:
+    struct promise_type {
+        void (*on_complete)(void*) = nullptr;
+        void* context = nullptr;
+
+        CompletionTask get_return_object() noexcept {
+            return CompletionTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        auto final_suspend() const noexcept {
+            struct Notify {
+                bool await_ready() const noexcept { return false; }
+
+                void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    // Read everything first: the callback may destroy this frame
+                    auto on_complete = handle.promise().on_complete;
+                    void* context = handle.promise().context;
+                    on_complete(context);
+                }
+
+                void await_resume() const noexcept {}
+            };
+            return Notify{};
+        }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    explicit CompletionTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    CompletionTask(CompletionTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CompletionTask(const CompletionTask&) = delete;
+    CompletionTask& operator=(const CompletionTask&) = delete;
+    CompletionTask& operator=(CompletionTask&&) = delete;
+
+    ~CompletionTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    void start(void (*on_complete)(void*), void* context) {
+        handle_.promise().on_complete = on_complete;
+        handle_.promise().context = context;
+        handle_.resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template<typename T>
+CompletionTask complete_into(Task<T> task, ResultSlot<T>& slot) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+        } else {
+            slot.value.emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        slot.error = std::current_exception();
+    }
+}
+
+class SyncWaitEvent {
+public:
+    static void notify(void* self) {
+        auto* event = static_cast<SyncWaitEvent*>(self);
+        // Notify under the lock: the waiter destroys the event once it sees done_
+        std::lock_guard<std::mutex> lock(event->mutex_);
+        event->done_ = true;
+        event->condition_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return done_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool done_ = false;
+};
+
+/**
+ * @brief Counts outstanding when_all() children; the last arrival resumes the parent
+ *
+ * Starts at children + 1 so the parent's own arrival (after starting every
+ * child) decides whether it needs to suspend at all.
+ */
+class WhenAllLatch {
+public:
+    explicit WhenAllLatch(size_t count) : remaining_(count + 1) {}
+
+    static void arrive(void* self) {
+        auto* latch = static_cast<WhenAllLatch*>(self);
+        if (latch->remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            latch->awaiting_.resume();
+        }
+    }
+
+    void set_awaiting(std::coroutine_handle<> awaiting) { awaiting_ = awaiting; }
+
+    /**
+     * @brief Parent's arrival; returns true if children are still running
+     */
+    bool parent_arrive() {
+        return remaining_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+
+private:
+    std::atomic<size_t> remaining_;
+    std::coroutine_handle<> awaiting_;
+};
+
+struct WhenAllAwaiter {
+    std::vector<CompletionTask>& children;
+    WhenAllLatch& latch;
+
+    bool await_ready() const noexcept { return children.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        latch.set_awaiting(awaiting);
+        for (auto& child : children) {
+            child.start(&WhenAllLatch::arrive, &latch);
+        }
+        return latch.parent_arrive();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @brief Await a set of tasks and collect their results in order
+ *
+ * Each task starts on the awaiting thread and runs until its first
+ * suspension; tasks that `co_await pool.schedule()` therefore run
+ * concurrently. The awaiting coroutine resumes on the thread that finishes
+ * the last task. If any task throws, the first exception (by index) is
+ * rethrown after all tasks have completed.
+ */
+template<typename T>
+    requires (!std::is_void_v<T>)
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+    std::vector<detail::ResultSlot<T>> slots(tasks.size());
+    std::vector<detail::CompletionTask> children;
+    children.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        children.push_back(detail::complete_into(std::move(tasks[i]), slots[i]));
+    }
+
+    detail::WhenAllLatch latch(children.size());
+    co_await detail::WhenAllAwaiter{children, latch};
+
+    std::vector<T> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots) {
+        if (slot.error) std::rethrow_exception(slot.error);
+        results.push_back(std::move(*slot.value));
+    }
+    co_return results;
+}
+
+/**
+ * @brief Await a set of void tasks
+ */
+inline Task<void> when_all(std::vector<Task<void>> tasks) {
+    std::vector<detail::ResultSlot<void>> slots(tasks.size());
+    std::vector<detail::CompletionTask> children;
+    children.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        children.push_back(detail::complete_into(std::move(tasks[i]), slots[i]));
+    }
+
+    detail::WhenAllLatch latch(children.size());
+    co_await detail::WhenAllAwaiter{children, latch};
+
+    for (auto& slot : slots) {
+        if (slot.error) std::rethrow_exception(slot.error);
+    }
+}
+
+/**
+ * @brief Run a task to completion, blocking the calling thread
+ *
+ * Entry point from ordinary code (main loop, tests). Must not be called
+ * from a pool worker whose pool the task needs to make progress.
+ */
+template<typename T>
+T sync_wait(Task<T> task) {
+    detail::ResultSlot<T> slot;
+    detail::SyncWaitEvent event;
+    detail::CompletionTask completion = detail::complete_into(std::move(task), slot);
+    completion.start(&detail::SyncWaitEvent::notify, &event);
+    event.wait();
+
+    if (slot.error) std::rethrow_exception(slot.error);
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*slot.value);
+    }
+}
+
+/**
+ * @brief Awaiter returned by async_read_file()
+ *
+ * The read runs on the IoThread; the coroutine is then resumed on the pool
+ * through this node, so no worker blocks on disk access.
+ */
+class FileReadAwaiter final : public TaskNode {
+public:
+    FileReadAwaiter(IoThread& io, ThreadPool& pool, std::string path)
+        : io_(io), pool_(pool), path_(std::move(path)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        awaiting_ = awaiting;
+        io_.submit([this] {
+            try {
+                data_ = read_file_bytes(path_);
+            } catch (...) {
+                error_ = std::current_exception();
+            }
+            pool_.submit_node(this);
+        });
+    }
+
+    std::vector<uint8_t> await_resume() {
+        if (error_) std::rethrow_exception(error_);
+        return std::move(data_);
+    }
+
+    void run() override { awaiting_.resume(); }
+
+private:
+    IoThread& io_;
+    ThreadPool& pool_;
+    std::string path_;
+    std::coroutine_handle<> awaiting_;
+    std::vector<uint8_t> data_;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief Read a whole file without blocking a worker
+ *
+ * `auto bytes = co_await async_read_file(io, pool, "chunk.bin");`
+ * Resumes on `pool`; throws std::runtime_error if the file cannot be read.
+ */
+inline FileReadAwaiter async_read_file(IoThread& io, ThreadPool& pool, std::string path) {
+    return FileReadAwaiter(io, pool, std::move(path));
+}
+
+} // namespace Threading
+} // namespace PyNovaGE
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Threading {
+
+/**
+ * @brief Dedicated thread for blocking I/O
+ *
+ * File reads and other blocking calls run here in submission order, so
+ * they never occupy a ThreadPool worker. Coroutines use it through
+ * async_read_file() in threading/coroutine.hpp and are resumed on a pool
+ * once the data is ready.
+ */
+class IoThread {
+public:
+    IoThread();
+
+    /**
+     * @brief Destructor - finishes queued requests, then joins the thread
+     */
+    ~IoThread();
+
+    IoThread(const IoThread&) = delete;
+    IoThread& operator=(const IoThread&) = delete;
+
+    /**
+     * @brief Queue blocking work to run on the I/O thread
+     * @param work Function to execute; must not throw
+     */
+    void submit(std::function<void()> work);
+
+    /**
+     * @brief Get number of requests waiting to run
+     */
+    size_t pending_requests() const;
+
+private:
+    void worker_loop();
+
+    std::queue<std::function<void()>> requests_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+/**
+ * @brief Read a whole file into memory (blocking)
+ * @throws std::runtime_error if the file cannot be opened or read
+ */
+std::vector<uint8_t> read_file_bytes(const std::string& path);
+
+} // namespace Threading
+} // namespace PyNovaGE
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "threading/thread_pool.hpp"
+
+namespace PyNovaGE {
+namespace Threading {
+
+/**
+ * @brief Timing of the most recent TaskGraph execution
+ */
+struct TaskGraphStats {
+    double wall_time_ms = 0.0;        ///< Submit-to-completion time of the whole graph
+    double critical_path_ms = 0.0;    ///< Longest dependency chain using measured job times
+    double total_work_ms = 0.0;       ///< Sum of all job times (serial cost)
+    size_t job_count = 0;
+    size_t edge_count = 0;
+
+    /**
+     * @brief Achieved parallelism (total work / wall time)
+     */
+    double parallelism() const { return wall_time_ms > 0.0 ? total_work_ms / wall_time_ms : 0.0; }
+};
+
+/**
+ * @brief Dependency graph of jobs executed on a ThreadPool
+ *
+ * Built for the per-frame pipeline: declare jobs once, together with the
+ * resources they read and write, then execute the DAG every frame. Edges are
+ * derived from resource access in declaration order (read-after-write,
+ * write-after-read, write-after-write) and may be added explicitly.
+ *
+ * Execution allocates nothing: each job has a TaskNode, created by
+ * compile(), and an atomic count of unfinished predecessors, and the worker
+ * that finishes a job releases its successors, continuing directly with one
+ * of them.
+ *
+ * A graph must not be modified while executing and execute() must not be
+ * called from one of the pool's own worker threads.
+ */
+class TaskGraph {
+public:
+    using JobId = uint32_t;
+    using ResourceId = uint32_t;
+
+    static constexpr JobId kInvalidJob = ~JobId(0);
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * @brief Register a named resource (e.g. "transforms", "particles")
+     * @return Id to use in job read/write sets; repeated names return the same id
+     */
+    ResourceId declare_resource(const std::string& name);
+
+    /**
+     * @brief Add a job
+     * @param name Debug name
+     * @param func Work to run
+     * @param reads Resources the job reads
+     * @param writes Resources the job writes
+     * @return Job id
+     */
+    JobId add_job(std::string name, std::function<void()> func,
+                  std::initializer_list<ResourceId> reads = {},
+                  std::initializer_list<ResourceId> writes = {});
+
+    /**
+     * @brief Add an explicit edge: `after` waits for `before`
+     */
+    void add_dependency(JobId before, JobId after);
+
+    /**
+     * @brief Resolve resource edges and validate the graph
+     *
+     * Called implicitly by execute() after modification.
+     * @throws std::logic_error if the graph contains a cycle
+     */
+    void compile();
+
+    /**
+     * @brief Run all jobs on the pool and block until they complete
+     *
+     * If a job throws, jobs that have not started yet are skipped (their
+     * successors are still released) and the first exception is rethrown
+     * here once the graph has drained.
+     */
+    void execute(ThreadPool& pool);
+
+    /**
+     * @brief Run all jobs on the calling thread in topological order
+     */
+    void execute_serial();
+
+    /**
+     * @brief Remove all jobs, edges and resources
+     */
+    void clear();
+
+    size_t job_count() const { return jobs_.size(); }
+    const std::string& job_name(JobId id) const { return jobs_[id].name; }
+    const std::vector<JobId>& successors(JobId id) const { return jobs_[id].successors; }
+
+    /**
+     * @brief Measured duration of a job in the last execution
+     */
+    double job_time_ms(JobId id) const { return jobs_[id].duration_ms; }
+
+    /**
+     * @brief Topological order computed by compile()
+     */
+    const std::vector<JobId>& execution_order() const { return topological_order_; }
+
+    /**
+     * @brief Timing of the last execution
+     */
+    const TaskGraphStats& stats() const { return stats_; }
+
+private:
+    struct Job {
+        std::string name;
+        std::function<void()> func;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        std::vector<JobId> explicit_successors;
+        std::vector<JobId> successors;
+        uint32_t predecessor_count = 0;
+        double duration_ms = 0.0;
+    };
+
+    // What execute() submits for a job; preallocated so running a frame does not allocate
+    struct JobNode final : TaskNode {
+        TaskGraph* graph = nullptr;
+        JobId id = kInvalidJob;
+        void run() override { graph->run_job(id); }
+    };
+
+    void run_job(JobId id);
+    double time_job(JobId id);
+    void finish_stats(double wall_time_ms);
+
+    std::vector<Job> jobs_;
+    std::vector<std::string> resource_names_;
+    std::vector<JobId> topological_order_;
+    bool compiled_ = false;
+
+    // Execution state (valid during execute())
+    ThreadPool* pool_ = nullptr;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending_;
+    std::unique_ptr<JobNode[]> nodes_;
+    std::atomic<size_t> remaining_{0};
+    std::mutex done_mutex_;
+    std::condition_variable done_;
+    bool finished_ = false;                 // Set under done_mutex_ by the last job
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;              // First exception thrown by a job, under done_mutex_
+
+    TaskGraphStats stats_;
+    std::vector<double> finish_ms_;         // Scratch for finish_stats(), sized by compile()
+};
+
+} // namespace Threading
+} // namespace PyNovaGE
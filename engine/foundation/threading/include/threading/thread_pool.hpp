@@ -10,10 +10,40 @@
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+
+#include "threading/work_stealing_deque.hpp"
 
 namespace PyNovaGE {
 namespace Threading {
 
+/**
+ * @brief How a ThreadPool distributes tasks to its workers
+ */
+enum class SchedulingPolicy {
+    SharedQueue,   ///< Single mutex-guarded FIFO shared by all workers
+    WorkStealing   ///< Per-worker Chase-Lev deques with randomized stealing
+};
+
+/**
+ * @brief Intrusive task that can be scheduled without any heap allocation
+ *
+ * The submitter owns the node and must keep it alive until every scheduled
+ * run() has returned. The same node may be submitted several times; run()
+ * must then be safe to execute concurrently.
+ */
+class TaskNode {
+public:
+    virtual void run() = 0;
+
+protected:
+    ~TaskNode() = default;
+};
+
+class ScheduleAwaiter;
+
 /**
  * @brief High-performance thread pool for MMO-scale parallel processing
  * 
@@ -28,8 +58,14 @@ public:
     /**
      * @brief Create thread pool with specified number of worker threads
      * @param threads Number of worker threads (0 = auto-detect)
+     * @param policy Task distribution policy (work stealing is opt-in)
+     *
+     * With SchedulingPolicy::WorkStealing, tasks submitted from inside a
+     * worker go to that worker's local deque and idle workers steal from
+     * random victims; tasks submitted from other threads go through a
+     * shared injection queue that workers drain in batches.
      */
-    explicit ThreadPool(size_t threads = 0);
+    explicit ThreadPool(size_t threads = 0, SchedulingPolicy policy = SchedulingPolicy::SharedQueue);
     
     /**
      * @brief Destructor - waits for all tasks to complete
@@ -46,11 +82,51 @@ public:
     auto enqueue(F&& f, Args&&... args) 
         -> std::future<typename std::invoke_result<F, Args...>::type>;
 
+    /**
+     * @brief Submit a fire-and-forget task (no future allocated)
+     * @param f Function to execute
+     */
+    template<class F>
+    void submit(F&& f);
+
+    /**
+     * @brief Submit a caller-owned task node (no allocation in work-stealing mode)
+     * @param node Task to run; must outlive its execution
+     */
+    void submit_node(TaskNode* node);
+
+    /**
+     * @brief Run one queued task on the calling thread, if any is available
+     *
+     * Lets threads that wait on pool work (e.g. parallel_for callers,
+     * including workers running nested loops) help instead of blocking.
+     * @return true if a task was executed
+     */
+    bool try_run_pending_task();
+
+    /**
+     * @brief Awaitable that resumes the awaiting coroutine on a pool worker
+     *
+     * `co_await pool.schedule();` - see threading/coroutine.hpp.
+     */
+    ScheduleAwaiter schedule();
+
     /**
      * @brief Get number of worker threads
      */
     size_t size() const { return workers_.size(); }
 
+    /**
+     * @brief Get the scheduling policy this pool was created with
+     */
+    SchedulingPolicy policy() const { return policy_; }
+
+    /**
+     * @brief Index of the calling worker thread in this pool, or -1 if the
+     * caller is not one of this pool's workers
+     */
+    int current_worker_index() const;
+
     /**
      * @brief Get number of pending tasks
      */
@@ -67,11 +143,47 @@ public:
     bool is_busy() const;
 
 private:
+    using Task = std::function<void()>;
+    class FunctionTask;
+
+    // Per-worker state for work-stealing mode
+    struct WorkerQueue {
+        WorkStealingDeque<TaskNode*> deque;
+        uint32_t rng_state = 0;
+    };
+
+    // Route a type-erased task to the right queue for the active policy
+    void dispatch(Task&& task);
+    void push_node(TaskNode* node);
+
+    // Worker entry points
+    void shared_queue_worker(size_t index);
+    void work_stealing_worker(size_t index);
+
+    // Shared-queue helpers
+    void finish_shared_task();
+
+    // Work-stealing helpers
+    bool try_acquire_task(size_t index, TaskNode*& task);
+    bool try_take_injected(WorkerQueue* local, TaskNode*& task);
+    bool try_steal(size_t index, uint32_t& rng_state, TaskNode*& task);
+    void run_task(TaskNode* task);
+    void notify_sleeping_worker();
+
     // Worker threads
     std::vector<std::thread> workers_;
+    SchedulingPolicy policy_;
     
-    // Task queue
+    // Task queue (shared-queue mode)
     std::queue<std::function<void()>> tasks_;
+
+    // Work-stealing mode: per-worker deques plus injection queue for external submissions
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+    std::vector<TaskNode*> injected_;       // Pending from injected_head_ on; storage reused once drained
+    size_t injected_head_ = 0;
+    std::atomic<size_t> injected_count_;
+    std::atomic<size_t> queued_tasks_;
+    std::atomic<size_t> sleeping_threads_;
     
     // Synchronization
     mutable std::mutex queue_mutex_;
@@ -84,35 +196,139 @@ private:
     std::atomic<size_t> total_tasks_;
 };
 
+/**
+ * @brief Awaiter returned by ThreadPool::schedule()
+ *
+ * Lives in the suspended coroutine's frame and is submitted to the pool as
+ * an intrusive TaskNode, so hopping onto the pool allocates nothing in
+ * work-stealing mode. Written against any coroutine handle type so this
+ * header stays usable from C++17 code.
+ */
+class ScheduleAwaiter final : public TaskNode {
+public:
+    explicit ScheduleAwaiter(ThreadPool& pool) : pool_(pool) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    template<typename Handle>
+    void await_suspend(Handle handle) {
+        handle_ = handle.address();
+        resume_ = [](void* address) { Handle::from_address(address).resume(); };
+        pool_.submit_node(this);
+    }
+
+    void await_resume() const noexcept {}
+
+    void run() override { resume_(handle_); }
+
+private:
+    ThreadPool& pool_;
+    void* handle_ = nullptr;
+    void (*resume_)(void*) = nullptr;
+};
+
+inline ScheduleAwaiter ThreadPool::schedule() {
+    return ScheduleAwaiter(*this);
+}
+
+/**
+ * @brief Process-wide thread pool used when no pool is passed explicitly
+ *
+ * Created on first use with SchedulingPolicy::WorkStealing and kept alive
+ * until exit, so parallel loops never spawn or join threads per call.
+ */
+ThreadPool& default_thread_pool();
+
+/**
+ * @brief Default number of chunks per participating thread in parallel loops
+ *
+ * Oversplitting lets fast threads pick up the slack of slow ones.
+ */
+constexpr size_t kDefaultChunksPerThread = 4;
+
+/**
+ * @brief Non-owning view of a contiguous range (C++17 stand-in for std::span)
+ */
+template<typename T>
+class Span {
+public:
+    Span() = default;
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t index) const { return data_[index]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
 /**
  * @brief Parallel for loop implementation
+ *
+ * The range is split into roughly kDefaultChunksPerThread chunks per
+ * participating thread (never smaller than grain_size). Workers and the
+ * calling thread claim chunks dynamically; no futures or per-chunk tasks
+ * are allocated. The caller helps with queued pool work while it waits,
+ * so nested loops issued from inside pool tasks cannot deadlock.
+ *
  * @param start Start index (inclusive)
  * @param end End index (exclusive)  
  * @param func Function to execute for each index
- * @param pool Thread pool to use (nullptr = create temporary pool)
+ * @param pool Thread pool to use (nullptr = default_thread_pool())
+ * @param grain_size Minimum indices per chunk (0 = automatic)
  */
 template<typename Func>
-void parallel_for(size_t start, size_t end, Func func, ThreadPool* pool = nullptr);
+void parallel_for(size_t start, size_t end, Func func, ThreadPool* pool = nullptr, size_t grain_size = 0);
 
 /**
  * @brief Parallel for each implementation
  * @param container Container to iterate over
  * @param func Function to execute for each element
- * @param pool Thread pool to use (nullptr = create temporary pool)
+ * @param pool Thread pool to use (nullptr = default_thread_pool())
+ * @param grain_size Minimum elements per chunk (0 = automatic)
  */
 template<typename Container, typename Func>
-void parallel_for_each(Container& container, Func func, ThreadPool* pool = nullptr);
+void parallel_for_each(Container& container, Func func, ThreadPool* pool = nullptr, size_t grain_size = 0);
 
 /**
  * @brief Batch parallel execution - optimal for MMO scenarios
+ *
+ * Each batch is passed as a view into `items`; nothing is copied.
+ *
  * @param items Vector of items to process
  * @param batch_size Number of items per batch
- * @param func Function to execute on each batch
- * @param pool Thread pool to use (nullptr = create temporary pool)
+ * @param func Function called with a Span<const T> for each batch
+ * @param pool Thread pool to use (nullptr = default_thread_pool())
  */
 template<typename T, typename Func>
 void parallel_batch(const std::vector<T>& items, size_t batch_size, Func func, ThreadPool* pool = nullptr);
 
+/**
+ * @brief Parallel map-reduce over an index range
+ *
+ * Each chunk folds `map(i)` into a local accumulator starting from
+ * `identity`; chunk results are then combined with `reduce`. Because chunk
+ * results combine in completion order, `reduce` must be associative and
+ * commutative (floating-point sums may differ in the last bits run to run).
+ *
+ * @param start Start index (inclusive)
+ * @param end End index (exclusive)
+ * @param identity Neutral element of `reduce`
+ * @param map Function `T(size_t index)`
+ * @param reduce Function `T(T, T)`
+ * @param pool Thread pool to use (nullptr = default_thread_pool())
+ * @param grain_size Minimum indices per chunk (0 = automatic)
+ * @return Reduced value (identity for an empty range)
+ */
+template<typename T, typename MapFunc, typename ReduceFunc>
+T parallel_reduce(size_t start, size_t end, T identity, MapFunc map, ReduceFunc reduce,
+                  ThreadPool* pool = nullptr, size_t grain_size = 0);
+
 } // namespace Threading
 } // namespace PyNovaGE
 
@@ -131,95 +347,166 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
     );
 
     std::future<return_type> res = task->get_future();
-    
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
+    dispatch([task]() { (*task)(); });
+    return res;
+}
+
+template<class F>
+void ThreadPool::submit(F&& f) {
+    dispatch(Task(std::forward<F>(f)));
+}
+
+namespace detail {
 
-        // Don't allow enqueueing after stopping the pool
-        if (stop_) {
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+/**
+ * @brief One parallel loop: the calling thread plus up to one helper
+ * invocation per worker claim fixed-size chunks from an atomic counter
+ */
+template<typename ChunkFunc>
+class ParallelLoop final : public TaskNode {
+public:
+    ParallelLoop(size_t start, size_t end, size_t chunk_size, ChunkFunc& func)
+        : start_(start), end_(end), chunk_size_(chunk_size),
+          chunk_count_((end - start + chunk_size - 1) / chunk_size),
+          func_(func), next_chunk_(0), helpers_remaining_(0) {}
+
+    void execute(ThreadPool& pool) {
+        const size_t helpers = std::min(pool.size(), chunk_count_ - 1);
+        helpers_remaining_.store(helpers, std::memory_order_relaxed);
+        for (size_t i = 0; i < helpers; ++i) {
+            pool.submit_node(this);
+        }
+
+        process();
+
+        // Helpers reference this stack frame; help with pool work until they retire
+        while (helpers_remaining_.load(std::memory_order_acquire) > 0) {
+            if (!pool.try_run_pending_task()) {
+                std::this_thread::yield();
+            }
         }
 
-        tasks_.emplace([task]() { (*task)(); });
-        ++total_tasks_;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
     }
-    
-    condition_.notify_one();
-    return res;
-}
 
-template<typename Func>
-void parallel_for(size_t start, size_t end, Func func, ThreadPool* pool) {
-    if (start >= end) return;
-    
-    bool owns_pool = false;
-    if (!pool) {
-        pool = new ThreadPool();
-        owns_pool = true;
+    void run() override {
+        process();
+        helpers_remaining_.fetch_sub(1, std::memory_order_release);
     }
-    
-    const size_t range = end - start;
-    const size_t num_threads = std::min(range, pool->size());
-    const size_t chunk_size = range / num_threads;
-    
-    std::vector<std::future<void>> futures;
-    futures.reserve(num_threads);
-    
-    for (size_t i = 0; i < num_threads; ++i) {
-        const size_t chunk_start = start + i * chunk_size;
-        const size_t chunk_end = (i == num_threads - 1) ? end : chunk_start + chunk_size;
-        
-        futures.emplace_back(pool->enqueue([chunk_start, chunk_end, func]() {
-            for (size_t idx = chunk_start; idx < chunk_end; ++idx) {
-                func(idx);
+
+private:
+    void process() {
+        while (true) {
+            const size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunk_count_) {
+                return;
             }
-        }));
-    }
-    
-    // Wait for all chunks to complete
-    for (auto& future : futures) {
-        future.wait();
+            const size_t chunk_start = start_ + chunk * chunk_size_;
+            const size_t chunk_end = std::min(chunk_start + chunk_size_, end_);
+            try {
+                func_(chunk_start, chunk_end);
+            } catch (...) {
+                // Keep the first error, skip remaining chunks, rethrow on the caller
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                if (!error_) error_ = std::current_exception();
+                next_chunk_.store(chunk_count_, std::memory_order_relaxed);
+            }
+        }
     }
-    
-    if (owns_pool) {
-        delete pool;
+
+    const size_t start_;
+    const size_t end_;
+    const size_t chunk_size_;
+    const size_t chunk_count_;
+    ChunkFunc& func_;
+    std::atomic<size_t> next_chunk_;
+    std::atomic<size_t> helpers_remaining_;
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief Chunk size giving ~kDefaultChunksPerThread chunks per participant
+ */
+inline size_t adaptive_chunk_size(size_t range, size_t participants, size_t grain_size) {
+    const size_t target_chunks = std::max<size_t>(1, participants * kDefaultChunksPerThread);
+    const size_t chunk = (range + target_chunks - 1) / target_chunks;
+    return std::max(chunk, std::max<size_t>(grain_size, 1));
+}
+
+/**
+ * @brief Run chunk_func(begin, end) over [start, end) in chunks of chunk_size
+ */
+template<typename ChunkFunc>
+void run_chunked(size_t start, size_t end, size_t chunk_size, ChunkFunc& chunk_func, ThreadPool& pool) {
+    if (end - start <= chunk_size) {
+        chunk_func(start, end);
+        return;
     }
+    ParallelLoop<ChunkFunc> loop(start, end, chunk_size, chunk_func);
+    loop.execute(pool);
+}
+
+} // namespace detail
+
+template<typename Func>
+void parallel_for(size_t start, size_t end, Func func, ThreadPool* pool, size_t grain_size) {
+    if (start >= end) return;
+
+    ThreadPool& target = pool ? *pool : default_thread_pool();
+    const size_t chunk_size = detail::adaptive_chunk_size(end - start, target.size() + 1, grain_size);
+
+    auto chunk_func = [&func](size_t chunk_start, size_t chunk_end) {
+        for (size_t idx = chunk_start; idx < chunk_end; ++idx) {
+            func(idx);
+        }
+    };
+    detail::run_chunked(start, end, chunk_size, chunk_func, target);
 }
 
 template<typename Container, typename Func>
-void parallel_for_each(Container& container, Func func, ThreadPool* pool) {
-    parallel_for(0, container.size(), [&container, func](size_t i) {
+void parallel_for_each(Container& container, Func func, ThreadPool* pool, size_t grain_size) {
+    parallel_for(0, container.size(), [&container, &func](size_t i) {
         func(container[i]);
-    }, pool);
+    }, pool, grain_size);
 }
 
 template<typename T, typename Func>
 void parallel_batch(const std::vector<T>& items, size_t batch_size, Func func, ThreadPool* pool) {
-    bool owns_pool = false;
-    if (!pool) {
-        pool = new ThreadPool();
-        owns_pool = true;
-    }
-    
-    std::vector<std::future<void>> futures;
-    
-    for (size_t start = 0; start < items.size(); start += batch_size) {
-        const size_t end = std::min(start + batch_size, items.size());
-        
-        futures.emplace_back(pool->enqueue([&items, start, end, func]() {
-            std::vector<T> batch(items.begin() + start, items.begin() + end);
-            func(batch);
-        }));
-    }
-    
-    // Wait for all batches to complete
-    for (auto& future : futures) {
-        future.wait();
-    }
-    
-    if (owns_pool) {
-        delete pool;
-    }
+    if (items.empty()) return;
+
+    ThreadPool& target = pool ? *pool : default_thread_pool();
+    const T* data = items.data();
+
+    auto chunk_func = [data, &func](size_t batch_start, size_t batch_end) {
+        func(Span<const T>(data + batch_start, batch_end - batch_start));
+    };
+    detail::run_chunked(0, items.size(), std::max<size_t>(batch_size, 1), chunk_func, target);
+}
+
+template<typename T, typename MapFunc, typename ReduceFunc>
+T parallel_reduce(size_t start, size_t end, T identity, MapFunc map, ReduceFunc reduce,
+                  ThreadPool* pool, size_t grain_size) {
+    if (start >= end) return identity;
+
+    ThreadPool& target = pool ? *pool : default_thread_pool();
+    const size_t chunk_size = detail::adaptive_chunk_size(end - start, target.size() + 1, grain_size);
+
+    T result = identity;
+    std::mutex result_mutex;
+    auto chunk_func = [&](size_t chunk_start, size_t chunk_end) {
+        T local = identity;
+        for (size_t idx = chunk_start; idx < chunk_end; ++idx) {
+            local = reduce(std::move(local), map(idx));
+        }
+        std::lock_guard<std::mutex> lock(result_mutex);
+        result = reduce(std::move(result), std::move(local));
+    };
+    detail::run_chunked(start, end, chunk_size, chunk_func, target);
+
+    return result;
 }
 
 } // namespace Threading  
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace PyNovaGE {
+namespace Threading {
+
+/**
+ * @brief Lock-free Chase-Lev work-stealing deque
+ *
+ * The owning worker pushes and pops at the bottom (LIFO, cache-warm),
+ * while any other thread may steal from the top (FIFO, oldest work first).
+ * Follows the C11 memory model formulation by Le, Pop, Cohen and Zappa Nardelli.
+ *
+ * Only the owner may call push()/pop(); steal() is safe from any thread.
+ * Grown buffers are retired rather than freed so concurrent thieves never
+ * read from released memory; they are reclaimed when the deque is destroyed.
+ *
+ * @tparam T Trivially copyable element type (typically a task pointer)
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires trivially copyable elements");
+
+public:
+    /**
+     * @brief Create a deque
+     * @param initial_capacity Initial ring buffer capacity (rounded up to a power of two)
+     */
+    explicit WorkStealingDeque(size_t initial_capacity = 1024);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Push an element at the bottom (owner only)
+     */
+    void push(T item);
+
+    /**
+     * @brief Pop the most recently pushed element (owner only)
+     * @return true if an element was taken
+     */
+    bool pop(T& out);
+
+    /**
+     * @brief Steal the oldest element (any thread)
+     * @return true if an element was taken; false if empty or lost a race
+     */
+    bool steal(T& out);
+
+    /**
+     * @brief Approximate number of queued elements
+     */
+    size_t size() const;
+
+    /**
+     * @brief Check if the deque appears empty
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Current ring buffer capacity
+     */
+    size_t capacity() const { return static_cast<size_t>(array_.load(std::memory_order_relaxed)->capacity); }
+
+private:
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+
+        explicit Array(int64_t cap)
+            : capacity(cap), mask(cap - 1), buffer(new std::atomic<T>[static_cast<size_t>(cap)]) {}
+
+        T get(int64_t index) const {
+            return buffer[static_cast<size_t>(index & mask)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item) {
+            buffer[static_cast<size_t>(index & mask)].store(item, std::memory_order_relaxed);
+        }
+
+        Array* grow(int64_t bottom, int64_t top) const {
+            Array* grown = new Array(capacity * 2);
+            for (int64_t i = top; i < bottom; ++i) {
+                grown->put(i, get(i));
+            }
+            return grown;
+        }
+    };
+
+    // Separate cache lines: thieves hammer top_, the owner hammers bottom_
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    alignas(64) std::atomic<Array*> array_;
+
+    // Buffers replaced by grow(), owned until destruction (owner thread only)
+    std::vector<std::unique_ptr<Array>> retired_;
+};
+
+} // namespace Threading
+} // namespace PyNovaGE
+
+// Template implementations
+namespace PyNovaGE {
+namespace Threading {
+
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t initial_capacity)
+    : top_(0), bottom_(0), array_(nullptr)
+{
+    int64_t capacity = 2;
+    while (capacity < static_cast<int64_t>(initial_capacity)) {
+        capacity <<= 1;
+    }
+    retired_.emplace_back(new Array(capacity));
+    array_.store(retired_.back().get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+void WorkStealingDeque<T>::push(T item) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+
+    if (bottom - top > array->capacity - 1) {
+        array = array->grow(bottom, top);
+        retired_.emplace_back(array);
+        array_.store(array, std::memory_order_release);
+    }
+
+    array->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::pop(T& out) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // Empty - restore bottom
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    T item = array->get(bottom);
+    if (top == bottom) {
+        // Last element - race against thieves for it
+        const bool won = top_.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        if (!won) {
+            return false;
+        }
+    }
+
+    out = item;
+    return true;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::steal(T& out) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    Array* array = array_.load(std::memory_order_acquire);
+    T item = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    out = item;
+    return true;
+}
+
+template<typename T>
+size_t WorkStealingDeque<T>::size() const {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+} // namespace Threading
+} // namespace PyNovaGE
@@ -0,0 +1,81 @@
+#include "threading/io_thread.hpp"
+#include <fstream>
+#include <stdexcept>
+
+namespace PyNovaGE {
+namespace Threading {
+
+IoThread::IoThread()
+    : thread_(&IoThread::worker_loop, this)
+{
+}
+
+IoThread::~IoThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_one();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void IoThread::submit(std::function<void()> work) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            throw std::runtime_error("submit on stopped IoThread");
+        }
+        requests_.push(std::move(work));
+    }
+    condition_.notify_one();
+}
+
+size_t IoThread::pending_requests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_.size();
+}
+
+void IoThread::worker_loop() {
+    while (true) {
+        std::function<void()> work;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+
+            if (stop_ && requests_.empty()) {
+                return;
+            }
+
+            work = std::move(requests_.front());
+            requests_.pop();
+        }
+
+        work();
+    }
+}
+
+std::vector<uint8_t> read_file_bytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size < 0) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0 && !file.read(reinterpret_cast<char*>(data.data()), size)) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+    return data;
+}
+
+} // namespace Threading
+} // namespace PyNovaGE
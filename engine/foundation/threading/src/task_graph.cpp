@@ -0,0 +1,260 @@
+#include "threading/task_graph.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace PyNovaGE {
+namespace Threading {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void add_unique(std::vector<TaskGraph::JobId>& list, TaskGraph::JobId id) {
+    if (std::find(list.begin(), list.end(), id) == list.end()) {
+        list.push_back(id);
+    }
+}
+
+} // namespace
+
+TaskGraph::ResourceId TaskGraph::declare_resource(const std::string& name) {
+    auto it = std::find(resource_names_.begin(), resource_names_.end(), name);
+    if (it != resource_names_.end()) {
+        return static_cast<ResourceId>(it - resource_names_.begin());
+    }
+    resource_names_.push_back(name);
+    return static_cast<ResourceId>(resource_names_.size() - 1);
+}
+
+TaskGraph::JobId TaskGraph::add_job(std::string name, std::function<void()> func,
+                                    std::initializer_list<ResourceId> reads,
+                                    std::initializer_list<ResourceId> writes) {
+    for (ResourceId r : reads) {
+        if (r >= resource_names_.size()) throw std::out_of_range("TaskGraph: unknown read resource");
+    }
+    for (ResourceId w : writes) {
+        if (w >= resource_names_.size()) throw std::out_of_range("TaskGraph: unknown write resource");
+    }
+
+    Job job;
+    job.name = std::move(name);
+    job.func = std::move(func);
+    job.reads.assign(reads.begin(), reads.end());
+    job.writes.assign(writes.begin(), writes.end());
+    jobs_.push_back(std::move(job));
+
+    compiled_ = false;
+    return static_cast<JobId>(jobs_.size() - 1);
+}
+
+void TaskGraph::add_dependency(JobId before, JobId after) {
+    if (before >= jobs_.size() || after >= jobs_.size()) {
+        throw std::out_of_range("TaskGraph: invalid job id");
+    }
+    if (before == after) {
+        throw std::logic_error("TaskGraph: job cannot depend on itself");
+    }
+    add_unique(jobs_[before].explicit_successors, after);
+    compiled_ = false;
+}
+
+void TaskGraph::compile() {
+    for (auto& job : jobs_) {
+        job.successors = job.explicit_successors;
+        job.predecessor_count = 0;
+    }
+
+    // Derive hazards per resource in declaration order
+    std::vector<JobId> last_writer(resource_names_.size(), kInvalidJob);
+    std::vector<std::vector<JobId>> readers_since_write(resource_names_.size());
+
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        const Job& job = jobs_[id];
+
+        for (ResourceId r : job.reads) {
+            if (last_writer[r] != kInvalidJob && last_writer[r] != id) {
+                add_unique(jobs_[last_writer[r]].successors, id);       // read-after-write
+            }
+            readers_since_write[r].push_back(id);
+        }
+
+        for (ResourceId w : job.writes) {
+            if (last_writer[w] != kInvalidJob && last_writer[w] != id) {
+                add_unique(jobs_[last_writer[w]].successors, id);       // write-after-write
+            }
+            for (JobId reader : readers_since_write[w]) {
+                if (reader != id) {
+                    add_unique(jobs_[reader].successors, id);           // write-after-read
+                }
+            }
+            readers_since_write[w].clear();
+            last_writer[w] = id;
+        }
+    }
+
+    size_t edge_count = 0;
+    for (const auto& job : jobs_) {
+        for (JobId succ : job.successors) {
+            ++jobs_[succ].predecessor_count;
+        }
+        edge_count += job.successors.size();
+    }
+
+    // Kahn's algorithm - validates acyclicity and gives the serial order
+    topological_order_.clear();
+    topological_order_.reserve(jobs_.size());
+    std::vector<uint32_t> in_degree(jobs_.size());
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        in_degree[id] = jobs_[id].predecessor_count;
+        if (in_degree[id] == 0) topological_order_.push_back(id);
+    }
+    for (size_t i = 0; i < topological_order_.size(); ++i) {
+        for (JobId succ : jobs_[topological_order_[i]].successors) {
+            if (--in_degree[succ] == 0) topological_order_.push_back(succ);
+        }
+    }
+    if (topological_order_.size() != jobs_.size()) {
+        throw std::logic_error("TaskGraph: dependency cycle detected");
+    }
+
+    pending_.reset(new std::atomic<uint32_t>[jobs_.size()]);
+    nodes_.reset(new JobNode[jobs_.size()]);
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        nodes_[id].graph = this;
+        nodes_[id].id = id;
+    }
+    finish_ms_.assign(jobs_.size(), 0.0);
+    stats_ = TaskGraphStats{};
+    stats_.job_count = jobs_.size();
+    stats_.edge_count = edge_count;
+    compiled_ = true;
+}
+
+void TaskGraph::execute(ThreadPool& pool) {
+    if (!compiled_) compile();
+    if (jobs_.empty()) return;
+
+    pool_ = &pool;
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        pending_[id].store(jobs_[id].predecessor_count, std::memory_order_relaxed);
+    }
+    remaining_.store(jobs_.size(), std::memory_order_release);
+    finished_ = false;
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+
+    const auto start = Clock::now();
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        if (jobs_[id].predecessor_count == 0) {
+            pool.submit_node(&nodes_[id]);
+        }
+    }
+
+    {
+        // The last job sets finished_ under the lock, so once we see it no
+        // worker touches the graph again and the caller may destroy it
+        std::unique_lock<std::mutex> lock(done_mutex_);
+        done_.wait(lock, [this] { return finished_; });
+    }
+
+    pool_ = nullptr;
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+    finish_stats(elapsed_ms(start, Clock::now()));
+}
+
+void TaskGraph::execute_serial() {
+    if (!compiled_) compile();
+
+    const auto start = Clock::now();
+    for (JobId id : topological_order_) {
+        time_job(id);
+    }
+    finish_stats(elapsed_ms(start, Clock::now()));
+}
+
+void TaskGraph::clear() {
+    jobs_.clear();
+    resource_names_.clear();
+    topological_order_.clear();
+    pending_.reset();
+    nodes_.reset();
+    finish_ms_.clear();
+    stats_ = TaskGraphStats{};
+    compiled_ = false;
+}
+
+void TaskGraph::run_job(JobId id) {
+    while (id != kInvalidJob) {
+        // After a failure the remaining jobs are only drained
+        if (!failed_.load(std::memory_order_relaxed)) {
+            try {
+                time_job(id);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(done_mutex_);
+                if (!error_) error_ = std::current_exception();
+                failed_.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        // Release successors; keep one to run here instead of round-tripping the pool
+        JobId next = kInvalidJob;
+        for (JobId succ : jobs_[id].successors) {
+            if (pending_[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                if (next == kInvalidJob) {
+                    next = succ;
+                } else {
+                    pool_->submit_node(&nodes_[succ]);
+                }
+            }
+        }
+
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Nothing of the graph may be touched after this block
+            std::lock_guard<std::mutex> lock(done_mutex_);
+            finished_ = true;
+            done_.notify_all();
+            return;
+        }
+
+        id = next;
+    }
+}
+
+double TaskGraph::time_job(JobId id) {
+    Job& job = jobs_[id];
+    const auto start = Clock::now();
+    if (job.func) job.func();
+    job.duration_ms = elapsed_ms(start, Clock::now());
+    return job.duration_ms;
+}
+
+void TaskGraph::finish_stats(double wall_time_ms) {
+    // Longest path through the DAG weighted by measured job times
+    std::fill(finish_ms_.begin(), finish_ms_.end(), 0.0);
+    double critical = 0.0;
+    double total = 0.0;
+    for (JobId id : topological_order_) {
+        finish_ms_[id] += jobs_[id].duration_ms;
+        critical = std::max(critical, finish_ms_[id]);
+        total += jobs_[id].duration_ms;
+        for (JobId succ : jobs_[id].successors) {
+            finish_ms_[succ] = std::max(finish_ms_[succ], finish_ms_[id]);
+        }
+    }
+
+    stats_.wall_time_ms = wall_time_ms;
+    stats_.critical_path_ms = critical;
+    stats_.total_work_ms = total;
+}
+
+} // namespace Threading
+} // namespace PyNovaGE
@@ -4,60 +4,84 @@
 namespace PyNovaGE {
 namespace Threading {
 
-ThreadPool::ThreadPool(size_t threads)
-    : stop_(false), busy_threads_(0), total_tasks_(0)
+namespace {
+
+// Identifies the pool (and slot) the current thread works for, so that
+// submissions from inside a task can go straight to the local deque
+thread_local const ThreadPool* t_worker_pool = nullptr;
+thread_local size_t t_worker_index = 0;
+
+// Maximum number of injected tasks a worker moves into its own deque at once
+constexpr size_t kInjectBatchSize = 32;
+
+// Failed steal sweeps before an idle worker goes to sleep
+constexpr int kStealAttemptsBeforeSleep = 4;
+
+uint32_t next_random(uint32_t& state) {
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Steal RNG for threads outside the pool that help via try_run_pending_task()
+thread_local uint32_t t_external_rng = 0x2545F491u;
+
+} // namespace
+
+/**
+ * @brief Heap-allocated wrapper for std::function tasks; deletes itself after running
+ */
+class ThreadPool::FunctionTask final : public TaskNode {
+public:
+    explicit FunctionTask(Task&& task) : task_(std::move(task)) {}
+
+    void run() override {
+        std::unique_ptr<FunctionTask> self(this);
+        task_();
+    }
+
+private:
+    Task task_;
+};
+
+ThreadPool& default_thread_pool() {
+    static ThreadPool pool(0, SchedulingPolicy::WorkStealing);
+    return pool;
+}
+
+ThreadPool::ThreadPool(size_t threads, SchedulingPolicy policy)
+    : policy_(policy), injected_count_(0), queued_tasks_(0), sleeping_threads_(0),
+      stop_(false), busy_threads_(0), total_tasks_(0)
 {
     // Auto-detect optimal thread count if not specified
     if (threads == 0) {
         threads = std::thread::hardware_concurrency();
         if (threads == 0) threads = 4; // Fallback for older systems
     }
-    
+
     // Reserve one thread for main game logic, use rest for parallel tasks
     threads = std::max(size_t(1), threads - 1);
-    
+
     workers_.reserve(threads);
-    
+
+    if (policy_ == SchedulingPolicy::WorkStealing) {
+        worker_queues_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            auto queue = std::make_unique<WorkerQueue>();
+            queue->rng_state = static_cast<uint32_t>(0x9E3779B9u * (i + 1)) | 1u;
+            worker_queues_.push_back(std::move(queue));
+        }
+    }
+
     // Create worker threads
     for (size_t i = 0; i < threads; ++i) {
-        workers_.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-                
-                {
-                    std::unique_lock<std::mutex> lock(queue_mutex_);
-                    
-                    // Wait for task or stop signal
-                    condition_.wait(lock, [this] {
-                        return stop_ || !tasks_.empty();
-                    });
-                    
-                    if (stop_ && tasks_.empty()) {
-                        return; // Exit thread
-                    }
-                    
-                    // Get next task
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                    ++busy_threads_;
-                }
-                
-                // Execute task
-                task();
-                
-                // Mark thread as no longer busy
-                {
-                    std::unique_lock<std::mutex> lock(queue_mutex_);
-                    --busy_threads_;
-                    --total_tasks_;
-                    
-                    // Notify if all tasks completed
-                    if (busy_threads_ == 0 && tasks_.empty()) {
-                        finished_.notify_all();
-                    }
-                }
-            }
-        });
+        if (policy_ == SchedulingPolicy::WorkStealing) {
+            workers_.emplace_back([this, i] { work_stealing_worker(i); });
+        } else {
+            workers_.emplace_back([this, i] { shared_queue_worker(i); });
+        }
     }
 }
 
@@ -66,9 +90,9 @@ ThreadPool::~ThreadPool() {
         std::unique_lock<std::mutex> lock(queue_mutex_);
         stop_ = true;
     }
-    
+
     condition_.notify_all();
-    
+
     for (std::thread &worker : workers_) {
         if (worker.joinable()) {
             worker.join();
@@ -76,22 +100,282 @@ ThreadPool::~ThreadPool() {
     }
 }
 
+void ThreadPool::dispatch(Task&& task) {
+    if (policy_ == SchedulingPolicy::SharedQueue) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+
+            // Don't allow enqueueing after stopping the pool
+            if (stop_) {
+                throw std::runtime_error("enqueue on stopped ThreadPool");
+            }
+
+            tasks_.emplace(std::move(task));
+            ++total_tasks_;
+        }
+
+        condition_.notify_one();
+        return;
+    }
+
+    push_node(new FunctionTask(std::move(task)));
+}
+
+void ThreadPool::submit_node(TaskNode* node) {
+    if (policy_ == SchedulingPolicy::SharedQueue) {
+        dispatch([node]() { node->run(); });
+        return;
+    }
+    push_node(node);
+}
+
+void ThreadPool::push_node(TaskNode* node) {
+    // Submissions from our own workers stay local: no lock, LIFO, cache-warm.
+    // These are allowed during shutdown since the worker drains them itself.
+    if (t_worker_pool == this) {
+        ++total_tasks_;
+        worker_queues_[t_worker_index]->deque.push(node);
+        ++queued_tasks_;
+        notify_sleeping_worker();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+
+        if (stop_) {
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+        }
+
+        injected_.push_back(node);
+        ++injected_count_;
+        ++total_tasks_;
+        ++queued_tasks_;
+    }
+
+    condition_.notify_one();
+}
+
+void ThreadPool::shared_queue_worker(size_t index) {
+    t_worker_pool = this;
+    t_worker_index = index;
+
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+
+            // Wait for task or stop signal
+            condition_.wait(lock, [this] {
+                return stop_ || !tasks_.empty();
+            });
+
+            if (stop_ && tasks_.empty()) {
+                t_worker_pool = nullptr;
+                return; // Exit thread
+            }
+
+            // Get next task
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            ++busy_threads_;
+        }
+
+        // Execute task
+        task();
+
+        finish_shared_task();
+    }
+}
+
+void ThreadPool::finish_shared_task() {
+    // Mark thread as no longer busy
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    --busy_threads_;
+    --total_tasks_;
+
+    // Notify if all tasks completed
+    if (busy_threads_ == 0 && tasks_.empty()) {
+        finished_.notify_all();
+    }
+}
+
+void ThreadPool::work_stealing_worker(size_t index) {
+    t_worker_pool = this;
+    t_worker_index = index;
+
+    int failed_sweeps = 0;
+    while (true) {
+        TaskNode* task = nullptr;
+        if (try_acquire_task(index, task)) {
+            failed_sweeps = 0;
+            run_task(task);
+            continue;
+        }
+
+        // Work may be in flight (e.g. a victim racing us for its last task);
+        // spin a few sweeps before paying for a sleep/wake round trip
+        if (queued_tasks_.load() > 0 && ++failed_sweeps < kStealAttemptsBeforeSleep) {
+            std::this_thread::yield();
+            continue;
+        }
+        failed_sweeps = 0;
+
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        ++sleeping_threads_;
+        condition_.wait(lock, [this] {
+            return stop_ || queued_tasks_.load() > 0;
+        });
+        --sleeping_threads_;
+
+        if (stop_ && queued_tasks_.load() == 0) {
+            t_worker_pool = nullptr;
+            return; // Exit thread
+        }
+    }
+}
+
+bool ThreadPool::try_acquire_task(size_t index, TaskNode*& task) {
+    WorkerQueue& local = *worker_queues_[index];
+
+    // 1. Own deque, newest first
+    if (local.deque.pop(task)) {
+        --queued_tasks_;
+        return true;
+    }
+
+    // 2. Injection queue, then 3. random victims
+    return try_take_injected(&local, task) || try_steal(index, local.rng_state, task);
+}
+
+bool ThreadPool::try_take_injected(WorkerQueue* local, TaskNode*& task) {
+    if (injected_count_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (injected_head_ == injected_.size()) {
+        return false;
+    }
+
+    task = injected_[injected_head_++];
+
+    // Workers also take a fair share to seed their own deque, so the lock is
+    // touched once per batch instead of once per task
+    size_t share = 0;
+    if (local) {
+        share = std::min(kInjectBatchSize, (injected_.size() - injected_head_) / worker_queues_.size());
+        for (size_t i = 0; i < share; ++i) {
+            local->deque.push(injected_[injected_head_++]);
+        }
+    }
+    injected_count_ -= share + 1;
+
+    // Reuse the storage instead of letting the queue allocate as it cycles
+    if (injected_head_ == injected_.size()) {
+        injected_.clear();
+        injected_head_ = 0;
+    } else if (injected_head_ >= kInjectBatchSize && injected_head_ * 2 >= injected_.size()) {
+        injected_.erase(injected_.begin(), injected_.begin() + static_cast<std::ptrdiff_t>(injected_head_));
+        injected_head_ = 0;
+    }
+    --queued_tasks_;
+    return true;
+}
+
+bool ThreadPool::try_steal(size_t index, uint32_t& rng_state, TaskNode*& task) {
+    const size_t count = worker_queues_.size();
+    const size_t start = next_random(rng_state) % count;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t victim = (start + i) % count;
+        if (victim == index) continue;
+        if (worker_queues_[victim]->deque.steal(task)) {
+            --queued_tasks_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_task(TaskNode* task) {
+    ++busy_threads_;
+    task->run();
+    --busy_threads_;
+
+    if (--total_tasks_ == 0) {
+        // Lock so the notification can't slip between a waiter's check and its wait
+        { std::lock_guard<std::mutex> lock(queue_mutex_); }
+        finished_.notify_all();
+    }
+}
+
+bool ThreadPool::try_run_pending_task() {
+    if (policy_ == SchedulingPolicy::SharedQueue) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if (tasks_.empty()) {
+                return false;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            ++busy_threads_;
+        }
+        task();
+        finish_shared_task();
+        return true;
+    }
+
+    TaskNode* task = nullptr;
+    const bool acquired = (t_worker_pool == this)
+        ? try_acquire_task(t_worker_index, task)
+        : (try_take_injected(nullptr, task) || try_steal(worker_queues_.size(), t_external_rng, task));
+    if (!acquired) {
+        return false;
+    }
+    run_task(task);
+    return true;
+}
+
+void ThreadPool::notify_sleeping_worker() {
+    if (sleeping_threads_.load() > 0) {
+        // Taking the lock orders this wake-up after any in-progress predicate check
+        { std::lock_guard<std::mutex> lock(queue_mutex_); }
+        condition_.notify_one();
+    }
+}
+
+int ThreadPool::current_worker_index() const {
+    return t_worker_pool == this ? static_cast<int>(t_worker_index) : -1;
+}
+
 size_t ThreadPool::pending_tasks() const {
+    if (policy_ == SchedulingPolicy::WorkStealing) {
+        return total_tasks_.load();
+    }
     std::lock_guard<std::mutex> lock(queue_mutex_);
     return tasks_.size() + busy_threads_;
 }
 
 void ThreadPool::wait_for_all() {
     std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (policy_ == SchedulingPolicy::WorkStealing) {
+        finished_.wait(lock, [this] { return total_tasks_.load() == 0; });
+        return;
+    }
     finished_.wait(lock, [this] {
         return tasks_.empty() && busy_threads_ == 0;
     });
 }
 
 bool ThreadPool::is_busy() const {
+    if (policy_ == SchedulingPolicy::WorkStealing) {
+        return total_tasks_.load() > 0;
+    }
     std::lock_guard<std::mutex> lock(queue_mutex_);
     return !tasks_.empty() || busy_threads_ > 0;
 }
 
 } // namespace Threading
-} // namespace PyNovaGE
\ No newline at end of file
+} // namespace PyNovaGE
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "threading/task_graph.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace PyNovaGE::Threading;
+
+// Count global heap allocations made while a test has counting enabled.
+// This replaces operator new for the whole binary, so it only lives here.
+namespace {
+std::atomic<bool> g_count_allocations{false};
+std::atomic<size_t> g_allocation_count{0};
+}
+
+void* operator new(std::size_t size) {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+        g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST(TaskGraphAllocationTest, RepeatedExecuteDoesNotAllocate) {
+    ThreadPool pool(4, SchedulingPolicy::WorkStealing);
+    TaskGraph graph;
+    std::atomic<int> runs{0};
+
+    // Fan out and back in, so successors are released from several workers
+    auto root = graph.add_job("root", [&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+    auto sink = graph.add_job("sink", [&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+    for (int i = 0; i < 16; ++i) {
+        auto job = graph.add_job("work", [&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+        graph.add_dependency(root, job);
+        graph.add_dependency(job, sink);
+    }
+    graph.compile();
+
+    // Warm up so the pool's queues have grown to their working size
+    for (int frame = 0; frame < 8; ++frame) {
+        graph.execute(pool);
+        graph.execute_serial();
+    }
+
+    runs = 0;
+    g_allocation_count = 0;
+    g_count_allocations = true;
+    for (int frame = 0; frame < 64; ++frame) {
+        graph.execute(pool);
+        graph.execute_serial();
+    }
+    g_count_allocations = false;
+
+    EXPECT_EQ(runs.load(), 64 * 2 * 18);
+    EXPECT_EQ(g_allocation_count.load(), 0u);
+}
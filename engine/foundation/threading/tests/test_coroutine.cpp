@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "threading/coroutine.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace PyNovaGE::Threading;
+
+namespace {
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<std::thread::id> thread_after_schedule(ThreadPool& pool) {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+// Each level hops onto the pool and then awaits the next level, so a whole
+// chain of suspended coroutines is alive at once
+Task<int> nested_depth(ThreadPool& pool, int depth) {
+    co_await pool.schedule();
+    if (depth == 0) {
+        co_return 0;
+    }
+    const int below = co_await nested_depth(pool, depth - 1);
+    co_return below + 1;
+}
+
+// Binary fan-out through when_all at every level
+Task<int> count_leaves(ThreadPool& pool, int depth) {
+    co_await pool.schedule();
+    if (depth == 0) {
+        co_return 1;
+    }
+    std::vector<Task<int>> children;
+    children.push_back(count_leaves(pool, depth - 1));
+    children.push_back(count_leaves(pool, depth - 1));
+    auto counts = co_await when_all(std::move(children));
+    co_return counts[0] + counts[1];
+}
+
+Task<int> throw_after_schedule(ThreadPool& pool) {
+    co_await pool.schedule();
+    throw std::runtime_error("chunk generation failed");
+}
+
+} // namespace
+
+TEST(CoroutineTest, SyncWaitReturnsValue) {
+    EXPECT_EQ(sync_wait(answer()), 42);
+}
+
+TEST(CoroutineTest, TaskIsLazy) {
+    bool started = false;
+    auto body = [&started]() -> Task<void> {
+        started = true;
+        co_return;
+    };
+    auto task = body();
+
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.done());
+    sync_wait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(CoroutineTest, ScheduleResumesOnWorker) {
+    for (auto policy : {SchedulingPolicy::SharedQueue, SchedulingPolicy::WorkStealing}) {
+        ThreadPool pool(3, policy);
+        EXPECT_NE(sync_wait(thread_after_schedule(pool)), std::this_thread::get_id());
+    }
+}
+
+TEST(CoroutineTest, NestedAwaitsDeeperThanWorkerCount) {
+    ThreadPool pool(2, SchedulingPolicy::WorkStealing);
+    ASSERT_LT(pool.size(), 64u);
+
+    EXPECT_EQ(sync_wait(nested_depth(pool, 64)), 64);
+}
+
+TEST(CoroutineTest, WhenAllFanOutDeeperThanWorkerCount) {
+    for (auto policy : {SchedulingPolicy::SharedQueue, SchedulingPolicy::WorkStealing}) {
+        ThreadPool pool(2, policy);
+        EXPECT_EQ(sync_wait(count_leaves(pool, 8)), 256);
+    }
+}
+
+TEST(CoroutineTest, WhenAllPreservesOrder) {
+    ThreadPool pool(4, SchedulingPolicy::WorkStealing);
+
+    auto square = [&pool](int x) -> Task<int> {
+        co_await pool.schedule();
+        co_return x * x;
+    };
+
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.push_back(square(i));
+    }
+    auto results = sync_wait(when_all(std::move(tasks)));
+
+    ASSERT_EQ(results.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[static_cast<size_t>(i)], i * i);
+    }
+}
+
+TEST(CoroutineTest, WhenAllVoidAndEmpty) {
+    ThreadPool pool(4, SchedulingPolicy::WorkStealing);
+    std::atomic<int> counter{0};
+
+    auto increment = [&]() -> Task<void> {
+        co_await pool.schedule();
+        ++counter;
+    };
+
+    std::vector<Task<void>> tasks;
+    for (int i = 0; i < 500; ++i) {
+        tasks.push_back(increment());
+    }
+    sync_wait(when_all(std::move(tasks)));
+    EXPECT_EQ(counter.load(), 500);
+
+    EXPECT_TRUE(sync_wait(when_all(std::vector<Task<int>>{})).empty());
+}
+
+TEST(CoroutineTest, ExceptionsPropagateToAwaiter) {
+    ThreadPool pool(2, SchedulingPolicy::WorkStealing);
+    EXPECT_THROW(sync_wait(throw_after_schedule(pool)), std::runtime_error);
+
+    std::vector<Task<int>> tasks;
+    tasks.push_back(nested_depth(pool, 3));
+    tasks.push_back(throw_after_schedule(pool));
+    EXPECT_THROW(sync_wait(when_all(std::move(tasks))), std::runtime_error);
+}
+
+TEST(CoroutineTest, AsyncReadFileResumesOnPool) {
+    const std::string path = "coroutine_read_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "voxel chunk payload";
+    }
+
+    ThreadPool pool(2, SchedulingPolicy::WorkStealing);
+    IoThread io;
+
+    auto load = [&]() -> Task<std::vector<uint8_t>> {
+        auto bytes = co_await async_read_file(io, pool, path);
+        EXPECT_GE(pool.current_worker_index(), 0);
+        co_return bytes;
+    };
+
+    auto bytes = sync_wait(load());
+    EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "voxel chunk payload");
+    std::remove(path.c_str());
+
+    auto missing = [&]() -> Task<std::vector<uint8_t>> {
+        co_return co_await async_read_file(io, pool, "does_not_exist.bin");
+    };
+    EXPECT_THROW(sync_wait(missing()), std::runtime_error);
+}
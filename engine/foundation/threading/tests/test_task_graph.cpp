@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "threading/task_graph.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace PyNovaGE::Threading;
+
+namespace {
+
+// Records the order in which jobs finish
+struct Trace {
+    std::mutex mutex;
+    std::vector<TaskGraph::JobId> order;
+
+    std::function<void()> record(TaskGraph::JobId id) {
+        return [this, id] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    }
+
+    size_t position(TaskGraph::JobId id) const {
+        return static_cast<size_t>(std::find(order.begin(), order.end(), id) - order.begin());
+    }
+};
+
+} // namespace
+
+TEST(TaskGraphTest, ExplicitDependenciesAreRespected) {
+    ThreadPool pool(4, SchedulingPolicy::WorkStealing);
+    TaskGraph graph;
+    Trace trace;
+
+    // a -> b -> d, a -> c -> d
+    auto a = graph.add_job("a", trace.record(0));
+    auto b = graph.add_job("b", trace.record(1));
+    auto c = graph.add_job("c", trace.record(2));
+    auto d = graph.add_job("d", trace.record(3));
+    graph.add_dependency(a, b);
+    graph.add_dependency(a, c);
+    graph.add_dependency(b, d);
+    graph.add_dependency(c, d);
+
+    graph.execute(pool);
+
+    ASSERT_EQ(trace.order.size(), 4u);
+    EXPECT_LT(trace.position(a), trace.position(b));
+    EXPECT_LT(trace.position(a), trace.position(c));
+    EXPECT_LT(trace.position(b), trace.position(d));
+    EXPECT_LT(trace.position(c), trace.position(d));
+}
+
+TEST(TaskGraphTest, ResourceAccessDerivesEdges) {
+    TaskGraph graph;
+    auto transforms = graph.declare_resource("transforms");
+    auto particles = graph.declare_resource("particles");
+    auto meshes = graph.declare_resource("meshes");
+    EXPECT_EQ(graph.declare_resource("transforms"), transforms);
+
+    auto update_transforms = graph.add_job("transforms", nullptr, {}, {transforms});
+    auto update_particles = graph.add_job("particles", nullptr, {transforms}, {particles});
+    auto remesh = graph.add_job("remesh", nullptr, {}, {meshes});
+    auto render = graph.add_job("render", nullptr, {transforms, particles, meshes}, {});
+    auto teleport = graph.add_job("teleport", nullptr, {}, {transforms});
+    graph.compile();
+
+    auto has_edge = [&](TaskGraph::JobId from, TaskGraph::JobId to) {
+        const auto& succ = graph.successors(from);
+        return std::find(succ.begin(), succ.end(), to) != succ.end();
+    };
+
+    EXPECT_TRUE(has_edge(update_transforms, update_particles));  // read-after-write
+    EXPECT_TRUE(has_edge(update_particles, render));
+    EXPECT_TRUE(has_edge(remesh, render));
+    EXPECT_TRUE(has_edge(render, teleport));                     // write-after-read
+    EXPECT_TRUE(has_edge(update_particles, teleport));
+    EXPECT_TRUE(has_edge(update_transforms, teleport));          // write-after-write
+
+    // Independent stages may overlap
+    EXPECT_FALSE(has_edge(update_particles, remesh));
+    EXPECT_FALSE(has_edge(remesh, update_particles));
+}
+
+TEST(TaskGraphTest, CycleIsRejected) {
+    TaskGraph graph;
+    auto a = graph.add_job("a", nullptr);
+    auto b = graph.add_job("b", nullptr);
+    graph.add_dependency(a, b);
+    graph.add_dependency(b, a);
+
+    EXPECT_THROW(graph.compile(), std::logic_error);
+    EXPECT_THROW(graph.add_dependency(a, a), std::logic_error);
+}
+
+TEST(TaskGraphTest, ReexecutesEveryFrame) {
+    ThreadPool pool(4);
+    TaskGraph graph;
+    std::atomic<int> counter{0};
+
+    auto state = graph.declare_resource("state");
+    for (int i = 0; i < 8; ++i) {
+        graph.add_job("fan", [&counter] { ++counter; }, {state}, {});
+    }
+    graph.add_job("reduce", [&counter] { counter += 100; }, {}, {state});
+
+    for (int frame = 0; frame < 50; ++frame) {
+        graph.execute(pool);
+    }
+
+    EXPECT_EQ(counter.load(), 50 * 108);
+    EXPECT_EQ(graph.stats().job_count, 9u);
+    EXPECT_EQ(graph.stats().edge_count, 8u);
+}
+
+TEST(TaskGraphTest, GraphMayBeDestroyedAsSoonAsExecuteReturns) {
+    ThreadPool pool(4);
+    for (int frame = 0; frame < 200; ++frame) {
+        auto graph = std::make_unique<TaskGraph>();
+        std::atomic<int> counter{0};
+        auto a = graph->add_job("a", [&counter] { ++counter; });
+        for (int i = 0; i < 4; ++i) {
+            graph->add_dependency(a, graph->add_job("b", [&counter] { ++counter; }));
+        }
+        graph->execute(pool);
+        graph.reset();
+        EXPECT_EQ(counter.load(), 5);
+    }
+}
+
+TEST(TaskGraphTest, JobExceptionIsRethrownFromExecute) {
+    ThreadPool pool(4);
+    TaskGraph graph;
+    std::atomic<int> ran{0};
+
+    auto a = graph.add_job("a", [&ran] { ++ran; });
+    auto b = graph.add_job("b", [] { throw std::runtime_error("job failed"); });
+    auto c = graph.add_job("c", [&ran] { ++ran; });
+    graph.add_dependency(a, b);
+    graph.add_dependency(b, c);
+
+    EXPECT_THROW(graph.execute(pool), std::runtime_error);
+    EXPECT_EQ(ran.load(), 1);   // c was skipped
+
+    // The pool keeps working afterwards
+    TaskGraph ok;
+    ok.add_job("x", [&ran] { ++ran; });
+    ok.execute(pool);
+    EXPECT_EQ(ran.load(), 2);
+}
+
+TEST(TaskGraphTest, SerialExecutionFollowsTopologicalOrder) {
+    TaskGraph graph;
+    Trace trace;
+
+    auto c = graph.add_job("c", trace.record(0));
+    auto b = graph.add_job("b", trace.record(1));
+    auto a = graph.add_job("a", trace.record(2));
+    graph.add_dependency(a, b);
+    graph.add_dependency(b, c);
+
+    graph.execute_serial();
+
+    ASSERT_EQ(trace.order.size(), 3u);
+    EXPECT_EQ(trace.order[0], a);
+    EXPECT_EQ(trace.order[1], b);
+    EXPECT_EQ(trace.order[2], c);
+}
+
+TEST(TaskGraphTest, StatsReportCriticalPath) {
+    TaskGraph graph;
+    auto spin = [](int micros) {
+        return [micros] {
+            auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(micros);
+            while (std::chrono::steady_clock::now() < end) {}
+        };
+    };
+
+    auto a = graph.add_job("a", spin(2000));
+    auto b = graph.add_job("b", spin(2000));
+    graph.add_job("c", spin(500));
+    graph.add_dependency(a, b);
+
+    graph.execute_serial();
+
+    const auto& stats = graph.stats();
+    EXPECT_GE(stats.total_work_ms, 4.5);
+    EXPECT_GE(stats.critical_path_ms, 4.0);
+    EXPECT_LT(stats.critical_path_ms, stats.total_work_ms);
+    EXPECT_GT(stats.wall_time_ms, 0.0);
+}
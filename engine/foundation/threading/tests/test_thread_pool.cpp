@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+#include "threading/thread_pool.hpp"
+#include "threading/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace PyNovaGE::Threading;
+
+TEST(WorkStealingDequeTest, OwnerPopIsLifo) {
+    WorkStealingDeque<int*> deque(4);
+    int values[3] = {0, 1, 2};
+
+    for (auto& v : values) deque.push(&v);
+    EXPECT_EQ(deque.size(), 3u);
+
+    int* out = nullptr;
+    ASSERT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, &values[2]);
+    ASSERT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, &values[1]);
+    ASSERT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, &values[0]);
+    EXPECT_FALSE(deque.pop(out));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, StealIsFifo) {
+    WorkStealingDeque<int*> deque(4);
+    int values[3] = {0, 1, 2};
+
+    for (auto& v : values) deque.push(&v);
+
+    int* out = nullptr;
+    ASSERT_TRUE(deque.steal(out));
+    EXPECT_EQ(out, &values[0]);
+    ASSERT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, &values[2]);
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+    WorkStealingDeque<size_t*> deque(2);
+    std::vector<size_t> values(1000);
+
+    for (auto& v : values) deque.push(&v);
+    EXPECT_GE(deque.capacity(), 1000u);
+    EXPECT_EQ(deque.size(), 1000u);
+
+    size_t* out = nullptr;
+    for (size_t i = values.size(); i-- > 0;) {
+        ASSERT_TRUE(deque.pop(out));
+        EXPECT_EQ(out, &values[i]);
+    }
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachItemOnce) {
+    constexpr size_t kItems = 20000;
+    WorkStealingDeque<size_t*> deque(16);
+    std::vector<size_t> values(kItems);
+    std::vector<std::atomic<int>> taken(kItems);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            size_t* out = nullptr;
+            while (!done.load() || !deque.empty()) {
+                if (deque.steal(out)) {
+                    ++taken[static_cast<size_t>(out - values.data())];
+                }
+            }
+        });
+    }
+
+    size_t* out = nullptr;
+    for (size_t i = 0; i < kItems; ++i) {
+        deque.push(&values[i]);
+        if (i % 3 == 0 && deque.pop(out)) {
+            ++taken[static_cast<size_t>(out - values.data())];
+        }
+    }
+    while (deque.pop(out)) {
+        ++taken[static_cast<size_t>(out - values.data())];
+    }
+    done = true;
+    for (auto& t : thieves) t.join();
+
+    for (size_t i = 0; i < kItems; ++i) {
+        EXPECT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+class ThreadPoolPolicyTest : public ::testing::TestWithParam<SchedulingPolicy> {};
+
+TEST_P(ThreadPoolPolicyTest, EnqueueReturnsResults) {
+    ThreadPool pool(4, GetParam());
+    EXPECT_EQ(pool.policy(), GetParam());
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.emplace_back(pool.enqueue([](int x) { return x * 2; }, i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(futures[static_cast<size_t>(i)].get(), i * 2);
+    }
+}
+
+TEST_P(ThreadPoolPolicyTest, WaitForAllCoversSubmittedTasks) {
+    ThreadPool pool(4, GetParam());
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter] { ++counter; });
+    }
+    pool.wait_for_all();
+
+    EXPECT_EQ(counter.load(), 1000);
+    EXPECT_FALSE(pool.is_busy());
+    EXPECT_EQ(pool.pending_tasks(), 0u);
+}
+
+TEST_P(ThreadPoolPolicyTest, NestedSubmissionsComplete) {
+    ThreadPool pool(4, GetParam());
+    std::atomic<int> leaves{0};
+
+    // Binary fan-out, depth 10 -> 1024 leaves
+    std::function<void(int)> spawn = [&](int depth) {
+        if (depth == 0) {
+            ++leaves;
+            return;
+        }
+        pool.submit([&spawn, depth] { spawn(depth - 1); });
+        pool.submit([&spawn, depth] { spawn(depth - 1); });
+    };
+
+    pool.submit([&spawn] { spawn(10); });
+    pool.wait_for_all();
+
+    EXPECT_EQ(leaves.load(), 1024);
+}
+
+TEST_P(ThreadPoolPolicyTest, WorkerIndexIsReportedInsideTasks) {
+    ThreadPool pool(4, GetParam());
+    EXPECT_EQ(pool.current_worker_index(), -1);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 32; ++i) {
+        futures.emplace_back(pool.enqueue([&pool] { return pool.current_worker_index(); }));
+    }
+    for (auto& f : futures) {
+        const int index = f.get();
+        EXPECT_GE(index, 0);
+        EXPECT_LT(index, static_cast<int>(pool.size()));
+    }
+}
+
+TEST_P(ThreadPoolPolicyTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(2, GetParam());
+        for (int i = 0; i < 500; ++i) {
+            pool.submit([&counter] { ++counter; });
+        }
+    }
+    EXPECT_EQ(counter.load(), 500);
+}
+
+INSTANTIATE_TEST_SUITE_P(Policies, ThreadPoolPolicyTest,
+    ::testing::Values(SchedulingPolicy::SharedQueue, SchedulingPolicy::WorkStealing));
+
+TEST(ThreadPoolWorkStealingTest, LocalSubmissionsAreStolenByIdleWorkers) {
+    ThreadPool pool(5, SchedulingPolicy::WorkStealing);
+    ASSERT_GE(pool.size(), 2u);
+
+    std::mutex ids_mutex;
+    std::set<std::thread::id> ids;
+
+    // A single root task fans out locally; other workers must steal to help
+    pool.submit([&] {
+        for (int i = 0; i < 256; ++i) {
+            pool.submit([&] {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                std::lock_guard<std::mutex> lock(ids_mutex);
+                ids.insert(std::this_thread::get_id());
+            });
+        }
+    });
+    pool.wait_for_all();
+
+    EXPECT_GT(ids.size(), 1u);
+}
+
+TEST(ParallelForTest, VisitsEveryIndexOnce) {
+    std::vector<std::atomic<int>> hits(10007);
+
+    parallel_for(0, hits.size(), [&hits](size_t i) { ++hits[i]; });
+
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQ(hits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(ParallelForTest, RespectsGrainSizeAndOffsets) {
+    ThreadPool pool(4);
+    std::vector<int> values(1000, 0);
+
+    parallel_for(100, 900, [&values](size_t i) { values[i] = 1; }, &pool, 64);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], (i >= 100 && i < 900) ? 1 : 0) << "index " << i;
+    }
+}
+
+TEST(ParallelForTest, DefaultPoolIsPersistent) {
+    ThreadPool& first = default_thread_pool();
+    ThreadPool& second = default_thread_pool();
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first.policy(), SchedulingPolicy::WorkStealing);
+}
+
+TEST(ParallelForTest, PropagatesExceptions) {
+    EXPECT_THROW(parallel_for(0, 1000, [](size_t i) {
+        if (i == 500) throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+TEST_P(ThreadPoolPolicyTest, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(3, GetParam());
+    std::atomic<int> total{0};
+
+    // Every outer iteration runs on a worker and issues its own parallel loop
+    parallel_for(0, 16, [&](size_t) {
+        parallel_for(0, 256, [&total](size_t) { ++total; }, &pool, 8);
+    }, &pool, 1);
+
+    EXPECT_EQ(total.load(), 16 * 256);
+}
+
+TEST(ParallelBatchTest, BatchesViewSourceWithoutCopying) {
+    std::vector<int> items(1000);
+    for (size_t i = 0; i < items.size(); ++i) items[i] = static_cast<int>(i);
+
+    std::atomic<int> batches{0};
+    std::atomic<long long> sum{0};
+    std::atomic<bool> views_source{true};
+
+    parallel_batch(items, 64, [&](Span<const int> batch) {
+        if (batch.data() < items.data() || batch.end() > items.data() + items.size()) {
+            views_source = false;
+        }
+        EXPECT_LE(batch.size(), 64u);
+        long long local = 0;
+        for (int v : batch) local += v;
+        sum += local;
+        ++batches;
+    });
+
+    EXPECT_TRUE(views_source.load());
+    EXPECT_EQ(batches.load(), 16);
+    EXPECT_EQ(sum.load(), 999LL * 1000LL / 2LL);
+}
+
+TEST(ParallelReduceTest, SumsRange) {
+    const long long total = parallel_reduce(size_t(0), size_t(100000), 0LL,
+        [](size_t i) { return static_cast<long long>(i); },
+        [](long long a, long long b) { return a + b; });
+    EXPECT_EQ(total, 99999LL * 100000LL / 2LL);
+}
+
+TEST(ParallelReduceTest, EmptyRangeReturnsIdentity) {
+    const int result = parallel_reduce(size_t(5), size_t(5), 42,
+        [](size_t) { return 1; },
+        [](int a, int b) { return a + b; });
+    EXPECT_EQ(result, 42);
+}
+
+TEST(ParallelReduceTest, FindsMaximum) {
+    std::vector<float> values(5000);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<float>((i * 7919) % 4999);
+
+    ThreadPool pool(4);
+    const float max_value = parallel_reduce(size_t(0), values.size(), 0.0f,
+        [&values](size_t i) { return values[i]; },
+        [](float a, float b) { return std::max(a, b); }, &pool);
+    EXPECT_EQ(max_value, 4998.0f);
+}
@@ -2,7 +2,8 @@
 
 #include "particles/particle.hpp"
 #include "particles/particle_emitter.hpp"
-#include <memory/object_pool.h>
+#include <memory/paged_object_pool.h>
+#include <memory/memory_tracker.h>
 #include <renderer/batch_renderer.hpp>
 #include <memory>
 #include <vector>
@@ -22,6 +23,8 @@ struct ParticleSystemStats {
     size_t active_emitters = 0;         ///< Currently active emitters
     size_t pool_size = 0;              ///< Total pool size
     size_t pool_free = 0;              ///< Free pool slots
+    size_t memory_used = 0;            ///< Tracked bytes of this system's particle pool (0 without memory tracking)
+    size_t memory_peak = 0;            ///< Peak of memory_used
     float update_time_ms = 0.0f;       ///< Last update time in milliseconds
     float render_time_ms = 0.0f;       ///< Last render time in milliseconds
     
@@ -49,7 +52,7 @@ struct ParticleSystemConfig {
  * @brief Main particle system class
  * 
  * Manages particle lifecycle, memory allocation, updates, and rendering.
- * Integrates with ObjectPool for efficient memory management and
+ * Integrates with PagedObjectPool for efficient memory management and
  * BatchRenderer for efficient rendering.
  */
 class ParticleSystem {
@@ -105,6 +108,12 @@ public:
      * @return Shared pointer to the created emitter
      */
     std::shared_ptr<ParticleEmitter> CreateEmitter(const EmitterConfig& config);
+
+    /**
+     * @brief Add an emitter created elsewhere; adding one twice does nothing
+     * @param emitter Emitter to add
+     */
+    void AddEmitter(std::shared_ptr<ParticleEmitter> emitter);
     
     /**
      * @brief Remove an emitter
@@ -211,6 +220,11 @@ private:
      */
     void RemoveDeadParticles();
     
+    /**
+     * @brief Refresh memory statistics from this system's memory scope
+     */
+    void UpdateMemoryStats();
+    
     /**
      * @brief Convert particle to BatchVertex for rendering
      */
@@ -231,7 +245,10 @@ private:
     bool initialized_ = false;
     
     // Memory management
-    std::unique_ptr<ObjectPool<Particle>> particle_pool_;
+    std::unique_ptr<PagedObjectPool<Particle>> particle_pool_;
+    // Charged by particle_pool_. Heap-held so the pool's pointer survives a
+    // move; declared after the pool so move assignment releases the old pool first
+    std::unique_ptr<MemoryScope> memory_scope_;
     
     // Active particles and emitters
     std::unordered_set<Particle*> active_particles_;
@@ -6,6 +6,13 @@
 namespace PyNovaGE {
 namespace Particles {
 
+namespace {
+// Particles per pool slab; the pool grows slab by slab up to max_particles
+constexpr size_t kParticleSlabSize = 1024;
+// Slabs kept across bursts so steady emission does not hit the system allocator
+constexpr size_t kParticleHighWaterSlabs = 8;
+}
+
 ParticleSystem::ParticleSystem(const ParticleSystemConfig& config)
     : config_(config) {
     
@@ -15,6 +22,7 @@ ParticleSystem::ParticleSystem(const ParticleSystemConfig& config)
 
 ParticleSystem::~ParticleSystem() {
     Shutdown();
+    particle_pool_.reset();  // Before memory_scope_, which it charges
 }
 
 bool ParticleSystem::Initialize() {
@@ -24,7 +32,12 @@ bool ParticleSystem::Initialize() {
     
     try {
         // Create particle pool
-        particle_pool_ = std::make_unique<ObjectPool<Particle>>(config_.max_particles);
+        particle_pool_ = std::make_unique<PagedObjectPool<Particle>>(
+            kParticleSlabSize, config_.max_particles, kParticleHighWaterSlabs);
+        if (!memory_scope_) {
+            memory_scope_ = std::make_unique<MemoryScope>(MemoryTag::Particles);
+        }
+        particle_pool_->setMemoryScope(memory_scope_.get());
         
         // Initialize statistics
         stats_.pool_size = config_.max_particles;
@@ -74,6 +87,7 @@ void ParticleSystem::Update(float dt) {
     stats_.active_particles = active_particles_.size();
     stats_.active_emitters = active_emitters_.size();
     stats_.pool_free = particle_pool_->getFreeCount();
+    UpdateMemoryStats();
     
     if (stats_.active_particles > stats_.peak_active_particles) {
         stats_.peak_active_particles = stats_.active_particles;
@@ -161,14 +175,21 @@ void ParticleSystem::Render(Renderer::BatchRenderer& batch_renderer) {
 
 std::shared_ptr<ParticleEmitter> ParticleSystem::CreateEmitter(const EmitterConfig& config) {
     auto emitter = std::make_shared<ParticleEmitter>(config);
-    
+    AddEmitter(emitter);
+    return emitter;
+}
+
+void ParticleSystem::AddEmitter(std::shared_ptr<ParticleEmitter> emitter) {
+    if (!emitter || std::find(active_emitters_.begin(), active_emitters_.end(), emitter) != active_emitters_.end()) {
+        return;
+    }
+
     // Set the emission callback to this system
     emitter->SetEmitCallback([this](const ParticleInitData& data) {
         OnParticleEmitted(data);
     });
-    
+
     active_emitters_.push_back(emitter);
-    return emitter;
 }
 
 void ParticleSystem::RemoveEmitter(std::shared_ptr<ParticleEmitter> emitter) {
@@ -232,22 +253,24 @@ void ParticleSystem::DestroyParticle(Particle* particle) {
 }
 
 void ParticleSystem::ClearParticles() {
-    // Destroy all active particles
-    for (Particle* particle : active_particles_) {
-        if (particle && particle_pool_->ownsPointer(particle)) {
-            particle_pool_->release(particle);
-        }
+    // Destroy all active particles in one pass over the pool's occupancy bitmaps
+    if (particle_pool_) {
+        particle_pool_->clear();
     }
     
     active_particles_.clear();
 }
 
 void ParticleSystem::ApplyGlobalForce(const Vector2f& force) {
-    for (Particle* particle : active_particles_) {
-        if (particle && particle->IsAlive()) {
-            particle->ApplyForce(force);
-        }
+    if (!particle_pool_) {
+        return;
     }
+    
+    particle_pool_->for_each_live([&force](Particle& particle) {
+        if (particle.IsAlive()) {
+            particle.ApplyForce(force);
+        }
+    });
 }
 
 void ParticleSystem::ApplyRadialForce(const Vector2f& position, float radius, const Vector2f& force, bool falloff) {
@@ -303,11 +326,12 @@ void ParticleSystem::OnParticleEmitted(const ParticleInitData& init_data) {
 }
 
 void ParticleSystem::UpdateParticles(float dt) {
-    for (Particle* particle : active_particles_) {
-        if (particle && particle->IsAlive()) {
-            particle->Update(dt);
+    // Walk the pool in address order rather than the hash set for cache locality
+    particle_pool_->for_each_live([dt](Particle& particle) {
+        if (particle.IsAlive()) {
+            particle.Update(dt);
         }
-    }
+    });
 }
 
 void ParticleSystem::UpdateEmitters(float dt) {
@@ -333,6 +357,13 @@ void ParticleSystem::RemoveDeadParticles() {
     }
 }
 
+void ParticleSystem::UpdateMemoryStats() {
+    // Slab storage recorded in this system's scope; MemoryTag::Particles totals every system
+    const MemoryTagStats memory = memory_scope_->getStats();
+    stats_.memory_used = memory.current_bytes;
+    stats_.memory_peak = memory.peak_bytes;
+}
+
 Renderer::BatchVertex ParticleSystem::ParticleToVertex(const Particle& particle, size_t vertex_index) {
     // This method is for future direct batch vertex generation if needed
     // Currently we use the Sprite conversion approach for simplicity
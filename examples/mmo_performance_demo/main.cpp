@@ -321,10 +321,10 @@ public:
     }
     
     void UpdateCharacterAI(float delta_time) {
-        // Simple serial AI updates (parallel batching not yet implemented)
-        for (const auto& character : characters_) {
-            UpdateSingleCharacter(*character, delta_time);
-        }
+        // Characters are independent, so split them across the worker pool
+        Threading::parallel_for(0, characters_.size(), [this, delta_time](size_t i) {
+            UpdateSingleCharacter(*characters_[i], delta_time);
+        }, thread_pool_.get(), 64);
     }
     
     static void UpdateSingleCharacter(MMOCharacter& character, float delta_time) {